@@ -0,0 +1,124 @@
+// --------------------------------------------------------------------------------------------------------------------
+// <copyright file="Crc32C.cs" company="Zen Design Software">
+//   © Zen Design Software 2021
+// </copyright>
+// <summary>
+// </summary>
+// --------------------------------------------------------------------------------------------------------------------
+
+using System;
+
+namespace Zen.Trunk.IO
+{
+    /// <summary>
+    /// <c>Crc32C</c> computes CRC-32C (Castagnoli) checksums using a
+    /// slice-by-8 lookup table.
+    /// </summary>
+    /// <remarks>
+    /// Checksums can be built incrementally by passing the result of one
+    /// call as the seed of the next.
+    /// </remarks>
+    public static class Crc32C
+    {
+        #region Private Fields
+        private const uint Polynomial = 0x82F63B78;
+        private static readonly uint[] Table = CreateTable();
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Computes the checksum of the specified buffer region.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        /// <param name="offset">The offset.</param>
+        /// <param name="count">The count.</param>
+        /// <returns>The CRC-32C checksum.</returns>
+        public static uint Compute(byte[] buffer, int offset, int count)
+        {
+            return Append(0, buffer, offset, count);
+        }
+
+        /// <summary>
+        /// Extends an existing checksum with the specified buffer region.
+        /// </summary>
+        /// <param name="crc">The checksum computed so far (zero to start).</param>
+        /// <param name="buffer">The buffer.</param>
+        /// <param name="offset">The offset.</param>
+        /// <param name="count">The count.</param>
+        /// <returns>The CRC-32C checksum.</returns>
+        /// <exception cref="ArgumentNullException">buffer is null</exception>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// offset or count is outside the bounds of the buffer.
+        /// </exception>
+        public static uint Append(uint crc, byte[] buffer, int offset, int count)
+        {
+            if (buffer == null)
+            {
+                throw new ArgumentNullException(nameof(buffer));
+            }
+            if (offset < 0 || count < 0 || offset > buffer.Length - count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+
+            var table = Table;
+            var value = ~crc;
+
+            // Process eight bytes at a time
+            while (count >= 8)
+            {
+                var low = value ^ (uint)(
+                    buffer[offset] |
+                    buffer[offset + 1] << 8 |
+                    buffer[offset + 2] << 16 |
+                    buffer[offset + 3] << 24);
+                value =
+                    table[0x700 + (low & 0xff)] ^
+                    table[0x600 + ((low >> 8) & 0xff)] ^
+                    table[0x500 + ((low >> 16) & 0xff)] ^
+                    table[0x400 + (low >> 24)] ^
+                    table[0x300 + buffer[offset + 4]] ^
+                    table[0x200 + buffer[offset + 5]] ^
+                    table[0x100 + buffer[offset + 6]] ^
+                    table[buffer[offset + 7]];
+                offset += 8;
+                count -= 8;
+            }
+
+            // Process remaining bytes
+            while (count-- > 0)
+            {
+                value = table[(value ^ buffer[offset++]) & 0xff] ^ (value >> 8);
+            }
+
+            return ~value;
+        }
+        #endregion
+
+        #region Private Methods
+        private static uint[] CreateTable()
+        {
+            var table = new uint[8 * 256];
+            for (uint index = 0; index < 256; ++index)
+            {
+                var entry = index;
+                for (var bit = 0; bit < 8; ++bit)
+                {
+                    entry = (entry & 1) != 0 ? (entry >> 1) ^ Polynomial : entry >> 1;
+                }
+                table[index] = entry;
+            }
+
+            for (var index = 0; index < 256; ++index)
+            {
+                for (var slice = 1; slice < 8; ++slice)
+                {
+                    var previous = table[((slice - 1) * 256) + index];
+                    table[(slice * 256) + index] = (previous >> 8) ^ table[previous & 0xff];
+                }
+            }
+            return table;
+        }
+        #endregion
+    }
+}
@@ -6,7 +6,7 @@ namespace Zen.Trunk.Storage
     /// Simple value type which represents a Logical Page Identifier.
     /// </summary>
     [Serializable]
-    public struct LogicalPageId : IComparable, ICloneable
+    public struct LogicalPageId : IComparable, ICloneable, IEquatable<LogicalPageId>
     {
         #region Public Fields
         /// <summary>
@@ -102,6 +102,19 @@ namespace Zen.Trunk.Storage
             return equal;
         }
 
+        /// <summary>
+        /// Tests the specified logical page id for equality with this instance.
+        /// </summary>
+        /// <param name="other">The logical page id to compare.</param>
+        /// <returns>
+        /// <c>true</c> if both identifiers refer to the same logical page;
+        /// otherwise <c>false</c>.
+        /// </returns>
+        public bool Equals(LogicalPageId other)
+        {
+            return Value == other.Value;
+        }
+
         /// <summary>
         /// Overridden. Returns the hash code for this instance.
         /// </summary>
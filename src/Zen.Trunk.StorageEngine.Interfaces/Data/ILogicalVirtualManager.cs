@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 using System.Threading.Tasks;
 using Zen.Trunk.VirtualMemory;
 
@@ -34,6 +35,21 @@ namespace Zen.Trunk.Storage.Data
         /// </returns>
         Task AddLookupAsync(VirtualPageId virtualPageId, LogicalPageId logicalPageId);
 
+        /// <summary>
+        /// Removes the lookup for the specified virtual page id.
+        /// </summary>
+        /// <param name="virtualPageId">
+        /// A <see cref="VirtualPageId"/> representing the virtual page identifier.
+        /// </param>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <remarks>
+        /// Once removed both the virtual page and the logical page it was
+        /// mapped to may be used in a new lookup.
+        /// </remarks>
+        Task RemoveLookupAsync(VirtualPageId virtualPageId);
+
         /// <summary>
         /// Gets the logical page identifier that corresponds to the specified virtual page id.
         /// </summary>
@@ -57,5 +73,43 @@ namespace Zen.Trunk.Storage.Data
         /// representing the virtual page identifier.
         /// </returns>
         Task<VirtualPageId> GetVirtualAsync(LogicalPageId logicalPageId);
+
+        /// <summary>
+        /// Attempts to get the logical page identifier that corresponds to
+        /// the specified virtual page id without waiting.
+        /// </summary>
+        /// <param name="virtualPageId">
+        /// A <see cref="VirtualPageId"/> representing the virtual page identifier.
+        /// </param>
+        /// <param name="logicalPageId">
+        /// When this method returns <c>true</c>, the logical page identifier.
+        /// </param>
+        /// <returns>
+        /// <c>true</c> if a mapping exists; otherwise, <c>false</c>.
+        /// </returns>
+        bool TryGetLogical(VirtualPageId virtualPageId, out LogicalPageId logicalPageId);
+
+        /// <summary>
+        /// Attempts to get the virtual page identifier that corresponds to
+        /// the specified logical id without waiting.
+        /// </summary>
+        /// <param name="logicalPageId">
+        /// A <see cref="LogicalPageId"/> representing the logical page identifier.
+        /// </param>
+        /// <param name="virtualPageId">
+        /// When this method returns <c>true</c>, the virtual page identifier.
+        /// </param>
+        /// <returns>
+        /// <c>true</c> if a mapping exists; otherwise, <c>false</c>.
+        /// </returns>
+        bool TryGetVirtual(LogicalPageId logicalPageId, out VirtualPageId virtualPageId);
+
+        /// <summary>
+        /// Gets a snapshot of all logical to virtual page mappings.
+        /// </summary>
+        /// <returns>
+        /// A list of mappings ordered by logical page identifier.
+        /// </returns>
+        IList<KeyValuePair<LogicalPageId, VirtualPageId>> GetLookups();
     }
 }
\ No newline at end of file
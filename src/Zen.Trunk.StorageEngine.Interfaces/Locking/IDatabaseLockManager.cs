@@ -18,6 +18,30 @@ namespace Zen.Trunk.Storage.Locking
         /// </value>
         DatabaseId DatabaseId { get; }
 
+        /// <summary>
+        /// Gets or sets the number of item locks a transaction may hold on
+        /// a single object before they are escalated to an object lock.
+        /// </summary>
+        /// <value>
+        /// The lock escalation threshold.
+        /// </value>
+        uint LockEscalationThreshold { get; set; }
+
+        /// <summary>
+        /// Gets the number of lock escalations performed against this
+        /// database.
+        /// </summary>
+        /// <value>
+        /// The lock escalation count.
+        /// </value>
+        int LockEscalationCount { get; }
+
+        /// <summary>
+        /// Occurs when a transaction escalates its item locks to an owner
+        /// lock.
+        /// </summary>
+        event EventHandler<LockEscalatedEventArgs> LockEscalated;
+
         #region Database Lock/Unlock
         /// <summary>
         /// Locks the database.
@@ -188,7 +212,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="indexId">The index identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        void LockRootIndex(ObjectId objectId, IndexId indexId, bool writable, TimeSpan timeout);
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        Task LockRootIndexAsync(ObjectId objectId, IndexId indexId, bool writable, TimeSpan timeout);
 
         /// <summary>
         /// Unlocks the index of the root.
@@ -206,7 +233,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="logicalId">The logical identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        void LockInternalIndex(ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout);
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        Task LockInternalIndexAsync(ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout);
 
         /// <summary>
         /// Unlocks the index of the internal.
@@ -225,7 +255,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="logicalId">The logical identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        void LockLeafIndex(ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout);
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        Task LockLeafIndexAsync(ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout);
 
         /// <summary>
         /// Unlocks the index of the leaf.
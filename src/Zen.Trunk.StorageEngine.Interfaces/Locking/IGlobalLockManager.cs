@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 using System.Threading.Tasks;
 using Zen.Trunk.VirtualMemory;
 
@@ -10,6 +11,42 @@ namespace Zen.Trunk.Storage.Locking
     /// </summary>
     public interface IGlobalLockManager
     {
+        /// <summary>
+        /// Gets the number of deadlocks broken by deadlock detection.
+        /// </summary>
+        /// <value>
+        /// The deadlock count.
+        /// </value>
+        int DeadlockCount { get; }
+
+        /// <summary>
+        /// Finds deadlocked lock requests and fails one request in each
+        /// deadlock.
+        /// </summary>
+        /// <returns>
+        /// The number of deadlocks broken.
+        /// </returns>
+        int DetectDeadlocks();
+
+        /// <summary>
+        /// Gets the acquire, wait and timeout statistics for each class of
+        /// lock.
+        /// </summary>
+        /// <returns>
+        /// A list of <see cref="LockClassStatistics"/> objects.
+        /// </returns>
+        IList<LockClassStatistics> GetLockStatistics();
+
+        /// <summary>
+        /// Gets the most contended lock resources.
+        /// </summary>
+        /// <param name="count">The maximum number of resources to return.</param>
+        /// <returns>
+        /// A list of <see cref="LockResourceStatistics"/> objects ordered by
+        /// descending total wait time.
+        /// </returns>
+        IList<LockResourceStatistics> GetHotResources(int count);
+
         /// <summary>
         /// Locks the database.
         /// </summary>
@@ -226,8 +263,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="indexId">The index identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        /// <returns></returns>
-        void LockRootIndex(DatabaseId dbId, ObjectId objectId, IndexId indexId, bool writable, TimeSpan timeout);
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        Task LockRootIndexAsync(DatabaseId dbId, ObjectId objectId, IndexId indexId, bool writable, TimeSpan timeout);
 
         /// <summary>
         /// Unlocks the root index.
@@ -247,7 +286,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="logicalId">The logical identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        void LockInternalIndex(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout);
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        Task LockInternalIndexAsync(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout);
 
         /// <summary>
         /// Unlocks the internal index.
@@ -269,8 +311,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="logicalId">The logical identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        /// <returns></returns>
-        void LockLeafIndex(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout);
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        Task LockLeafIndexAsync(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout);
 
         /// <summary>
         /// Unlocks the leaf index.
@@ -32,5 +32,18 @@ namespace Zen.Trunk.Storage.Locking
         /// The timeout.
         /// </value>
         TimeSpan Timeout { get; }
+
+        /// <summary>
+        /// Gets or sets a value indicating whether commit returns before the
+        /// commit log record has been written to the log.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if durability is delayed; otherwise, <c>false</c>.
+        /// </value>
+        /// <remarks>
+        /// A transaction committed with delayed durability may be lost if
+        /// the process fails before the log is next flushed.
+        /// </remarks>
+        bool IsDurabilityDelayed { get; set; }
 	}
 }
@@ -0,0 +1,92 @@
+using System;
+using System.Collections.Generic;
+
+namespace Zen.Trunk.Storage.Locking
+{
+    /// <summary>
+    /// <c>LockClassStatistics</c> is a point-in-time view of the activity of
+    /// a single class of lock.
+    /// </summary>
+    /// <seealso cref="IGlobalLockManager.GetLockStatistics"/>
+    public class LockClassStatistics
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LockClassStatistics"/> class.
+        /// </summary>
+        /// <param name="lockClass">The lock class name.</param>
+        /// <param name="acquireCount">The number of lock requests.</param>
+        /// <param name="waitCount">The number of requests that had to wait.</param>
+        /// <param name="timeoutCount">The number of requests that timed out.</param>
+        /// <param name="totalWaitTime">The total time spent waiting.</param>
+        /// <param name="waitTimeHistogram">The wait time histogram.</param>
+        public LockClassStatistics(
+            string lockClass,
+            long acquireCount,
+            long waitCount,
+            long timeoutCount,
+            TimeSpan totalWaitTime,
+            IReadOnlyList<long> waitTimeHistogram)
+        {
+            LockClass = lockClass;
+            AcquireCount = acquireCount;
+            WaitCount = waitCount;
+            TimeoutCount = timeoutCount;
+            TotalWaitTime = totalWaitTime;
+            WaitTimeHistogram = waitTimeHistogram;
+        }
+
+        /// <summary>
+        /// Gets the name of the lock class.
+        /// </summary>
+        /// <value>
+        /// The lock class.
+        /// </value>
+        public string LockClass { get; }
+
+        /// <summary>
+        /// Gets the number of lock requests made.
+        /// </summary>
+        /// <value>
+        /// The acquire count.
+        /// </value>
+        public long AcquireCount { get; }
+
+        /// <summary>
+        /// Gets the number of lock requests that could not be granted
+        /// immediately.
+        /// </summary>
+        /// <value>
+        /// The wait count.
+        /// </value>
+        public long WaitCount { get; }
+
+        /// <summary>
+        /// Gets the number of lock requests that timed out.
+        /// </summary>
+        /// <value>
+        /// The timeout count.
+        /// </value>
+        public long TimeoutCount { get; }
+
+        /// <summary>
+        /// Gets the total time spent waiting for locks of this class.
+        /// </summary>
+        /// <value>
+        /// The total wait time.
+        /// </value>
+        public TimeSpan TotalWaitTime { get; }
+
+        /// <summary>
+        /// Gets the wait time histogram.
+        /// </summary>
+        /// <value>
+        /// The wait time histogram.
+        /// </value>
+        /// <remarks>
+        /// Bucket <c>n</c> counts waits shorter than 2^n milliseconds that
+        /// did not fall into an earlier bucket; the final bucket counts
+        /// every longer wait.
+        /// </remarks>
+        public IReadOnlyList<long> WaitTimeHistogram { get; }
+    }
+}
@@ -0,0 +1,50 @@
+using System;
+
+namespace Zen.Trunk.Storage.Locking
+{
+    /// <summary>
+    /// <c>LockEscalatedEventArgs</c> is passed as event data when a
+    /// transaction escalates its item locks to a single owner lock.
+    /// </summary>
+    /// <seealso cref="System.EventArgs" />
+    /// <seealso cref="IDatabaseLockManager.LockEscalated"/>
+    public class LockEscalatedEventArgs : EventArgs
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LockEscalatedEventArgs"/> class.
+        /// </summary>
+        /// <param name="resource">The resource that owns the item locks.</param>
+        /// <param name="lockType">The owner lock type taken.</param>
+        /// <param name="releasedLockCount">The number of item locks released.</param>
+        public LockEscalatedEventArgs(string resource, ObjectLockType lockType, int releasedLockCount)
+        {
+            Resource = resource;
+            LockType = lockType;
+            ReleasedLockCount = releasedLockCount;
+        }
+
+        /// <summary>
+        /// Gets a description of the resource that owns the item locks.
+        /// </summary>
+        /// <value>
+        /// The resource.
+        /// </value>
+        public string Resource { get; }
+
+        /// <summary>
+        /// Gets the owner lock type taken by the escalation.
+        /// </summary>
+        /// <value>
+        /// The type of the lock.
+        /// </value>
+        public ObjectLockType LockType { get; }
+
+        /// <summary>
+        /// Gets the number of item locks released by the escalation.
+        /// </summary>
+        /// <value>
+        /// The released lock count.
+        /// </value>
+        public int ReleasedLockCount { get; }
+    }
+}
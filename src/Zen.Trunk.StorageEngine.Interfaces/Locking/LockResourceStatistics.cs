@@ -0,0 +1,59 @@
+using System;
+
+namespace Zen.Trunk.Storage.Locking
+{
+    /// <summary>
+    /// <c>LockResourceStatistics</c> describes the contention observed on a
+    /// single lock resource.
+    /// </summary>
+    /// <seealso cref="IGlobalLockManager.GetHotResources"/>
+    public class LockResourceStatistics
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LockResourceStatistics"/> class.
+        /// </summary>
+        /// <param name="lockClass">The lock class name.</param>
+        /// <param name="resource">The lock resource identity.</param>
+        /// <param name="waitCount">The number of waits observed.</param>
+        /// <param name="totalWaitTime">The total time spent waiting.</param>
+        public LockResourceStatistics(string lockClass, string resource, long waitCount, TimeSpan totalWaitTime)
+        {
+            LockClass = lockClass;
+            Resource = resource;
+            WaitCount = waitCount;
+            TotalWaitTime = totalWaitTime;
+        }
+
+        /// <summary>
+        /// Gets the name of the lock class.
+        /// </summary>
+        /// <value>
+        /// The lock class.
+        /// </value>
+        public string LockClass { get; }
+
+        /// <summary>
+        /// Gets the identity of the locked resource.
+        /// </summary>
+        /// <value>
+        /// The resource.
+        /// </value>
+        public string Resource { get; }
+
+        /// <summary>
+        /// Gets the number of waits observed on this resource.
+        /// </summary>
+        /// <value>
+        /// The wait count.
+        /// </value>
+        public long WaitCount { get; }
+
+        /// <summary>
+        /// Gets the total time spent waiting on this resource.
+        /// </summary>
+        /// <value>
+        /// The total wait time.
+        /// </value>
+        public TimeSpan TotalWaitTime { get; }
+    }
+}
@@ -0,0 +1,265 @@
+using System;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using Xunit;
+using Xunit.Abstractions;
+using Zen.Trunk.Storage.Locking;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Global Lock Manager")]
+    [Collection(nameof(GlobalLockManager_should))]
+    // ReSharper disable once InconsistentNaming
+    public class GlobalLockManager_should
+    {
+        private const int LookupsPerThread = 20000;
+        private const int PagesPerThread = 8;
+
+        private readonly ITestOutputHelper _output;
+
+        public GlobalLockManager_should(ITestOutputHelper output)
+        {
+            _output = output;
+        }
+
+        [Fact(DisplayName = "Return the same lock object for the same resource")]
+        public void ReturnSameLockObjectForSameResource()
+        {
+            var sut = new GlobalLockManager();
+            var dbId = new DatabaseId(1);
+            var objectId = new ObjectId(2);
+
+            var first = sut.GetDataLock(dbId, objectId, new LogicalPageId(3));
+            var second = sut.GetDataLock(dbId, objectId, new LogicalPageId(3));
+            var other = sut.GetDataLock(dbId, objectId, new LogicalPageId(4));
+            try
+            {
+                Assert.Same(first, second);
+                Assert.NotSame(first, other);
+                Assert.Same(first.Parent, other.Parent);
+            }
+            finally
+            {
+                first.ReleaseRefLock();
+                second.ReleaseRefLock();
+                other.ReleaseRefLock();
+            }
+        }
+
+        [Fact(DisplayName = "Format lock resource ids as legacy lock keys")]
+        public void FormatLockResourceIdsAsLegacyLockKeys()
+        {
+            var dbId = new DatabaseId(1);
+
+            Assert.Equal("DBK:0001", LockIdentity.GetDatabaseKey(dbId).ToString());
+            Assert.Equal(
+                "ODK:0001$00000002$0000000000000003",
+                LockIdentity.GetDataLockKey(dbId, new ObjectId(2), new LogicalPageId(3)).ToString());
+            Assert.NotEqual(
+                LockIdentity.GetObjectLockKey(dbId, new ObjectId(2)),
+                LockIdentity.GetSchemaLockKey(dbId, new ObjectId(2)));
+        }
+
+        [Fact(DisplayName = "Abort the youngest waiter when a deadlock is detected")]
+        public async Task AbortYoungestWaiterWhenDeadlockDetected()
+        {
+            using (var sut = new GlobalLockManager(TimeSpan.FromHours(1)))
+            {
+                var dbId = new DatabaseId(1);
+                var objectId = new ObjectId(2);
+                var firstLock = (DataLock)sut.GetDataLock(dbId, objectId, new LogicalPageId(3));
+                var secondLock = (DataLock)sut.GetDataLock(dbId, objectId, new LogicalPageId(4));
+                var olderOwner = new LockOwnerIdentity(SessionId.Zero, new TransactionId(5));
+                var youngerOwner = new LockOwnerIdentity(SessionId.Zero, new TransactionId(6));
+                var timeout = TimeSpan.FromSeconds(30);
+                try
+                {
+                    await firstLock.LockAsync(olderOwner, DataLockType.Update, timeout).ConfigureAwait(true);
+                    await secondLock.LockAsync(youngerOwner, DataLockType.Update, timeout).ConfigureAwait(true);
+                    var olderWait = secondLock.LockAsync(olderOwner, DataLockType.Update, timeout);
+                    var youngerWait = firstLock.LockAsync(youngerOwner, DataLockType.Update, timeout);
+
+                    Assert.Equal(1, sut.DetectDeadlocks());
+                    Assert.Equal(1, sut.DeadlockCount);
+                    await Assert.ThrowsAsync<LockAbortedException>(() => youngerWait).ConfigureAwait(true);
+                    Assert.False(olderWait.IsCompleted);
+
+                    // Releasing the victim's lock lets the survivor continue
+                    await secondLock.UnlockAsync(youngerOwner, DataLockType.None).ConfigureAwait(true);
+                    await olderWait.ConfigureAwait(true);
+                    Assert.Equal(0, sut.DetectDeadlocks());
+                }
+                finally
+                {
+                    await firstLock.UnlockAsync(olderOwner, DataLockType.None).ConfigureAwait(true);
+                    await secondLock.UnlockAsync(olderOwner, DataLockType.None).ConfigureAwait(true);
+                    firstLock.ReleaseRefLock();
+                    secondLock.ReleaseRefLock();
+                }
+            }
+        }
+
+        [Fact(DisplayName = "Detect deadlocks between index page locks and data locks")]
+        public async Task DetectDeadlockBetweenIndexAndDataLocks()
+        {
+            using (var sut = new GlobalLockManager(TimeSpan.FromHours(1)))
+            {
+                var dbId = new DatabaseId(1);
+                var objectId = new ObjectId(3);
+                var indexId = new IndexId(1);
+                var dataLock = (DataLock)sut.GetDataLock(dbId, objectId, new LogicalPageId(5));
+                var firstSession = new TrunkSession(new SessionId(21), TimeSpan.FromSeconds(60));
+                var secondSession = new TrunkSession(new SessionId(22), TimeSpan.FromSeconds(60));
+                var firstOwner = new LockOwnerIdentity(firstSession.SessionId, TransactionId.Zero);
+                var secondOwner = new LockOwnerIdentity(secondSession.SessionId, TransactionId.Zero);
+                var timeout = TimeSpan.FromSeconds(30);
+                try
+                {
+                    // First owner holds the index root and waits for the data
+                    //  page held by the second owner which waits for the root
+                    Task indexWait;
+                    using (TrunkSessionContext.SwitchSessionContext(firstSession))
+                    {
+                        await sut.LockRootIndexAsync(dbId, objectId, indexId, true, timeout).ConfigureAwait(true);
+                    }
+                    await dataLock.LockAsync(secondOwner, DataLockType.Update, timeout).ConfigureAwait(true);
+                    var dataWait = dataLock.LockAsync(firstOwner, DataLockType.Update, timeout);
+                    using (TrunkSessionContext.SwitchSessionContext(secondSession))
+                    {
+                        indexWait = sut.LockRootIndexAsync(dbId, objectId, indexId, true, timeout);
+                    }
+
+                    Assert.Equal(1, sut.DetectDeadlocks());
+                    var victimWait = await Task.WhenAny(dataWait, indexWait).ConfigureAwait(true);
+                    await Assert.ThrowsAsync<LockAbortedException>(() => victimWait).ConfigureAwait(true);
+
+                    // Release the victim's locks so the survivor can finish
+                    if (victimWait == indexWait)
+                    {
+                        await dataLock.UnlockAsync(secondOwner, DataLockType.None).ConfigureAwait(true);
+                        await dataWait.ConfigureAwait(true);
+                        await dataLock.UnlockAsync(firstOwner, DataLockType.None).ConfigureAwait(true);
+                        using (TrunkSessionContext.SwitchSessionContext(firstSession))
+                        {
+                            sut.UnlockRootIndex(dbId, objectId, indexId, true);
+                        }
+                    }
+                    else
+                    {
+                        using (TrunkSessionContext.SwitchSessionContext(firstSession))
+                        {
+                            sut.UnlockRootIndex(dbId, objectId, indexId, true);
+                        }
+                        await indexWait.ConfigureAwait(true);
+                        using (TrunkSessionContext.SwitchSessionContext(secondSession))
+                        {
+                            sut.UnlockRootIndex(dbId, objectId, indexId, true);
+                        }
+                        await dataLock.UnlockAsync(secondOwner, DataLockType.None).ConfigureAwait(true);
+                    }
+                    Assert.Equal(0, sut.DetectDeadlocks());
+                }
+                finally
+                {
+                    dataLock.ReleaseRefLock();
+                }
+            }
+        }
+
+        [Fact(DisplayName = "Report lock waits, timeouts and the hottest resource")]
+        public async Task ReportLockWaitsTimeoutsAndHottestResource()
+        {
+            using (var sut = new GlobalLockManager(TimeSpan.FromHours(1)))
+            {
+                var dbId = new DatabaseId(1);
+                var objectId = new ObjectId(2);
+                var dataLock = (DataLock)sut.GetDataLock(dbId, objectId, new LogicalPageId(3));
+                var holder = new LockOwnerIdentity(SessionId.Zero, new TransactionId(5));
+                var waiter = new LockOwnerIdentity(SessionId.Zero, new TransactionId(6));
+                try
+                {
+                    await dataLock.LockAsync(holder, DataLockType.Exclusive, TimeSpan.FromSeconds(30)).ConfigureAwait(true);
+                    await Assert
+                        .ThrowsAsync<LockTimeoutException>(() => dataLock.LockAsync(waiter, DataLockType.Shared, TimeSpan.FromMilliseconds(50)))
+                        .ConfigureAwait(true);
+
+                    var statistics = sut.GetLockStatistics().Single(s => s.LockClass == nameof(DataLock));
+                    Assert.Equal(2, statistics.AcquireCount);
+                    Assert.Equal(1, statistics.WaitCount);
+                    Assert.Equal(1, statistics.TimeoutCount);
+                    Assert.Equal(1, statistics.WaitTimeHistogram.Sum());
+
+                    var hottest = sut.GetHotResources(1).Single();
+                    Assert.Equal(
+                        LockIdentity.GetDataLockKey(dbId, objectId, new LogicalPageId(3)).ToString(),
+                        hottest.Resource);
+                    Assert.Equal(1, hottest.WaitCount);
+                }
+                finally
+                {
+                    await dataLock.UnlockAsync(holder, DataLockType.None).ConfigureAwait(true);
+                    dataLock.ReleaseRefLock();
+                }
+            }
+        }
+
+        [Theory(DisplayName = "Benchmark data lock lookups across threads")]
+        [InlineData(1)]
+        [InlineData(2)]
+        [InlineData(4)]
+        [InlineData(8)]
+        [InlineData(16)]
+        [InlineData(32)]
+        [InlineData(64)]
+        public void BenchmarkDataLockLookups(int threadCount)
+        {
+            var sut = new GlobalLockManager();
+            var dbId = new DatabaseId(1);
+            var objectId = new ObjectId(1);
+            var completed = 0;
+
+            void LookupPages(int threadIndex)
+            {
+                var firstPage = (ulong)(threadIndex * PagesPerThread);
+                for (var index = 0; index < LookupsPerThread; ++index)
+                {
+                    var logicalId = new LogicalPageId(firstPage + (ulong)(index % PagesPerThread));
+                    var dataLock = sut.GetDataLock(dbId, objectId, logicalId);
+                    dataLock.ReleaseRefLock();
+                }
+                Interlocked.Add(ref completed, LookupsPerThread);
+            }
+
+            // Warm up the free lock pools
+            LookupPages(0);
+            completed = 0;
+
+            var stopwatch = Stopwatch.StartNew();
+            var threads = Enumerable
+                .Range(0, threadCount)
+                .Select(threadIndex => Task.Factory.StartNew(
+                    () => LookupPages(threadIndex),
+                    TaskCreationOptions.LongRunning))
+                .ToArray();
+            Task.WaitAll(threads);
+            stopwatch.Stop();
+
+            var lookupsPerSecond = completed / stopwatch.Elapsed.TotalSeconds;
+            _output.WriteLine($"{threadCount} threads: {lookupsPerSecond:N0} lookups/sec");
+
+            Assert.Equal(threadCount * LookupsPerThread, completed);
+        }
+    }
+
+    /// <summary>
+    /// Runs the global lock manager tests in isolation so throughput
+    /// measurements are not skewed by tests running in parallel.
+    /// </summary>
+    [CollectionDefinition(nameof(GlobalLockManager_should), DisableParallelization = true)]
+    public class GlobalLockManagerCollection
+    {
+    }
+}
@@ -2,6 +2,6 @@
 {
     public interface IDatabaseLockBuilder
     {
-        IObjectLockBuilder WithObjectLock(string lockId);
+        IObjectLockBuilder WithObjectLock(ObjectId objectId);
     }
 }
\ No newline at end of file
@@ -2,8 +2,8 @@
 {
     public interface IObjectLockBuilder
     {
-        IObjectLockBuilder WithSchemaLock(string lockId);
+        IObjectLockBuilder WithSchemaLock();
 
-        IObjectLockBuilder WithDataLock(string lockId);
+        IObjectLockBuilder WithDataLock(LogicalPageId logicalId);
     }
 }
\ No newline at end of file
@@ -2,6 +2,6 @@
 {
     public interface IRootLockBuilder
     {
-        IDatabaseLockBuilder WithDatabaseLock(string lockId);
+        IDatabaseLockBuilder WithDatabaseLock(DatabaseId dbId);
     }
 }
\ No newline at end of file
@@ -6,13 +6,13 @@ namespace Zen.Trunk.Storage
 {
     public interface ITransactionLockHierarchy : IDisposable
     {
-        IDictionary<string, DatabaseLock> DatabaseLocks { get; }
+        IDictionary<LockResourceId, DatabaseLock> DatabaseLocks { get; }
 
-        IDictionary<string, ObjectLock> ObjectLocks { get; }
+        IDictionary<LockResourceId, ObjectLock> ObjectLocks { get; }
 
-        IDictionary<string, SchemaLock> SchemaLocks { get; }
+        IDictionary<LockResourceId, SchemaLock> SchemaLocks { get; }
 
-        IDictionary<string, DataLock> DataLocks { get; }
+        IDictionary<LockResourceId, DataLock> DataLocks { get; }
 
         int ExpectedFinalReleaseCount { get; }
 
@@ -0,0 +1,301 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+using Zen.Trunk.IO;
+using Zen.Trunk.Storage.Logging;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Log Record Encoding")]
+    [Collection(nameof(LogRecordEncoding_should))]
+    // ReSharper disable once InconsistentNaming
+    public class LogRecordEncoding_should
+    {
+        private const int CommitIterations = 1000;
+        private const int DecodeIterations = 1000;
+
+        private readonly ITestOutputHelper _output;
+
+        public LogRecordEncoding_should(ITestOutputHelper output)
+        {
+            _output = output;
+        }
+
+        [Fact(DisplayName = "Encode log records with the same layout as the buffer field serializer")]
+        public void EncodeLogRecordsWithSameLayoutAsBufferFieldSerializer()
+        {
+            var checkpoint = new EndCheckPointLogEntry { LogId = 7, LastLog = 512 };
+            checkpoint.UpdateTransactions(
+                new List<ActiveTransaction>
+                {
+                    new ActiveTransaction(3, new LogFileId(0x10002), 1024, 5)
+                });
+            var entries = new LogEntry[]
+            {
+                new BeginTransactionLogEntry(new TransactionId(3)) { LogId = 5 },
+                new PageImageUpdateLogEntry(CreatePageBuffer(1), CreatePageBuffer(2), 42, 9) { LogId = 6 },
+                checkpoint
+            };
+
+            foreach (var entry in entries)
+            {
+                byte[] expected;
+                using (var stream = new MemoryStream())
+                {
+                    using (var writer = new SwitchingBinaryWriter(stream, true))
+                    {
+                        entry.Write(writer);
+                    }
+                    expected = stream.ToArray();
+                }
+
+                var actual = new byte[entry.RawSize];
+                var recordWriter = new LogRecordWriter(actual, 0, actual.Length);
+                entry.Encode(ref recordWriter);
+
+                Assert.Equal(actual.Length, recordWriter.Position);
+                Assert.Equal(expected, actual);
+
+                var recordReader = new LogRecordReader(actual, 0, actual.Length);
+                var decoded = LogEntry.ReadEntry(ref recordReader);
+                Assert.Equal(entry.LogType, decoded.LogType);
+                Assert.Equal(entry.LogId, decoded.LogId);
+                Assert.Equal(0, recordReader.Remaining);
+            }
+        }
+
+        [Fact(DisplayName = "Benchmark allocations per commit written to the log")]
+        public void BenchmarkAllocationsPerCommit()
+        {
+            var mockedLogDevice = new Moq.Mock<ILogPageDevice>();
+            var logFileInfo = new VirtualLogFileInfo { Length = uint.MaxValue };
+            var before = CreatePageBuffer(1);
+            var after = CreatePageBuffer(2);
+            var transactionId = new TransactionId(1);
+
+            using (var stream = new MemoryStream())
+            using (var sut = new VirtualLogFileStream(mockedLogDevice.Object, stream, logFileInfo))
+            {
+                sut.InitNew();
+                sut.CompressPageImages = false;
+
+                var logId = 0u;
+                void WriteCommit()
+                {
+                    var begin = new BeginTransactionLogEntry(transactionId) { LogId = ++logId };
+                    var update = new PageImageUpdateLogEntry(before, after, 42, logId) { LogId = ++logId };
+                    var commit = new CommitTransactionLogEntry(transactionId) { LogId = ++logId };
+                    sut.WriteEntry(begin);
+                    sut.WriteEntry(update);
+                    sut.WriteEntry(commit);
+                    update.Release();
+                }
+
+                // Warm up pools and let the backing stream reach steady state
+                for (var index = 0; index < CommitIterations; ++index)
+                {
+                    WriteCommit();
+                }
+                stream.SetLength(stream.Length + (CommitIterations * 20 * 1024));
+
+                AppDomain.MonitoringIsEnabled = true;
+                var allocatedBefore = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+                for (var index = 0; index < CommitIterations; ++index)
+                {
+                    WriteCommit();
+                }
+                var allocatedAfter = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+
+                var bytesPerCommit = (allocatedAfter - allocatedBefore) / CommitIterations;
+                _output.WriteLine($"Allocated {bytesPerCommit} bytes per commit");
+
+                // Record objects remain but no page image or block buffer
+                //  should be allocated per commit
+                Assert.True(bytesPerCommit < StorageConstants.PageBufferSize);
+            }
+        }
+
+        [Fact(DisplayName = "Decode log records by value with the fields of the log entry")]
+        public void DecodeLogRecordsByValue()
+        {
+            var before = CreatePageBuffer(1);
+            var after = CreatePageBuffer(2);
+            var block = EncodeBlock(
+                new BeginTransactionLogEntry(new TransactionId(3)) { LogId = 5, LastLog = 4 },
+                new PageImageCreateLogEntry(after, 41, 8) { LogId = 6 },
+                new PageImageUpdateLogEntry(before, after, 42, 9) { LogId = 7 },
+                new PageImageDeleteLogEntry(before, 43, 10) { LogId = 8 },
+                new CommitTransactionLogEntry(new TransactionId(3)) { LogId = 9 });
+
+            var recordReader = new LogRecordReader(block, 0, block.Length);
+            var entryReader = new LogRecordReader(block, 0, block.Length);
+            while (recordReader.Remaining > 0)
+            {
+                var record = LogRecord.Decode(ref recordReader);
+                var entry = (TransactionLogEntry)LogEntry.ReadEntry(ref entryReader);
+                Assert.Equal(entryReader.Position, recordReader.Position);
+                Assert.Equal(entry.LogType, record.LogType);
+                Assert.Equal(entry.LogId, record.LogId);
+                Assert.Equal(entry.LastLog, record.LastLog);
+                Assert.Equal(entry.TransactionId, record.TransactionId);
+                Assert.True(record.IsTransactionRecord);
+
+                switch (entry)
+                {
+                    case PageImageCreateLogEntry create:
+                        Assert.Equal(create.VirtualPageId, record.VirtualPageId);
+                        Assert.Equal(create.Timestamp, record.Timestamp);
+                        Assert.Null(record.BeforeImage);
+                        Assert.Equal(create.Image, record.AfterImage);
+                        break;
+                    case PageImageUpdateLogEntry update:
+                        Assert.Equal(update.VirtualPageId, record.VirtualPageId);
+                        Assert.Equal(update.Timestamp, record.Timestamp);
+                        Assert.Equal(update.BeforeImage, record.BeforeImage);
+                        Assert.Equal(update.AfterImage, record.AfterImage);
+                        break;
+                    case PageImageDeleteLogEntry delete:
+                        Assert.Equal(delete.VirtualPageId, record.VirtualPageId);
+                        Assert.Equal(delete.Timestamp, record.Timestamp);
+                        Assert.Equal(delete.Image, record.BeforeImage);
+                        Assert.Null(record.AfterImage);
+                        break;
+                    default:
+                        Assert.False(record.IsPageRecord);
+                        break;
+                }
+                record.Release();
+                entry.Release();
+            }
+        }
+
+        [Fact(DisplayName = "Benchmark allocations per log record decoded for recovery")]
+        public void BenchmarkAllocationsPerRecordDecoded()
+        {
+            var transactionId = new TransactionId(1);
+            var block = EncodeBlock(
+                new BeginTransactionLogEntry(transactionId) { LogId = 1 },
+                new PageImageUpdateLogEntry(CreatePageBuffer(1), CreatePageBuffer(2), 42, 1) { LogId = 2 },
+                new CommitTransactionLogEntry(transactionId) { LogId = 3 });
+
+            long MeasureBytesPerRecord(Action<byte[]> decodeBlock)
+            {
+                // Warm up the page image pool before measuring
+                for (var index = 0; index < DecodeIterations; ++index)
+                {
+                    decodeBlock(block);
+                }
+
+                AppDomain.MonitoringIsEnabled = true;
+                var allocatedBefore = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+                for (var index = 0; index < DecodeIterations; ++index)
+                {
+                    decodeBlock(block);
+                }
+                var allocatedAfter = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+                return (allocatedAfter - allocatedBefore) / (DecodeIterations * 3);
+            }
+
+            var entryBytes = MeasureBytesPerRecord(
+                buffer =>
+                {
+                    var reader = new LogRecordReader(buffer, 0, buffer.Length);
+                    while (reader.Remaining > 0)
+                    {
+                        LogEntry.ReadEntry(ref reader).Release();
+                    }
+                });
+            var recordBytes = MeasureBytesPerRecord(
+                buffer =>
+                {
+                    var reader = new LogRecordReader(buffer, 0, buffer.Length);
+                    while (reader.Remaining > 0)
+                    {
+                        LogRecord.Decode(ref reader).Release();
+                    }
+                });
+            _output.WriteLine($"Allocated {entryBytes} bytes per log entry and {recordBytes} bytes per log record decoded");
+
+            // Only the pool's own bookkeeping remains on the record path
+            Assert.True(recordBytes < 64);
+            Assert.True(recordBytes < entryBytes);
+        }
+
+        private static byte[] EncodeBlock(params LogEntry[] entries)
+        {
+            var block = new byte[entries.Sum(entry => (long)entry.RawSize)];
+            var writer = new LogRecordWriter(block, 0, block.Length);
+            foreach (var entry in entries)
+            {
+                entry.Encode(ref writer);
+                entry.Release();
+            }
+            return block;
+        }
+
+        private static IVirtualBuffer CreatePageBuffer(byte seed)
+        {
+            var image = new byte[StorageConstants.PageBufferSize];
+            for (var index = 0; index < image.Length; ++index)
+            {
+                image[index] = (byte)(index + seed);
+            }
+            return new PageImageBuffer(image);
+        }
+
+        // Hand-rolled rather than mocked so the benchmark does not measure
+        //  the allocations made when recording mock invocations.
+        private class PageImageBuffer : IVirtualBuffer
+        {
+            private readonly byte[] _image;
+
+            public PageImageBuffer(byte[] image)
+            {
+                _image = image;
+            }
+
+            public string BufferId => nameof(PageImageBuffer);
+
+            public int BufferSize => _image.Length;
+
+            public bool IsDirty => false;
+
+            public int CompareTo(IVirtualBuffer other) => string.CompareOrdinal(BufferId, other?.BufferId);
+
+            public void ClearDirty()
+            {
+            }
+
+            public void CopyTo(IVirtualBuffer destination) => destination.InitFrom(_image);
+
+            public void CopyTo(byte[] buffer) => Buffer.BlockCopy(_image, 0, buffer, 0, _image.Length);
+
+            public Stream GetBufferStream(int offset, int count, bool writable) =>
+                new MemoryStream(_image, offset, count, writable);
+
+            public void InitFrom(byte[] buffer) => Buffer.BlockCopy(buffer, 0, _image, 0, _image.Length);
+
+            public void SetDirty()
+            {
+            }
+
+            public void Dispose()
+            {
+            }
+        }
+    }
+
+    /// <summary>
+    /// Runs the log record encoding tests in isolation so allocation
+    /// measurements are not skewed by tests running in parallel.
+    /// </summary>
+    [CollectionDefinition(nameof(LogRecordEncoding_should), DisableParallelization = true)]
+    public class LogRecordEncodingCollection
+    {
+    }
+}
@@ -0,0 +1,75 @@
+using System.Collections.Generic;
+using System.IO;
+using System.Threading.Tasks;
+using Xunit;
+using Zen.Trunk.Storage.Data;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Logical Page Map File")]
+    // ReSharper disable once InconsistentNaming
+    public class LogicalPageMapFile_should
+    {
+        [Fact(DisplayName = "Restore saved mappings per distribution page and report pages changed since the save")]
+        public async Task RestoreMappingsAndReportChangedPages()
+        {
+            var pathName = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName() + StorageConstants.LogicalPageMapFileExtension);
+            var firstDistributionPage = new VirtualPageId(DeviceId.Primary, 1);
+            var secondDistributionPage = new VirtualPageId(DeviceId.Primary, 514);
+            try
+            {
+                Assert.Null(LogicalPageMapFile.Open(pathName));
+
+                LogicalPageMapFile.Save(
+                    pathName,
+                    new List<DistributionPageMapping>
+                    {
+                        new DistributionPageMapping(
+                            firstDistributionPage,
+                            10,
+                            new List<KeyValuePair<LogicalPageId, VirtualPageId>>
+                            {
+                                new KeyValuePair<LogicalPageId, VirtualPageId>(
+                                    new LogicalPageId(1), new VirtualPageId(DeviceId.Primary, 2))
+                            }),
+                        new DistributionPageMapping(
+                            secondDistributionPage,
+                            20,
+                            new List<KeyValuePair<LogicalPageId, VirtualPageId>>
+                            {
+                                new KeyValuePair<LogicalPageId, VirtualPageId>(
+                                    new LogicalPageId(2000), new VirtualPageId(DeviceId.Primary, 515))
+                            })
+                    });
+
+                using (var mapFile = LogicalPageMapFile.Open(pathName))
+                using (var target = new LogicalVirtualManager())
+                {
+                    Assert.NotNull(mapFile);
+                    Assert.True(mapFile.IsCurrent(firstDistributionPage, 10));
+                    Assert.False(mapFile.IsCurrent(secondDistributionPage, 21));
+                    Assert.False(mapFile.IsCurrent(new VirtualPageId(DeviceId.Primary, 1027), 0));
+
+                    // Only the mappings of the requested distribution page are imported
+                    await mapFile.ImportToAsync(firstDistributionPage, target).ConfigureAwait(true);
+                    Assert.Equal(1, target.GetLookups().Count);
+                    Assert.False(target.TryGetVirtual(new LogicalPageId(2000), out _));
+
+                    await mapFile.ImportToAsync(secondDistributionPage, target).ConfigureAwait(true);
+                    Assert.Equal(2, target.GetLookups().Count);
+                    Assert.True(target.TryGetVirtual(new LogicalPageId(2000), out var virtualPageId));
+                    Assert.Equal(new VirtualPageId(DeviceId.Primary, 515), virtualPageId);
+
+                    // New logical ids continue after the restored mappings
+                    Assert.Equal(2001UL, (await target.GetNewLogicalPageIdAsync().ConfigureAwait(true)).Value);
+                }
+            }
+            finally
+            {
+                File.Delete(pathName);
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+using System;
+using System.Linq;
+using System.Threading.Tasks;
+using Xunit;
+using Zen.Trunk.Storage.Data;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Logical Virtual Manager")]
+    // ReSharper disable once InconsistentNaming
+    public class LogicalVirtualManager_should
+    {
+        [Fact(DisplayName = "Map logical and virtual pages in both directions without waiting")]
+        public async Task MapPagesInBothDirections()
+        {
+            using (var sut = new LogicalVirtualManager())
+            {
+                // Mappings span several directory segments and the overflow map
+                var logicalIds = new ulong[] { 1, 1023, 1024, 5000, 70000, ulong.MaxValue - 1 };
+                for (var index = 0; index < logicalIds.Length; ++index)
+                {
+                    await sut
+                        .AddLookupAsync(
+                            new VirtualPageId(DeviceId.Primary, (uint)(index + 1)),
+                            new LogicalPageId(logicalIds[index]))
+                        .ConfigureAwait(true);
+                }
+
+                for (var index = 0; index < logicalIds.Length; ++index)
+                {
+                    var virtualPageId = new VirtualPageId(DeviceId.Primary, (uint)(index + 1));
+                    Assert.True(sut.TryGetVirtual(new LogicalPageId(logicalIds[index]), out var mappedVirtual));
+                    Assert.Equal(virtualPageId, mappedVirtual);
+                    Assert.True(sut.TryGetLogical(virtualPageId, out var mappedLogical));
+                    Assert.Equal(new LogicalPageId(logicalIds[index]), mappedLogical);
+                }
+
+                Assert.False(sut.TryGetVirtual(new LogicalPageId(2), out _));
+                await Assert
+                    .ThrowsAsync<ArgumentException>(() => sut.GetVirtualAsync(new LogicalPageId(2)))
+                    .ConfigureAwait(true);
+                await Assert
+                    .ThrowsAsync<ArgumentException>(() => sut.AddLookupAsync(
+                        new VirtualPageId(DeviceId.Primary, 100), new LogicalPageId(1024)))
+                    .ConfigureAwait(true);
+            }
+        }
+
+        [Fact(DisplayName = "Allow pages to be mapped again once their lookup is removed")]
+        public async Task RemapPagesAfterRemovingLookup()
+        {
+            using (var sut = new LogicalVirtualManager())
+            {
+                var virtualPageId = new VirtualPageId(DeviceId.Primary, 1);
+                var overflowVirtualPageId = new VirtualPageId(DeviceId.Primary, 2);
+                await sut.AddLookupAsync(virtualPageId, new LogicalPageId(5)).ConfigureAwait(true);
+                await sut
+                    .AddLookupAsync(overflowVirtualPageId, new LogicalPageId(ulong.MaxValue - 1))
+                    .ConfigureAwait(true);
+
+                await sut.RemoveLookupAsync(virtualPageId).ConfigureAwait(true);
+                await sut.RemoveLookupAsync(overflowVirtualPageId).ConfigureAwait(true);
+                Assert.False(sut.TryGetLogical(virtualPageId, out _));
+                Assert.False(sut.TryGetVirtual(new LogicalPageId(5), out _));
+                Assert.False(sut.TryGetVirtual(new LogicalPageId(ulong.MaxValue - 1), out _));
+                Assert.Empty(sut.GetLookups());
+                await Assert
+                    .ThrowsAsync<ArgumentException>(() => sut.RemoveLookupAsync(virtualPageId))
+                    .ConfigureAwait(true);
+
+                // The freed virtual page is reused for a new logical page
+                await sut.AddLookupAsync(virtualPageId, new LogicalPageId(6)).ConfigureAwait(true);
+                Assert.True(sut.TryGetLogical(virtualPageId, out var mappedLogical));
+                Assert.Equal(new LogicalPageId(6), mappedLogical);
+            }
+        }
+
+        [Fact(DisplayName = "Allocate unique logical page identifiers across threads")]
+        public async Task AllocateUniqueLogicalPageIds()
+        {
+            using (var sut = new LogicalVirtualManager())
+            {
+                await sut
+                    .AddLookupAsync(new VirtualPageId(DeviceId.Primary, 1), new LogicalPageId(10))
+                    .ConfigureAwait(true);
+
+                var ids = await Task
+                    .WhenAll(Enumerable
+                        .Range(0, 1000)
+                        .Select(index => Task.Run(() => sut.GetNewLogicalPageIdAsync())))
+                    .ConfigureAwait(true);
+
+                // New identifiers follow the highest imported identifier
+                Assert.Equal(1000, ids.Select(id => id.Value).Distinct().Count());
+                Assert.Equal(11UL, ids.Min(id => id.Value));
+            }
+        }
+    }
+}
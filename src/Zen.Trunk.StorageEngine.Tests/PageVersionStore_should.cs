@@ -0,0 +1,158 @@
+using Moq;
+using Xunit;
+using Zen.Trunk.Storage.Data;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Page Version Store")]
+    // ReSharper disable once InconsistentNaming
+    public class PageVersionStore_should
+    {
+        [Fact(DisplayName = "Return the page image visible to a snapshot until it is released")]
+        public void ReturnVisibleImageUntilSnapshotReleased()
+        {
+            var sut = new PageVersionStore();
+            var pageId = new VirtualPageId(DeviceId.Primary, 10);
+            var firstImage = new Mock<IVirtualBuffer>();
+            var secondImage = new Mock<IVirtualBuffer>();
+
+            // Snapshot starts before either commit
+            var snapshot = sut.RegisterSnapshot();
+
+            var firstCommit = sut.BeginCommit();
+            sut.AddVersion(pageId, firstImage.Object, firstCommit);
+            sut.EndCommit(firstCommit);
+
+            // A snapshot started now sees the first commit
+            var laterSnapshot = sut.RegisterSnapshot();
+
+            var secondCommit = sut.BeginCommit();
+            sut.AddVersion(pageId, secondImage.Object, secondCommit);
+            sut.EndCommit(secondCommit);
+
+            Assert.Same(firstImage.Object, sut.GetVersion(pageId, snapshot));
+            Assert.Same(secondImage.Object, sut.GetVersion(pageId, laterSnapshot));
+            Assert.Null(sut.GetVersion(pageId, sut.RegisterSnapshot()));
+
+            // Releasing the oldest snapshot discards the image only it needed
+            sut.ReleaseSnapshot(snapshot);
+            firstImage.Verify(b => b.Dispose());
+            Assert.Equal(1, sut.VersionCount);
+
+            sut.ReleaseSnapshot(laterSnapshot);
+            secondImage.Verify(b => b.Dispose());
+            Assert.Equal(0, sut.VersionCount);
+        }
+
+        [Fact(DisplayName = "Require versions for every commit in progress")]
+        public void RequireVersionsForEveryCommitInProgress()
+        {
+            var sut = new PageVersionStore();
+
+            var commit = sut.BeginCommit();
+            Assert.True(sut.IsVersionRequired(commit));
+
+            sut.EndCommit(commit);
+            Assert.False(sut.IsVersionRequired(commit));
+        }
+
+        [Fact(DisplayName = "Hide a multi-page commit from a snapshot registered part way through it")]
+        public void HideCommitFromSnapshotRegisteredMidCommit()
+        {
+            var sut = new PageVersionStore();
+            var firstPageId = new VirtualPageId(DeviceId.Primary, 10);
+            var secondPageId = new VirtualPageId(DeviceId.Primary, 11);
+            var firstImage = new Mock<IVirtualBuffer>();
+            var secondImage = new Mock<IVirtualBuffer>();
+
+            // Commit begins with no snapshot registered and writes one page
+            var commit = sut.BeginCommit();
+            sut.AddVersion(firstPageId, firstImage.Object, commit);
+
+            // Snapshot registers before the commit writes its second page
+            var snapshot = sut.RegisterSnapshot();
+            Assert.True(snapshot < commit);
+
+            sut.AddVersion(secondPageId, secondImage.Object, commit);
+            sut.EndCommit(commit);
+
+            // Neither page written by the commit is visible to the snapshot
+            Assert.Same(firstImage.Object, sut.GetVersion(firstPageId, snapshot));
+            Assert.Same(secondImage.Object, sut.GetVersion(secondPageId, snapshot));
+            Assert.Equal(2, sut.VersionCount);
+
+            sut.ReleaseSnapshot(snapshot);
+            Assert.Equal(0, sut.VersionCount);
+        }
+
+        [Fact(DisplayName = "Discard versions of commits that end without an active snapshot")]
+        public void DiscardVersionsWithoutActiveSnapshot()
+        {
+            var sut = new PageVersionStore();
+            var pageId = new VirtualPageId(DeviceId.Primary, 10);
+            var image = new Mock<IVirtualBuffer>();
+
+            var commit = sut.BeginCommit();
+            sut.AddVersion(pageId, image.Object, commit);
+            sut.EndCommit(commit);
+
+            image.Verify(b => b.Dispose());
+            Assert.Equal(0, sut.VersionCount);
+        }
+
+        [Fact(DisplayName = "Report pages committed since a snapshot started")]
+        public void ReportPagesSupersededSinceSnapshot()
+        {
+            var sut = new PageVersionStore();
+            var pageId = new VirtualPageId(DeviceId.Primary, 10);
+            var otherPageId = new VirtualPageId(DeviceId.Primary, 11);
+            var image = new Mock<IVirtualBuffer>();
+
+            var snapshot = sut.RegisterSnapshot();
+            var commit = sut.BeginCommit();
+            sut.AddVersion(pageId, image.Object, commit);
+            sut.EndCommit(commit);
+
+            // Writing the page under the snapshot would lose the commit
+            var laterSnapshot = sut.RegisterSnapshot();
+            Assert.True(sut.IsSupersededSince(pageId, snapshot));
+            Assert.False(sut.IsSupersededSince(pageId, laterSnapshot));
+            Assert.False(sut.IsSupersededSince(otherPageId, snapshot));
+
+            sut.ReleaseSnapshot(laterSnapshot);
+            sut.ReleaseSnapshot(snapshot);
+        }
+
+        [Fact(DisplayName = "Discard versions in commit order when commits complete out of order")]
+        public void DiscardVersionsInCommitOrder()
+        {
+            var sut = new PageVersionStore();
+            var firstPageId = new VirtualPageId(DeviceId.Primary, 10);
+            var secondPageId = new VirtualPageId(DeviceId.Primary, 11);
+            var firstImage = new Mock<IVirtualBuffer>();
+            var secondImage = new Mock<IVirtualBuffer>();
+
+            var snapshot = sut.RegisterSnapshot();
+            var firstCommit = sut.BeginCommit();
+            var secondCommit = sut.BeginCommit();
+
+            // Later commit completes first
+            sut.AddVersion(secondPageId, secondImage.Object, secondCommit);
+            sut.EndCommit(secondCommit);
+            sut.AddVersion(firstPageId, firstImage.Object, firstCommit);
+
+            // Releasing the snapshot cannot discard versions from the commit
+            //  still in progress nor any that follow it
+            sut.ReleaseSnapshot(snapshot);
+            Assert.Equal(2, sut.VersionCount);
+
+            sut.EndCommit(firstCommit);
+            firstImage.Verify(b => b.Dispose());
+            secondImage.Verify(b => b.Dispose());
+            Assert.Equal(0, sut.VersionCount);
+            Assert.Null(sut.GetVersion(firstPageId, snapshot));
+        }
+    }
+}
@@ -5,6 +5,7 @@ using System.Linq;
 using System.Threading.Tasks;
 using Autofac;
 using Xunit;
+using Xunit.Abstractions;
 using Zen.Trunk.Storage.Data;
 using Zen.Trunk.Storage.Locking;
 using Zen.Trunk.VirtualMemory;
@@ -17,10 +18,12 @@ namespace Zen.Trunk.Storage
     public class Page_should : IClassFixture<StorageEngineTestFixture>
     {
         private readonly StorageEngineTestFixture _fixture;
+        private readonly ITestOutputHelper _output;
 
-        public Page_should(StorageEngineTestFixture fixture)
+        public Page_should(StorageEngineTestFixture fixture, ITestOutputHelper output)
         {
             _fixture = fixture;
+            _output = output;
         }
 
         private class MockPageDevice : PageDevice, IMultipleBufferDevice
@@ -141,6 +144,46 @@ namespace Zen.Trunk.Storage
             await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
         }
 
+        [Theory(DisplayName = nameof(Page_should) + "_" + nameof(benchmark_distribution_page_allocation_throughput))]
+        [InlineData(1)]
+        [InlineData(8)]
+        [InlineData(64)]
+        public async Task benchmark_distribution_page_allocation_throughput(int objectCount)
+        {
+            var pageDevice = new MockPageDevice(_fixture.Scope);
+
+            pageDevice.BeginTransaction();
+
+            // Make every extent on the distribution page usable
+            var page = pageDevice.CreatePage<DistributionPage>(new VirtualPageId(0));
+            await page.UpdateValidExtentsAsync(DistributionPage.PageTrackingCount + 1).ConfigureAwait(true);
+
+            // Fill the page by allocating to each object in turn so later
+            //	allocations must find the extent owned by the object
+            var stopwatch = Stopwatch.StartNew();
+            for (uint index = 0; index < DistributionPage.PageTrackingCount; ++index)
+            {
+                var virtualId = await page
+                    .AllocatePageAsync(
+                        new AllocateDataPageParameters(
+                            new LogicalPageId(1024 + index),
+                            new ObjectId(1 + (index % (uint)objectCount)),
+                            ObjectType.Audio,
+                            false,
+                            false))
+                    .ConfigureAwait(true);
+                Assert.True(virtualId != VirtualPageId.Zero, $"Expected allocation {index} to succeed.");
+            }
+            stopwatch.Stop();
+
+            var allocationsPerSecond = DistributionPage.PageTrackingCount / stopwatch.Elapsed.TotalSeconds;
+            _output.WriteLine($"{objectCount} objects: {allocationsPerSecond:N0} allocations/sec");
+
+            Assert.Equal(0, page.FreeSpaceMap.FreePageCount);
+
+            await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+        }
+
         [Fact(DisplayName = nameof(Page_should) + "_" + nameof(verify_all_concrete_page_classes_have_header_block_smaller_than_maximum))]
         public void verify_all_concrete_page_classes_have_header_block_smaller_than_maximum()
         {
@@ -0,0 +1,50 @@
+using System.Collections.Generic;
+using Xunit;
+using Zen.Trunk.Storage.Data;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Proportional Fill Strategy")]
+    // ReSharper disable once InconsistentNaming
+    public class ProportionalFillStrategy_should
+    {
+        [Fact(DisplayName = "Prefer uncontended devices with free space and try full devices last")]
+        public void PreferUncontendedDevicesWithFreeSpace()
+        {
+            var sut = new ProportionalFillStrategy();
+            var idle = new DeviceId(1);
+            var busy = new DeviceId(2);
+            var full = new DeviceId(3);
+            var devices = new List<KeyValuePair<DeviceId, long>>
+            {
+                new KeyValuePair<DeviceId, long>(full, 0),
+                new KeyValuePair<DeviceId, long>(busy, 1000),
+                new KeyValuePair<DeviceId, long>(idle, 1000)
+            };
+
+            for (var index = 0; index < 10; ++index)
+            {
+                sut.OnFailed(busy);
+            }
+
+            var idleFirstCount = 0;
+            for (var index = 0; index < 1000; ++index)
+            {
+                var order = sut.OrderDevices(devices);
+                Assert.Equal(3, order.Count);
+                Assert.Equal(full, order[2]);
+                if (order[0] == idle)
+                {
+                    ++idleFirstCount;
+                }
+            }
+            Assert.True(idleFirstCount > 800, $"Expected idle device first in most orderings but was {idleFirstCount}.");
+
+            // Successful allocations let a busy device recover
+            sut.OnAllocated(busy);
+            Assert.Equal(5, sut.GetContention(busy));
+        }
+    }
+}
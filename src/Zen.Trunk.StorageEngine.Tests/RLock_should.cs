@@ -0,0 +1,52 @@
+using System;
+using System.Threading.Tasks;
+using Xunit;
+using Zen.Trunk.Storage.Locking;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Resource Lock")]
+    // ReSharper disable once InconsistentNaming
+    public class RLock_should
+    {
+        [Fact(DisplayName = "Queue new readers behind a waiting writer")]
+        public async Task QueueNewReadersBehindWaitingWriter()
+        {
+            var sut = new RLock();
+            var timeout = TimeSpan.FromSeconds(30);
+
+            await sut.LockAsync(false, timeout).ConfigureAwait(true);
+            var writer = sut.LockAsync(true, timeout);
+            var reader = sut.LockAsync(false, timeout);
+            Assert.False(writer.IsCompleted);
+            Assert.False(reader.IsCompleted);
+
+            // Releasing the first reader grants the writer only
+            sut.Unlock(false);
+            await writer.ConfigureAwait(true);
+            Assert.False(reader.IsCompleted);
+
+            // Releasing the writer grants the queued reader
+            sut.Unlock(true);
+            await reader.ConfigureAwait(true);
+            sut.Unlock(false);
+        }
+
+        [Fact(DisplayName = "Throw lock timeout when write lock is not granted in time")]
+        public async Task ThrowLockTimeoutWhenWriteLockNotGranted()
+        {
+            var sut = new RLock();
+
+            await sut.LockAsync(false, TimeSpan.FromSeconds(30)).ConfigureAwait(true);
+            await Assert
+                .ThrowsAsync<LockTimeoutException>(() => sut.LockAsync(true, TimeSpan.FromMilliseconds(50)))
+                .ConfigureAwait(true);
+
+            // A withdrawn writer must not block later readers
+            await sut.LockAsync(false, TimeSpan.FromSeconds(1)).ConfigureAwait(true);
+            sut.Unlock(false);
+            sut.Unlock(false);
+        }
+    }
+}
@@ -1,9 +1,12 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
+using System.Linq;
 using System.Threading.Tasks;
 using Autofac;
 using Xunit;
+using Xunit.Abstractions;
 using Zen.Trunk.Storage.Data;
 using Zen.Trunk.Storage.Data.Table;
 using Zen.Trunk.Storage.Locking;
@@ -18,10 +21,12 @@ namespace Zen.Trunk.Storage
     public class StorageEngine_should : IClassFixture<StorageEngineTestFixture>
     {
         private readonly StorageEngineTestFixture _fixture;
+        private readonly ITestOutputHelper _output;
 
-        public StorageEngine_should(StorageEngineTestFixture fixture)
+        public StorageEngine_should(StorageEngineTestFixture fixture, ITestOutputHelper output)
         {
             _fixture = fixture;
+            _output = output;
         }
 
         [Fact(DisplayName = nameof(StorageEngine_should) + "_" + nameof(create_database_under_transaction))]
@@ -433,6 +438,485 @@ namespace Zen.Trunk.Storage
             }
         }
 
+        [Fact(DisplayName = nameof(StorageEngine_should) + "_" + nameof(sustain_row_inserts_into_indexed_table))]
+        public async Task sustain_row_inserts_into_indexed_table()
+        {
+            const int statementCount = 200;
+            const int rowsPerStatement = 50;
+
+            var masterDataPathName = _fixture.GlobalTracker.Get("master7.mddf");
+            var masterLogPathName = _fixture.GlobalTracker.Get("master7.mlf");
+
+            using (var childScope = _fixture.Scope.BeginLifetimeScope())
+            {
+                using (var dbDevice = new DatabaseDevice(new DatabaseId(7)))
+                {
+                    try
+                    {
+                        dbDevice.InitialiseDeviceLifetimeScope(childScope);
+
+                        var addFgDevice =
+                            new AddFileGroupDeviceParameters(
+                                FileGroupId.Primary,
+                                "PRIMARY",
+                                "master",
+                                masterDataPathName,
+                                DeviceId.Zero,
+                                128,
+                                true);
+                        await dbDevice.AddFileGroupDeviceAsync(addFgDevice).ConfigureAwait(true);
+
+                        var addLogDevice =
+                            new AddLogDeviceParameters(
+                                "MASTER_LOG",
+                                masterLogPathName,
+                                DeviceId.Zero,
+                                2);
+                        await dbDevice.AddLogDeviceAsync(addLogDevice).ConfigureAwait(true);
+
+                        await dbDevice.OpenAsync(true).ConfigureAwait(true);
+
+                        // Columns supplied by each insert; the identity is generated
+                        var insertColumns = new[]
+                        {
+                            new TableColumnInfo(
+                                "Name",
+                                TableColumnDataType.NVarChar,
+                                false,
+                                50),
+                            new TableColumnInfo(
+                                "SequenceIndex",
+                                TableColumnDataType.Int,
+                                false),
+                            new TableColumnInfo(
+                                "CreatedDate",
+                                TableColumnDataType.DateTime,
+                                false)
+                        };
+
+                        // Clustered on the identity with a secondary index so
+                        //  every insert maintains both
+                        dbDevice.BeginTransaction();
+                        var param =
+                            new AddFileGroupTableParameters(
+                                addFgDevice.FileGroupId,
+                                addFgDevice.FileGroupName,
+                                "Test",
+                                new TableColumnInfo(
+                                    "Id",
+                                    TableColumnDataType.Int,
+                                    false,
+                                    0,
+                                    1,
+                                    1),
+                                insertColumns[0],
+                                insertColumns[1],
+                                insertColumns[2]);
+                        var objectId = await dbDevice
+                            .AddFileGroupTableAsync(param)
+                            .ConfigureAwait(true);
+                        await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+
+                        dbDevice.BeginTransaction();
+                        var primaryIndexParam =
+                            new AddFileGroupTableIndexParameters(
+                                addFgDevice.FileGroupId,
+                                addFgDevice.FileGroupName,
+                                "PK_Test",
+                                TableIndexSubType.Primary | TableIndexSubType.Clustered | TableIndexSubType.Unique,
+                                objectId);
+                        primaryIndexParam.AddColumnAndSortDirection(
+                            "Id", TableIndexSortDirection.Ascending);
+                        await dbDevice
+                            .AddFileGroupTableIndexAsync(primaryIndexParam)
+                            .ConfigureAwait(true);
+
+                        var secondaryIndexParam =
+                            new AddFileGroupTableIndexParameters(
+                                addFgDevice.FileGroupId,
+                                addFgDevice.FileGroupName,
+                                "IX_SequenceIndex",
+                                TableIndexSubType.Normal,
+                                objectId);
+                        secondaryIndexParam.AddColumnAndSortDirection(
+                            "SequenceIndex", TableIndexSortDirection.Ascending);
+                        await dbDevice
+                            .AddFileGroupTableIndexAsync(secondaryIndexParam)
+                            .ConfigureAwait(true);
+                        await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+
+                        // Each statement commits on its own; the first loads
+                        //  the empty table and the rest take the insert path
+                        var random = new Random(42);
+                        var createdDate = new DateTime(2017, 1, 1);
+                        var sequenceValues = new List<int>();
+                        var stopwatch = Stopwatch.StartNew();
+                        for (var statement = 0; statement < statementCount; ++statement)
+                        {
+                            var rowData = new MemoryStream();
+                            var rowWriter = new TableRowWriter(rowData, insertColumns);
+                            for (var row = 0; row < rowsPerStatement; ++row)
+                            {
+                                rowWriter[0] = $"Row {statement}.{row}";
+                                var sequenceIndex = random.Next();
+                                sequenceValues.Add(sequenceIndex);
+                                rowWriter[1] = sequenceIndex;
+                                rowWriter[2] = createdDate.AddSeconds((statement * rowsPerStatement) + row);
+                                rowWriter.Write();
+                            }
+                            rowData.Position = 0;
+
+                            dbDevice.BeginTransaction();
+                            await dbDevice.PrimaryFileGroupDevice
+                                .InsertTableData(
+                                    new InsertTableDataParameters(
+                                        objectId, "Name,SequenceIndex,CreatedDate", rowData))
+                                .ConfigureAwait(true);
+                            await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+                        }
+                        stopwatch.Stop();
+
+                        var insertsPerSecond = (statementCount * rowsPerStatement) / stopwatch.Elapsed.TotalSeconds;
+                        _output.WriteLine($"{rowsPerStatement} rows per statement: {insertsPerSecond:N0} inserts/sec");
+
+                        // Read every row back and check both indices hold
+                        //  an entry for each row
+                        dbDevice.BeginTransaction();
+                        try
+                        {
+                            var objRef = await dbDevice
+                                .GetObjectReferenceAsync(new GetObjectReferenceParameters(objectId, ObjectType.Table))
+                                .ConfigureAwait(true);
+                            var fileGroupDevice = (FileGroupDevice)dbDevice.PrimaryFileGroupDevice;
+                            var tableFactory = fileGroupDevice.LifetimeScope.Resolve<IDatabaseTableFactory>();
+                            using (var table = (DatabaseTable)tableFactory.GetScopeForExistingTable(objectId))
+                            {
+                                await table.LoadSchemaAsync(objRef.FirstLogicalPageId).ConfigureAwait(true);
+
+                                var rowIds = new List<int>();
+                                var rowSequenceValues = new List<int>();
+                                var logicalPageId = table.DataFirstLogicalPageId;
+                                while (logicalPageId != LogicalPageId.Zero)
+                                {
+                                    using (var dataPage =
+                                        new TableDataPage
+                                        {
+                                            LogicalPageId = logicalPageId,
+                                            FileGroupId = table.FileGroupId
+                                        })
+                                    {
+                                        await fileGroupDevice
+                                            .LoadDataPageAsync(new LoadDataPageParameters(dataPage, false, true))
+                                            .ConfigureAwait(true);
+                                        var view = dataPage.GetView(table.Columns);
+                                        for (uint rowIndex = 0; rowIndex < view.RowCount; ++rowIndex)
+                                        {
+                                            rowIds.Add(view.GetInt32(rowIndex, 0));
+                                            rowSequenceValues.Add(view.GetInt32(rowIndex, 2));
+                                        }
+                                        logicalPageId = dataPage.NextLogicalPageId;
+                                    }
+                                }
+
+                                Assert.Equal(statementCount * rowsPerStatement, rowIds.Count);
+                                Assert.Equal(sequenceValues.OrderBy(value => value), rowSequenceValues.OrderBy(value => value));
+
+                                var indices = table.IndexManager.Indices.ToList();
+                                Assert.Equal(2, indices.Count);
+                                Assert.Equal(
+                                    rowIds.OrderBy(value => value),
+                                    await ReadIndexKeysAsync(table, indices.Single(index => (index.IndexSubType & TableIndexSubType.Clustered) != 0)).ConfigureAwait(true));
+                                Assert.Equal(
+                                    sequenceValues.OrderBy(value => value),
+                                    await ReadIndexKeysAsync(table, indices.Single(index => (index.IndexSubType & TableIndexSubType.Clustered) == 0)).ConfigureAwait(true));
+                            }
+                            await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+                        }
+                        catch
+                        {
+                            await TrunkTransactionContext.RollbackAsync().ConfigureAwait(true);
+                            throw;
+                        }
+                    }
+                    finally
+                    {
+                        await dbDevice.CloseAsync().ConfigureAwait(true);
+                    }
+                }
+            }
+        }
+
+        [Fact(DisplayName = nameof(StorageEngine_should) + "_" + nameof(allocate_heap_pages_after_compaction))]
+        public async Task allocate_heap_pages_after_compaction()
+        {
+            const int statementCount = 20;
+            const int rowsPerStatement = 50;
+
+            var masterDataPathName = _fixture.GlobalTracker.Get("master11.mddf");
+            var masterLogPathName = _fixture.GlobalTracker.Get("master11.mlf");
+
+            using (var childScope = _fixture.Scope.BeginLifetimeScope())
+            {
+                using (var dbDevice = new DatabaseDevice(new DatabaseId(11)))
+                {
+                    try
+                    {
+                        dbDevice.InitialiseDeviceLifetimeScope(childScope);
+
+                        var addFgDevice =
+                            new AddFileGroupDeviceParameters(
+                                FileGroupId.Primary,
+                                "PRIMARY",
+                                "master",
+                                masterDataPathName,
+                                DeviceId.Zero,
+                                128,
+                                true);
+                        await dbDevice.AddFileGroupDeviceAsync(addFgDevice).ConfigureAwait(true);
+
+                        var addLogDevice =
+                            new AddLogDeviceParameters(
+                                "MASTER_LOG",
+                                masterLogPathName,
+                                DeviceId.Zero,
+                                2);
+                        await dbDevice.AddLogDeviceAsync(addLogDevice).ConfigureAwait(true);
+
+                        await dbDevice.OpenAsync(true).ConfigureAwait(true);
+
+                        // Columns supplied by each insert; the identity is generated
+                        var insertColumns = new[]
+                        {
+                            new TableColumnInfo(
+                                "Name",
+                                TableColumnDataType.NVarChar,
+                                false,
+                                200),
+                            new TableColumnInfo(
+                                "SequenceIndex",
+                                TableColumnDataType.Int,
+                                false)
+                        };
+
+                        // No indices so the table is a heap that can be compacted
+                        dbDevice.BeginTransaction();
+                        var param =
+                            new AddFileGroupTableParameters(
+                                addFgDevice.FileGroupId,
+                                addFgDevice.FileGroupName,
+                                "Test",
+                                new TableColumnInfo(
+                                    "Id",
+                                    TableColumnDataType.Int,
+                                    false,
+                                    0,
+                                    1,
+                                    1),
+                                insertColumns[0],
+                                insertColumns[1]);
+                        var objectId = await dbDevice
+                            .AddFileGroupTableAsync(param)
+                            .ConfigureAwait(true);
+                        await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+
+                        var random = new Random(11);
+                        var sequenceValues = new List<int>();
+                        await InsertSequenceRowsAsync(
+                                dbDevice, objectId, insertColumns, random, sequenceValues, statementCount, rowsPerStatement)
+                            .ConfigureAwait(true);
+
+                        // Empty every data page but the last
+                        var fileGroupDevice = (FileGroupDevice)dbDevice.PrimaryFileGroupDevice;
+                        var tableFactory = fileGroupDevice.LifetimeScope.Resolve<IDatabaseTableFactory>();
+                        ObjectReferenceResult objRef;
+                        int emptiedPageCount;
+                        dbDevice.BeginTransaction();
+                        try
+                        {
+                            objRef = await dbDevice
+                                .GetObjectReferenceAsync(new GetObjectReferenceParameters(objectId, ObjectType.Table))
+                                .ConfigureAwait(true);
+                            using (var table = (DatabaseTable)tableFactory.GetScopeForExistingTable(objectId))
+                            {
+                                await table.LoadSchemaAsync(objRef.FirstLogicalPageId).ConfigureAwait(true);
+
+                                var dataPages = await ReadDataPagesAsync(fileGroupDevice, table, 2).ConfigureAwait(true);
+                                Assert.True(dataPages.Count > 2);
+                                emptiedPageCount = dataPages.Count - 1;
+                                foreach (var dataPage in dataPages.Take(emptiedPageCount))
+                                {
+                                    Assert.Equal(
+                                        dataPage.Item2.Count,
+                                        await table.DeleteDataPageRowsAsync(dataPage.Item1).ConfigureAwait(true));
+                                    foreach (var value in dataPage.Item2)
+                                    {
+                                        sequenceValues.Remove(value);
+                                    }
+                                }
+                            }
+                            await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+                        }
+                        catch
+                        {
+                            await TrunkTransactionContext.RollbackAsync().ConfigureAwait(true);
+                            throw;
+                        }
+
+                        // Compaction releases the empty pages back to the
+                        //  distribution pages
+                        dbDevice.BeginTransaction();
+                        var pagesReclaimed = await fileGroupDevice
+                            .CompactTableAsync(new CompactTableParameters(objectId))
+                            .ConfigureAwait(true);
+                        await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+                        Assert.Equal(emptiedPageCount, pagesReclaimed);
+
+                        // Growing the table again allocates the released
+                        //  virtual pages to new logical pages
+                        await InsertSequenceRowsAsync(
+                                dbDevice, objectId, insertColumns, random, sequenceValues, statementCount, rowsPerStatement)
+                            .ConfigureAwait(true);
+
+                        dbDevice.BeginTransaction();
+                        try
+                        {
+                            using (var table = (DatabaseTable)tableFactory.GetScopeForExistingTable(objectId))
+                            {
+                                await table.LoadSchemaAsync(objRef.FirstLogicalPageId).ConfigureAwait(true);
+
+                                var dataPages = await ReadDataPagesAsync(fileGroupDevice, table, 2).ConfigureAwait(true);
+                                Assert.True(dataPages.Count > 2);
+                                Assert.Equal(
+                                    sequenceValues.OrderBy(value => value),
+                                    dataPages.SelectMany(dataPage => dataPage.Item2).OrderBy(value => value));
+                            }
+                            await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+                        }
+                        catch
+                        {
+                            await TrunkTransactionContext.RollbackAsync().ConfigureAwait(true);
+                            throw;
+                        }
+                    }
+                    finally
+                    {
+                        await dbDevice.CloseAsync().ConfigureAwait(true);
+                    }
+                }
+            }
+        }
+
+        [Fact(DisplayName = nameof(StorageEngine_should) + "_" + nameof(return_from_delayed_commit_before_log_flush))]
+        public async Task return_from_delayed_commit_before_log_flush()
+        {
+            using (var childScope = _fixture.Scope.BeginLifetimeScope())
+            {
+                using (var dbDevice = new DatabaseDevice(new DatabaseId(8)))
+                {
+                    try
+                    {
+                        var logDevice = await OpenDatabaseWithDelayedFlushAsync(dbDevice, childScope, "master8")
+                            .ConfigureAwait(true);
+
+                        var transactionId = new TransactionId(1);
+                        await logDevice
+                            .WriteEntryAsync(new BeginTransactionLogEntry(transactionId))
+                            .ConfigureAwait(true);
+
+                        // Commit returns once the record is buffered
+                        var commitEntry = new CommitTransactionLogEntry(transactionId);
+                        var commitTask = logDevice.WriteEntryAsync(commitEntry, true);
+                        Assert.True(commitTask.IsCompleted, "Expected delayed commit to complete immediately");
+                        await commitTask.ConfigureAwait(true);
+
+                        // Log ids are assigned when the record is written
+                        Assert.Equal(0u, commitEntry.LogId);
+                        Assert.Equal((long)commitEntry.RawSize, logDevice.UnhardenedBytes);
+                    }
+                    finally
+                    {
+                        await dbDevice.CloseAsync().ConfigureAwait(true);
+                    }
+                }
+            }
+        }
+
+        [Fact(DisplayName = nameof(StorageEngine_should) + "_" + nameof(harden_delayed_commit_on_explicit_flush))]
+        public async Task harden_delayed_commit_on_explicit_flush()
+        {
+            using (var childScope = _fixture.Scope.BeginLifetimeScope())
+            {
+                using (var dbDevice = new DatabaseDevice(new DatabaseId(9)))
+                {
+                    try
+                    {
+                        var logDevice = await OpenDatabaseWithDelayedFlushAsync(dbDevice, childScope, "master9")
+                            .ConfigureAwait(true);
+
+                        var transactionId = new TransactionId(1);
+                        var beginEntry = new BeginTransactionLogEntry(transactionId);
+                        await logDevice.WriteEntryAsync(beginEntry).ConfigureAwait(true);
+
+                        var commitEntry = new CommitTransactionLogEntry(transactionId);
+                        await logDevice.WriteEntryAsync(commitEntry, true).ConfigureAwait(true);
+                        Assert.NotEqual(0L, logDevice.UnhardenedBytes);
+
+                        await logDevice.FlushDelayedEntriesAsync().ConfigureAwait(true);
+
+                        Assert.Equal(0L, logDevice.UnhardenedBytes);
+                        Assert.True(commitEntry.LogId > beginEntry.LogId, "Expected commit to be written after begin");
+                    }
+                    finally
+                    {
+                        await dbDevice.CloseAsync().ConfigureAwait(true);
+                    }
+                }
+            }
+        }
+
+        [Fact(DisplayName = nameof(StorageEngine_should) + "_" + nameof(harden_delayed_commit_ahead_of_durable_commit))]
+        public async Task harden_delayed_commit_ahead_of_durable_commit()
+        {
+            using (var childScope = _fixture.Scope.BeginLifetimeScope())
+            {
+                using (var dbDevice = new DatabaseDevice(new DatabaseId(10)))
+                {
+                    try
+                    {
+                        var logDevice = await OpenDatabaseWithDelayedFlushAsync(dbDevice, childScope, "master10")
+                            .ConfigureAwait(true);
+
+                        var delayedTransactionId = new TransactionId(1);
+                        var durableTransactionId = new TransactionId(2);
+                        await logDevice
+                            .WriteEntryAsync(new BeginTransactionLogEntry(delayedTransactionId))
+                            .ConfigureAwait(true);
+                        await logDevice
+                            .WriteEntryAsync(new BeginTransactionLogEntry(durableTransactionId))
+                            .ConfigureAwait(true);
+
+                        var delayedCommitEntry = new CommitTransactionLogEntry(delayedTransactionId);
+                        await logDevice.WriteEntryAsync(delayedCommitEntry, true).ConfigureAwait(true);
+                        Assert.Equal(0u, delayedCommitEntry.LogId);
+
+                        // Durable commit must carry the delayed commit with it
+                        var durableCommitEntry = new CommitTransactionLogEntry(durableTransactionId);
+                        await logDevice.WriteEntryAsync(durableCommitEntry).ConfigureAwait(true);
+
+                        Assert.Equal(0L, logDevice.UnhardenedBytes);
+                        Assert.NotEqual(0u, delayedCommitEntry.LogId);
+                        Assert.True(
+                            delayedCommitEntry.LogId < durableCommitEntry.LogId,
+                            "Expected delayed commit to be written ahead of durable commit");
+                    }
+                    finally
+                    {
+                        await dbDevice.CloseAsync().ConfigureAwait(true);
+                    }
+                }
+            }
+        }
+
         [Fact(DisplayName = nameof(StorageEngine_should) + "_" + nameof(create_session_lock_with_use_database_entrypoint))]
         public async Task create_session_lock_with_use_database_entrypoint()
         {
@@ -563,5 +1047,119 @@ namespace Zen.Trunk.Storage
                 }
             }
         }
+
+        private async Task<MasterLogPageDevice> OpenDatabaseWithDelayedFlushAsync(
+            DatabaseDevice dbDevice, ILifetimeScope childScope, string fileName)
+        {
+            dbDevice.InitialiseDeviceLifetimeScope(childScope);
+
+            var addFgDevice =
+                new AddFileGroupDeviceParameters(
+                    FileGroupId.Primary,
+                    "PRIMARY",
+                    "master",
+                    _fixture.GlobalTracker.Get($"{fileName}.mddf"),
+                    DeviceId.Zero,
+                    128,
+                    true);
+            await dbDevice.AddFileGroupDeviceAsync(addFgDevice).ConfigureAwait(true);
+
+            var addLogDevice =
+                new AddLogDeviceParameters(
+                    "MASTER_LOG",
+                    _fixture.GlobalTracker.Get($"{fileName}.mlf"),
+                    DeviceId.Zero,
+                    2);
+            await dbDevice.AddLogDeviceAsync(addLogDevice).ConfigureAwait(true);
+
+            // Background flush must not run while the test inspects the buffer
+            var logDevice = (MasterLogPageDevice)dbDevice.LifetimeScope.Resolve<IMasterLogPageDevice>();
+            logDevice.DelayedFlushInterval = TimeSpan.FromHours(1);
+
+            await dbDevice.OpenAsync(true).ConfigureAwait(true);
+            return logDevice;
+        }
+
+        private static async Task InsertSequenceRowsAsync(
+            DatabaseDevice dbDevice,
+            ObjectId objectId,
+            TableColumnInfo[] insertColumns,
+            Random random,
+            List<int> sequenceValues,
+            int statementCount,
+            int rowsPerStatement)
+        {
+            for (var statement = 0; statement < statementCount; ++statement)
+            {
+                var rowData = new MemoryStream();
+                var rowWriter = new TableRowWriter(rowData, insertColumns);
+                for (var row = 0; row < rowsPerStatement; ++row)
+                {
+                    var sequenceIndex = random.Next();
+                    sequenceValues.Add(sequenceIndex);
+                    rowWriter[0] = $"Row {sequenceIndex}".PadRight(100, '.');
+                    rowWriter[1] = sequenceIndex;
+                    rowWriter.Write();
+                }
+                rowData.Position = 0;
+
+                dbDevice.BeginTransaction();
+                await dbDevice.PrimaryFileGroupDevice
+                    .InsertTableData(
+                        new InsertTableDataParameters(
+                            objectId, "Name,SequenceIndex", rowData))
+                    .ConfigureAwait(true);
+                await TrunkTransactionContext.CommitAsync().ConfigureAwait(true);
+            }
+        }
+
+        private static async Task<List<Tuple<LogicalPageId, List<int>>>> ReadDataPagesAsync(
+            FileGroupDevice fileGroupDevice, DatabaseTable table, int columnIndex)
+        {
+            var dataPages = new List<Tuple<LogicalPageId, List<int>>>();
+            var logicalPageId = table.DataFirstLogicalPageId;
+            while (logicalPageId != LogicalPageId.Zero)
+            {
+                using (var dataPage =
+                    new TableDataPage
+                    {
+                        LogicalPageId = logicalPageId,
+                        FileGroupId = table.FileGroupId
+                    })
+                {
+                    await fileGroupDevice
+                        .LoadDataPageAsync(new LoadDataPageParameters(dataPage, false, true))
+                        .ConfigureAwait(true);
+                    var values = new List<int>();
+                    var view = dataPage.GetView(table.Columns);
+                    for (uint rowIndex = 0; rowIndex < view.RowCount; ++rowIndex)
+                    {
+                        values.Add(view.GetInt32(rowIndex, columnIndex));
+                    }
+                    dataPages.Add(Tuple.Create(logicalPageId, values));
+                    logicalPageId = dataPage.NextLogicalPageId;
+                }
+            }
+            return dataPages;
+        }
+
+        private static async Task<List<int>> ReadIndexKeysAsync(DatabaseTable table, RootTableIndexInfo index)
+        {
+            var keys = new List<int>();
+            var cursor = table.IndexManager.OpenRangeCursor(
+                new ScanTableIndexParameters(index, new object[] { int.MinValue }, new object[] { int.MaxValue }));
+            try
+            {
+                while (await cursor.MoveNextAsync().ConfigureAwait(true))
+                {
+                    keys.Add((int)cursor.Current.Keys[0]);
+                }
+            }
+            finally
+            {
+                await cursor.DisposeAsync().ConfigureAwait(true);
+            }
+            return keys;
+        }
     }
 }
@@ -0,0 +1,74 @@
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Zen.Trunk.Storage.Logging;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Striped Log Reader")]
+    // ReSharper disable once InconsistentNaming
+    public class StripedLogReader_should
+    {
+        [Fact(DisplayName = "Merge log records from each stripe in log id order")]
+        public void MergeLogRecordsFromEachStripeInLogIdOrder()
+        {
+            var sut = new StripedLogReader(
+                new[]
+                {
+                    CreateStripe(1, 4, 5, 8),
+                    CreateStripe(2, 6),
+                    CreateStripe(3, 7, 9)
+                },
+                1);
+
+            Assert.Equal(Enumerable.Range(1, 9).Select(logId => (uint)logId), ReadAll(sut));
+        }
+
+        [Fact(DisplayName = "Skip log records preceding the first log id")]
+        public void SkipLogRecordsPrecedingTheFirstLogId()
+        {
+            var sut = new StripedLogReader(
+                new[]
+                {
+                    CreateStripe(1, 3, 5),
+                    CreateStripe(2, 4, 6)
+                },
+                4);
+
+            Assert.Equal(new uint[] { 4, 5, 6 }, ReadAll(sut));
+        }
+
+        [Fact(DisplayName = "Stop reading at the first missing log id")]
+        public void StopReadingAtTheFirstMissingLogId()
+        {
+            // Log id 4 was never written to the second stripe
+            var sut = new StripedLogReader(
+                new[]
+                {
+                    CreateStripe(1, 3, 5, 7),
+                    CreateStripe(2, 6)
+                },
+                1);
+
+            Assert.Equal(new uint[] { 1, 2, 3 }, ReadAll(sut));
+        }
+
+        private static IEnumerable<LogRecord> CreateStripe(params uint[] logIds)
+        {
+            return logIds
+                .Select(logId => new LogRecord(LogEntryType.NoOp, logId, 0))
+                .ToList();
+        }
+
+        private static List<uint> ReadAll(StripedLogReader reader)
+        {
+            var logIds = new List<uint>();
+            while (reader.TryReadRecord(out var record))
+            {
+                logIds.Add(record.LogId);
+            }
+            return logIds;
+        }
+    }
+}
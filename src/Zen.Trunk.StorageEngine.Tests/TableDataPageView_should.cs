@@ -0,0 +1,82 @@
+using System;
+using System.IO;
+using System.Text;
+using Xunit;
+using Zen.Trunk.Storage.Data.Table;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Table Data Page View")]
+    // ReSharper disable once InconsistentNaming
+    public class TableDataPageView_should
+    {
+        private const int DataSize = 8000;
+
+        [Fact(DisplayName = "Read typed column values directly from the page data")]
+        public void ReadTypedColumnValues()
+        {
+            var columns = new[]
+            {
+                new TableColumnInfo("Id", TableColumnDataType.Int, false),
+                new TableColumnInfo("Name", TableColumnDataType.NVarChar, false, 50),
+                new TableColumnInfo("Code", TableColumnDataType.NChar, false, 4),
+                new TableColumnInfo("Amount", TableColumnDataType.Money, false),
+                new TableColumnInfo("Created", TableColumnDataType.DateTime, false)
+            };
+            var created = new DateTime(2017, 3, 1, 12, 30, 0);
+            var pageData = new byte[DataSize];
+            var totalRowDataSize = WriteRows(
+                pageData,
+                columns,
+                new object[] { 1, "Alpha", "AB", 12.5m, created },
+                new object[] { -42, "Beta", "WXYZ", -0.01m, created.AddDays(1) });
+
+            var sut = new TableDataPageView(pageData, DataSize, totalRowDataSize, columns);
+
+            Assert.Equal(2U, sut.RowCount);
+            Assert.Equal(1, sut.GetInt32(0, 0));
+            Assert.Equal(-42, sut.GetInt32(1, 0));
+            Assert.Equal(12.5m, sut.GetDecimal(0, 3));
+            Assert.Equal(-0.01m, sut.GetDecimal(1, 3));
+            Assert.Equal(created.AddDays(1), sut.GetDateTime(1, 4));
+
+            // Variable length columns shift the offset of later columns
+            var name = sut.GetUtf16Span(1, 1);
+            Assert.Equal("Beta", Encoding.Unicode.GetString(name.Array, name.Offset, name.Count));
+            Assert.Equal(0, sut.CompareUtf16(0, 1, "Alpha"));
+            Assert.True(sut.CompareUtf16(0, 1, "Alphabet") < 0);
+            Assert.True(sut.CompareUtf16(1, 1, "Alpha") > 0);
+
+            // Fixed length character padding is ignored
+            Assert.Equal(0, sut.CompareUtf16(0, 2, "AB"));
+            Assert.Equal(0, sut.CompareUtf16(1, 2, "WXYZ"));
+
+            Assert.Throws<InvalidOperationException>(() => sut.GetInt64(0, 0));
+            Assert.Throws<ArgumentOutOfRangeException>(() => sut.GetInt32(2, 0));
+        }
+
+        private static ushort WriteRows(
+            byte[] pageData, TableColumnInfo[] columns, params object[][] rows)
+        {
+            var stream = new MemoryStream(pageData);
+            var slotOffset = DataSize;
+            foreach (var row in rows)
+            {
+                var rowOffset = (ushort)stream.Position;
+                var writer = new TableRowWriter(stream, columns);
+                for (var index = 0; index < row.Length; ++index)
+                {
+                    writer[index] = row[index];
+                }
+                writer.Write();
+
+                // Row offset table entries hold the row offset plus one
+                var rowDataOffset = rowOffset + 1;
+                pageData[--slotOffset] = (byte)(rowDataOffset & 0xff);
+                pageData[--slotOffset] = (byte)(rowDataOffset >> 8);
+            }
+            return (ushort)stream.Position;
+        }
+    }
+}
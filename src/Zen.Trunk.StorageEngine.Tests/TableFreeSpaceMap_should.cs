@@ -0,0 +1,88 @@
+using Xunit;
+using Zen.Trunk.Storage.Data.Table;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Table Free Space Map")]
+    // ReSharper disable once InconsistentNaming
+    public class TableFreeSpaceMap_should
+    {
+        private const uint DataSize = 8000;
+
+        [Fact(DisplayName = "Place pages in buckets by the fraction of their data area that is free")]
+        public void PlacePagesInBucketsByFreeSpace()
+        {
+            Assert.Equal(TableFreeSpaceMap.EmptyBucket, TableFreeSpaceMap.GetBucket(0, 7998, DataSize));
+            Assert.Equal(0, TableFreeSpaceMap.GetBucket(TableDataPage.MaxRows, 4000, DataSize));
+            Assert.Equal(0, TableFreeSpaceMap.GetBucket(10, 999, DataSize));
+            Assert.Equal(4, TableFreeSpaceMap.GetBucket(10, 4000, DataSize));
+            Assert.Equal(TableFreeSpaceMap.BucketCount - 1, TableFreeSpaceMap.GetBucket(1, 7990, DataSize));
+        }
+
+        [Fact(DisplayName = "Find the fullest page with room and only fall back to empty pages")]
+        public void FindFullestPageWithRoom()
+        {
+            var sut = new TableFreeSpaceMap();
+            sut.Update(new LogicalPageId(1), 10, 500, DataSize);
+            sut.Update(new LogicalPageId(2), 10, 2100, DataSize);
+            sut.Update(new LogicalPageId(3), 10, 6000, DataSize);
+            sut.Update(new LogicalPageId(4), 0, 7998, DataSize);
+
+            Assert.True(sut.TryFindPage(100, LogicalPageId.Zero, out var logicalPageId));
+            Assert.Equal(new LogicalPageId(2), logicalPageId);
+            Assert.True(sut.TryFindPage(100, new LogicalPageId(2), out logicalPageId));
+            Assert.Equal(new LogicalPageId(3), logicalPageId);
+            Assert.True(sut.TryFindPage(3000, LogicalPageId.Zero, out logicalPageId));
+            Assert.Equal(new LogicalPageId(3), logicalPageId);
+            Assert.True(sut.TryFindPage(7500, LogicalPageId.Zero, out logicalPageId));
+            Assert.Equal(new LogicalPageId(4), logicalPageId);
+
+            // Pages move between buckets as they fill
+            sut.Update(new LogicalPageId(4), 1, 100, DataSize);
+            Assert.False(sut.TryFindPage(7500, LogicalPageId.Zero, out _));
+        }
+
+        [Fact(DisplayName = "Offer empty pages for reclaim and mostly empty pages when rows can move")]
+        public void OfferReclaimCandidates()
+        {
+            var sut = new TableFreeSpaceMap();
+            sut.Update(new LogicalPageId(1), 10, 500, DataSize);
+            sut.Update(new LogicalPageId(2), 0, 7998, DataSize);
+            sut.Update(new LogicalPageId(3), 1, 7900, DataSize);
+
+            Assert.Equal(new[] { new LogicalPageId(2) }, sut.GetReclaimCandidates(false));
+            Assert.Equal(
+                new[] { new LogicalPageId(2), new LogicalPageId(3) },
+                sut.GetReclaimCandidates(true));
+
+            sut.Remove(new LogicalPageId(2));
+            Assert.False(sut.Contains(new LogicalPageId(2)));
+            Assert.Equal(new[] { new LogicalPageId(3) }, sut.GetReclaimCandidates(true));
+            Assert.True(sut.IsDirty);
+        }
+
+        [Fact(DisplayName = "Only reuse a cached map while its first page is unchanged")]
+        public void ReuseCachedMapWhileFirstPageIsUnchanged()
+        {
+            var sut = new TableFreeSpaceMapCache();
+            var objectId = new ObjectId(1);
+            var freeSpaceMap = new TableFreeSpaceMap();
+
+            sut.Return(objectId, freeSpaceMap, new LogicalPageId(4), 10);
+            Assert.True(sut.TryTake(objectId, new LogicalPageId(4), 10, out var cachedMap));
+            Assert.Same(freeSpaceMap, cachedMap);
+
+            // A map is handed to one statement at a time
+            Assert.False(sut.TryTake(objectId, new LogicalPageId(4), 10, out _));
+
+            // A rolled back save leaves the first page with another timestamp
+            sut.Return(objectId, freeSpaceMap, new LogicalPageId(4), 11);
+            Assert.False(sut.TryTake(objectId, new LogicalPageId(4), 10, out cachedMap));
+            Assert.Null(cachedMap);
+
+            sut.Return(objectId, freeSpaceMap, new LogicalPageId(4), 11);
+            Assert.False(sut.TryTake(objectId, LogicalPageId.Zero, 0, out _));
+        }
+    }
+}
@@ -0,0 +1,77 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Zen.Trunk.Storage.Data.Table;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Table Index Key Encoder")]
+    // ReSharper disable once InconsistentNaming
+    public class TableIndexKeyEncoder_should
+    {
+        [Fact(DisplayName = "Encode single column keys so byte order matches value order")]
+        public void EncodeKeysInValueOrder()
+        {
+            AssertEncodedOrder(TableColumnDataType.Int, int.MinValue, -1000, -1, 0, 1, 42, int.MaxValue);
+            AssertEncodedOrder(TableColumnDataType.Long, long.MinValue, -5L, 0L, 7L, long.MaxValue);
+            AssertEncodedOrder(TableColumnDataType.Double, double.MinValue, -2.5, -0.0001, 0.0, 1e-10, 3.75, double.MaxValue);
+            AssertEncodedOrder(TableColumnDataType.Money, -1000.5m, -1.25m, -0.0001m, 0m, 0.0001m, 1.2m, 1.25m, 79228162514264337593543950335m);
+            AssertEncodedOrder(TableColumnDataType.DateTime, new DateTime(1999, 12, 31), new DateTime(2000, 1, 1), new DateTime(2017, 6, 1));
+            AssertEncodedOrder(TableColumnDataType.NVarChar, string.Empty, "A", "AB", "AB\0", "ABC", "B", "a");
+        }
+
+        [Fact(DisplayName = "Honour descending columns, trailing nulls and wildcard keys")]
+        public void HonourDirectionsNullsAndWildcards()
+        {
+            var columns = new[]
+            {
+                new TableColumnInfo("Name", TableColumnDataType.NVarChar, false, 50),
+                new TableColumnInfo("Score", TableColumnDataType.Int, true)
+            };
+            var directions = new[] { TableIndexSortDirection.Ascending, TableIndexSortDirection.Descending };
+
+            var high = Encode(columns, directions, "Bob", 10, out _);
+            var low = Encode(columns, directions, "Bob", 5, out _);
+            var missing = Encode(columns, directions, "Bob", null, out _);
+            var other = Encode(columns, directions, "Carol", 100, out _);
+
+            // Descending second column; nulls follow values before inversion
+            Assert.True(TableIndexKeyEncoder.Compare(high, false, low, false) < 0);
+            Assert.True(TableIndexKeyEncoder.Compare(missing, false, high, false) < 0);
+            Assert.True(TableIndexKeyEncoder.Compare(low, false, other, false) < 0);
+
+            // A null for a non-nullable column matches any key it prefixes
+            var wildcard = Encode(columns, directions, null, 1, out var isPartial);
+            Assert.True(isPartial);
+            Assert.Equal(0, TableIndexKeyEncoder.Compare(wildcard, true, other, false));
+        }
+
+        private static void AssertEncodedOrder(TableColumnDataType dataType, params object[] orderedValues)
+        {
+            var columns = new[] { new TableColumnInfo("Key", dataType, false) };
+            var encoded = orderedValues
+                .Select(value => Encode(columns, null, value, out _))
+                .ToList();
+            for (var index = 1; index < encoded.Count; ++index)
+            {
+                Assert.True(
+                    TableIndexKeyEncoder.Compare(encoded[index - 1], false, encoded[index], false) < 0,
+                    $"{dataType} value {orderedValues[index - 1]} should sort before {orderedValues[index]}");
+            }
+        }
+
+        private static byte[] Encode(
+            IList<TableColumnInfo> columns, TableIndexSortDirection[] directions, object value, out bool isPartial)
+        {
+            return TableIndexKeyEncoder.Encode(new[] { value }, columns, directions, out isPartial);
+        }
+
+        private static byte[] Encode(
+            IList<TableColumnInfo> columns, TableIndexSortDirection[] directions, object first, object second, out bool isPartial)
+        {
+            return TableIndexKeyEncoder.Encode(new[] { first, second }, columns, directions, out isPartial);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+using System;
+using System.Collections.Generic;
+using Xunit;
+using Zen.Trunk.Storage.Data.Table;
+
+namespace Zen.Trunk.Storage
+{
+    [Trait("Subsystem", "Storage Engine")]
+    [Trait("Class", "Table Row Serializer")]
+    // ReSharper disable once InconsistentNaming
+    public class TableRowSerializer_should
+    {
+        public List<TableColumnInfo> ColumnDefinition { get; } =
+            new List<TableColumnInfo>
+            {
+                new TableColumnInfo("id", TableColumnDataType.Int, false),
+                new TableColumnInfo("name", TableColumnDataType.NVarChar, true, 50),
+                new TableColumnInfo("code", TableColumnDataType.Char, false),
+                new TableColumnInfo("price", TableColumnDataType.Money, true),
+                new TableColumnInfo("notes", TableColumnDataType.VarChar, true),
+                new TableColumnInfo("created", TableColumnDataType.DateTime, false),
+                new TableColumnInfo("ratio", TableColumnDataType.Double, false)
+            };
+
+        [Fact(DisplayName = "Place fixed length columns at precomputed offsets after the null bitmap")]
+        public void PlaceFixedColumnsAfterNullBitmap()
+        {
+            var sut = TableRowSerializer.GetSerializer(ColumnDefinition);
+
+            Assert.Same(sut, TableRowSerializer.GetSerializer(ColumnDefinition));
+            Assert.Equal(1, sut.NullBitmapSize);
+            Assert.Equal(1 + 4 + 10 + 16 + 8 + 8, sut.FixedSize);
+
+            var buffer = new byte[sut.MaxRowSize];
+            Assert.Equal(1, sut.GetColumnOffset(buffer, 0, 0, out var length));
+            Assert.Equal(4, length);
+            Assert.Equal(15, sut.GetColumnOffset(buffer, 0, 3, out length));
+            Assert.Equal(16, length);
+        }
+
+        [Fact(DisplayName = "Share one serializer between row definitions with the same schema")]
+        public void ShareSerializerBetweenMatchingSchemas()
+        {
+            var sut = TableRowSerializer.GetSerializer(ColumnDefinition);
+
+            // A separate copy of the same schema reuses the serializer
+            var copy = new List<TableColumnInfo>
+            {
+                new TableColumnInfo("id", TableColumnDataType.Int, false),
+                new TableColumnInfo("name", TableColumnDataType.NVarChar, true, 50),
+                new TableColumnInfo("code", TableColumnDataType.Char, false),
+                new TableColumnInfo("price", TableColumnDataType.Money, true),
+                new TableColumnInfo("notes", TableColumnDataType.VarChar, true),
+                new TableColumnInfo("created", TableColumnDataType.DateTime, false),
+                new TableColumnInfo("ratio", TableColumnDataType.Double, false)
+            };
+            Assert.Same(sut, TableRowSerializer.GetSerializer(copy));
+
+            // A change in nullability or length produces a different layout
+            copy[0] = new TableColumnInfo("id", TableColumnDataType.Int, true);
+            Assert.NotSame(sut, TableRowSerializer.GetSerializer(copy));
+            copy[0] = new TableColumnInfo("id", TableColumnDataType.Int, false);
+            copy[1] = new TableColumnInfo("name", TableColumnDataType.NVarChar, true, 60);
+            Assert.NotSame(sut, TableRowSerializer.GetSerializer(copy));
+        }
+
+        [Fact(DisplayName = "Read the same values that are written including nulls")]
+        public void ReadTheSameValuesThatAreWritten()
+        {
+            var sut = TableRowSerializer.GetSerializer(ColumnDefinition);
+            var created = new DateTime(2017, 5, 4, 3, 2, 1);
+            var rows = new[]
+            {
+                new object[] { 1, "First", "AB", 19.99m, "note", created, 0.5 },
+                new object[] { 2, null, "WXYZ", null, null, created.AddHours(1), -1.25 }
+            };
+
+            var buffer = new byte[sut.MaxRowSize * rows.Length];
+            var offset = 0;
+            var rowOffsets = new int[rows.Length];
+            for (var index = 0; index < rows.Length; ++index)
+            {
+                rowOffsets[index] = offset;
+                var rowSize = sut.Write(rows[index], buffer, offset);
+                Assert.Equal(sut.GetRowSize(rows[index]), rowSize);
+                offset += rowSize;
+            }
+
+            for (var index = 0; index < rows.Length; ++index)
+            {
+                var values = new object[ColumnDefinition.Count];
+                sut.Read(buffer, rowOffsets[index], values);
+                Assert.Equal(rows[index], values);
+            }
+
+            Assert.False(sut.IsNull(buffer, rowOffsets[0], 1));
+            Assert.True(sut.IsNull(buffer, rowOffsets[1], 1));
+            Assert.True(sut.IsNull(buffer, rowOffsets[1], 3));
+
+            // Variable length columns follow in definition order
+            sut.GetColumnOffset(buffer, rowOffsets[0], 4, out var notesLength);
+            Assert.Equal(4, notesLength);
+        }
+    }
+}
@@ -16,15 +16,15 @@ namespace Zen.Trunk.Storage
                 _owner = owner;
             }
 
-            public IDatabaseLockBuilder WithDatabaseLock(string lockId)
+            public IDatabaseLockBuilder WithDatabaseLock(DatabaseId dbId)
             {
                 var lockObject = new DatabaseLock();
-                lockObject.Id = lockId;
+                lockObject.Id = LockIdentity.GetDatabaseKey(dbId);
                 lockObject.Initialise();
                 lockObject.AddRefLock();
                 lockObject.FinalRelease += _owner._lockReleaseTracker.OnLockFinalRelease;
-                _owner._databaseLocks.Add(lockId, lockObject);
-                return new DatabaseLockBuilder(_owner, lockObject);
+                _owner._databaseLocks.Add(lockObject.Id, lockObject);
+                return new DatabaseLockBuilder(_owner, lockObject, dbId);
             }
         }
 
@@ -32,23 +32,25 @@ namespace Zen.Trunk.Storage
         {
             private readonly TransactionLockHierarchyBuilder _owner;
             private readonly DatabaseLock _parentLock;
+            private readonly DatabaseId _dbId;
 
-            public DatabaseLockBuilder(TransactionLockHierarchyBuilder owner, DatabaseLock parentLock)
+            public DatabaseLockBuilder(TransactionLockHierarchyBuilder owner, DatabaseLock parentLock, DatabaseId dbId)
             {
                 _owner = owner;
                 _parentLock = parentLock;
+                _dbId = dbId;
             }
 
-            public IObjectLockBuilder WithObjectLock(string lockId)
+            public IObjectLockBuilder WithObjectLock(ObjectId objectId)
             {
                 var lockObject = new ObjectLock();
-                lockObject.Id = lockId;
+                lockObject.Id = LockIdentity.GetObjectLockKey(_dbId, objectId);
                 lockObject.Parent = _parentLock;
                 lockObject.Initialise();
                 lockObject.AddRefLock();
                 lockObject.FinalRelease += _owner._lockReleaseTracker.OnLockFinalRelease;
-                _owner._objectLocks.Add(lockId, lockObject);
-                return new ObjectLockBuilder(_owner, lockObject);
+                _owner._objectLocks.Add(lockObject.Id, lockObject);
+                return new ObjectLockBuilder(_owner, lockObject, _dbId, objectId);
             }
         }
 
@@ -56,34 +58,38 @@ namespace Zen.Trunk.Storage
         {
             private readonly TransactionLockHierarchyBuilder _owner;
             private readonly ObjectLock _parentLock;
+            private readonly DatabaseId _dbId;
+            private readonly ObjectId _objectId;
 
-            public ObjectLockBuilder(TransactionLockHierarchyBuilder owner, ObjectLock parentLock)
+            public ObjectLockBuilder(TransactionLockHierarchyBuilder owner, ObjectLock parentLock, DatabaseId dbId, ObjectId objectId)
             {
                 _owner = owner;
                 _parentLock = parentLock;
+                _dbId = dbId;
+                _objectId = objectId;
             }
 
-            public IObjectLockBuilder WithSchemaLock(string lockId)
+            public IObjectLockBuilder WithSchemaLock()
             {
                 var lockObject = new SchemaLock();
-                lockObject.Id = lockId;
+                lockObject.Id = LockIdentity.GetSchemaLockKey(_dbId, _objectId);
                 lockObject.Parent = _parentLock;
                 lockObject.Initialise();
                 lockObject.AddRefLock();
                 lockObject.FinalRelease += _owner._lockReleaseTracker.OnLockFinalRelease;
-                _owner._schemaLocks.Add(lockId, lockObject);
+                _owner._schemaLocks.Add(lockObject.Id, lockObject);
                 return this;
             }
 
-            public IObjectLockBuilder WithDataLock(string lockId)
+            public IObjectLockBuilder WithDataLock(LogicalPageId logicalId)
             {
                 var lockObject = new DataLock();
-                lockObject.Id = lockId;
+                lockObject.Id = LockIdentity.GetDataLockKey(_dbId, _objectId, logicalId);
                 lockObject.Parent = _parentLock;
                 lockObject.Initialise();
                 lockObject.AddRefLock();
                 lockObject.FinalRelease += _owner._lockReleaseTracker.OnLockFinalRelease;
-                _owner._dataLocks.Add(lockId, lockObject);
+                _owner._dataLocks.Add(lockObject.Id, lockObject);
                 return this;
             }
         }
@@ -96,19 +102,19 @@ namespace Zen.Trunk.Storage
             {
                 _owner = owner;
 
-                DatabaseLocks = new ReadOnlyDictionary<string, DatabaseLock>(owner._databaseLocks);
-                ObjectLocks = new ReadOnlyDictionary<string, ObjectLock>(owner._objectLocks);
-                SchemaLocks = new ReadOnlyDictionary<string, SchemaLock>(owner._schemaLocks);
-                DataLocks = new ReadOnlyDictionary<string, DataLock>(owner._dataLocks);
+                DatabaseLocks = new ReadOnlyDictionary<LockResourceId, DatabaseLock>(owner._databaseLocks);
+                ObjectLocks = new ReadOnlyDictionary<LockResourceId, ObjectLock>(owner._objectLocks);
+                SchemaLocks = new ReadOnlyDictionary<LockResourceId, SchemaLock>(owner._schemaLocks);
+                DataLocks = new ReadOnlyDictionary<LockResourceId, DataLock>(owner._dataLocks);
             }
 
-            public IDictionary<string, DatabaseLock> DatabaseLocks { get; }
+            public IDictionary<LockResourceId, DatabaseLock> DatabaseLocks { get; }
 
-            public IDictionary<string, ObjectLock> ObjectLocks { get; }
+            public IDictionary<LockResourceId, ObjectLock> ObjectLocks { get; }
 
-            public IDictionary<string, SchemaLock> SchemaLocks { get; }
+            public IDictionary<LockResourceId, SchemaLock> SchemaLocks { get; }
 
-            public IDictionary<string, DataLock> DataLocks { get; }
+            public IDictionary<LockResourceId, DataLock> DataLocks { get; }
 
             public int ExpectedFinalReleaseCount { get; private set; }
 
@@ -155,14 +161,14 @@ namespace Zen.Trunk.Storage
 
         private readonly LockReleaseTracker _lockReleaseTracker =
             new LockReleaseTracker();
-        private readonly IDictionary<string, DatabaseLock> _databaseLocks =
-            new Dictionary<string, DatabaseLock>();
-        private readonly IDictionary<string, ObjectLock> _objectLocks =
-            new Dictionary<string, ObjectLock>();
-        private readonly IDictionary<string, SchemaLock> _schemaLocks =
-            new Dictionary<string, SchemaLock>();
-        private readonly IDictionary<string, DataLock> _dataLocks =
-            new Dictionary<string, DataLock>();
+        private readonly IDictionary<LockResourceId, DatabaseLock> _databaseLocks =
+            new Dictionary<LockResourceId, DatabaseLock>();
+        private readonly IDictionary<LockResourceId, ObjectLock> _objectLocks =
+            new Dictionary<LockResourceId, ObjectLock>();
+        private readonly IDictionary<LockResourceId, SchemaLock> _schemaLocks =
+            new Dictionary<LockResourceId, SchemaLock>();
+        private readonly IDictionary<LockResourceId, DataLock> _dataLocks =
+            new Dictionary<LockResourceId, DataLock>();
 
         public IRootLockBuilder WithRootLock()
         {
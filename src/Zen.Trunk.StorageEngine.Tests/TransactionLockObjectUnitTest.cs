@@ -17,15 +17,18 @@ namespace Zen.Trunk.Storage
         public async Task TransactionDataLockTest()
         {
             // Setup lock hierarchy
+            var dbId = new DatabaseId(1);
+            var objectId = new ObjectId(1);
+            var logicalId = new LogicalPageId(1);
             var builder = new TransactionLockHierarchyBuilder();
             builder.WithRootLock()
-                .WithDatabaseLock("DBL:01")
-                .WithObjectLock("OBL:01")
-                .WithDataLock("DL:01");
+                .WithDatabaseLock(dbId)
+                .WithObjectLock(objectId)
+                .WithDataLock(logicalId);
             ITransactionLockHierarchy lockHierarchy;
             using (lockHierarchy = builder.Build())
             {
-                var dataLock = lockHierarchy.DataLocks["DL:01"];
+                var dataLock = lockHierarchy.DataLocks[LockIdentity.GetDataLockKey(dbId, objectId, logicalId)];
 
                 // Now we spoof transactions so we can test this madness
                 var firstLockOwner = new LockOwnerIdentity(
@@ -116,17 +119,20 @@ namespace Zen.Trunk.Storage
         public async Task TransactionObjectLockTest()
         {
             // Setup lock hierarchy
+            var dbId = new DatabaseId(1);
+            var objectId = new ObjectId(1);
+            var logicalId = new LogicalPageId(1);
             var builder = new TransactionLockHierarchyBuilder();
             builder.WithRootLock()
-                .WithDatabaseLock("DBL:01")
-                .WithObjectLock("OBL:01")
-                .WithDataLock("DL:01");
+                .WithDatabaseLock(dbId)
+                .WithObjectLock(objectId)
+                .WithDataLock(logicalId);
             ITransactionLockHierarchy lockHierarchy;
             using (lockHierarchy = builder.Build())
             {
-                var databaseLock = lockHierarchy.DatabaseLocks["DBL:01"];
-                var objectLock = lockHierarchy.ObjectLocks["OBL:01"];
-                var dataLock = lockHierarchy.DataLocks["DL:01"];
+                var databaseLock = lockHierarchy.DatabaseLocks[LockIdentity.GetDatabaseKey(dbId)];
+                var objectLock = lockHierarchy.ObjectLocks[LockIdentity.GetObjectLockKey(dbId, objectId)];
+                var dataLock = lockHierarchy.DataLocks[LockIdentity.GetDataLockKey(dbId, objectId, logicalId)];
 
                 // Now we spoof transactions so we can test this madness
                 var firstLockOwner = new LockOwnerIdentity(
@@ -185,5 +191,53 @@ namespace Zen.Trunk.Storage
                 lockHierarchy.ExpectedFinalReleaseCount,
                 lockHierarchy.ActualFinalReleaseCount);
         }
+
+        /// <summary>
+        /// Tests that uncontended requests complete inline and blocked
+        /// requests are granted once the conflicting lock is released.
+        /// </summary>
+        [Fact(DisplayName = "Test uncontended DataLock requests complete inline and blocked requests wait for release.")]
+        public async Task TransactionDataLockWaiterTest()
+        {
+            // Setup lock hierarchy
+            var dbId = new DatabaseId(1);
+            var objectId = new ObjectId(1);
+            var logicalId = new LogicalPageId(1);
+            var builder = new TransactionLockHierarchyBuilder();
+            builder.WithRootLock()
+                .WithDatabaseLock(dbId)
+                .WithObjectLock(objectId)
+                .WithDataLock(logicalId);
+            ITransactionLockHierarchy lockHierarchy;
+            using (lockHierarchy = builder.Build())
+            {
+                var dataLock = lockHierarchy.DataLocks[LockIdentity.GetDataLockKey(dbId, objectId, logicalId)];
+
+                var firstLockOwner = new LockOwnerIdentity(
+                    SessionId.Zero, new TransactionId(5));
+                var secondLockOwner = new LockOwnerIdentity(
+                    SessionId.Zero, new TransactionId(6));
+
+                // Uncontended acquire completes without waiting
+                var firstLockTask = dataLock.LockAsync(firstLockOwner, DataLockType.Exclusive, TimeSpan.FromSeconds(30));
+                Assert.True(firstLockTask.IsCompleted);
+                await firstLockTask.ConfigureAwait(true);
+
+                // Conflicting request must wait for the release
+                var secondLockTask = dataLock.LockAsync(secondLockOwner, DataLockType.Shared, TimeSpan.FromSeconds(30));
+                Assert.False(secondLockTask.IsCompleted);
+
+                await dataLock.UnlockAsync(firstLockOwner, DataLockType.None).ConfigureAwait(true);
+                await secondLockTask.ConfigureAwait(true);
+                Assert.True(await dataLock.HasLockAsync(secondLockOwner, DataLockType.Shared).ConfigureAwait(true));
+
+                await dataLock.UnlockAsync(secondLockOwner, DataLockType.None).ConfigureAwait(true);
+                Assert.False(await dataLock.HasLockAsync(secondLockOwner, DataLockType.None).ConfigureAwait(true));
+            }
+
+            Assert.Equal(
+                lockHierarchy.ExpectedFinalReleaseCount,
+                lockHierarchy.ActualFinalReleaseCount);
+        }
     }
 }
@@ -277,6 +277,92 @@ namespace Zen.Trunk.Storage
             }
         }
 
+        /// <summary>
+        /// Verify exclusive item locks are escalated to an exclusive object
+        /// lock and the escalation is reported.
+        /// </summary>
+        [Fact(DisplayName = nameof(TransactionLockOwnerBlock_should) + "_" + nameof(escalate_exclusive_item_locks_and_report_escalation))]
+        public async Task escalate_exclusive_item_locks_and_report_escalation()
+        {
+            uint maxPageLocks = 5;
+            var objectId = new ObjectId(4);
+            var startLogicalId = new LogicalPageId(40);
+            var endLogicalId = new LogicalPageId(40 + maxPageLocks + 1);
+
+            // Setup minimal service container we need to get trunk transactions to work
+            var databaseLockManager = _scope.Resolve<IDatabaseLockManager>();
+            LockEscalatedEventArgs escalation = null;
+            databaseLockManager.LockEscalated += (sender, e) => escalation = e;
+
+            ITrunkTransaction transaction = new TrunkTransaction(_scope, IsolationLevel.ReadCommitted, TimeSpan.FromSeconds(10));
+            var transactionLob = transaction.GetTransactionLockOwnerBlock(databaseLockManager);
+
+            using (TrunkTransactionContext.SwitchTransactionContext(transaction))
+            {
+                var dataLockOwnerBlock = transactionLob.GetOrCreateDataLockOwnerBlock(objectId, maxPageLocks);
+                for (var logicalId = startLogicalId; logicalId < endLogicalId; logicalId = logicalId.Next)
+                {
+                    await dataLockOwnerBlock
+                        .LockItemAsync(logicalId, DataLockType.Exclusive, TimeSpan.FromSeconds(5))
+                        .ConfigureAwait(true);
+                }
+
+                // Escalation should have replaced the item locks with an exclusive owner lock
+                Assert.True(
+                    await dataLockOwnerBlock
+                        .HasOwnerLockAsync(ObjectLockType.Exclusive)
+                        .ConfigureAwait(true));
+                Assert.True(
+                    await dataLockOwnerBlock
+                        .HasItemLockAsync(startLogicalId, DataLockType.Exclusive)
+                        .ConfigureAwait(true));
+                Assert.Equal(1, databaseLockManager.LockEscalationCount);
+                Assert.NotNull(escalation);
+                Assert.Equal(ObjectLockType.Exclusive, escalation.LockType);
+                Assert.Equal((int)maxPageLocks + 1, escalation.ReleasedLockCount);
+            }
+        }
+
+        [Fact(DisplayName = nameof(TransactionLockOwnerBlock_should) + "_" + nameof(complete_synchronously_when_item_lock_already_held))]
+        public async Task complete_synchronously_when_item_lock_already_held()
+        {
+            uint maxPageLocks = 100;
+            var objectId = new ObjectId(5);
+            var startLogicalId = new LogicalPageId(50);
+            var endLogicalId = new LogicalPageId(50 + 40);
+
+            var databaseLockManager = _scope.Resolve<IDatabaseLockManager>();
+            ITrunkTransaction transaction = new TrunkTransaction(_scope, IsolationLevel.ReadCommitted, TimeSpan.FromSeconds(10));
+            var transactionLob = transaction.GetTransactionLockOwnerBlock(databaseLockManager);
+
+            using (TrunkTransactionContext.SwitchTransactionContext(transaction))
+            {
+                var dataLockOwnerBlock = transactionLob.GetOrCreateDataLockOwnerBlock(objectId, maxPageLocks);
+                for (var logicalId = startLogicalId; logicalId < endLogicalId; logicalId = logicalId.Next)
+                {
+                    await dataLockOwnerBlock
+                        .LockItemAsync(logicalId, DataLockType.Update, TimeSpan.FromSeconds(5))
+                        .ConfigureAwait(true);
+                }
+
+                // Held and weaker requests are satisfied without waiting
+                Assert.True(dataLockOwnerBlock.LockItemAsync(startLogicalId, DataLockType.Update, TimeSpan.FromSeconds(5)).IsCompleted);
+                Assert.True(dataLockOwnerBlock.LockItemAsync(startLogicalId, DataLockType.Shared, TimeSpan.FromSeconds(5)).IsCompleted);
+                Assert.True(dataLockOwnerBlock.HasItemLockAsync(startLogicalId, DataLockType.Shared).Result);
+
+                // Unlocking an item leaves the remaining items held
+                await dataLockOwnerBlock.UnlockItemAsync(startLogicalId).ConfigureAwait(true);
+                Assert.False(
+                    await dataLockOwnerBlock
+                        .HasItemLockAsync(startLogicalId, DataLockType.Update)
+                        .ConfigureAwait(true));
+                for (var logicalId = startLogicalId.Next; logicalId < endLogicalId; logicalId = logicalId.Next)
+                {
+                    Assert.True(dataLockOwnerBlock.HasItemLockAsync(logicalId, DataLockType.Update).IsCompleted);
+                }
+            }
+        }
+
         public void Dispose()
         {
             _scope.Dispose();
@@ -1,6 +1,8 @@
-﻿using System.IO;
+﻿using System.Collections.Generic;
+using System.IO;
 using Xunit;
 using Zen.Trunk.Storage.Logging;
+using Zen.Trunk.VirtualMemory;
 
 namespace Zen.Trunk.Storage
 {
@@ -28,11 +30,11 @@ namespace Zen.Trunk.Storage
         }
 
 
-        [Fact(DisplayName = "Given an initialised stream, When two log records are written, Then the stream length is as expected.")]
+        [Fact(DisplayName = "Given an initialised stream, When two log records are written, Then each is framed in an aligned log block.")]
         public void CreateStreamAndWriteCheckpoint()
         {
             var mockedLogDevice = new Moq.Mock<ILogPageDevice>();
-            var logFileInfo = new VirtualLogFileInfo();
+            var logFileInfo = new VirtualLogFileInfo { Length = 64 * 1024 };
 
             using (var stream = new MemoryStream())
             {
@@ -41,15 +43,167 @@ namespace Zen.Trunk.Storage
                 using (var sut = new VirtualLogFileStream(mockedLogDevice.Object, stream, logFileInfo))
                 {
                     sut.InitNew();
-                    sut.WriteEntry(beginCheckpoint);
+                    var beginPosition = sut.WriteEntry(beginCheckpoint);
+                    sut.Flush();
+
+                    Assert.Equal(0u, beginPosition);
+                    Assert.Equal(VirtualLogFileStream.TotalHeaderSize + VirtualLogFileStream.BlockAlignment, stream.Length);
+
+                    var endPosition = sut.WriteEntry(endCheckpoint);
+                    sut.Flush();
+
+                    Assert.Equal((uint)VirtualLogFileStream.BlockAlignment, endPosition);
+                    Assert.Equal(beginPosition, endCheckpoint.LastLog);
+                    Assert.Equal(VirtualLogFileStream.TotalHeaderSize + (2 * VirtualLogFileStream.BlockAlignment), stream.Length);
+                }
+            }
+        }
+
+        [Fact(DisplayName = "Given a used stream, When the stream is reinitialised for reuse, Then the cursor is reset to the start.")]
+        public void ReinitialisedStreamResetsCursor()
+        {
+            var mockedLogDevice = new Moq.Mock<ILogPageDevice>();
+            var logFileInfo = new VirtualLogFileInfo { Length = 64 * 1024 };
+
+            using (var stream = new MemoryStream())
+            {
+                using (var sut = new VirtualLogFileStream(mockedLogDevice.Object, stream, logFileInfo))
+                {
+                    sut.InitNew();
+                    sut.WriteEntry(new BeginCheckPointLogEntry());
+                    sut.WriteEntry(new EndCheckPointLogEntry());
+                    sut.IsFull = true;
+                    Assert.NotEqual(0u, logFileInfo.CurrentHeader.Cursor);
+
+                    sut.InitNew();
+
+                    Assert.Equal(0u, logFileInfo.CurrentHeader.Cursor);
+                    Assert.Equal(0u, logFileInfo.CurrentHeader.LastCursor);
+                    Assert.True(logFileInfo.IsAllocated);
+                    Assert.False(logFileInfo.IsFull);
+                    Assert.Null(sut.ReadEntry());
+                }
+            }
+        }
+
+        [Fact(DisplayName = "Given several small entries, When they are written together, Then they share a single log block.")]
+        public void SmallEntriesShareLogBlock()
+        {
+            var mockedLogDevice = new Moq.Mock<ILogPageDevice>();
+            var logFileInfo = new VirtualLogFileInfo { Length = 64 * 1024 };
+
+            using (var stream = new MemoryStream())
+            {
+                using (var sut = new VirtualLogFileStream(mockedLogDevice.Object, stream, logFileInfo))
+                {
+                    sut.InitNew();
+                    var entries = new LogEntry[]
+                    {
+                        new BeginCheckPointLogEntry { LogId = 1 },
+                        new NoOpLogEntry { LogId = 2 },
+                        new EndCheckPointLogEntry { LogId = 3 }
+                    };
+                    Assert.Equal(entries.Length, sut.GetEntriesThatFit(entries));
+
+                    var logPositions = new List<uint>();
+                    sut.WriteEntries(entries, logPositions);
+                    sut.Flush();
+
+                    Assert.Equal(new uint[] { 0, 1, 2 }, logPositions);
+                    Assert.Equal(VirtualLogFileStream.TotalHeaderSize + VirtualLogFileStream.BlockAlignment, stream.Length);
+
+                    sut.SeekLogPosition(logPositions[1]);
+                    Assert.Equal(LogEntryType.NoOp, sut.ReadEntry().LogType);
+                    Assert.Equal(LogEntryType.EndCheckpoint, sut.ReadEntry().LogType);
+                    Assert.Null(sut.ReadEntry());
+                }
+            }
+        }
+
+        [Fact(DisplayName = "Given a reused stream, When blocks from the earlier use follow the new blocks, Then reading stops at the earlier blocks.")]
+        public void ReadStopsAtBlocksFromEarlierUse()
+        {
+            var mockedLogDevice = new Moq.Mock<ILogPageDevice>();
+            var logFileInfo = new VirtualLogFileInfo { Length = 64 * 1024 };
+
+            using (var stream = new MemoryStream())
+            {
+                using (var sut = new VirtualLogFileStream(mockedLogDevice.Object, stream, logFileInfo))
+                {
+                    sut.InitNew();
+                    sut.WriteEntry(new BeginCheckPointLogEntry { LogId = 100 });
+                    sut.WriteEntry(new NoOpLogEntry { LogId = 101 });
+                    sut.WriteEntry(new EndCheckPointLogEntry { LogId = 102 });
+                    var firstSequence = logFileInfo.CurrentHeader.Sequence;
+
+                    // Log ids restart below those left in the file
+                    sut.InitNew();
+                    sut.WriteEntry(new BeginCheckPointLogEntry { LogId = 1 });
                     sut.Flush();
 
-                    Assert.Equal(VirtualLogFileStream.TotalHeaderSize + beginCheckpoint.RawSize, stream.Length);
+                    Assert.True(logFileInfo.CurrentHeader.Sequence > firstSequence);
+                    sut.SeekLogPosition(0);
+                    var entry = sut.ReadEntry();
+                    Assert.Equal(1u, entry.LogId);
+                    Assert.Null(sut.ReadEntry());
+                    Assert.Equal(1u, sut.GetLastLogId());
+                }
+            }
+        }
+
+        [Fact(DisplayName = "Given a log with a torn final block, When entries are read, Then reading stops at the last valid block.")]
+        public void ReadStopsAtTornBlock()
+        {
+            var mockedLogDevice = new Moq.Mock<ILogPageDevice>();
+            var logFileInfo = new VirtualLogFileInfo { Length = 64 * 1024 };
 
-                    sut.WriteEntry(endCheckpoint);
+            using (var stream = new MemoryStream())
+            {
+                using (var sut = new VirtualLogFileStream(mockedLogDevice.Object, stream, logFileInfo))
+                {
+                    sut.InitNew();
+                    sut.WriteEntry(new BeginCheckPointLogEntry { LogId = 1 });
+                    var tornPosition = sut.WriteEntry(new EndCheckPointLogEntry { LogId = 2 });
                     sut.Flush();
 
-                    Assert.Equal(VirtualLogFileStream.TotalHeaderSize + beginCheckpoint.RawSize + endCheckpoint.RawSize, stream.Length);
+                    // Corrupt a payload byte of the final block
+                    var tornOffset = VirtualLogFileStream.TotalHeaderSize + tornPosition + LogBlockHeader.HeaderSize;
+                    var buffer = stream.GetBuffer();
+                    buffer[tornOffset] ^= 0xff;
+
+                    sut.SeekLogPosition(0);
+                    var entry = sut.ReadEntry();
+                    Assert.NotNull(entry);
+                    Assert.Equal(LogEntryType.BeginCheckpoint, entry.LogType);
+                    Assert.Null(sut.ReadEntry());
+                }
+            }
+        }
+
+        [Fact(DisplayName = "Given a page image entry, When it is written, Then the block is compressed and reads back intact.")]
+        public void PageImageBlockIsCompressed()
+        {
+            var mockedLogDevice = new Moq.Mock<ILogPageDevice>();
+            var mockedBuffer = new Moq.Mock<IVirtualBuffer>();
+            var logFileInfo = new VirtualLogFileInfo { Length = 64 * 1024 };
+
+            using (var stream = new MemoryStream())
+            {
+                var pageEntry = new PageImageCreateLogEntry(mockedBuffer.Object, 42, 1) { LogId = 1 };
+                using (var sut = new VirtualLogFileStream(mockedLogDevice.Object, stream, logFileInfo))
+                {
+                    sut.InitNew();
+                    sut.WriteEntries(new LogEntry[] { pageEntry, new EndCheckPointLogEntry { LogId = 2 } });
+                    sut.Flush();
+
+                    Assert.True(stream.Length < VirtualLogFileStream.TotalHeaderSize + pageEntry.RawSize);
+
+                    sut.SeekLogPosition(0);
+                    var entry = sut.ReadEntry();
+                    Assert.IsType<PageImageCreateLogEntry>(entry);
+                    Assert.Equal(42ul, ((PageLogEntry)entry).VirtualPageId.Value);
+                    Assert.Equal(LogEntryType.EndCheckpoint, sut.ReadEntry().LogType);
+                    Assert.Null(sut.ReadEntry());
                 }
             }
         }
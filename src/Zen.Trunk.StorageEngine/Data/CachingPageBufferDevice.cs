@@ -198,6 +198,7 @@ namespace Zen.Trunk.Storage.Data
         private bool _isDisposed;
         private readonly CancellationTokenSource _shutdownToken = new CancellationTokenSource();
         private IMultipleBufferDevice _bufferDevice;
+        private readonly PageVersionStore _versionStore;
         private readonly IStorageEngineEventService _storageEngineEventService;
 
         // Buffer load/initialisation
@@ -233,8 +234,30 @@ namespace Zen.Trunk.Storage.Data
             IMultipleBufferDevice bufferDevice,
             IStorageEngineEventService storageEngineEventService,
             CachingPageBufferDeviceSettings cacheSettings)
+            : this(bufferDevice, storageEngineEventService, cacheSettings, null)
+        {
+        }
+        #endregion
+
+        #region Internal Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CachingPageBufferDevice" /> class.
+        /// </summary>
+        /// <param name="bufferDevice">The buffer device that is to be cached.</param>
+        /// <param name="storageEngineEventService">Event service.</param>
+        /// <param name="cacheSettings">The cache device settings.</param>
+        /// <param name="versionStore">
+        /// The version store of the owning database or <c>null</c> if
+        /// superseded page images are not retained.
+        /// </param>
+        internal CachingPageBufferDevice(
+            IMultipleBufferDevice bufferDevice,
+            IStorageEngineEventService storageEngineEventService,
+            CachingPageBufferDeviceSettings cacheSettings,
+            PageVersionStore versionStore)
         {
             _bufferDevice = bufferDevice ?? throw new ArgumentNullException(nameof(bufferDevice));
+            _versionStore = versionStore;
             _storageEngineEventService = storageEngineEventService ?? throw new ArgumentNullException(nameof(storageEngineEventService));
             _cacheSettings = cacheSettings ?? new CachingPageBufferDeviceSettings();
 
@@ -247,7 +270,7 @@ namespace Zen.Trunk.Storage.Data
                         return null;
                     }
 
-                    return new PageBuffer(_bufferDevice);
+                    return new PageBuffer(_bufferDevice, _versionStore);
                 });
             _freePoolFillerTask = Task.Factory.StartNew(
                 FreePoolFillerThread,
@@ -640,7 +663,7 @@ namespace Zen.Trunk.Storage.Data
                 while (!_shutdownToken.IsCancellationRequested &&
                     _freePagePool.Count < _cacheSettings.MaximumFreePoolSize)
                 {
-                    _freePagePool.PutObject(new PageBuffer(_bufferDevice));
+                    _freePagePool.PutObject(new PageBuffer(_bufferDevice, _versionStore));
                 }
 
                 // Monitor until we see low-water mark
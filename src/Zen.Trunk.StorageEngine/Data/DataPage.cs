@@ -369,8 +369,9 @@ namespace Zen.Trunk.Storage.Data
         /// <see cref="LockPageAsync"/> as necessary.
         /// This mechanism ensures that all lock states have been set prior to
         /// the first call to LockPage.
-        /// When the current isolation level is uncommitted read then <see cref="LockPageAsync"/>
-        /// will not be called.
+        /// When the current isolation level is uncommitted read or snapshot
+        /// then <see cref="LockPageAsync"/> will not be called; snapshot
+        /// readers are served committed page versions instead.
         /// When the current isolation level is repeatable read or serializable
         /// then the <see cref="HoldLock"/> will be set to <c>true</c> prior to
         /// calling <see cref="LockPageAsync"/>.
@@ -388,6 +389,7 @@ namespace Zen.Trunk.Storage.Data
             switch (TrunkTransactionContext.Current.IsolationLevel)
             {
                 case IsolationLevel.ReadUncommitted:
+                case IsolationLevel.Snapshot:
                     break;
 
                 case IsolationLevel.ReadCommitted:
@@ -421,6 +423,7 @@ namespace Zen.Trunk.Storage.Data
             switch (TrunkTransactionContext.Current.IsolationLevel)
             {
                 case IsolationLevel.ReadUncommitted:
+                case IsolationLevel.Snapshot:
                     break;
 
                 case IsolationLevel.ReadCommitted:
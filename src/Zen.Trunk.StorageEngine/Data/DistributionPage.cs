@@ -257,6 +257,21 @@ namespace Zen.Trunk.Storage.Data
         public ObjectLockType DistributionLock { get; private set; } = ObjectLockType.IntentShared;
         #endregion
 
+        #region Internal Properties
+        /// <summary>
+        /// Gets or sets the free space summary for this page.
+        /// </summary>
+        /// <value>
+        /// The free space map.
+        /// </value>
+        /// <remarks>
+        /// Devices share a single map per distribution page index across the
+        /// page objects they load so that full pages can be skipped without
+        /// loading them.
+        /// </remarks>
+        internal ExtentFreeSpaceMap FreeSpaceMap { get; set; } = new ExtentFreeSpaceMap();
+        #endregion
+
         #region Private Properties
         private DistributionLockOwnerBlock DistributionLockOwnerBlock =>
             TransactionLockOwnerBlock?.GetOrCreateDistributionLockOwnerBlock(VirtualPageId);
@@ -403,6 +418,7 @@ namespace Zen.Trunk.Storage.Data
 
             // Update extent full state
             info.IsFull = info.Pages.All(p => p.IsAllocated);
+            FreeSpaceMap.Update(result.Extent, info);
 
             // Mark this instance as dirty and force save to underlying page buffer
             SetDirty();
@@ -456,6 +472,7 @@ namespace Zen.Trunk.Storage.Data
                     _extents[extentIndex].IsMixedExtent = false;
                     _extents[extentIndex].ObjectId = ObjectId.Zero;
                 }
+                FreeSpaceMap.Update(extentIndex, _extents[extentIndex]);
 
                 // Perform full save of distribution page
                 SetDirty();
@@ -469,12 +486,32 @@ namespace Zen.Trunk.Storage.Data
         /// <param name="logicalVirtualManager">The logical virtual manager.</param>
         /// <returns></returns>
         public Task ExportPageMappingTo(ILogicalVirtualManager logicalVirtualManager)
+        {
+            // Add lookups for each allocated page
+            var addTasks = new List<Task>();
+            foreach (var lookup in GetPageMappings())
+            {
+                addTasks.Add(logicalVirtualManager.AddLookupAsync(lookup.Value, lookup.Key));
+            }
+
+            // Return task that will complete when dist page has been processed
+            return TaskExtra.WhenAllOrEmpty(addTasks.ToArray());
+        }
+
+        /// <summary>
+        /// Gets the logical to virtual mappings of the pages allocated by
+        /// this distribution page.
+        /// </summary>
+        /// <returns>
+        /// A list of mappings ordered by virtual page identifier.
+        /// </returns>
+        public IList<KeyValuePair<LogicalPageId, VirtualPageId>> GetPageMappings()
         {
             var startPageId = VirtualPageId.NextPage;
 
             // Loop through next 512 device pages adding logical
             //	lookups where we have allocated pages.
-            var addTasks = new List<Task>();
+            var lookups = new List<KeyValuePair<LogicalPageId, VirtualPageId>>();
 
             // Walk list of usable extents
             for (uint extentIndex = 0; extentIndex < ExtentTrackingCount && _extents[extentIndex].IsUsable; ++extentIndex)
@@ -496,14 +533,12 @@ namespace Zen.Trunk.Storage.Data
                         // Pull out the logical page identifier from the page information
                         var logicalPageId = _extents[extentIndex].Pages[pageIndex].LogicalPageId;
 
-                        // Add mapping to the logical/virtual manager
-                        addTasks.Add(logicalVirtualManager.AddLookupAsync(virtualPageId, logicalPageId));
+                        lookups.Add(new KeyValuePair<LogicalPageId, VirtualPageId>(logicalPageId, virtualPageId));
                     }
                 }
             }
 
-            // Return task that will complete when dist page has been processed
-            return TaskExtra.WhenAllOrEmpty(addTasks.ToArray());
+            return lookups;
         }
 
         /// <summary>
@@ -558,6 +593,7 @@ namespace Zen.Trunk.Storage.Data
                     extentInfo.IsUsable = false;
                 }
             }
+            FreeSpaceMap.Refresh(_extents);
 
             // Force full save of this distribution page
             SetDirty();
@@ -644,6 +680,7 @@ namespace Zen.Trunk.Storage.Data
             {
                 _extents[index].Read(streamManager);
             }
+            FreeSpaceMap.Refresh(_extents);
         }
 
         /// <summary>
@@ -682,6 +719,7 @@ namespace Zen.Trunk.Storage.Data
                     page.LogicalPageId = LogicalPageId.Zero;
                 }
             }
+            FreeSpaceMap.Refresh(_extents);
             return base.OnInitAsync();
         }
 
@@ -769,9 +807,13 @@ namespace Zen.Trunk.Storage.Data
         #region Private Methods
         private async Task<AllocExtentResult> TryFindUsableExistingExtentAsync(AllocateDataPageParameters allocParams)
         {
+            // Only visit extents the free space map says we can use
             var result = new AllocExtentResult();
-            for (uint index = 0; !result.UseExtent && index < ExtentTrackingCount; ++index)
+            var candidates = FreeSpaceMap.GetExistingExtentCandidates(allocParams);
+            while (!result.UseExtent && candidates != 0)
             {
+                var index = ExtentFreeSpaceMap.GetLowestBit(candidates);
+                candidates &= candidates - 1;
                 try
                 {
                     // Get the extent information
@@ -779,15 +821,9 @@ namespace Zen.Trunk.Storage.Data
                     var info = lockInfo.Item1;
                     result.HasAcquiredLock = lockInfo.Item2;
 
-                    // If this extent is unusable then stop as we have reached
-                    //	the end of the device...
-                    if (!info.IsUsable)
-                    {
-                        break;
-                    }
-
-                    // Skip extents that are full
-                    if (info.IsFull)
+                    // Skip extents that have become unusable or full since
+                    //	the map was last refreshed
+                    if (!info.IsUsable || info.IsFull)
                     {
                         continue;
                     }
@@ -819,9 +855,13 @@ namespace Zen.Trunk.Storage.Data
 
         private async Task<AllocExtentResult> TryFindUsableFreeExtentAsync()
         {
+            // Only visit extents the free space map says are free
             var result = new AllocExtentResult();
-            for (uint index = 0; !result.UseExtent && index < ExtentTrackingCount; ++index)
+            var candidates = FreeSpaceMap.GetFreeExtentCandidates();
+            while (!result.UseExtent && candidates != 0)
             {
+                var index = ExtentFreeSpaceMap.GetLowestBit(candidates);
+                candidates &= candidates - 1;
                 try
                 {
                     // Get the extent information
@@ -829,15 +869,8 @@ namespace Zen.Trunk.Storage.Data
                     var info = lockInfo.Item1;
                     result.HasAcquiredLock = lockInfo.Item2;
 
-                    // If this extent is unusable then stop as we have reached
-                    //	the end of the device...
-                    if (!info.IsUsable)
-                    {
-                        break;
-                    }
-
                     // If extent is free then we will use it
-                    if (info.IsFree)
+                    if (info.IsUsable && info.IsFree)
                     {
                         result.Extent = index;
                         result.UseExtent = true;
@@ -903,6 +936,7 @@ namespace Zen.Trunk.Storage.Data
                 !_lockedExtents.Contains(extentIndex))
             {
                 info.ReadFrom(DataBuffer, HeaderSize, extentIndex);
+                FreeSpaceMap.Update(extentIndex, info);
             }
             return new Tuple<ExtentInfo, bool>(info, hasAcquiredLock);
         }
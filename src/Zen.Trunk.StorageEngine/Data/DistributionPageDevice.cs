@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Threading.Tasks;
 using Serilog;
@@ -18,6 +19,8 @@ namespace Zen.Trunk.Storage.Data
         #region Private Fields
         private static readonly ILogger Logger = Serilog.Log.ForContext<DistributionPageDevice>();
 
+        private readonly ConcurrentDictionary<uint, ExtentFreeSpaceMap> _freeSpaceMaps =
+            new ConcurrentDictionary<uint, ExtentFreeSpaceMap>();
         private IFileGroupDevice _fileGroupDevice;
         #endregion
 
@@ -74,6 +77,30 @@ namespace Zen.Trunk.Storage.Data
         /// The distribution page offset.
         /// </value>
         public abstract uint DistributionPageOffset { get; }
+
+        /// <summary>
+        /// Gets the number of unallocated pages in the usable extents of
+        /// this device.
+        /// </summary>
+        /// <value>
+        /// The free page count.
+        /// </value>
+        /// <remarks>
+        /// This value is derived from the free space maps of the loaded
+        /// distribution pages and is intended as an allocation hint.
+        /// </remarks>
+        public long FreePageCount
+        {
+            get
+            {
+                long freePages = 0;
+                foreach (var freeSpaceMap in _freeSpaceMaps.Values)
+                {
+                    freePages += freeSpaceMap.FreePageCount;
+                }
+                return freePages;
+            }
+        }
         #endregion
 
         #region Public Methods
@@ -121,6 +148,7 @@ namespace Zen.Trunk.Storage.Data
         {
             // Keep looping until we allocate
             var isExpand = false;
+            var useFreeSpaceMaps = true;
             while (true)
             {
                 // Load device root page
@@ -136,6 +164,16 @@ namespace Zen.Trunk.Storage.Data
                         ) + 1;
                     for (uint distPageIndex = 0; distPageIndex < maxDistPage; ++distPageIndex)
                     {
+                        // Skip distribution pages that have no candidate
+                        //	extent without loading or locking them
+                        if (useFreeSpaceMaps &&
+                            _freeSpaceMaps.TryGetValue(distPageIndex, out var freeSpaceMap) &&
+                            freeSpaceMap.IsInitialised &&
+                            !freeSpaceMap.HasCandidate(allocParams))
+                        {
+                            continue;
+                        }
+
                         // Walk the distribution pages on this device
                         using (var distPage = new DistributionPage())
                         {
@@ -164,6 +202,15 @@ namespace Zen.Trunk.Storage.Data
                         }
                     }
 
+                    // Free space maps are only refreshed when a page is loaded
+                    //	so space released by a rollback may have been skipped;
+                    //	check every page before expanding the device
+                    if (useFreeSpaceMaps)
+                    {
+                        useFreeSpaceMaps = false;
+                        continue;
+                    }
+
                     // If we have already tried to expand the device or the
                     //	device cannot be automatically expanded then throw
                     if (isExpand || !rootPage.IsExpandable)
@@ -182,6 +229,51 @@ namespace Zen.Trunk.Storage.Data
 
                 // Signal we have expanded the device
                 isExpand = true;
+                useFreeSpaceMaps = true;
+            }
+        }
+
+        /// <summary>
+        /// Reads the committed mappings of every distribution page loaded by
+        /// this device.
+        /// </summary>
+        /// <param name="mappings">The collection to add the mappings to.</param>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <remarks>
+        /// The caller must run this method under a snapshot transaction so
+        /// each distribution page is read as last committed without waiting
+        /// on allocations in progress.
+        /// </remarks>
+        public async Task ExportCommittedPageMappingsAsync(ICollection<DistributionPageMapping> mappings)
+        {
+            var distPageIndices = new List<uint>();
+            foreach (var entry in _freeSpaceMaps)
+            {
+                if (entry.Value.IsInitialised)
+                {
+                    distPageIndices.Add(entry.Key);
+                }
+            }
+            distPageIndices.Sort();
+
+            foreach (var distPageIndex in distPageIndices)
+            {
+                using (var distPage = new DistributionPage())
+                {
+                    // The page is not attached to the shared free space map
+                    //	so reading an older committed image leaves it untouched
+                    HookupPageSite(distPage);
+                    var physicalId = ((distPageIndex * (DistributionPage.PageTrackingCount + 1)) + DistributionPageOffset);
+                    distPage.VirtualPageId = new VirtualPageId(DeviceId, physicalId);
+                    await FileGroupDevice
+                        .LoadDataPageAsync(new LoadDataPageParameters(distPage))
+                        .ConfigureAwait(false);
+
+                    mappings.Add(new DistributionPageMapping(
+                        distPage.VirtualPageId, distPage.Timestamp, distPage.GetPageMappings()));
+                }
             }
         }
 
@@ -340,6 +432,7 @@ namespace Zen.Trunk.Storage.Data
                 {
                     // Create contained init request
                     HookupPageSite(page);
+                    AttachFreeSpaceMap(page, distributionPageIndex);
 
                     // Determine the virtual id for the page
                     var physicalId = ((distributionPageIndex * (DistributionPage.PageTrackingCount + 1)) +
@@ -381,6 +474,7 @@ namespace Zen.Trunk.Storage.Data
                 {
                     // Create contained load request
                     HookupPageSite(page);
+                    AttachFreeSpaceMap(page, distributionPageIndex);
 
                     // Determine the virtual id for the page
                     var physicalId = ((distributionPageIndex * (DistributionPage.PageTrackingCount + 1)) + DistributionPageOffset);
@@ -406,6 +500,15 @@ namespace Zen.Trunk.Storage.Data
             }
         }
 
+        private void AttachFreeSpaceMap(IDistributionPage page, uint distributionPageIndex)
+        {
+            if (page is DistributionPage distributionPage)
+            {
+                distributionPage.FreeSpaceMap = _freeSpaceMaps.GetOrAdd(
+                    distributionPageIndex, index => new ExtentFreeSpaceMap());
+            }
+        }
+
         private async Task LoadDistributionPageAndImport(uint distPageIndex, IDistributionPage page)
         {
             await LoadDistributionPage(page, distPageIndex).ConfigureAwait(false);
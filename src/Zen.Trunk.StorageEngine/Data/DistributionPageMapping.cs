@@ -0,0 +1,57 @@
+using System.Collections.Generic;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage.Data
+{
+    /// <summary>
+    /// <c>DistributionPageMapping</c> holds the logical to virtual page
+    /// mappings tracked by a single distribution page together with the
+    /// timestamp of the page image they were read from.
+    /// </summary>
+    public sealed class DistributionPageMapping
+    {
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="DistributionPageMapping"/> class.
+        /// </summary>
+        /// <param name="distributionPageId">The distribution page identifier.</param>
+        /// <param name="timestamp">The distribution page timestamp.</param>
+        /// <param name="lookups">The logical to virtual page mappings.</param>
+        public DistributionPageMapping(
+            VirtualPageId distributionPageId,
+            long timestamp,
+            IList<KeyValuePair<LogicalPageId, VirtualPageId>> lookups)
+        {
+            DistributionPageId = distributionPageId;
+            Timestamp = timestamp;
+            Lookups = lookups;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the distribution page identifier.
+        /// </summary>
+        /// <value>
+        /// The distribution page identifier.
+        /// </value>
+        public VirtualPageId DistributionPageId { get; }
+
+        /// <summary>
+        /// Gets the timestamp of the distribution page.
+        /// </summary>
+        /// <value>
+        /// The timestamp.
+        /// </value>
+        public long Timestamp { get; }
+
+        /// <summary>
+        /// Gets the logical to virtual page mappings.
+        /// </summary>
+        /// <value>
+        /// The lookups.
+        /// </value>
+        public IList<KeyValuePair<LogicalPageId, VirtualPageId>> Lookups { get; }
+        #endregion
+    }
+}
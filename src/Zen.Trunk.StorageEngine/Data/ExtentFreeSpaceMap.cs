@@ -0,0 +1,277 @@
+using System;
+
+namespace Zen.Trunk.Storage.Data
+{
+    /// <summary>
+    /// <c>ExtentFreeSpaceMap</c> summarises the free space tracked by a
+    /// single distribution page so that allocators can go directly to a
+    /// candidate extent.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The map holds one bit per extent in each of three bitmaps: free
+    /// extents, mixed extents with space and object extents with space
+    /// together with the owner and free page count of every extent.
+    /// </para>
+    /// <para>
+    /// The map is a hint; it is refreshed whenever the distribution page is
+    /// read and updated whenever an extent is examined under lock. Callers
+    /// must always re-validate a candidate extent after locking it.
+    /// </para>
+    /// </remarks>
+    internal sealed class ExtentFreeSpaceMap
+    {
+        #region Private Fields
+        private readonly object _sync = new object();
+        private readonly ObjectId[] _owners = new ObjectId[DistributionPage.ExtentTrackingCount];
+        private readonly byte[] _freePageCounts = new byte[DistributionPage.ExtentTrackingCount];
+        private ulong _freeExtents;
+        private ulong _mixedExtents;
+        private ulong _ownedExtents;
+        private bool _isInitialised;
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets a value indicating whether this map has been populated from
+        /// a distribution page.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if this instance is initialised; otherwise, <c>false</c>.
+        /// </value>
+        public bool IsInitialised
+        {
+            get
+            {
+                lock (_sync)
+                {
+                    return _isInitialised;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of free extents.
+        /// </summary>
+        /// <value>
+        /// The free extent count.
+        /// </value>
+        public int FreeExtentCount
+        {
+            get
+            {
+                lock (_sync)
+                {
+                    return CountBits(_freeExtents);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of unallocated pages in usable extents.
+        /// </summary>
+        /// <value>
+        /// The free page count.
+        /// </value>
+        public int FreePageCount
+        {
+            get
+            {
+                lock (_sync)
+                {
+                    var count = 0;
+                    foreach (var freePages in _freePageCounts)
+                    {
+                        count += freePages;
+                    }
+                    return count;
+                }
+            }
+        }
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Updates the entry for a single extent.
+        /// </summary>
+        /// <param name="extentIndex">Index of the extent.</param>
+        /// <param name="info">The extent information.</param>
+        public void Update(uint extentIndex, DistributionPage.ExtentInfo info)
+        {
+            lock (_sync)
+            {
+                UpdateExtent(extentIndex, info);
+            }
+        }
+
+        /// <summary>
+        /// Rebuilds the map from the specified extent information.
+        /// </summary>
+        /// <param name="extents">The extent information.</param>
+        public void Refresh(DistributionPage.ExtentInfo[] extents)
+        {
+            lock (_sync)
+            {
+                for (uint index = 0; index < extents.Length; ++index)
+                {
+                    UpdateExtent(index, extents[index]);
+                }
+                _isInitialised = true;
+            }
+        }
+
+        /// <summary>
+        /// Gets the extents that already belong to the allocating object (or
+        /// are mixed extents when allocating mixed pages) and have space.
+        /// </summary>
+        /// <param name="allocParams">The allocation parameters.</param>
+        /// <returns>A bitmap with one bit set per candidate extent.</returns>
+        public ulong GetExistingExtentCandidates(AllocateDataPageParameters allocParams)
+        {
+            lock (_sync)
+            {
+                if (allocParams.MixedExtent)
+                {
+                    return _mixedExtents;
+                }
+
+                var candidates = 0UL;
+                var owned = _ownedExtents;
+                while (owned != 0)
+                {
+                    var index = GetLowestBit(owned);
+                    owned &= owned - 1;
+                    if (_owners[index] == allocParams.ObjectId)
+                    {
+                        candidates |= 1UL << index;
+                    }
+                }
+                return candidates;
+            }
+        }
+
+        /// <summary>
+        /// Gets the extents that are free.
+        /// </summary>
+        /// <returns>A bitmap with one bit set per free extent.</returns>
+        public ulong GetFreeExtentCandidates()
+        {
+            lock (_sync)
+            {
+                return _freeExtents;
+            }
+        }
+
+        /// <summary>
+        /// Determines whether the distribution page may be able to satisfy
+        /// the specified allocation.
+        /// </summary>
+        /// <param name="allocParams">The allocation parameters.</param>
+        /// <returns>
+        /// <c>true</c> if there is a candidate extent; otherwise, <c>false</c>.
+        /// </returns>
+        public bool HasCandidate(AllocateDataPageParameters allocParams)
+        {
+            return GetFreeExtentCandidates() != 0 ||
+                GetExistingExtentCandidates(allocParams) != 0;
+        }
+
+        /// <summary>
+        /// Gets the index of the lowest bit set in the specified bitmap.
+        /// </summary>
+        /// <param name="bitmap">The bitmap; must be non-zero.</param>
+        /// <returns>The zero-based bit index.</returns>
+        public static uint GetLowestBit(ulong bitmap)
+        {
+            if (bitmap == 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(bitmap));
+            }
+
+            uint index = 0;
+            if ((bitmap & 0xFFFFFFFFUL) == 0)
+            {
+                index += 32;
+                bitmap >>= 32;
+            }
+            if ((bitmap & 0xFFFFUL) == 0)
+            {
+                index += 16;
+                bitmap >>= 16;
+            }
+            if ((bitmap & 0xFFUL) == 0)
+            {
+                index += 8;
+                bitmap >>= 8;
+            }
+            if ((bitmap & 0xFUL) == 0)
+            {
+                index += 4;
+                bitmap >>= 4;
+            }
+            if ((bitmap & 0x3UL) == 0)
+            {
+                index += 2;
+                bitmap >>= 2;
+            }
+            if ((bitmap & 0x1UL) == 0)
+            {
+                index += 1;
+            }
+            return index;
+        }
+        #endregion
+
+        #region Private Methods
+        private static int CountBits(ulong bitmap)
+        {
+            var count = 0;
+            while (bitmap != 0)
+            {
+                bitmap &= bitmap - 1;
+                ++count;
+            }
+            return count;
+        }
+
+        private void UpdateExtent(uint extentIndex, DistributionPage.ExtentInfo info)
+        {
+            var mask = 1UL << (int)extentIndex;
+            _freeExtents &= ~mask;
+            _mixedExtents &= ~mask;
+            _ownedExtents &= ~mask;
+            _owners[extentIndex] = ObjectId.Zero;
+            _freePageCounts[extentIndex] = 0;
+
+            if (!info.IsUsable || info.IsFull)
+            {
+                return;
+            }
+
+            byte freePages = 0;
+            foreach (var page in info.Pages)
+            {
+                if (!page.IsAllocated)
+                {
+                    ++freePages;
+                }
+            }
+            _freePageCounts[extentIndex] = freePages;
+
+            if (info.IsFree)
+            {
+                _freeExtents |= mask;
+            }
+            else if (info.IsMixedExtent)
+            {
+                _mixedExtents |= mask;
+            }
+            else
+            {
+                _ownedExtents |= mask;
+                _owners[extentIndex] = info.ObjectId;
+            }
+        }
+        #endregion
+    }
+}
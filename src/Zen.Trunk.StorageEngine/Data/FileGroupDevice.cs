@@ -1,13 +1,16 @@
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Threading;
 using System.Threading.Tasks;
 using System.Threading.Tasks.Dataflow;
 using Autofac;
 using NAudio.Wave;
 using Serilog;
 using Serilog.Context;
+using Zen.Trunk.Extensions;
 using Zen.Trunk.Storage.BufferFields;
 using Zen.Trunk.Storage.Configuration;
 using Zen.Trunk.Storage.Data.Audio;
@@ -172,6 +175,16 @@ namespace Zen.Trunk.Storage.Data
             #endregion
         }
 
+        private class CompactTableRequest : TransactionContextTaskRequest<CompactTableParameters, int>
+        {
+            #region Public Constructors
+            public CompactTableRequest(CompactTableParameters compactParams)
+                : base(compactParams)
+            {
+            }
+            #endregion
+        }
+
         private class InsertTableDataRequest : TransactionContextTaskRequest<InsertTableDataParameters, bool>
         {
             #region Public Constructors
@@ -197,6 +210,7 @@ namespace Zen.Trunk.Storage.Data
         private static readonly string PrimaryDeviceServiceName = "Primary";
         private static readonly string SecondaryDeviceServiceName = "Secondary";
         private static readonly ILogger Logger = Serilog.Log.ForContext<FileGroupDevice>();
+        private static readonly TimeSpan CompactionInterval = TimeSpan.FromSeconds(30);
 
         private DatabaseDevice _owner;
 
@@ -211,6 +225,15 @@ namespace Zen.Trunk.Storage.Data
 
         // Logical id mapping
         private ILogicalVirtualManager _logicalVirtual;
+        private readonly ProportionalFillStrategy _fillStrategy = new ProportionalFillStrategy();
+        private string _logicalPageMapPathName;
+        private LogicalPageMapFile _logicalPageMap;
+
+        // Heap tables waiting for background compaction
+        private readonly ConcurrentDictionary<ObjectId, bool> _compactionCandidates =
+            new ConcurrentDictionary<ObjectId, bool>();
+        private Timer _compactionTimer;
+        private int _isCompacting;
         #endregion
 
         #region Protected Constructors
@@ -316,6 +339,12 @@ namespace Zen.Trunk.Storage.Data
                 {
                     TaskScheduler = taskInterleave.ConcurrentScheduler
                 });
+            CompactTablePort = new TransactionContextActionBlock<CompactTableRequest, int>(
+                request => CompactTableHandlerAsync(request),
+                new ExecutionDataflowBlockOptions
+                {
+                    TaskScheduler = taskInterleave.ConcurrentScheduler
+                });
         }
         #endregion
 
@@ -408,6 +437,8 @@ namespace Zen.Trunk.Storage.Data
 
         private ITargetBlock<InsertTableDataRequest> InsertTableDataPort { get; }
 
+        private ITargetBlock<CompactTableRequest> CompactTablePort { get; }
+
         private DatabaseDevice Owner
         {
             get
@@ -562,6 +593,49 @@ namespace Zen.Trunk.Storage.Data
             return request.Task;
         }
 
+        /// <summary>
+        /// Writes the logical page map for this file-group so the next mount
+        /// can restore mappings without exporting every distribution page.
+        /// </summary>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <remarks>
+        /// This method is called by the database device during checkpoint
+        /// once all dirty pages have been flushed. Distribution pages are
+        /// read under a snapshot transaction so only committed mappings are
+        /// written, each alongside the timestamp of the image it came from.
+        /// </remarks>
+        public async Task SaveLogicalPageMapAsync()
+        {
+            if (_logicalPageMapPathName == null)
+            {
+                return;
+            }
+
+            var mappings = new List<DistributionPageMapping>();
+            using (TrunkTransactionContext.SwitchTransactionContext(null))
+            {
+                TrunkTransactionContext.BeginTransaction(
+                    LifetimeScope, System.Transactions.IsolationLevel.Snapshot, TimeSpan.FromMinutes(1));
+                try
+                {
+                    await _primaryDevice.ExportCommittedPageMappingsAsync(mappings).ConfigureAwait(false);
+                    foreach (var device in _devices.Values)
+                    {
+                        await device.ExportCommittedPageMappingsAsync(mappings).ConfigureAwait(false);
+                    }
+                }
+                finally
+                {
+                    await TrunkTransactionContext.CommitAsync().ConfigureAwait(false);
+                }
+            }
+
+            var pathName = _logicalPageMapPathName;
+            await Task.Run(() => LogicalPageMapFile.Save(pathName, mappings)).ConfigureAwait(false);
+        }
+
         /// <summary>
         /// Inserts the reference information asynchronous.
         /// </summary>
@@ -675,6 +749,37 @@ namespace Zen.Trunk.Storage.Data
             return request.Task;
         }
 
+        /// <summary>
+        /// Reclaims the empty and mostly empty data pages of the heap table
+        /// associated with the specific object-identifier.
+        /// </summary>
+        /// <param name="compactParams">The compact table parameters.</param>
+        /// <returns>The number of data pages reclaimed.</returns>
+        /// <exception cref="BufferDeviceShuttingDownException"></exception>
+        public Task<int> CompactTableAsync(CompactTableParameters compactParams)
+        {
+            var request = new CompactTableRequest(compactParams);
+            if (!CompactTablePort.Post(request))
+            {
+                throw new BufferDeviceShuttingDownException();
+            }
+            return request.Task;
+        }
+
+        /// <summary>
+        /// Queues the heap table associated with the specific object-identifier
+        /// for compaction by the background compaction job.
+        /// </summary>
+        /// <param name="objectId">The table object identifier.</param>
+        /// <remarks>
+        /// Each scheduled table is compacted in its own transaction the next
+        /// time the compaction job runs.
+        /// </remarks>
+        public void ScheduleTableCompaction(ObjectId objectId)
+        {
+            _compactionCandidates.TryAdd(objectId, true);
+        }
+
         /// <summary>
         /// Using the previous page as a marker, loads the next linked page or
         /// creates a new linked page if one does not currently exist.
@@ -739,6 +844,13 @@ namespace Zen.Trunk.Storage.Data
                         "Cannot mount without primary device.");
                 }
 
+                // Open the mappings recorded at the last checkpoint so only
+                //	distribution pages changed since need exporting
+                if (!IsCreate && _logicalPageMapPathName != null)
+                {
+                    _logicalPageMap = LogicalPageMapFile.Open(_logicalPageMapPathName);
+                }
+
                 await _primaryDevice.OpenAsync(IsCreate).ConfigureAwait(false);
             }
 
@@ -801,6 +913,17 @@ namespace Zen.Trunk.Storage.Data
                     }
                 }
             }
+
+            // Mount is complete so release the logical page map
+            _logicalPageMap?.Dispose();
+            _logicalPageMap = null;
+
+            // Start background compaction of heap tables
+            _compactionTimer = new Timer(
+                state => ((FileGroupDevice)state).OnCompactionTimer(),
+                this,
+                CompactionInterval,
+                CompactionInterval);
         }
 
         /// <summary>
@@ -841,6 +964,11 @@ namespace Zen.Trunk.Storage.Data
         {
             using (LogContext.PushProperty("Method", $"{nameof(FileGroupDevice)} => {nameof(OnCloseAsync)}"))
             {
+                // Tables still waiting for compaction are left as they are
+                _compactionTimer?.Dispose();
+                _compactionTimer = null;
+                _compactionCandidates.Clear();
+
                 // Close secondary distribution page devices
                 foreach (var device in _devices.Values)
                 {
@@ -869,6 +997,7 @@ namespace Zen.Trunk.Storage.Data
             builder.RegisterInstance(this).As<IFileGroupDevice>();
             builder.RegisterType<DatabaseAudioFactory>().As<IDatabaseAudioFactory>();
             builder.RegisterType<DatabaseTableFactory>().As<IDatabaseTableFactory>();
+            builder.RegisterType<TableFreeSpaceMapCache>().SingleInstance();
             builder.RegisterType<PrimaryDistributionPageDevice>()
                 .As<IDistributionPageDevice>()
                 .Named<IDistributionPageDevice>(PrimaryDeviceServiceName)
@@ -984,6 +1113,8 @@ namespace Zen.Trunk.Storage.Data
             if (priFileGroupDevice)
             {
                 _primaryDeviceId = deviceId;
+                _logicalPageMapPathName = Path.ChangeExtension(
+                    fullPathName, StorageConstants.LogicalPageMapFileExtension);
                 _primaryDevice = GetService<IDistributionPageDevice>(
                     PrimaryDeviceServiceName, new NamedParameter("deviceId", deviceId));
                 newDevice = _primaryDevice;
@@ -1122,7 +1253,10 @@ namespace Zen.Trunk.Storage.Data
                 }
 
                 // Map from logical page to virtual page
-                virtualPageId = await LogicalVirtualManager.GetVirtualAsync(logicalPage.LogicalPageId).ConfigureAwait(false);
+                if (!LogicalVirtualManager.TryGetVirtual(logicalPage.LogicalPageId, out virtualPageId))
+                {
+                    throw new ArgumentException("Logical page identifier not found.");
+                }
 
                 // Update the request page and update the virtual page identifier
                 request.Message.Page.VirtualPageId = virtualPageId;
@@ -1151,6 +1285,19 @@ namespace Zen.Trunk.Storage.Data
 
         private async Task<bool> ProcessDistributionPageHandlerAsync(ProcessDistributionPageRequest request)
         {
+            // Distribution pages unchanged since the logical page map was
+            //	written import the recorded mappings; pages changed since
+            //	ignore them and export the mappings they hold now
+            var logicalPageMap = _logicalPageMap;
+            if (logicalPageMap != null &&
+                logicalPageMap.IsCurrent(request.Message.VirtualPageId, request.Message.Timestamp))
+            {
+                await logicalPageMap
+                    .ImportToAsync(request.Message.VirtualPageId, LogicalVirtualManager)
+                    .ConfigureAwait(false);
+                return true;
+            }
+
             await request.Message.ExportPageMappingTo(LogicalVirtualManager).ConfigureAwait(false);
             return true;
         }
@@ -1315,9 +1462,12 @@ namespace Zen.Trunk.Storage.Data
             }
             else
             {
-                // Get device keys and perform randomisation
-                deviceIds = GetDistributionPageDeviceKeys();
-                deviceIds.Randomize();
+                // Order devices in proportion to their free space
+                deviceIds = _fillStrategy.OrderDevices(
+                    GetDistributionPageDeviceKeys()
+                        .Select(deviceId => new KeyValuePair<DeviceId, long>(
+                            deviceId, GetDistributionPageDevice(deviceId).FreePageCount))
+                        .ToList());
             }
 
             // Walk each device and attempt to allocate page
@@ -1328,15 +1478,17 @@ namespace Zen.Trunk.Storage.Data
                 try
                 {
                     // Attempt to allocate (may fail)
-                    return await pageDevice
+                    var virtualPageId = await pageDevice
                         .AllocateDataPageAsync(request.Message)
                         .ConfigureAwait(false);
+                    _fillStrategy.OnAllocated(deviceId);
+                    return virtualPageId;
                 }
                 catch
                 {
-                    // Failed either because full or busy
-                    //	no need to handle or log unless we want to keep
-                    //	statistics on dist page contention
+                    // Failed either because full or busy so make this
+                    //	device less likely to be chosen first next time
+                    _fillStrategy.OnFailed(deviceId);
                 }
             }
 
@@ -1363,6 +1515,9 @@ namespace Zen.Trunk.Storage.Data
             await distDevice
                 .DeallocateDataPageAsync(new DeallocateDataPageParameters(virtualPageId, LogicalPageId.Zero))
                 .ConfigureAwait(false);
+
+            // The virtual page may now be allocated to another logical page
+            await LogicalVirtualManager.RemoveLookupAsync(virtualPageId).ConfigureAwait(false);
             return true;
         }
 
@@ -1581,32 +1736,108 @@ namespace Zen.Trunk.Storage.Data
                     columnIdentifiers.Add(column.Id);
                 }
 
-                // Setup partial row reader
+                // Setup partial row reader and bulk load the rows
                 var streamReader = new TableRowReader(request.Message.RowData, columns);
-                var columnIds = columnIdentifiers.ToArray();
-                var rowData = new object[columnNames.Length];
-                while (true)
+                await table
+                    .AddRowsAsync(
+                        columnIdentifiers.ToArray(),
+                        ReadTableRows(streamReader, columns.Count))
+                    .ConfigureAwait(false);
+            }
+
+            return true;
+        }
+
+        private async Task<int> CompactTableHandlerAsync(CompactTableRequest request)
+        {
+            // Determine first logical page identifier for the table schema
+            var objRef = await Owner
+                .GetObjectReferenceAsync(
+                    new GetObjectReferenceParameters(
+                        request.Message.ObjectId,
+                        ObjectType.Table))
+                .ConfigureAwait(false);
+            var firstLogicalPageId = objRef.FirstLogicalPageId;
+
+            // Load table schema and reclaim pages
+            var tableFactory = GetService<IDatabaseTableFactory>();
+            using (var table = tableFactory.GetScopeForExistingTable(request.Message.ObjectId))
+            {
+                await table.LoadSchemaAsync(firstLogicalPageId).ConfigureAwait(false);
+                return await table.CompactAsync().ConfigureAwait(false);
+            }
+        }
+
+        private void OnCompactionTimer()
+        {
+            // Skip this tick if the previous pass is still running
+            if (Interlocked.CompareExchange(ref _isCompacting, 1, 0) != 0)
+            {
+                return;
+            }
+
+            CompactScheduledTablesAsync().ContinueWith(
+                task =>
                 {
-                    // Read row data from the stream reader
-                    try
-                    {
-                        streamReader.Read();
-                        for (var index = 0; index < columnNames.Length; ++index)
-                        {
-                            rowData[index] = streamReader[index];
-                        }
-                    }
-                    catch (EndOfStreamException)
-                    {
-                        break;
-                    }
+                    Interlocked.Exchange(ref _isCompacting, 0);
+                    return task.Exception;
+                },
+                TaskContinuationOptions.ExecuteSynchronously);
+        }
 
-                    // Add row to the table
-                    await table.AddRow(columnIds, rowData).ConfigureAwait(false);
+        private async Task CompactScheduledTablesAsync()
+        {
+            foreach (var objectId in _compactionCandidates.Keys)
+            {
+                if (DeviceState != MountableDeviceState.Open ||
+                    !_compactionCandidates.TryRemove(objectId, out _))
+                {
+                    continue;
+                }
+
+                Owner.BeginTransaction();
+                try
+                {
+                    await CompactTableAsync(new CompactTableParameters(objectId)).ConfigureAwait(false);
+                    await TrunkTransactionContext.CommitAsync().ConfigureAwait(false);
+                }
+                catch (Exception exception)
+                {
+                    // Compaction is only an optimisation; the table will be
+                    //	scheduled again by the next statement that frees space
+                    Logger.Warning(
+                        exception,
+                        "Failed to compact table {ObjectId} in file group {FileGroupId}",
+                        objectId,
+                        FileGroupId);
+                    await TrunkTransactionContext.RollbackAsync().ConfigureAwait(false);
                 }
             }
+        }
 
-            return true;
+        private static IEnumerable<object[]> ReadTableRows(TableRowReader streamReader, int columnCount)
+        {
+            // The same array is reused for every row as the table serializes
+            //  each row before asking for the next
+            var rowData = new object[columnCount];
+            while (true)
+            {
+                // Read row data from the stream reader
+                try
+                {
+                    streamReader.Read();
+                    for (var index = 0; index < columnCount; ++index)
+                    {
+                        rowData[index] = streamReader[index];
+                    }
+                }
+                catch (EndOfStreamException)
+                {
+                    break;
+                }
+
+                yield return rowData;
+            }
         }
 
         private async Task ExpandDeviceCoreAsync(DeviceId deviceId, IRootPage rootPage, uint growthPages)
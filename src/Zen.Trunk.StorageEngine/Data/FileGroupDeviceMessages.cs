@@ -541,6 +541,29 @@ namespace Zen.Trunk.Storage.Data
         public IList<TableColumnInfo> Columns { get; } = new List<TableColumnInfo>();
     }
 
+    /// <summary>
+    /// Parameters for reclaiming the empty data pages of a heap table.
+    /// </summary>
+    public class CompactTableParameters
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CompactTableParameters"/> class.
+        /// </summary>
+        /// <param name="objectId">The table object identifier.</param>
+        public CompactTableParameters(ObjectId objectId)
+        {
+            ObjectId = objectId;
+        }
+
+        /// <summary>
+        /// Gets the table object identifier.
+        /// </summary>
+        /// <value>
+        /// The object identifier.
+        /// </value>
+        public ObjectId ObjectId { get; }
+    }
+
     /// <summary>
     /// 
     /// </summary>
@@ -1,4 +1,5 @@
-﻿using System.Threading.Tasks;
+﻿using System.Collections.Generic;
+using System.Threading.Tasks;
 using Zen.Trunk.VirtualMemory;
 
 namespace Zen.Trunk.Storage.Data
@@ -13,6 +14,10 @@ namespace Zen.Trunk.Storage.Data
 
         bool IsPrimary { get; }
 
+        long FreePageCount { get; }
+
+        Task ExportCommittedPageMappingsAsync(ICollection<DistributionPageMapping> mappings);
+
         Task<VirtualPageId> AllocateDataPageAsync(AllocateDataPageParameters allocParams);
 
         Task DeallocateDataPageAsync(DeallocateDataPageParameters deallocParams);
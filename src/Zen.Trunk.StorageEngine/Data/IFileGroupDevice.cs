@@ -26,6 +26,8 @@ namespace Zen.Trunk.Storage.Data
 
         Task<VirtualPageId> AllocateDataPageAsync(AllocateDataPageParameters allocParams);
 
+        Task<int> CompactTableAsync(CompactTableParameters compactParams);
+
         Task CreateDistributionPagesAsync(DeviceId deviceId, uint startPhysicalId, uint endPhysicalId);
 
         IRootPage CreateRootPage();
@@ -47,5 +49,9 @@ namespace Zen.Trunk.Storage.Data
         Task ProcessDistributionPageAsync(IDistributionPage page);
 
         Task<bool> RemoveDataDeviceAsync(RemoveDataDeviceParameters deviceParams);
+
+        Task SaveLogicalPageMapAsync();
+
+        void ScheduleTableCompaction(ObjectId objectId);
     }
 }
\ No newline at end of file
@@ -91,6 +91,7 @@ namespace Zen.Trunk.Storage.Data.Index
 			if (IndexCount == 0)
 			{
 				IndexEntries.Add(link);
+				SetDirty();
 				return true;
 			}
 
@@ -132,6 +133,7 @@ namespace Zen.Trunk.Storage.Data.Index
 			{
 				throw new InvalidOperationException("Failed to add page link!");
 			}
+			SetDirty();
 
 			return updateParentPage;
 		}
@@ -210,7 +212,9 @@ namespace Zen.Trunk.Storage.Data.Index
 					{
 						_lastInternalLockWritable = true;
 					}
-					lockManager.LockRootIndex(ObjectId, IndexId, _lastInternalLockWritable, LockTimeout);
+					await lockManager
+						.LockRootIndexAsync(ObjectId, IndexId, _lastInternalLockWritable, LockTimeout)
+						.ConfigureAwait(false);
 					break;
 
 				case IndexType.Intermediate:
@@ -219,7 +223,9 @@ namespace Zen.Trunk.Storage.Data.Index
 					{
 						_lastInternalLockWritable = true;
 					}
-					lockManager.LockInternalIndex(ObjectId, IndexId, LogicalPageId, _lastInternalLockWritable, LockTimeout);
+					await lockManager
+						.LockInternalIndexAsync(ObjectId, IndexId, LogicalPageId, _lastInternalLockWritable, LockTimeout)
+						.ConfigureAwait(false);
 					break;
 
 				case IndexType.Leaf:
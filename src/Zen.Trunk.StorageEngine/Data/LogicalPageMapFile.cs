@@ -0,0 +1,234 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Threading.Tasks;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage.Data
+{
+    /// <summary>
+    /// <c>LogicalPageMapFile</c> persists the logical to virtual page mapping
+    /// of a file-group so it can be restored at mount time without walking
+    /// every distribution page.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The file is written at each checkpoint and holds, for every
+    /// distribution page, the timestamp of its committed image followed by
+    /// the mappings of the pages it tracks. The file is read through a
+    /// memory-mapped view when the file-group is opened.
+    /// </para>
+    /// <para>
+    /// Mappings are only imported for distribution pages whose timestamp
+    /// matches the one recorded in the file; pages changed since the
+    /// checkpoint that wrote the file are exported in full instead.
+    /// </para>
+    /// </remarks>
+    internal sealed class LogicalPageMapFile : IDisposable
+    {
+        #region Private Types
+        private struct PageEntry
+        {
+            public long Timestamp;
+            public long Offset;
+            public int Count;
+        }
+        #endregion
+
+        #region Private Fields
+        private const uint Signature = 0x4D50474C;
+        private const int Version = 2;
+        private const int HeaderSize = 12;
+        private const int PageHeaderSize = 20;
+        private const int LookupSize = 16;
+
+        private readonly MemoryMappedFile _file;
+        private readonly MemoryMappedViewAccessor _view;
+        private readonly Dictionary<VirtualPageId, PageEntry> _pages;
+        #endregion
+
+        #region Private Constructors
+        private LogicalPageMapFile(
+            MemoryMappedFile file,
+            MemoryMappedViewAccessor view,
+            Dictionary<VirtualPageId, PageEntry> pages)
+        {
+            _file = file;
+            _view = view;
+            _pages = pages;
+        }
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Opens the logical page map file with the specified path name.
+        /// </summary>
+        /// <param name="pathName">The path name.</param>
+        /// <returns>
+        /// A <see cref="LogicalPageMapFile"/> instance or <c>null</c> if the
+        /// file does not exist or is not valid.
+        /// </returns>
+        public static LogicalPageMapFile Open(string pathName)
+        {
+            var fileInfo = new FileInfo(pathName);
+            if (!fileInfo.Exists || fileInfo.Length < HeaderSize)
+            {
+                return null;
+            }
+
+            var file = MemoryMappedFile.CreateFromFile(
+                pathName, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+            MemoryMappedViewAccessor view = null;
+            try
+            {
+                view = file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+                if (view.ReadUInt32(0) != Signature || view.ReadInt32(4) != Version)
+                {
+                    return Discard(file, view);
+                }
+
+                var pageCount = view.ReadInt32(8);
+                if (pageCount < 0)
+                {
+                    return Discard(file, view);
+                }
+
+                var pages = new Dictionary<VirtualPageId, PageEntry>(pageCount);
+                long offset = HeaderSize;
+                for (var index = 0; index < pageCount; ++index)
+                {
+                    if (offset + PageHeaderSize > fileInfo.Length)
+                    {
+                        return Discard(file, view);
+                    }
+
+                    var entry = new PageEntry
+                    {
+                        Timestamp = view.ReadInt64(offset + 8),
+                        Offset = offset + PageHeaderSize,
+                        Count = view.ReadInt32(offset + 16)
+                    };
+                    if (entry.Count < 0 ||
+                        entry.Offset + ((long)entry.Count * LookupSize) > fileInfo.Length)
+                    {
+                        return Discard(file, view);
+                    }
+
+                    pages[new VirtualPageId(view.ReadUInt64(offset))] = entry;
+                    offset = entry.Offset + ((long)entry.Count * LookupSize);
+                }
+
+                return new LogicalPageMapFile(file, view, pages);
+            }
+            catch
+            {
+                Discard(file, view);
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Writes the specified distribution page mappings to the logical
+        /// page map file with the specified path name.
+        /// </summary>
+        /// <param name="pathName">The path name.</param>
+        /// <param name="pages">
+        /// The committed mappings of each distribution page.
+        /// </param>
+        /// <remarks>
+        /// The file is written to a temporary file and then moved into place
+        /// so a failed write leaves no map rather than a partial one.
+        /// </remarks>
+        public static void Save(string pathName, ICollection<DistributionPageMapping> pages)
+        {
+            var tempPathName = pathName + ".tmp";
+            using (var stream = new FileStream(
+                tempPathName, FileMode.Create, FileAccess.Write, FileShare.None, 65536))
+            {
+                using (var writer = new BinaryWriter(stream))
+                {
+                    writer.Write(Signature);
+                    writer.Write(Version);
+                    writer.Write(pages.Count);
+                    foreach (var page in pages)
+                    {
+                        writer.Write(page.DistributionPageId.Value);
+                        writer.Write(page.Timestamp);
+                        writer.Write(page.Lookups.Count);
+                        foreach (var lookup in page.Lookups)
+                        {
+                            writer.Write(lookup.Key.Value);
+                            writer.Write(lookup.Value.Value);
+                        }
+                    }
+                }
+            }
+
+            File.Delete(pathName);
+            File.Move(tempPathName, pathName);
+        }
+
+        /// <summary>
+        /// Determines whether the mappings recorded for the specified
+        /// distribution page are current.
+        /// </summary>
+        /// <param name="distributionPageId">The distribution page identifier.</param>
+        /// <param name="timestamp">The timestamp of the distribution page.</param>
+        /// <returns>
+        /// <c>true</c> if the distribution page has not changed since the map
+        /// was written; otherwise, <c>false</c>.
+        /// </returns>
+        public bool IsCurrent(VirtualPageId distributionPageId, long timestamp)
+        {
+            return _pages.TryGetValue(distributionPageId, out var entry) &&
+                entry.Timestamp == timestamp;
+        }
+
+        /// <summary>
+        /// Adds the mappings recorded for the specified distribution page to
+        /// the specified logical virtual manager.
+        /// </summary>
+        /// <param name="distributionPageId">The distribution page identifier.</param>
+        /// <param name="logicalVirtualManager">The logical virtual manager.</param>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        public async Task ImportToAsync(VirtualPageId distributionPageId, ILogicalVirtualManager logicalVirtualManager)
+        {
+            if (!_pages.TryGetValue(distributionPageId, out var entry))
+            {
+                return;
+            }
+
+            for (var index = 0; index < entry.Count; ++index)
+            {
+                var offset = entry.Offset + ((long)index * LookupSize);
+                await logicalVirtualManager
+                    .AddLookupAsync(
+                        new VirtualPageId(_view.ReadUInt64(offset + 8)),
+                        new LogicalPageId(_view.ReadUInt64(offset)))
+                    .ConfigureAwait(false);
+            }
+        }
+
+        /// <summary>
+        /// Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.
+        /// </summary>
+        public void Dispose()
+        {
+            _view.Dispose();
+            _file.Dispose();
+        }
+        #endregion
+
+        #region Private Methods
+        private static LogicalPageMapFile Discard(MemoryMappedFile file, MemoryMappedViewAccessor view)
+        {
+            view?.Dispose();
+            file.Dispose();
+            return null;
+        }
+        #endregion
+    }
+}
@@ -1,9 +1,10 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Linq;
 using System.Threading;
 using System.Threading.Tasks;
-using System.Threading.Tasks.Dataflow;
-using Zen.Trunk.Utils;
+using Zen.Trunk.Extensions;
 using Zen.Trunk.VirtualMemory;
 
 namespace Zen.Trunk.Storage.Data
@@ -11,189 +12,44 @@ namespace Zen.Trunk.Storage.Data
     /// <summary>
 	/// Implements the logical-virtual lookup service
 	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Logical page identifiers are allocated sequentially so the logical to
+	/// virtual mapping is held in fixed size segments indexed directly by the
+	/// logical page identifier. Lookups read the segment directory and slot
+	/// without taking any lock; additions are serialised by a latch and
+	/// publish new segments and slots with volatile writes.
+	/// </para>
+	/// <para>
+	/// Identifiers beyond the directory range and the virtual to logical
+	/// mapping are held in concurrent dictionaries.
+	/// </para>
+	/// </remarks>
 	public sealed class LogicalVirtualManager : ILogicalVirtualManager
     {
-		#region Private Types
-		private class GetNewLogicalRequest : TaskRequest<LogicalPageId>
-		{
-		}
-
-		private class AddLookupRequest : TaskRequest<bool>
-		{
-			public AddLookupRequest(VirtualPageId virtualPageId, LogicalPageId logicalPageId)
-			{
-				VirtualPageId = virtualPageId;
-				LogicalPageId = logicalPageId;
-			}
-
-			public VirtualPageId VirtualPageId
-			{
-				get;
-			}
-
-			public LogicalPageId LogicalPageId
-			{
-				get;
-			}
-		}
-
-		private class GetLogicalRequest : TaskRequest<LogicalPageId>
-		{
-			public GetLogicalRequest(VirtualPageId virtualPageId)
-			{
-				VirtualPageId = virtualPageId;
-			}
-
-			public VirtualPageId VirtualPageId { get; }
-		}
-
-		private class GetVirtualRequest : TaskRequest<VirtualPageId>
-		{
-			public GetVirtualRequest(LogicalPageId logicalPageId)
-			{
-				LogicalPageId = logicalPageId;
-			}
-
-			public LogicalPageId LogicalPageId { get; }
-		}
-		#endregion
-
 		#region Private Fields
-		private readonly CancellationTokenSource _shutdownToken;
-        private readonly ITargetBlock<GetNewLogicalRequest> _getNewLogicalPort;
-		private readonly ITargetBlock<AddLookupRequest> _addLookupPort;
-		private readonly ITargetBlock<GetLogicalRequest> _getLogicalPort;
-		private readonly ITargetBlock<GetVirtualRequest> _getVirtualPort;
+		private const int SegmentShift = 10;
+		private const int SegmentSize = 1 << SegmentShift;
+		private const int SegmentMask = SegmentSize - 1;
+		private const ulong MaxDirectLogicalPageId = (ulong)SegmentSize << 20;
 
-		private readonly Dictionary<LogicalPageId, VirtualPageId> _logicalToVirtual =
-			new Dictionary<LogicalPageId, VirtualPageId>(1024);
-		private readonly Dictionary<VirtualPageId, LogicalPageId> _virtualToLogical =
-			new Dictionary<VirtualPageId, LogicalPageId>(1024);
-		private ulong _nextLogicalPageId = 1;
+		private readonly object _addSync = new object();
+		private readonly ConcurrentDictionary<LogicalPageId, VirtualPageId> _overflowLogicalToVirtual =
+			new ConcurrentDictionary<LogicalPageId, VirtualPageId>();
+		private readonly ConcurrentDictionary<VirtualPageId, LogicalPageId> _virtualToLogical =
+			new ConcurrentDictionary<VirtualPageId, LogicalPageId>();
+		private long[][] _segments = new long[16][];
+		private long _lastLogicalPageId;
+		private bool _isDisposed;
 		#endregion
 
-		#region Public Constructors
-		/// <summary>
-		/// Initializes a new instance of the <see cref="LogicalVirtualManager"/> class.
-		/// </summary>
-		public LogicalVirtualManager()
-		{
-		    _shutdownToken = new CancellationTokenSource();
-			var taskInterleave = new ConcurrentExclusiveSchedulerPair();
-			_getNewLogicalPort = new ActionBlock<GetNewLogicalRequest>(
-				request =>
-				{
-					try
-					{
-                        // Get the next free logical page identifier
-						var nextLogicalPageId = _nextLogicalPageId;
-
-                        // Incremement the logical page identifier
-						_nextLogicalPageId++;
-
-                        // Complete the request
-						request.TrySetResult(new LogicalPageId(nextLogicalPageId));
-					}
-					catch (Exception e)
-					{
-						request.TrySetException(e);
-					}
-				},
-				new ExecutionDataflowBlockOptions
-				{
-					TaskScheduler = taskInterleave.ExclusiveScheduler,
-					MaxMessagesPerTask = 1,
-					MaxDegreeOfParallelism = 1,
-					CancellationToken = _shutdownToken.Token
-				});
-			_addLookupPort = new ActionBlock<AddLookupRequest>(
-				request =>
-				{
-					try
-					{
-                        // Sanity check this is a unique mapping
-						if (_virtualToLogical.ContainsKey(request.VirtualPageId) ||
-							_logicalToVirtual.ContainsKey(request.LogicalPageId))
-						{
-							throw new ArgumentException("Mapping already exists.");
-						}
-
-                        // Add mapping
-						_virtualToLogical.Add(request.VirtualPageId, request.LogicalPageId);
-						_logicalToVirtual.Add(request.LogicalPageId, request.VirtualPageId);
-
-                        // Update next free logical page identifier as necessary
-						_nextLogicalPageId = Math.Max(_nextLogicalPageId, 1 + request.LogicalPageId.Value);
-						request.TrySetResult(true);
-					}
-					catch (Exception e)
-					{
-						request.TrySetException(e);
-					}
-				},
-				new ExecutionDataflowBlockOptions
-				{
-					TaskScheduler = taskInterleave.ExclusiveScheduler,
-					MaxMessagesPerTask = 1,
-					MaxDegreeOfParallelism = 1,
-					CancellationToken = _shutdownToken.Token
-				});
-			_getLogicalPort = new ActionBlock<GetLogicalRequest>(
-				request =>
-				{
-					try
-					{
-                        if (!_virtualToLogical.TryGetValue(request.VirtualPageId, out LogicalPageId logicalId))
-						{
-							throw new ArgumentException("Virtual page identifier not found.");
-						}
-						request.TrySetResult(logicalId);
-					}
-					catch (Exception e)
-					{
-						request.TrySetException(e);
-					}
-				},
-				new ExecutionDataflowBlockOptions
-				{
-					TaskScheduler = taskInterleave.ConcurrentScheduler,
-					MaxMessagesPerTask = 4,
-					MaxDegreeOfParallelism = 4,
-					CancellationToken = _shutdownToken.Token
-				});
-			_getVirtualPort = new ActionBlock<GetVirtualRequest>(
-				request =>
-				{
-					try
-					{
-						if (!_logicalToVirtual.TryGetValue(request.LogicalPageId, out VirtualPageId pageId))
-						{
-							throw new ArgumentException("Logical page identifier not found.");
-						}
-						request.TrySetResult(pageId);
-					}
-					catch (Exception e)
-					{
-						request.TrySetException(e);
-					}
-				},
-				new ExecutionDataflowBlockOptions
-				{
-					TaskScheduler = taskInterleave.ConcurrentScheduler,
-					MaxMessagesPerTask = 4,
-					MaxDegreeOfParallelism = 4,
-					CancellationToken = _shutdownToken.Token
-				});
-		}
-        #endregion
-
         #region Public Methods
         /// <summary>
         /// Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.
         /// </summary>
         public void Dispose()
 		{
-			_shutdownToken.Cancel();
+			_isDisposed = true;
 		}
 
         /// <summary>
@@ -205,12 +61,8 @@ namespace Zen.Trunk.Storage.Data
         /// <exception cref="BufferDeviceShuttingDownException"></exception>
         public Task<LogicalPageId> GetNewLogicalPageIdAsync()
 		{
-			var request = new GetNewLogicalRequest();
-			if (!_getNewLogicalPort.Post(request))
-			{
-				throw new BufferDeviceShuttingDownException();
-			}
-			return request.Task;
+			CheckNotDisposed();
+			return Task.FromResult(new LogicalPageId((ulong)Interlocked.Increment(ref _lastLogicalPageId)));
 		}
 
         /// <summary>
@@ -224,12 +76,61 @@ namespace Zen.Trunk.Storage.Data
         /// <exception cref="BufferDeviceShuttingDownException"></exception>
         public Task AddLookupAsync(VirtualPageId virtualPageId, LogicalPageId logicalPageId)
 		{
-			var request = new AddLookupRequest(virtualPageId, logicalPageId);
-			if (!_addLookupPort.Post(request))
+			CheckNotDisposed();
+			try
 			{
-				throw new BufferDeviceShuttingDownException();
+				lock (_addSync)
+				{
+					// Sanity check this is a unique mapping
+					if (_virtualToLogical.ContainsKey(virtualPageId) ||
+						TryGetVirtual(logicalPageId, out _))
+					{
+						throw new ArgumentException("Mapping already exists.");
+					}
+
+					// Add mapping
+					_virtualToLogical.TryAdd(virtualPageId, logicalPageId);
+					SetVirtual(logicalPageId, virtualPageId);
+				}
+
+				// Update next free logical page identifier as necessary
+				UpdateLastLogicalPageId(logicalPageId);
+				return CompletedTask.Default;
+			}
+			catch (Exception e)
+			{
+				return Task.FromException(e);
+			}
+		}
+
+        /// <summary>
+        /// Removes the lookup for the specified virtual page id.
+        /// </summary>
+        /// <param name="virtualPageId">A <see cref="VirtualPageId" /> representing the virtual page identifier.</param>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <exception cref="BufferDeviceShuttingDownException"></exception>
+        public Task RemoveLookupAsync(VirtualPageId virtualPageId)
+		{
+			CheckNotDisposed();
+			try
+			{
+				lock (_addSync)
+				{
+					if (!_virtualToLogical.TryRemove(virtualPageId, out var logicalPageId))
+					{
+						throw new ArgumentException("Mapping not found.");
+					}
+
+					ClearVirtual(logicalPageId);
+				}
+				return CompletedTask.Default;
+			}
+			catch (Exception e)
+			{
+				return Task.FromException(e);
 			}
-			return request.Task;
 		}
 
         /// <summary>
@@ -242,12 +143,13 @@ namespace Zen.Trunk.Storage.Data
         /// <exception cref="BufferDeviceShuttingDownException"></exception>
         public Task<LogicalPageId> GetLogicalAsync(VirtualPageId virtualPageId)
 		{
-			var request = new GetLogicalRequest(virtualPageId);
-			if (!_getLogicalPort.Post(request))
+			CheckNotDisposed();
+			if (!TryGetLogical(virtualPageId, out var logicalPageId))
 			{
-				throw new BufferDeviceShuttingDownException();
+				return Task.FromException<LogicalPageId>(
+					new ArgumentException("Virtual page identifier not found."));
 			}
-			return request.Task;
+			return Task.FromResult(logicalPageId);
 		}
 
         /// <summary>
@@ -260,12 +162,163 @@ namespace Zen.Trunk.Storage.Data
         /// <exception cref="BufferDeviceShuttingDownException"></exception>
         public Task<VirtualPageId> GetVirtualAsync(LogicalPageId logicalPageId)
 		{
-			var request = new GetVirtualRequest(logicalPageId);
-			if (!_getVirtualPort.Post(request))
+			CheckNotDisposed();
+			if (!TryGetVirtual(logicalPageId, out var virtualPageId))
+			{
+				return Task.FromException<VirtualPageId>(
+					new ArgumentException("Logical page identifier not found."));
+			}
+			return Task.FromResult(virtualPageId);
+		}
+
+        /// <summary>
+        /// Attempts to get the logical page identifier that corresponds to
+        /// the specified virtual page id without waiting.
+        /// </summary>
+        /// <param name="virtualPageId">A <see cref="VirtualPageId" /> representing the virtual page identifier.</param>
+        /// <param name="logicalPageId">When this method returns <c>true</c>, the logical page identifier.</param>
+        /// <returns>
+        /// <c>true</c> if a mapping exists; otherwise, <c>false</c>.
+        /// </returns>
+        public bool TryGetLogical(VirtualPageId virtualPageId, out LogicalPageId logicalPageId)
+		{
+			return _virtualToLogical.TryGetValue(virtualPageId, out logicalPageId);
+		}
+
+        /// <summary>
+        /// Attempts to get the virtual page identifier that corresponds to
+        /// the specified logical id without waiting.
+        /// </summary>
+        /// <param name="logicalPageId">A <see cref="LogicalPageId" /> representing the logical page identifier.</param>
+        /// <param name="virtualPageId">When this method returns <c>true</c>, the virtual page identifier.</param>
+        /// <returns>
+        /// <c>true</c> if a mapping exists; otherwise, <c>false</c>.
+        /// </returns>
+        public bool TryGetVirtual(LogicalPageId logicalPageId, out VirtualPageId virtualPageId)
+		{
+			var value = logicalPageId.Value;
+			if (value >= MaxDirectLogicalPageId)
+			{
+				return _overflowLogicalToVirtual.TryGetValue(logicalPageId, out virtualPageId);
+			}
+
+			// Zero is never a valid virtual page so denotes an empty slot
+			var segments = Volatile.Read(ref _segments);
+			var segmentIndex = (int)(value >> SegmentShift);
+			var segment = segmentIndex < segments.Length ? Volatile.Read(ref segments[segmentIndex]) : null;
+			var slot = segment != null ? Volatile.Read(ref segment[(int)(value & SegmentMask)]) : 0;
+
+			virtualPageId = new VirtualPageId(slot);
+			return slot != 0;
+		}
+
+        /// <summary>
+        /// Gets a snapshot of all logical to virtual page mappings.
+        /// </summary>
+        /// <returns>
+        /// A list of mappings ordered by logical page identifier.
+        /// </returns>
+        public IList<KeyValuePair<LogicalPageId, VirtualPageId>> GetLookups()
+		{
+			var lookups = new List<KeyValuePair<LogicalPageId, VirtualPageId>>();
+			var segments = Volatile.Read(ref _segments);
+			for (var segmentIndex = 0; segmentIndex < segments.Length; ++segmentIndex)
+			{
+				var segment = Volatile.Read(ref segments[segmentIndex]);
+				if (segment == null)
+				{
+					continue;
+				}
+
+				for (var slotIndex = 0; slotIndex < SegmentSize; ++slotIndex)
+				{
+					var slot = Volatile.Read(ref segment[slotIndex]);
+					if (slot != 0)
+					{
+						lookups.Add(new KeyValuePair<LogicalPageId, VirtualPageId>(
+							new LogicalPageId(((ulong)segmentIndex << SegmentShift) | (ulong)slotIndex),
+							new VirtualPageId(slot)));
+					}
+				}
+			}
+
+			lookups.AddRange(_overflowLogicalToVirtual.OrderBy(entry => entry.Key.Value));
+			return lookups;
+		}
+		#endregion
+
+		#region Private Methods
+		private void CheckNotDisposed()
+		{
+			if (_isDisposed)
 			{
 				throw new BufferDeviceShuttingDownException();
 			}
-			return request.Task;
+		}
+
+		private void SetVirtual(LogicalPageId logicalPageId, VirtualPageId virtualPageId)
+		{
+			var value = logicalPageId.Value;
+			if (value >= MaxDirectLogicalPageId)
+			{
+				_overflowLogicalToVirtual.TryAdd(logicalPageId, virtualPageId);
+				return;
+			}
+
+			// Grow the directory by publishing a larger copy
+			var segmentIndex = (int)(value >> SegmentShift);
+			var segments = _segments;
+			if (segmentIndex >= segments.Length)
+			{
+				var newLength = segments.Length;
+				while (segmentIndex >= newLength)
+				{
+					newLength *= 2;
+				}
+
+				var newSegments = new long[newLength][];
+				Array.Copy(segments, newSegments, segments.Length);
+				Volatile.Write(ref _segments, newSegments);
+				segments = newSegments;
+			}
+
+			var segment = segments[segmentIndex];
+			if (segment == null)
+			{
+				segment = new long[SegmentSize];
+				Volatile.Write(ref segments[segmentIndex], segment);
+			}
+
+			Volatile.Write(ref segment[(int)(value & SegmentMask)], (long)virtualPageId.Value);
+		}
+
+		private void ClearVirtual(LogicalPageId logicalPageId)
+		{
+			var value = logicalPageId.Value;
+			if (value >= MaxDirectLogicalPageId)
+			{
+				_overflowLogicalToVirtual.TryRemove(logicalPageId, out _);
+				return;
+			}
+
+			// The slot exists since the mapping was added through it
+			var segment = _segments[(int)(value >> SegmentShift)];
+			Volatile.Write(ref segment[(int)(value & SegmentMask)], 0L);
+		}
+
+		private void UpdateLastLogicalPageId(LogicalPageId logicalPageId)
+		{
+			var value = (long)logicalPageId.Value;
+			var last = Interlocked.Read(ref _lastLogicalPageId);
+			while (value > last)
+			{
+				var original = Interlocked.CompareExchange(ref _lastLogicalPageId, value, last);
+				if (original == last)
+				{
+					break;
+				}
+				last = original;
+			}
 		}
 		#endregion
 	}
@@ -83,6 +83,11 @@ namespace Zen.Trunk.Storage.Data
             {
                 switch (TrunkTransactionContext.Current.IsolationLevel)
                 {
+                    case IsolationLevel.Snapshot:
+                        // Snapshot readers take no shared locks; they read
+                        //  the page version as of the transaction start
+                        _mustHoldLock = false;
+                        break;
                     case IsolationLevel.ReadCommitted:
                         if (PageLock == DataLockType.None)
                         {
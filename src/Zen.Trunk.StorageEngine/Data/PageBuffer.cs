@@ -465,6 +465,20 @@ namespace Zen.Trunk.Storage.Data
                 if (TrunkTransactionContext.Current is ITrunkTransactionPrivate privateContext)
                 {
                     await privateContext.WriteLogEntryAsync(entry).ConfigureAwait(false);
+
+                    // Retain the committed image we are about to replace so
+                    //  snapshot readers can still see it
+                    var versionStore = pageBufferInstance._versionStore;
+                    if (!pageBufferInstance.IsNew &&
+                        versionStore != null &&
+                        privateContext.CommitSequence != 0 &&
+                        versionStore.IsVersionRequired(privateContext.CommitSequence))
+                    {
+                        var version = pageBufferInstance._bufferDevice.BufferFactory.AllocateBuffer();
+                        pageBufferInstance._oldBuffer.CopyTo(version);
+                        versionStore.AddVersion(
+                            instance.PageId, version, privateContext.CommitSequence);
+                    }
                 }
 
                 // Update new/delete status bits
@@ -530,6 +544,7 @@ namespace Zen.Trunk.Storage.Data
         private int _refCount;
         private bool _isDisposed;
         private readonly IBufferDevice _bufferDevice;
+        private readonly PageVersionStore _versionStore;
         private IVirtualBuffer _oldBuffer;
         private IVirtualBuffer _newBuffer;
         private TransactionId _currentTransactionId;
@@ -542,8 +557,24 @@ namespace Zen.Trunk.Storage.Data
         /// </summary>
         /// <param name="bufferDevice">The buffer device.</param>
         public PageBuffer(IBufferDevice bufferDevice)
+            : this(bufferDevice, null)
+        {
+        }
+        #endregion
+
+        #region Internal Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PageBuffer" /> class.
+        /// </summary>
+        /// <param name="bufferDevice">The buffer device.</param>
+        /// <param name="versionStore">
+        /// The version store of the owning database or <c>null</c> if
+        /// superseded images are not retained.
+        /// </param>
+        internal PageBuffer(IBufferDevice bufferDevice, PageVersionStore versionStore)
         {
             _bufferDevice = bufferDevice;
+            _versionStore = versionStore;
             _newBuffer = _bufferDevice.BufferFactory.AllocateBuffer();
 
             // Set initial state
@@ -814,6 +845,7 @@ namespace Zen.Trunk.Storage.Data
             //  uncommitted read (aka dirty read)
             var transactionId = TransactionId.Zero;
             var isReadUncommittedTxn = false;
+            var snapshotSequence = -1L;
             if (TrunkTransactionContext.Current != null)
             {
                 transactionId = TrunkTransactionContext.Current.TransactionId;
@@ -822,6 +854,37 @@ namespace Zen.Trunk.Storage.Data
                     isReadUncommittedTxn = true;
                     writable = false;
                 }
+                else if (TrunkTransactionContext.Current is ITrunkTransactionPrivate privateContext)
+                {
+                    snapshotSequence = privateContext.SnapshotSequence;
+                }
+            }
+
+            // Snapshot readers that do not own the page see the committed
+            //  image as of the start of their transaction
+            if (snapshotSequence >= 0 && !writable && _currentTransactionId != transactionId)
+            {
+                var version = _versionStore?.GetVersion(PageId, snapshotSequence);
+                if (version != null)
+                {
+                    Logger.Debug($"GetBufferStream backed by version buffer {version.BufferId}");
+                    return version.GetBufferStream(offset, count, false);
+                }
+
+                if (_currentTransactionId == TransactionId.Zero)
+                {
+                    Logger.Debug($"GetBufferStream backed by new buffer {_newBuffer.BufferId}");
+                    return _newBuffer.GetBufferStream(offset, count, false);
+                }
+            }
+
+            // Snapshot writers must not overwrite a commit they cannot see
+            //  otherwise that commit would be silently lost
+            if (snapshotSequence >= 0 && writable && _currentTransactionId != transactionId &&
+                _versionStore != null && _versionStore.IsSupersededSince(PageId, snapshotSequence))
+            {
+                throw new PageUpdateConflictException(
+                    $"Page {PageId} has been updated by another transaction since the snapshot started.");
             }
 
             // When we don't have a current transaction or when the current
@@ -0,0 +1,315 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage.Data
+{
+    /// <summary>
+    /// <c>PageVersionStore</c> retains committed page images that have been
+    /// superseded so that snapshot transactions can read pages as they were
+    /// when the transaction started.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Every committing transaction is assigned a commit sequence number and
+    /// every snapshot transaction records the highest sequence number for
+    /// which all commits have completed. When a page is committed the image
+    /// it replaces is added to the store tagged with the sequence number of
+    /// the commit that superseded it.
+    /// </para>
+    /// <para>
+    /// Every commit is versioned from the moment it begins until it ends; a
+    /// snapshot may register while a commit is part way through writing its
+    /// pages and must still see the images that commit replaces.
+    /// </para>
+    /// <para>
+    /// A version is discarded once no active or future snapshot can start
+    /// before the commit that superseded it.
+    /// </para>
+    /// <para>
+    /// Each database device owns a separate store since page identifiers
+    /// are only unique within a database.
+    /// </para>
+    /// </remarks>
+    internal sealed class PageVersionStore
+    {
+        #region Private Types
+        private class PageVersion
+        {
+            public PageVersion(VirtualPageId pageId, IVirtualBuffer buffer, long supersededSequence)
+            {
+                PageId = pageId;
+                Buffer = buffer;
+                SupersededSequence = supersededSequence;
+            }
+
+            public VirtualPageId PageId { get; }
+
+            public IVirtualBuffer Buffer { get; }
+
+            public long SupersededSequence { get; }
+        }
+        #endregion
+
+        #region Private Fields
+        private readonly object _sync = new object();
+        private readonly Dictionary<VirtualPageId, List<PageVersion>> _versions =
+            new Dictionary<VirtualPageId, List<PageVersion>>();
+        private readonly SortedDictionary<long, List<PageVersion>> _versionsBySequence =
+            new SortedDictionary<long, List<PageVersion>>();
+        private readonly SortedSet<long> _pendingCommits = new SortedSet<long>();
+        private readonly SortedDictionary<long, int> _activeSnapshots = new SortedDictionary<long, int>();
+        private long _lastCommitSequence;
+        private int _versionCount;
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the number of page versions currently retained.
+        /// </summary>
+        /// <value>
+        /// The version count.
+        /// </value>
+        public int VersionCount
+        {
+            get
+            {
+                lock (_sync)
+                {
+                    return _versionCount;
+                }
+            }
+        }
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Registers a snapshot reader.
+        /// </summary>
+        /// <returns>
+        /// The snapshot sequence number; every commit with a sequence number
+        /// less than or equal to this value is visible to the reader.
+        /// </returns>
+        public long RegisterSnapshot()
+        {
+            lock (_sync)
+            {
+                // Commits still in progress must not become visible
+                //  part way through so the snapshot stops short of the earliest
+                var sequence = _pendingCommits.Count > 0
+                    ? _pendingCommits.Min - 1
+                    : _lastCommitSequence;
+
+                _activeSnapshots.TryGetValue(sequence, out var count);
+                _activeSnapshots[sequence] = count + 1;
+                return sequence;
+            }
+        }
+
+        /// <summary>
+        /// Releases a snapshot reader previously registered via
+        /// <see cref="RegisterSnapshot"/>.
+        /// </summary>
+        /// <param name="snapshotSequence">The snapshot sequence.</param>
+        public void ReleaseSnapshot(long snapshotSequence)
+        {
+            lock (_sync)
+            {
+                if (!_activeSnapshots.TryGetValue(snapshotSequence, out var count))
+                {
+                    return;
+                }
+
+                if (count > 1)
+                {
+                    _activeSnapshots[snapshotSequence] = count - 1;
+                }
+                else
+                {
+                    _activeSnapshots.Remove(snapshotSequence);
+                }
+
+                PruneVersions();
+            }
+        }
+
+        /// <summary>
+        /// Allocates the sequence number for a committing transaction.
+        /// </summary>
+        /// <returns>The commit sequence number.</returns>
+        public long BeginCommit()
+        {
+            lock (_sync)
+            {
+                // Tracked even without an active snapshot since one may
+                //  register before this commit has written all its pages
+                var sequence = ++_lastCommitSequence;
+                _pendingCommits.Add(sequence);
+                return sequence;
+            }
+        }
+
+        /// <summary>
+        /// Determines whether pages written by the specified commit must
+        /// retain the image they replace.
+        /// </summary>
+        /// <param name="commitSequence">The commit sequence.</param>
+        /// <returns>
+        /// <c>true</c> if the commit is still in progress; otherwise
+        /// <c>false</c>.
+        /// </returns>
+        public bool IsVersionRequired(long commitSequence)
+        {
+            lock (_sync)
+            {
+                return _pendingCommits.Contains(commitSequence);
+            }
+        }
+
+        /// <summary>
+        /// Marks the commit with the specified sequence number as complete.
+        /// </summary>
+        /// <param name="commitSequence">The commit sequence.</param>
+        public void EndCommit(long commitSequence)
+        {
+            lock (_sync)
+            {
+                _pendingCommits.Remove(commitSequence);
+                PruneVersions();
+            }
+        }
+
+        /// <summary>
+        /// Adds a superseded page image to the store.
+        /// </summary>
+        /// <param name="pageId">The page identifier.</param>
+        /// <param name="buffer">
+        /// A copy of the committed image; ownership passes to the store.
+        /// </param>
+        /// <param name="commitSequence">
+        /// The sequence number of the commit that superseded the image.
+        /// </param>
+        public void AddVersion(VirtualPageId pageId, IVirtualBuffer buffer, long commitSequence)
+        {
+            lock (_sync)
+            {
+                if (!_versions.TryGetValue(pageId, out var versions))
+                {
+                    versions = new List<PageVersion>();
+                    _versions.Add(pageId, versions);
+                }
+
+                var version = new PageVersion(pageId, buffer, commitSequence);
+                versions.Add(version);
+
+                if (!_versionsBySequence.TryGetValue(commitSequence, out var superseded))
+                {
+                    superseded = new List<PageVersion>();
+                    _versionsBySequence.Add(commitSequence, superseded);
+                }
+
+                superseded.Add(version);
+                ++_versionCount;
+            }
+        }
+
+        /// <summary>
+        /// Gets the page image visible to a snapshot reader.
+        /// </summary>
+        /// <param name="pageId">The page identifier.</param>
+        /// <param name="snapshotSequence">The snapshot sequence.</param>
+        /// <returns>
+        /// The retained page image or <c>null</c> if the current committed
+        /// image is visible to the reader.
+        /// </returns>
+        public IVirtualBuffer GetVersion(VirtualPageId pageId, long snapshotSequence)
+        {
+            lock (_sync)
+            {
+                if (!_versions.TryGetValue(pageId, out var versions))
+                {
+                    return null;
+                }
+
+                // The visible image is the one replaced by the earliest
+                //  commit the reader cannot see
+                PageVersion match = null;
+                foreach (var version in versions)
+                {
+                    if (version.SupersededSequence > snapshotSequence &&
+                        (match == null || version.SupersededSequence < match.SupersededSequence))
+                    {
+                        match = version;
+                    }
+                }
+                return match?.Buffer;
+            }
+        }
+
+        /// <summary>
+        /// Determines whether the page has been committed since the specified
+        /// snapshot started.
+        /// </summary>
+        /// <param name="pageId">The page identifier.</param>
+        /// <param name="snapshotSequence">The snapshot sequence.</param>
+        /// <returns>
+        /// <c>true</c> if a commit the snapshot cannot see has replaced the
+        /// page; otherwise <c>false</c>.
+        /// </returns>
+        /// <remarks>
+        /// Versions superseded after a snapshot are kept until it is released
+        /// so the retained versions alone decide the question.
+        /// </remarks>
+        public bool IsSupersededSince(VirtualPageId pageId, long snapshotSequence)
+        {
+            return GetVersion(pageId, snapshotSequence) != null;
+        }
+        #endregion
+
+        #region Private Methods
+        private void PruneVersions()
+        {
+            if (_versionCount == 0)
+            {
+                return;
+            }
+
+            // Versions superseded at or below the low-water mark cannot be
+            //  needed by any active snapshot nor any snapshot started later
+            var lowWaterMark = _pendingCommits.Count > 0
+                ? _pendingCommits.Min - 1
+                : _lastCommitSequence;
+            if (_activeSnapshots.Count > 0)
+            {
+                lowWaterMark = Math.Min(lowWaterMark, _activeSnapshots.First().Key);
+            }
+
+            // Versions are ordered by superseding commit so we only visit
+            //  those we are about to discard
+            while (_versionsBySequence.Count > 0)
+            {
+                var oldest = _versionsBySequence.First();
+                if (oldest.Key > lowWaterMark)
+                {
+                    break;
+                }
+
+                _versionsBySequence.Remove(oldest.Key);
+                foreach (var version in oldest.Value)
+                {
+                    var versions = _versions[version.PageId];
+                    versions.Remove(version);
+                    if (versions.Count == 0)
+                    {
+                        _versions.Remove(version.PageId);
+                    }
+
+                    version.Buffer.Dispose();
+                    --_versionCount;
+                }
+            }
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,120 @@
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using Zen.Trunk.CoordinationDataStructures;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage.Data
+{
+    /// <summary>
+    /// <c>ProportionalFillStrategy</c> determines the order in which the
+    /// devices of a file-group are asked to allocate a page.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each device is weighted by its free page count divided by its recent
+    /// contention; the first device is chosen at random in proportion to
+    /// this weight so that devices fill at the same rate and allocations
+    /// are spread across all data files.
+    /// </para>
+    /// <para>
+    /// Contention is incremented whenever a device fails to allocate and is
+    /// halved whenever it succeeds so busy devices recover quickly.
+    /// Devices without free pages are placed last as they can only satisfy
+    /// a request by expanding.
+    /// </para>
+    /// </remarks>
+    internal sealed class ProportionalFillStrategy
+    {
+        #region Private Fields
+        private const int MaxContention = 64;
+
+        private readonly ConcurrentDictionary<DeviceId, int> _contention =
+            new ConcurrentDictionary<DeviceId, int>();
+        private readonly ThreadSafeRandom _random = new ThreadSafeRandom();
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Gets the recent contention recorded for a device.
+        /// </summary>
+        /// <param name="deviceId">The device identifier.</param>
+        /// <returns>The contention count.</returns>
+        public int GetContention(DeviceId deviceId)
+        {
+            _contention.TryGetValue(deviceId, out var contention);
+            return contention;
+        }
+
+        /// <summary>
+        /// Orders the specified devices for allocation.
+        /// </summary>
+        /// <param name="devices">
+        /// The candidate devices with the number of free pages on each.
+        /// </param>
+        /// <returns>The device identifiers in the order they should be tried.</returns>
+        public List<DeviceId> OrderDevices(IList<KeyValuePair<DeviceId, long>> devices)
+        {
+            var orderedDevices = new List<DeviceId>(devices.Count);
+            var weightedDevices = new List<KeyValuePair<DeviceId, double>>(devices.Count);
+            var totalWeight = 0.0;
+            foreach (var device in devices)
+            {
+                if (device.Value > 0)
+                {
+                    var weight = (double)device.Value / (1 + GetContention(device.Key));
+                    weightedDevices.Add(new KeyValuePair<DeviceId, double>(device.Key, weight));
+                    totalWeight += weight;
+                }
+            }
+
+            // Draw devices in proportion to their weight
+            while (weightedDevices.Count > 0)
+            {
+                var target = _random.NextDouble() * totalWeight;
+                var index = 0;
+                while (index < weightedDevices.Count - 1 && target >= weightedDevices[index].Value)
+                {
+                    target -= weightedDevices[index].Value;
+                    ++index;
+                }
+
+                orderedDevices.Add(weightedDevices[index].Key);
+                totalWeight -= weightedDevices[index].Value;
+                weightedDevices.RemoveAt(index);
+            }
+
+            // Full devices can only allocate by expanding
+            foreach (var device in devices)
+            {
+                if (device.Value <= 0)
+                {
+                    orderedDevices.Add(device.Key);
+                }
+            }
+            return orderedDevices;
+        }
+
+        /// <summary>
+        /// Records a successful allocation on a device.
+        /// </summary>
+        /// <param name="deviceId">The device identifier.</param>
+        public void OnAllocated(DeviceId deviceId)
+        {
+            if (GetContention(deviceId) > 0)
+            {
+                _contention.AddOrUpdate(deviceId, 0, (key, contention) => contention / 2);
+            }
+        }
+
+        /// <summary>
+        /// Records a failed allocation attempt on a device.
+        /// </summary>
+        /// <param name="deviceId">The device identifier.</param>
+        public void OnFailed(DeviceId deviceId)
+        {
+            _contention.AddOrUpdate(
+                deviceId, 1, (key, contention) => contention < MaxContention ? contention + 1 : contention);
+        }
+        #endregion
+    }
+}
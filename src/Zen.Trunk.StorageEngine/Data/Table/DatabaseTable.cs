@@ -2,7 +2,6 @@
 using System.Collections.Generic;
 using System.Collections.ObjectModel;
 using System.ComponentModel;
-using System.IO;
 using System.Linq;
 using System.Threading.Tasks;
 using Autofac;
@@ -381,9 +380,37 @@ namespace Zen.Trunk.Storage.Data.Table
             #endregion
         }
 
+        private class BulkLoadIndex
+        {
+            #region Public Constructors
+            public BulkLoadIndex(RootTableIndexInfo rootInfo, int[] ordinals)
+            {
+                RootInfo = rootInfo;
+                Ordinals = ordinals;
+                LeafEntries = new List<TableIndexLeafInfo>();
+            }
+            #endregion
+
+            #region Public Properties
+            public RootTableIndexInfo RootInfo { get; }
+
+            public int[] Ordinals { get; }
+
+            public List<TableIndexLeafInfo> LeafEntries { get; }
+
+            public bool IsClustered => (RootInfo.IndexSubType & TableIndexSubType.Clustered) != 0;
+            #endregion
+        }
+
         #endregion
 
         #region Private Fields
+        /// <summary>
+        /// Size of the buffer bulk loaded rows are serialized into before
+        /// being packed into data pages.
+        /// </summary>
+        private const int BulkLoadBlockSize = 65536;
+
         private readonly ILifetimeScope _lifetimeScope;
 
         private readonly List<TableSchemaPage> _schemaPages = new List<TableSchemaPage>();
@@ -391,10 +418,13 @@ namespace Zen.Trunk.Storage.Data.Table
         private bool _canUpdateSchema;
         private ColumnCollection _updatedColumns;
         private ReadOnlyCollection<TableColumnInfo> _columns;
+        private TableRowSerializer _rowSerializer;
         private ConstraintCollection _updatedConstraints;
         private ReadOnlyCollection<RowConstraint> _constraints;
         private InclusiveRange _rowSize;
         private ushort _rowsPerPage;
+        private TableFreeSpaceMap _freeSpaceMap;
+        private long _freeSpaceMapTimestamp;
         #endregion
 
         #region Public Constructors
@@ -639,6 +669,14 @@ namespace Zen.Trunk.Storage.Data.Table
 
         #region Internal Properties
         internal IDatabaseLockManager LockingManager => _lifetimeScope.Resolve<IDatabaseLockManager>();
+
+        internal TableIndexManager IndexManager => _lifetimeScope.Resolve<TableIndexManager>();
+        #endregion
+
+        #region Private Properties
+        private TableFreeSpaceMapCache FreeSpaceMapCache => _lifetimeScope.Resolve<TableFreeSpaceMapCache>();
+
+        private bool HasIndices => _lifetimeScope.Resolve<TableIndexManager>().Indices.Any();
         #endregion
 
         #region Public Methods
@@ -1008,6 +1046,9 @@ namespace Zen.Trunk.Storage.Data.Table
             // Swap column definition lists
             _columns = new ReadOnlyCollection<TableColumnInfo>(_updatedColumns);
             _updatedColumns = null;
+
+            // Compile row serializer for this schema version
+            _rowSerializer = TableRowSerializer.GetSerializer(_columns);
             _constraints = new ReadOnlyCollection<RowConstraint>(_updatedConstraints);
             _updatedConstraints = null;
             UpdateRowSize();
@@ -1029,11 +1070,20 @@ namespace Zen.Trunk.Storage.Data.Table
         {
             _rowSize.Min = 0;
             _rowSize.Max = 0;
+            var nullableCount = 0;
             foreach (var column in Columns)
             {
                 _rowSize.Min += column.MinDataSize;
                 _rowSize.Max += column.MaxDataSize;
+                if (column.Nullable)
+                {
+                    ++nullableCount;
+                }
             }
+
+            // Account for row null bitmap
+            _rowSize.Min += (nullableCount + 7) / 8;
+            _rowSize.Max += (nullableCount + 7) / 8;
             TableSchemaPage temp;
             if (_schemaPages.Count > 0)
             {
@@ -1094,6 +1144,10 @@ namespace Zen.Trunk.Storage.Data.Table
         /// <param name="columnIDs">The column i ds.</param>
         /// <param name="rowData">The row data.</param>
         /// <returns></returns>
+        /// <remarks>
+        /// A single row is added as a statement of one row so it shares the
+        /// insert and index maintenance path of <see cref="AddRowsAsync"/>.
+        /// </remarks>
         public async Task AddRow(uint[] columnIDs, object[] rowData)
         {
             // Sanity checks
@@ -1110,150 +1164,232 @@ namespace Zen.Trunk.Storage.Data.Table
                 throw new ArgumentException("Mismatch in array size between column identifier and row data.");
             }
 
-            // Setup buffer for building row data
-            var stream = new MemoryStream();
-            var rowWriter = new TableRowWriter(stream, _columns);
+            await AddRowsAsync(columnIDs, new[] { rowData }).ConfigureAwait(false);
+        }
 
-            // We need to build a full row
-            var columnIdList = columnIDs.ToList();
-            for (var columnIndex = 0; columnIndex < _columns.Count; ++columnIndex)
+        /// <summary>
+        /// Adds a batch of rows to the table.
+        /// </summary>
+        /// <param name="columnIDs">The column identifiers shared by every row.</param>
+        /// <param name="rows">
+        /// The row data. Each row is serialized before the next is requested
+        /// so the caller may reuse the same array for every row.
+        /// </param>
+        /// <returns>The number of rows added.</returns>
+        /// <remarks>
+        /// <para>
+        /// When the table is empty rows are serialized into a block and
+        /// appended to data pages as many at a time as will fit. The indices
+        /// are then built from the bottom up instead of inserting each row.
+        /// </para>
+        /// <para>
+        /// Otherwise each row is placed in turn; heap tables write to a page
+        /// with room found through the free space map before extending the
+        /// table and clustered tables insert at the position found through
+        /// the clustered index. Entries for the other indices are
+        /// applied in index order once every row of the batch is placed.
+        /// </para>
+        /// </remarks>
+        public async Task<int> AddRowsAsync(uint[] columnIDs, IEnumerable<object[]> rows)
+        {
+            // Sanity checks
+            if (columnIDs == null)
             {
-                var column = _columns[columnIndex];
-
-                // If this column is an auto-increment field
-                if (column.AutoIncrement)
-                {
-                    // If caller specified data, we must have identity insert
-                    //	switched on
-                    object incrValue;
-                    if (columnIDs.Any(item => item == column.Id))
-                    {
-                        if (!AllowIdentityInsert)
-                        {
-                            throw new ArgumentException("Identity insert is switched off");
-                        }
-
-                        // Get value from inputs
-                        var index = columnIdList.IndexOf(column.Id);
-                        incrValue = rowData[index];
-                    }
-                    else
-                    {
-                        // TODO: Determine increment value either by 
-                        //	interrogating a system table or by some other means
-                        // Will probably use an in-memory increment value tracker
-                        //	when table is saved we will take the current value
-                        //	and update the table...
-                        incrValue = 1;
-                    }
+                throw new ArgumentNullException(nameof(columnIDs));
+            }
+            if (rows == null)
+            {
+                throw new ArgumentNullException(nameof(rows));
+            }
 
-                    rowWriter[columnIndex] = incrValue;
-                    continue;
-                }
-                if (column.DataType == TableColumnDataType.Timestamp)
+            // Column positions are resolved once for the whole batch
+            var sourceOrdinals = GetSourceOrdinals(columnIDs);
+            var rowValues = rows.Select(
+                rowData =>
                 {
-                    // Caller cannot specify timestamp column data
-                    if (columnIDs.Any(item => item == column.Id))
+                    if (rowData.Length != columnIDs.Length)
                     {
-                        throw new ArgumentException("Cannot specify timestamp column data.");
+                        throw new ArgumentException("Mismatch in array size between column identifier and row data.");
                     }
+                    return BuildRowValues(sourceOrdinals, rowData);
+                });
 
-                    // Add timestamp data
-                    rowWriter[columnIndex] = (ulong)1;
-                    continue;
-                }
+            // Rows added to a table that already holds data are inserted
+            if (HasData)
+            {
+                return await InsertRowsAsync(rowValues).ConfigureAwait(false);
+            }
 
-                if (!columnIDs.Any(item => item == column.Id))
-                {
-                    // This column has not been specified, look for default
-                    object defaultValue = null;
-                    var constraint = _constraints.FirstOrDefault(
-                        item => item.ColumnId == column.Id &&
-                        item.ConstraintType == RowConstraintType.Default);
-                    if (constraint != null)
-                    {
-                        // TODO: Parse constraint data into appropriate object
-                        //	as specified by the column...
-                        defaultValue = constraint.ConstraintData;
-                    }
+            // Indices are built once the empty table has been loaded
+            var indices = _lifetimeScope
+                .Resolve<TableIndexManager>()
+                .Indices
+                .Select(rootInfo => new BulkLoadIndex(rootInfo, GetIndexOrdinals(rootInfo)))
+                .ToArray();
 
-                    // If no default found then column must allow nulls
-                    if (defaultValue == null && !column.Nullable)
-                    {
-                        throw new ArgumentException($"No data specified for column {column.Name} which does not allow nulls.");
-                    }
+            // Clustered tables must be written in clustered key order
+            if (!IsHeap)
+            {
+                var clusteredOrdinals = GetIndexOrdinals(ClusteredIndex);
+                rowValues = rowValues
+                    .OrderBy(values => CreateIndexInfo(ClusteredIndex, clusteredOrdinals, values))
+                    .ToList();
+            }
 
-                    // Add default to row data
-                    rowWriter[columnIndex] = defaultValue;
-                    continue;
-                }
+            // Extending the data page chain needs a schema modification lock
+            await SchemaRootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
 
-                // Get specified value for this column
-                var dataValue = rowData[columnIdList.IndexOf(column.Id)];
-                if (dataValue == null && !column.Nullable)
-                {
-                    throw new ArgumentException($"No data specified for column {column.Name} which does not allow nulls.");
-                }
+            // Heap data pages are tracked by the free space map as they fill
+            if (IsHeap)
+            {
+                await GetFreeSpaceMapAsync().ConfigureAwait(false);
+            }
 
-                // Apply check constraints
-                var checkConstraint = _constraints.FirstOrDefault(
-                    item => item.ColumnId == column.Id &&
-                        item.ConstraintType == RowConstraintType.Check);
-                if (checkConstraint != null)
+            var rowBlock = new byte[Math.Max(BulkLoadBlockSize, _rowSerializer.MaxRowSize)];
+            var rowLengths = new List<ushort>();
+            var blockRows = new List<object[]>();
+            var blockSize = 0;
+            var rowCount = 0;
+            TableDataPage currentPage = null;
+            foreach (var values in rowValues)
+            {
+                // Pack the current block into pages when this row won't fit
+                var rowSize = _rowSerializer.GetRowSize(values);
+                if (blockSize + rowSize > rowBlock.Length)
                 {
-                    // TODO: Execute the check constraint
-                    //checkConstraint.Ex
+                    currentPage = await WriteRowBlockAsync(currentPage, rowBlock, rowLengths, blockRows, indices).ConfigureAwait(false);
+                    rowLengths.Clear();
+                    blockRows.Clear();
+                    blockSize = 0;
                 }
 
-                rowWriter[columnIndex] = dataValue;
+                blockSize += _rowSerializer.Write(values, rowBlock, blockSize);
+                rowLengths.Add((ushort)rowSize);
+                blockRows.Add(values);
+                ++rowCount;
             }
+            if (rowLengths.Count > 0)
+            {
+                currentPage = await WriteRowBlockAsync(currentPage, rowBlock, rowLengths, blockRows, indices).ConfigureAwait(false);
+            }
+            currentPage?.Save();
+            await SaveFreeSpaceMapAsync(true).ConfigureAwait(false);
 
-            // Determine row size and write row to underlying stream
-            var rowSize = rowWriter.RowSize;
-            rowWriter.Write();
-            var rowBuffer = stream.GetBuffer();
-
-            // If we get this far we have the full row data and all constraints
-            //	have been executed.
+            // Build indices now all rows have been placed
+            var indexManager = _lifetimeScope.Resolve<TableIndexManager>();
+            foreach (var index in indices)
+            {
+                await indexManager
+                    .BuildIndexAsync(new BuildTableIndexParameters(index.RootInfo, index.LeafEntries))
+                    .ConfigureAwait(false);
+            }
+            return rowCount;
+        }
 
-            // If the table has no logical ids then create first data page
-            if (DataFirstLogicalPageId == LogicalPageId.Zero &&
-                DataLastLogicalPageId == LogicalPageId.Zero)
+        /// <summary>
+        /// Deletes every row held on the specified data page of a heap table.
+        /// </summary>
+        /// <param name="logicalPageId">The logical id of the data page.</param>
+        /// <returns>The number of rows deleted.</returns>
+        /// <remarks>
+        /// Index entries are not maintained so only heaps without indices
+        /// are supported. The page is left in the chain for compaction to
+        /// reclaim.
+        /// </remarks>
+        internal async Task<int> DeleteDataPageRowsAsync(LogicalPageId logicalPageId)
+        {
+            if (!IsHeap || HasIndices)
             {
-                // We need a schema modification lock at this point
-                var rootPage = (TableSchemaRootPage)_schemaPages[0];
-                await rootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
+                throw new NotSupportedException("Rows can only be deleted from heaps without indices.");
+            }
 
-                // Create first data page
-                var newPage = new TableDataPage();
-                newPage.FileGroupId = FileGroupId;
-                await newPage.SetObjectLockAsync(ObjectLockType.Exclusive).ConfigureAwait(false);
-                await FileGroupDevice
-                    .InitDataPageAsync(new InitDataPageParameters(newPage, true, true, true))
-                    .ConfigureAwait(false);
+            await GetFreeSpaceMapAsync().ConfigureAwait(false);
+            int rowCount;
+            using (var dataPage = await LoadDataPageAsync(logicalPageId).ConfigureAwait(false))
+            {
+                rowCount = (int)dataPage.RowCount;
+                for (var rowIndex = rowCount - 1; rowIndex >= 0; --rowIndex)
+                {
+                    dataPage.DeleteRow((ushort)rowIndex);
+                }
+            }
 
-                // Update schema
-                DataFirstLogicalPageId = DataLastLogicalPageId = newPage.LogicalPageId;
+            await SaveFreeSpaceMapAsync(false).ConfigureAwait(false);
+            return rowCount;
+        }
 
-                // Write first row
-                ushort rowIndex;
-                newPage.WriteRowIfSpace(0, rowBuffer, rowSize, out rowIndex);
+        /// <summary>
+        /// Reclaims data pages of a heap table that are empty or mostly
+        /// empty.
+        /// </summary>
+        /// <returns>The number of data pages reclaimed.</returns>
+        /// <remarks>
+        /// <para>
+        /// Candidates are taken from the free space map. When the table has
+        /// no indices the rows on a mostly empty page are moved to other
+        /// pages with room so the page can be released.
+        /// </para>
+        /// <para>
+        /// Index entries of a heap refer to rows by page and row index so
+        /// rows are never moved when the table has indices; only pages that
+        /// hold no rows are reclaimed.
+        /// </para>
+        /// </remarks>
+        public async Task<int> CompactAsync()
+        {
+            if (!IsHeap || !HasData)
+            {
+                return 0;
+            }
 
-                // TODO: Update indicies
+            var freeSpaceMap = await GetFreeSpaceMapAsync().ConfigureAwait(false);
+            var candidates = GetReclaimCandidates();
+            if (candidates.Count == 0)
+            {
+                return 0;
             }
-            else
+
+            // Unlinking data pages needs a schema modification lock
+            await SchemaRootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
+
+            // Candidates leave the map so rows are never moved onto a page
+            //	that is about to be reclaimed
+            foreach (var logicalPageId in candidates)
             {
-                // TODO: Check all unique indices to ensure this row is unique
+                freeSpaceMap.Remove(logicalPageId);
+            }
 
-                // If the table has a clustered index then do a clustered
-                //	insert via the index and copy the row data into the page
-                //	given in the index search result
+            var canMoveRows = !HasIndices;
+            var rowBuffer = new byte[Math.Max(_rowSerializer.MaxRowSize, TableDataPage.MinRowBytes)];
+            var pagesReclaimed = 0;
+            foreach (var logicalPageId in candidates)
+            {
+                var dataPage = await LoadDataPageAsync(logicalPageId).ConfigureAwait(false);
+                dataPage.FreeSpaceMap = null;
+                try
+                {
+                    if (canMoveRows && dataPage.RowCount > 0)
+                    {
+                        await MoveRowsToMappedPagesAsync(dataPage, rowBuffer).ConfigureAwait(false);
+                    }
 
-                // If the table has no clustered index we need to add data to the
-                //	last page defined for the table
+                    if (dataPage.RowCount > 0)
+                    {
+                        freeSpaceMap.Update(dataPage);
+                        continue;
+                    }
 
-                // In all cases update all other indices
+                    await ReclaimDataPageAsync(dataPage).ConfigureAwait(false);
+                    ++pagesReclaimed;
+                }
+                finally
+                {
+                    dataPage.Dispose();
+                }
             }
+
+            await SaveFreeSpaceMapAsync(false).ConfigureAwait(false);
+            return pagesReclaimed;
         }
 
         /// <summary>
@@ -1302,11 +1438,13 @@ namespace Zen.Trunk.Storage.Data.Table
                 var indexManager = _lifetimeScope.Resolve<TableIndexManager>();
                 foreach (var rootIndexInfo in page.Indices)
                 {
+                    // Indices are always created in the table file-group
+                    rootIndexInfo.IndexFileGroupId = FileGroupId;
                     indexManager.AddIndexInfo(rootIndexInfo);
                 }
 
                 // Look for clustered index
-                var clusteredIndex = page.Indices.FirstOrDefault(item => item.IndexSubType == TableIndexSubType.Clustered);
+                var clusteredIndex = page.Indices.FirstOrDefault(item => (item.IndexSubType & TableIndexSubType.Clustered) != 0);
                 if (clusteredIndex != null)
                 {
                     if (IsHeap)
@@ -1321,6 +1459,40 @@ namespace Zen.Trunk.Storage.Data.Table
                 }
             }
         }
+
+        /// <summary>
+        /// Records the root page of the specified index in the table schema.
+        /// </summary>
+        /// <param name="rootInfo">The root index information.</param>
+        /// <returns></returns>
+        /// <remarks>
+        /// The schema page is saved in the current transaction so the new
+        /// root is only persisted when the change to the index commits.
+        /// </remarks>
+        internal async Task UpdateIndexRootAsync(RootTableIndexInfo rootInfo)
+        {
+            var schemaPage = _schemaPages.FirstOrDefault(page => page.Indices.Contains(rootInfo));
+            if (schemaPage == null)
+            {
+                // Index is not in the schema yet so add it to the last page
+                //  (chaining a new schema page if that one is full)
+                schemaPage = _schemaPages[_schemaPages.Count - 1];
+                try
+                {
+                    schemaPage.Indices.Add(rootInfo);
+                }
+                catch (PageException)
+                {
+                    schemaPage = await InitSchemaPageAndLinkAsync(schemaPage).ConfigureAwait(false);
+                    _schemaPages.Add(schemaPage);
+                    SchemaLastLogicalPageId = schemaPage.LogicalPageId;
+                    schemaPage.Indices.Add(rootInfo);
+                }
+            }
+
+            schemaPage.SetDataDirty();
+            schemaPage.Save();
+        }
         #endregion
 
         #region Protected Methods
@@ -1339,6 +1511,740 @@ namespace Zen.Trunk.Storage.Data.Table
         #endregion
 
         #region Private Methods
+        private async Task<TableDataPage> WriteRowBlockAsync(
+            TableDataPage currentPage, byte[] rowBlock, List<ushort> rowLengths,
+            List<object[]> blockRows, BulkLoadIndex[] indices)
+        {
+            // Start with the last page of the table
+            if (currentPage == null)
+            {
+                currentPage = DataLastLogicalPageId == LogicalPageId.Zero
+                    ? await InitDataPageAndLinkAsync(null).ConfigureAwait(false)
+                    : await LoadDataPageAsync(DataLastLogicalPageId).ConfigureAwait(false);
+            }
+
+            var clusteredOrdinals = IsHeap ? null : GetIndexOrdinals(ClusteredIndex);
+            var firstRow = 0;
+            var blockOffset = 0;
+            while (firstRow < rowLengths.Count)
+            {
+                // Fill the current page then chain a new page after it
+                var rowsWritten = currentPage.AppendRowBlock(rowBlock, blockOffset, rowLengths, firstRow);
+                if (rowsWritten == 0)
+                {
+                    if (currentPage.RowCount == 0)
+                    {
+                        throw new InvalidOperationException("Row too large for an empty data page.");
+                    }
+
+                    currentPage = await InitDataPageAndLinkAsync(currentPage).ConfigureAwait(false);
+                    continue;
+                }
+
+                // Record index entries for the rows placed on this page
+                var firstRowId = (ushort)(currentPage.RowCount - rowsWritten);
+                foreach (var index in indices)
+                {
+                    if (index.IsClustered)
+                    {
+                        // Clustered leaf entries refer to whole data pages
+                        if (firstRowId == 0)
+                        {
+                            index.LeafEntries.Add(
+                                new TableIndexClusteredLeafInfo(
+                                    GetIndexKeys(index.Ordinals, blockRows[firstRow]),
+                                    currentPage.LogicalPageId));
+                        }
+                        continue;
+                    }
+
+                    for (var rowIndex = 0; rowIndex < rowsWritten; ++rowIndex)
+                    {
+                        var values = blockRows[firstRow + rowIndex];
+                        var keys = GetIndexKeys(index.Ordinals, values);
+                        if (IsHeap)
+                        {
+                            index.LeafEntries.Add(
+                                new TableIndexNormalLeafInfo(
+                                    keys, currentPage.LogicalPageId, (ushort)(firstRowId + rowIndex)));
+                        }
+                        else
+                        {
+                            index.LeafEntries.Add(
+                                new TableIndexNormalOverClusteredLeafInfo(
+                                    keys, GetIndexKeys(clusteredOrdinals, values)));
+                        }
+                    }
+                }
+
+                for (var rowIndex = 0; rowIndex < rowsWritten; ++rowIndex)
+                {
+                    blockOffset += rowLengths[firstRow + rowIndex];
+                }
+                firstRow += rowsWritten;
+            }
+
+            return currentPage;
+        }
+
+        private async Task<int> InsertRowsAsync(IEnumerable<object[]> rowValues)
+        {
+            var indexManager = _lifetimeScope.Resolve<TableIndexManager>();
+            var clusteredOrdinals = IsHeap ? null : GetIndexOrdinals(ClusteredIndex);
+            var indices = indexManager
+                .Indices
+                .Where(rootInfo => (rootInfo.IndexSubType & TableIndexSubType.Clustered) == 0)
+                .Select(rootInfo => new BulkLoadIndex(rootInfo, GetIndexOrdinals(rootInfo)))
+                .ToArray();
+
+            if (IsHeap)
+            {
+                await GetFreeSpaceMapAsync().ConfigureAwait(false);
+            }
+
+            var rowBuffer = new byte[_rowSerializer.MaxRowSize];
+            var rowCount = 0;
+            TableDataPage lastPage = null;
+            try
+            {
+                foreach (var values in rowValues)
+                {
+                    var rowSize = (ushort)_rowSerializer.Write(values, rowBuffer, 0);
+                    if (IsHeap)
+                    {
+                        lastPage = await AppendHeapRowAsync(lastPage, rowBuffer, rowSize).ConfigureAwait(false);
+                    }
+                    else
+                    {
+                        await InsertClusteredRowAsync(indexManager, clusteredOrdinals, values, rowBuffer, rowSize)
+                            .ConfigureAwait(false);
+                    }
+
+                    // Index entries are held back until the batch is placed
+                    foreach (var index in indices)
+                    {
+                        var keys = GetIndexKeys(index.Ordinals, values);
+                        if (IsHeap)
+                        {
+                            index.LeafEntries.Add(
+                                new TableIndexNormalLeafInfo(
+                                    keys, lastPage.LogicalPageId, (ushort)(lastPage.RowCount - 1)));
+                        }
+                        else
+                        {
+                            index.LeafEntries.Add(
+                                new TableIndexNormalOverClusteredLeafInfo(
+                                    keys, GetIndexKeys(clusteredOrdinals, values)));
+                        }
+                    }
+                    ++rowCount;
+                }
+            }
+            finally
+            {
+                lastPage?.Dispose();
+            }
+            await SaveFreeSpaceMapAsync(true).ConfigureAwait(false);
+
+            foreach (var index in indices)
+            {
+                await InsertIndexEntriesAsync(indexManager, index).ConfigureAwait(false);
+            }
+            return rowCount;
+        }
+
+        private async Task<TableDataPage> AppendHeapRowAsync(TableDataPage lastPage, byte[] rowBuffer, ushort rowSize)
+        {
+            // The page last written stays loaded for the rest of the batch so
+            //	its free space is tracked without reloading it for every row
+            var page = await WriteRowToMappedPageAsync(lastPage, rowBuffer, rowSize).ConfigureAwait(false);
+            if (page != null)
+            {
+                return page;
+            }
+
+            // Pages written before the table had a free space map are not
+            //	tracked so the last page may still have room
+            var tailPage = lastPage;
+            if (tailPage?.LogicalPageId != DataLastLogicalPageId)
+            {
+                tailPage = await LoadDataPageAsync(DataLastLogicalPageId).ConfigureAwait(false);
+                if (tailPage.WriteRowIfSpace(ushort.MaxValue, rowBuffer, rowSize, out _))
+                {
+                    lastPage?.Dispose();
+                    return tailPage;
+                }
+            }
+
+            // Extending the data page chain needs a schema modification lock
+            TableDataPage newPage;
+            try
+            {
+                await SchemaRootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
+                newPage = await InitDataPageAndLinkAsync(tailPage).ConfigureAwait(false);
+            }
+            finally
+            {
+                if (tailPage != lastPage)
+                {
+                    tailPage.Dispose();
+                }
+                lastPage?.Dispose();
+            }
+
+            if (!newPage.WriteRowIfSpace(ushort.MaxValue, rowBuffer, rowSize, out _))
+            {
+                newPage.Dispose();
+                throw new InvalidOperationException("Row too large for an empty data page.");
+            }
+            return newPage;
+        }
+
+        private async Task<TableDataPage> WriteRowToMappedPageAsync(TableDataPage currentPage, byte[] rowBuffer, ushort rowSize)
+        {
+            // Try the page already loaded before asking the map for another
+            if (currentPage != null && currentPage.WriteRowIfSpace(ushort.MaxValue, rowBuffer, rowSize, out _))
+            {
+                return currentPage;
+            }
+
+            var excludeLogicalPageId = currentPage?.LogicalPageId ?? LogicalPageId.Zero;
+            while (_freeSpaceMap.TryFindPage(rowSize, excludeLogicalPageId, out var logicalPageId))
+            {
+                var candidatePage = await LoadDataPageAsync(logicalPageId).ConfigureAwait(false);
+                if (candidatePage.WriteRowIfSpace(ushort.MaxValue, rowBuffer, rowSize, out _))
+                {
+                    currentPage?.Dispose();
+                    return candidatePage;
+                }
+
+                // The map entry was stale; correct it before looking again
+                _freeSpaceMap.Update(candidatePage);
+                candidatePage.Dispose();
+            }
+            return null;
+        }
+
+        private async Task MoveRowsToMappedPagesAsync(TableDataPage dataPage, byte[] rowBuffer)
+        {
+            // Rows are moved from the end of the page so the rows still to
+            //	be moved keep their place in the view
+            var view = dataPage.GetView(_columns);
+            TableDataPage targetPage = null;
+            try
+            {
+                for (var rowIndex = (int)view.RowCount - 1; rowIndex >= 0; --rowIndex)
+                {
+                    var row = view.GetRow((uint)rowIndex);
+                    Array.Copy(row.Array, row.Offset, rowBuffer, 0, row.Count);
+                    var page = await WriteRowToMappedPageAsync(targetPage, rowBuffer, (ushort)row.Count).ConfigureAwait(false);
+                    if (page == null)
+                    {
+                        break;
+                    }
+
+                    targetPage = page;
+                    dataPage.DeleteRow((ushort)rowIndex);
+                }
+            }
+            finally
+            {
+                targetPage?.Dispose();
+            }
+        }
+
+        private async Task ReclaimDataPageAsync(TableDataPage dataPage)
+        {
+            // Unlink the page from its neighbours
+            if (dataPage.PrevLogicalPageId != LogicalPageId.Zero)
+            {
+                using (var prevPage = await LoadDataPageAsync(dataPage.PrevLogicalPageId).ConfigureAwait(false))
+                {
+                    prevPage.NextLogicalPageId = dataPage.NextLogicalPageId;
+                }
+            }
+            else
+            {
+                DataFirstLogicalPageId = dataPage.NextLogicalPageId;
+            }
+            if (dataPage.NextLogicalPageId != LogicalPageId.Zero)
+            {
+                using (var nextPage = await LoadDataPageAsync(dataPage.NextLogicalPageId).ConfigureAwait(false))
+                {
+                    nextPage.PrevLogicalPageId = dataPage.PrevLogicalPageId;
+                }
+            }
+            else
+            {
+                DataLastLogicalPageId = dataPage.PrevLogicalPageId;
+            }
+
+            // Release the page once its last changes have been written
+            dataPage.Save();
+            await FileGroupDevice
+                .DeallocateDataPageAsync(new DeallocateDataPageParameters(dataPage))
+                .ConfigureAwait(false);
+        }
+
+        private IList<LogicalPageId> GetReclaimCandidates()
+        {
+            // The last page is where the table grows so it is never reclaimed
+            return _freeSpaceMap
+                .GetReclaimCandidates(!HasIndices)
+                .Where(logicalPageId => logicalPageId != DataLastLogicalPageId)
+                .ToList();
+        }
+
+        private async Task<TableFreeSpaceMap> GetFreeSpaceMapAsync()
+        {
+            if (_freeSpaceMap == null)
+            {
+                // The first map page stays locked until the transaction ends
+                //	so only one statement at a time maintains the map
+                var firstLogicalPageId = SchemaRootPage.FreeSpaceFirstLogicalPageId;
+                var timestamp = 0L;
+                if (firstLogicalPageId != LogicalPageId.Zero)
+                {
+                    using (var mapPage = await LoadFreeSpacePageAsync(firstLogicalPageId).ConfigureAwait(false))
+                    {
+                        timestamp = mapPage.Timestamp;
+                    }
+                }
+
+                // Reuse the map saved by an earlier statement unless it has
+                //	since been rolled back
+                if (!FreeSpaceMapCache.TryTake(ObjectId, firstLogicalPageId, timestamp, out var freeSpaceMap))
+                {
+                    freeSpaceMap = new TableFreeSpaceMap();
+                    var logicalId = firstLogicalPageId;
+                    while (logicalId != LogicalPageId.Zero)
+                    {
+                        using (var mapPage = await LoadFreeSpacePageAsync(logicalId).ConfigureAwait(false))
+                        {
+                            freeSpaceMap.Load(mapPage);
+                            logicalId = mapPage.NextLogicalPageId;
+                        }
+                    }
+                }
+                _freeSpaceMap = freeSpaceMap;
+                _freeSpaceMapTimestamp = timestamp;
+            }
+            return _freeSpaceMap;
+        }
+
+        private async Task SaveFreeSpaceMapAsync(bool scheduleCompaction)
+        {
+            if (_freeSpaceMap == null)
+            {
+                return;
+            }
+
+            var timestamp = _freeSpaceMapTimestamp;
+            if (_freeSpaceMap.IsDirty)
+            {
+                await _freeSpaceMap
+                    .SaveAsync(LoadFreeSpacePageAsync, InitFreeSpacePageAndLinkAsync)
+                    .ConfigureAwait(false);
+
+                // Rewriting the first map page gives it a timestamp that
+                //	identifies this version of the map
+                using (var mapPage = await LoadFreeSpacePageAsync(SchemaRootPage.FreeSpaceFirstLogicalPageId)
+                    .ConfigureAwait(false))
+                {
+                    mapPage.SetHeaderDirty();
+                    mapPage.Save();
+                    timestamp = mapPage.Timestamp;
+                }
+
+                // Pages worth reclaiming are left to the background compaction
+                if (scheduleCompaction && GetReclaimCandidates().Count > 0)
+                {
+                    FileGroupDevice.ScheduleTableCompaction(ObjectId);
+                }
+            }
+
+            FreeSpaceMapCache.Return(ObjectId, _freeSpaceMap, SchemaRootPage.FreeSpaceFirstLogicalPageId, timestamp);
+            _freeSpaceMap = null;
+        }
+
+        private async Task<TableFreeSpacePage> InitFreeSpacePageAndLinkAsync(LogicalPageId prevLogicalPageId)
+        {
+            var mapPage =
+                new TableFreeSpacePage
+                {
+                    ObjectId = ObjectId,
+                    FileGroupId = FileGroupId
+                };
+            await mapPage.SetObjectLockAsync(ObjectLockType.IntentExclusive).ConfigureAwait(false);
+            await mapPage.SetPageLockAsync(DataLockType.Exclusive).ConfigureAwait(false);
+
+            await FileGroupDevice
+                .InitDataPageAsync(new InitDataPageParameters(mapPage, true, true, true))
+                .ConfigureAwait(false);
+
+            if (prevLogicalPageId != LogicalPageId.Zero)
+            {
+                using (var prevMapPage = await LoadFreeSpacePageAsync(prevLogicalPageId).ConfigureAwait(false))
+                {
+                    mapPage.PrevLogicalPageId = prevMapPage.LogicalPageId;
+                    prevMapPage.NextLogicalPageId = mapPage.LogicalPageId;
+                }
+            }
+            else
+            {
+                // Recording the first map page needs a schema modification lock
+                await SchemaRootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
+                SchemaRootPage.FreeSpaceFirstLogicalPageId = mapPage.LogicalPageId;
+            }
+            return mapPage;
+        }
+
+        private async Task<TableFreeSpacePage> LoadFreeSpacePageAsync(LogicalPageId logicalId)
+        {
+            var mapPage =
+                new TableFreeSpacePage
+                {
+                    LogicalPageId = logicalId,
+                    FileGroupId = FileGroupId
+                };
+            // Map pages are locked on their own so statements maintaining
+            //	the map do not block other writers on the table
+            await mapPage.SetObjectLockAsync(ObjectLockType.IntentExclusive).ConfigureAwait(false);
+            await mapPage.SetPageLockAsync(DataLockType.Exclusive).ConfigureAwait(false);
+            mapPage.HoldLock = true;
+
+            await FileGroupDevice
+                .LoadDataPageAsync(new LoadDataPageParameters(mapPage, false, true))
+                .ConfigureAwait(false);
+            return mapPage;
+        }
+
+        private async Task InsertClusteredRowAsync(
+            TableIndexManager indexManager, int[] clusteredOrdinals, object[] rowValues, byte[] rowBuffer, ushort rowSize)
+        {
+            // The leaf holding the entry for the target data page stays
+            //	latched until any pages split from it have been indexed
+            var clusteredKeys = GetIndexKeys(clusteredOrdinals, rowValues);
+            var result = await indexManager
+                .FindIndexAsync(new FindTableIndexParameters(ClusteredIndex, clusteredKeys, clusteredKeys, rowSize))
+                .ConfigureAwait(false);
+            using (var leafPage = result.Page)
+            {
+                if (result.Entry == null)
+                {
+                    throw new InvalidOperationException("Clustered index has no entry for table data.");
+                }
+
+                var dataPage = await LoadDataPageAsync(result.Entry.LogicalPageId).ConfigureAwait(false);
+                try
+                {
+                    var rowKey = CreateIndexInfo(ClusteredIndex, clusteredOrdinals, rowValues);
+                    var rowIndex = FindClusteredRowIndex(dataPage, clusteredOrdinals, rowKey);
+                    var oldNextLogicalPageId = dataPage.NextLogicalPageId;
+                    await dataPage
+                        .InsertRowAndSplitIfNeeded(this, rowIndex, rowBuffer, rowSize)
+                        .ConfigureAwait(false);
+
+                    // Pages split off the data page are linked in after it
+                    //	and sort before the next entry so they follow its
+                    //	entry on the same leaf
+                    var entryIndex = leafPage.IndexEntries.IndexOf(result.Entry);
+                    var logicalPageId = dataPage.NextLogicalPageId;
+                    while (logicalPageId != oldNextLogicalPageId)
+                    {
+                        using (var splitPage = await LoadDataPageAsync(logicalPageId).ConfigureAwait(false))
+                        {
+                            var splitEntry = new TableIndexClusteredLeafInfo(
+                                GetClusteredKeys(splitPage, clusteredOrdinals), logicalPageId);
+                            splitEntry.SetContext(this, ClusteredIndex);
+                            leafPage.IndexEntries.Insert(++entryIndex, splitEntry);
+                            leafPage.SetDirty();
+                            logicalPageId = splitPage.NextLogicalPageId;
+                        }
+                    }
+                }
+                finally
+                {
+                    dataPage.Dispose();
+                }
+            }
+        }
+
+        private ushort FindClusteredRowIndex(TableDataPage dataPage, int[] clusteredOrdinals, TableIndexInfo rowKey)
+        {
+            // Rows are held in clustered key order; insert after the last
+            //	row that does not sort after the new row
+            var view = dataPage.GetView(_columns);
+            var values = new object[_columns.Count];
+            var low = 0u;
+            var high = view.RowCount;
+            while (low < high)
+            {
+                var middle = low + ((high - low) / 2);
+                var row = view.GetRow(middle);
+                _rowSerializer.Read(row.Array, row.Offset, values);
+                if (CreateIndexInfo(ClusteredIndex, clusteredOrdinals, values).CompareTo(rowKey) <= 0)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+
+            // An equal key can only be the row before the insert point
+            if (low > 0 && (ClusteredIndex.IndexSubType & TableIndexSubType.Unique) != 0)
+            {
+                var row = view.GetRow(low - 1);
+                _rowSerializer.Read(row.Array, row.Offset, values);
+                if (CreateIndexInfo(ClusteredIndex, clusteredOrdinals, values).CompareTo(rowKey) == 0)
+                {
+                    throw new InvalidOperationException("Duplicate key in unique clustered index.");
+                }
+            }
+            return (ushort)low;
+        }
+
+        private object[] GetClusteredKeys(TableDataPage dataPage, int[] clusteredOrdinals)
+        {
+            var view = dataPage.GetView(_columns);
+            var row = view.GetRow(0);
+            var values = new object[_columns.Count];
+            _rowSerializer.Read(row.Array, row.Offset, values);
+            return GetIndexKeys(clusteredOrdinals, values);
+        }
+
+        private async Task InsertIndexEntriesAsync(TableIndexManager indexManager, BulkLoadIndex index)
+        {
+            // Entries are applied in index order so consecutive inserts
+            //	descend through the same pages while they are still cached
+            foreach (var entry in index.LeafEntries)
+            {
+                entry.SetContext(this, index.RootInfo);
+            }
+            index.LeafEntries.Sort();
+
+            var isUnique = (index.RootInfo.IndexSubType & TableIndexSubType.Unique) != 0;
+            foreach (var entry in index.LeafEntries)
+            {
+                var findParams = entry is TableIndexNormalLeafInfo heapEntry
+                    ? new FindTableIndexParameters(
+                        index.RootInfo, entry.Keys, heapEntry.LogicalPageId.Value, heapEntry.RowId)
+                    : new FindTableIndexParameters(
+                        index.RootInfo, entry.Keys, ((TableIndexNormalOverClusteredLeafInfo)entry).ClusteredKeys);
+                var result = await indexManager.FindIndexAsync(findParams).ConfigureAwait(false);
+                using (var leafPage = result.Page)
+                {
+                    if (isUnique && result.Entry != null && result.Entry.CompareTo(entry) == 0)
+                    {
+                        throw new InvalidOperationException("Duplicate key in unique index.");
+                    }
+                    leafPage.AddLinkToPage(entry);
+                }
+            }
+        }
+
+        private async Task<TableDataPage> InitDataPageAndLinkAsync(TableDataPage prevDataPage)
+        {
+            var dataPage =
+                new TableDataPage
+                {
+                    ObjectId = ObjectId,
+                    FileGroupId = FileGroupId,
+                    FreeSpaceMap = _freeSpaceMap
+                };
+
+            // Writers only need intent on the table; the new page itself is
+            //	locked exclusively until the transaction completes
+            await dataPage.SetObjectLockAsync(ObjectLockType.IntentExclusive).ConfigureAwait(false);
+            await dataPage.SetPageLockAsync(DataLockType.Exclusive).ConfigureAwait(false);
+
+            // Pages after the first come from extents owned by this table
+            //	rather than from mixed extents
+            await FileGroupDevice
+                .InitDataPageAsync(new InitDataPageParameters(dataPage, true, true, true, prevDataPage == null && !HasData))
+                .ConfigureAwait(false);
+            _freeSpaceMap?.Update(dataPage);
+
+            if (prevDataPage != null)
+            {
+                dataPage.PrevLogicalPageId = prevDataPage.LogicalPageId;
+                prevDataPage.NextLogicalPageId = dataPage.LogicalPageId;
+                prevDataPage.Save();
+            }
+            else
+            {
+                DataFirstLogicalPageId = dataPage.LogicalPageId;
+            }
+            DataLastLogicalPageId = dataPage.LogicalPageId;
+            return dataPage;
+        }
+
+        private async Task<TableDataPage> LoadDataPageAsync(LogicalPageId logicalId)
+        {
+            var dataPage =
+                new TableDataPage
+                {
+                    LogicalPageId = logicalId,
+                    FileGroupId = FileGroupId,
+                    FreeSpaceMap = _freeSpaceMap
+                };
+
+            // Take intent on the table and an exclusive lock on the page
+            //	that is held until the transaction completes so concurrent
+            //	writers only serialise on the pages they actually touch
+            await dataPage.SetObjectLockAsync(ObjectLockType.IntentExclusive).ConfigureAwait(false);
+            await dataPage.SetPageLockAsync(DataLockType.Exclusive).ConfigureAwait(false);
+            dataPage.HoldLock = true;
+
+            await FileGroupDevice
+                .LoadDataPageAsync(new LoadDataPageParameters(dataPage, false, true))
+                .ConfigureAwait(false);
+            return dataPage;
+        }
+
+        private int[] GetIndexOrdinals(RootTableIndexInfo rootInfo)
+        {
+            var ordinals = new int[rootInfo.ColumnIDs.Length];
+            for (var keyIndex = 0; keyIndex < ordinals.Length; ++keyIndex)
+            {
+                var columnIndex = 0;
+                while (_columns[columnIndex].Id != rootInfo.ColumnIDs[keyIndex])
+                {
+                    ++columnIndex;
+                }
+                ordinals[keyIndex] = columnIndex;
+            }
+            return ordinals;
+        }
+
+        private static object[] GetIndexKeys(int[] ordinals, object[] rowValues)
+        {
+            var keys = new object[ordinals.Length];
+            for (var keyIndex = 0; keyIndex < ordinals.Length; ++keyIndex)
+            {
+                keys[keyIndex] = rowValues[ordinals[keyIndex]];
+            }
+            return keys;
+        }
+
+        private TableIndexInfo CreateIndexInfo(RootTableIndexInfo rootInfo, int[] ordinals, object[] rowValues)
+        {
+            var indexInfo = new TableIndexInfo(GetIndexKeys(ordinals, rowValues));
+            indexInfo.SetContext(this, rootInfo);
+            return indexInfo;
+        }
+
+        private int[] GetSourceOrdinals(uint[] columnIDs)
+        {
+            // Position of each table column in the caller's row data or -1
+            //	when the caller has not supplied the column
+            var sourceOrdinals = new int[_columns.Count];
+            for (var columnIndex = 0; columnIndex < _columns.Count; ++columnIndex)
+            {
+                sourceOrdinals[columnIndex] = Array.IndexOf(columnIDs, (uint)_columns[columnIndex].Id);
+            }
+            return sourceOrdinals;
+        }
+
+        private object[] BuildRowValues(int[] sourceOrdinals, object[] rowData)
+        {
+            var rowValues = new object[_columns.Count];
+            for (var columnIndex = 0; columnIndex < _columns.Count; ++columnIndex)
+            {
+                var column = _columns[columnIndex];
+
+                // If this column is an auto-increment field
+                if (column.AutoIncrement)
+                {
+                    // If caller specified data, we must have identity insert
+                    //	switched on
+                    object incrValue;
+                    if (sourceOrdinals[columnIndex] >= 0)
+                    {
+                        if (!AllowIdentityInsert)
+                        {
+                            throw new ArgumentException("Identity insert is switched off");
+                        }
+
+                        // Get value from inputs
+                        incrValue = rowData[sourceOrdinals[columnIndex]];
+                    }
+                    else
+                    {
+                        // TODO: Determine increment value either by 
+                        //	interrogating a system table or by some other means
+                        // Will probably use an in-memory increment value tracker
+                        //	when table is saved we will take the current value
+                        //	and update the table...
+                        incrValue = 1;
+                    }
+
+                    rowValues[columnIndex] = incrValue;
+                    continue;
+                }
+                if (column.DataType == TableColumnDataType.Timestamp)
+                {
+                    // Caller cannot specify timestamp column data
+                    if (sourceOrdinals[columnIndex] >= 0)
+                    {
+                        throw new ArgumentException("Cannot specify timestamp column data.");
+                    }
+
+                    // Add timestamp data
+                    rowValues[columnIndex] = (ulong)1;
+                    continue;
+                }
+
+                if (sourceOrdinals[columnIndex] < 0)
+                {
+                    // This column has not been specified, look for default
+                    object defaultValue = null;
+                    var constraint = _constraints.FirstOrDefault(
+                        item => item.ColumnId == column.Id &&
+                        item.ConstraintType == RowConstraintType.Default);
+                    if (constraint != null)
+                    {
+                        // TODO: Parse constraint data into appropriate object
+                        //	as specified by the column...
+                        defaultValue = constraint.ConstraintData;
+                    }
+
+                    // If no default found then column must allow nulls
+                    if (defaultValue == null && !column.Nullable)
+                    {
+                        throw new ArgumentException($"No data specified for column {column.Name} which does not allow nulls.");
+                    }
+
+                    // Add default to row data
+                    rowValues[columnIndex] = defaultValue;
+                    continue;
+                }
+
+                // Get specified value for this column
+                var dataValue = rowData[sourceOrdinals[columnIndex]];
+                if (dataValue == null && !column.Nullable)
+                {
+                    throw new ArgumentException($"No data specified for column {column.Name} which does not allow nulls.");
+                }
+
+                // Apply check constraints
+                var checkConstraint = _constraints.FirstOrDefault(
+                    item => item.ColumnId == column.Id &&
+                        item.ConstraintType == RowConstraintType.Check);
+                if (checkConstraint != null)
+                {
+                    // TODO: Execute the check constraint
+                    //checkConstraint.Ex
+                }
+
+                rowValues[columnIndex] = dataValue;
+            }
+
+            return rowValues;
+        }
+
         private async Task CreateTableDefinition()
         {
             if (!IsNewTable)
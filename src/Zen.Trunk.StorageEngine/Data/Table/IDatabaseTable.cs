@@ -260,5 +260,21 @@ namespace Zen.Trunk.Storage.Data.Table
         /// <param name="rowData">The row data.</param>
         /// <returns></returns>
         Task AddRow(uint[] columnIDs, object[] rowData);
+
+        /// <summary>
+        /// Adds a batch of rows, packing as many rows as fit into each data
+        /// page at a time.
+        /// </summary>
+        /// <param name="columnIDs">The column identifiers shared by every row.</param>
+        /// <param name="rows">The row data.</param>
+        /// <returns>The number of rows added.</returns>
+        Task<int> AddRowsAsync(uint[] columnIDs, IEnumerable<object[]> rows);
+
+        /// <summary>
+        /// Reclaims data pages of a heap table that are empty or mostly
+        /// empty.
+        /// </summary>
+        /// <returns>The number of data pages reclaimed.</returns>
+        Task<int> CompactAsync();
     }
 }
\ No newline at end of file
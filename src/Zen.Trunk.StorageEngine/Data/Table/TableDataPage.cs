@@ -68,11 +68,15 @@ namespace Zen.Trunk.Storage.Data.Table
 		{
 			get
 			{
-				if (_rowInfo == null)
+				if (_rowInfo != null)
+				{
+					return (uint)_rowInfo.Count;
+				}
+				if (_pageData == null)
 				{
 					return 0;
 				}
-				return (uint)_rowInfo.Count;
+				return TableDataPageView.CountRows(_pageData, (int)DataSize);
 			}
 		}
 
@@ -83,10 +87,10 @@ namespace Zen.Trunk.Storage.Data.Table
 		{
 			get
 			{
-				var allocated = (ushort)(_totalRowDataSize.Value + (_rowInfo.Count * 2));
+				var allocated = (ushort)(_totalRowDataSize.Value + (RowInfos.Count * 2));
 
 				// Account for row offset table terminator
-				if (_rowInfo.Count < MaxRows)
+				if (RowInfos.Count < MaxRows)
 				{
 					allocated += 2;
 				}
@@ -96,8 +100,58 @@ namespace Zen.Trunk.Storage.Data.Table
 		}
 		#endregion
 
+		#region Internal Properties
+		/// <summary>
+		/// Gets or sets the free space map kept up to date as rows are added
+		/// to or removed from this page.
+		/// </summary>
+		/// <value>
+		/// The free space map or <c>null</c> if the owning table is not a heap.
+		/// </value>
+		internal TableFreeSpaceMap FreeSpaceMap { get; set; }
+		#endregion
+
+		#region Private Properties
+		/// <summary>
+		/// Gets the row offset information, building it from the row offset
+		/// table on first use after the page is loaded.
+		/// </summary>
+		private List<RowInfo> RowInfos
+		{
+			get
+			{
+				if (_rowInfo == null && _pageData != null)
+				{
+					ReadPageInfo();
+				}
+				return _rowInfo;
+			}
+		}
+		#endregion
+
 		#region Public Methods
 	    /// <summary>
+	    /// Returns a <see cref="TableDataPageView"/> for reading row and
+	    /// column data directly from the page.
+	    /// </summary>
+	    /// <param name="rowDef">Complete row column definition.</param>
+	    /// <returns><see cref="TableDataPageView"/></returns>
+	    /// <remarks>
+	    /// Pages that have not been modified since they were loaded are read
+	    /// through their row offset table without building row information.
+	    /// </remarks>
+	    public TableDataPageView GetView(IList<TableColumnInfo> rowDef)
+		{
+			// Bring row offset table up to date with in-memory changes
+			if (_rowInfo != null && _pageData != null)
+			{
+				WritePageInfo();
+			}
+			return new TableDataPageView(
+				_pageData, (int)DataSize, _totalRowDataSize.Value, rowDef);
+		}
+
+	    /// <summary>
 	    /// Returns a <see cref="T:RowReaderWriter"/> for accessing row data
 	    /// for the specified row.
 	    /// </summary>
@@ -107,12 +161,10 @@ namespace Zen.Trunk.Storage.Data.Table
 	    public TableRowReader GetRowReader(
 			uint rowIndex, IList<TableColumnInfo> rowDef)
 		{
-			var rowStream = new MemoryStream(
+			return new TableRowReader(
 				_pageData,
-				_rowInfo[(int)rowIndex].Offset,
-				_rowInfo[(int)rowIndex].Length,
-				false);
-			return new TableRowReader(rowStream, rowDef);
+				RowInfos[(int)rowIndex].Offset,
+				TableRowSerializer.GetSerializer(rowDef));
 		}
 
         /// <summary>
@@ -127,8 +179,8 @@ namespace Zen.Trunk.Storage.Data.Table
         {
             Stream rowStream = new MemoryStream(
                 _pageData,
-                _rowInfo[(int)rowIndex].Offset,
-                _rowInfo[(int)rowIndex].Length,
+                RowInfos[(int)rowIndex].Offset,
+                RowInfos[(int)rowIndex].Length,
                 true);
             return new TableRowWriter(rowStream, rowDef);
         }
@@ -180,22 +232,18 @@ namespace Zen.Trunk.Storage.Data.Table
 		{
 			// If this table doesn't have a clustered index then add the new
 			//	row at the of the last data page.
-			TableDataPage splitPage;
 			ushort newRowIndex;
 			if (table.IsHeap)
 			{
 				// Determine last page and load if needed
-				TableDataPage lastPage;
-				if (LogicalPageId == table.DataLastLogicalPageId)
-				{
-					lastPage = this;
-				}
-				else
+				var lastPage = this;
+				if (LogicalPageId != table.DataLastLogicalPageId)
 				{
 				    lastPage = new TableDataPage
 				    {
 				        LogicalPageId = table.DataLastLogicalPageId,
 				        FileGroupId = FileGroupId,
+				        FreeSpaceMap = FreeSpaceMap,
 				    };
 
 				    await lastPage.SetObjectLockAsync(ObjectLock).ConfigureAwait(false);
@@ -205,33 +253,34 @@ namespace Zen.Trunk.Storage.Data.Table
 						.ConfigureAwait(false);
 				}
 
-				// Attempt to add the row to the end of the last page
-				if (lastPage.WriteRowIfSpace(ushort.MaxValue, newRowData, length, out newRowIndex))
+				try
 				{
-					return new Tuple<LogicalPageId, ushort>(lastPage.LogicalPageId, newRowIndex);
-				}
+					// Attempt to add the row to the end of the last page
+					if (lastPage.WriteRowIfSpace(ushort.MaxValue, newRowData, length, out newRowIndex))
+					{
+						return new Tuple<LogicalPageId, ushort>(lastPage.LogicalPageId, newRowIndex);
+					}
 
-				// If we get here then we need to add a new page to the end
-                // We will need a schema modification lock on the schema root page
-			    await table.SchemaRootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
-			    splitPage = new TableDataPage
-			    {
-			        FileGroupId = FileGroupId,
-			    };
-			    await splitPage.SetObjectLockAsync(ObjectLock).ConfigureAwait(false);
-
-                await table.FileGroupDevice
-					.InitDataPageAsync(new InitDataPageParameters(splitPage, true, true, true))
-					.ConfigureAwait(false);
-				splitPage.PrevLogicalPageId = lastPage.LogicalPageId;
-				lastPage.NextLogicalPageId = splitPage.LogicalPageId;
-				table.DataLastLogicalPageId = splitPage.LogicalPageId;
-
-				if (!splitPage.WriteRowIfSpace(ushort.MaxValue, newRowData, length, out newRowIndex))
+					// If we get here then we need to add a new page to the end
+					// We will need a schema modification lock on the schema root page
+					await table.SchemaRootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
+					using (var newPage = await CreateLinkedPageAsync(table, lastPage, null).ConfigureAwait(false))
+					{
+						table.DataLastLogicalPageId = newPage.LogicalPageId;
+						if (!newPage.WriteRowIfSpace(ushort.MaxValue, newRowData, length, out newRowIndex))
+						{
+							throw new InvalidOperationException("Failed to add row to new page.");
+						}
+						return new Tuple<LogicalPageId, ushort>(newPage.LogicalPageId, newRowIndex);
+					}
+				}
+				finally
 				{
-					throw new InvalidOperationException("Failed to add row to new page.");
+					if (lastPage != this)
+					{
+						lastPage.Dispose();
+					}
 				}
-				return new Tuple<LogicalPageId, ushort>(splitPage.LogicalPageId, newRowIndex);
 			}
 
 			// Attempt: #1
@@ -241,82 +290,46 @@ namespace Zen.Trunk.Storage.Data.Table
 				return new Tuple<LogicalPageId, ushort>(LogicalPageId, newRowIndex);
 			}
 
-			// Counting back from the maximum row on this page - calculate the
-			//	number of rows we need to move before we can insert the desired row
-			ushort totalSize = FreeSpace, splitAtRowIndex;
-			for (splitAtRowIndex = (ushort)(_rowInfo.Count - 1); splitAtRowIndex > rowIndex && totalSize < length; --splitAtRowIndex)
-			{
-				totalSize += (ushort)(_rowInfo[splitAtRowIndex].Length + 2);
-			}
-
-			// Load the next page in preparation for split.
+			// Rows are never moved onto the front of the next page as they
+			//	would then sort before the clustered index entry for that
+			//	page; instead a new page is linked in after this one.
 			TableDataPage nextPage = null;
-			if (NextLogicalPageId != LogicalPageId.Zero)
-			{
-			    nextPage = new TableDataPage
-			    {
-			        LogicalPageId = NextLogicalPageId,
-			        FileGroupId = FileGroupId,
-			    };
-			    await nextPage.SetObjectLockAsync(ObjectLock).ConfigureAwait(false);
-
-                await table.FileGroupDevice
-					.LoadDataPageAsync(new LoadDataPageParameters(nextPage, false, true))
-					.ConfigureAwait(false);
-			}
-
-			// If the next page is valid then attempt to split data into
-			//	the next page and update row in this page
-			if (nextPage != null &&
-				totalSize >= length &&
-				SplitPage(nextPage, splitAtRowIndex) &&
-				WriteRowIfSpace(rowIndex, newRowData, length, out newRowIndex))
-			{
-				return new Tuple<LogicalPageId, ushort>(LogicalPageId, newRowIndex);
-			}
-
-			// Create a new page and link to this page
-		    splitPage = new TableDataPage
-		    {
-		        FileGroupId = FileGroupId,
-		    };
-		    await SetObjectLockAsync(ObjectLock).ConfigureAwait(false);
-
-            await table.FileGroupDevice
-				.InitDataPageAsync(new InitDataPageParameters(splitPage, true, true, true))
-				.ConfigureAwait(false);
-			splitPage.PrevLogicalPageId = LogicalPageId;
-			splitPage.NextLogicalPageId = NextLogicalPageId;
-			if (nextPage != null)
-			{
-				nextPage.PrevLogicalPageId = splitPage.LogicalPageId;
-			}
-			NextLogicalPageId = splitPage.LogicalPageId;
-			if (nextPage == null)
+			TableDataPage splitPage = null;
+			TableDataPage extraPage = null;
+			try
 			{
-                // We will need a schema modification lock on the schema root page
-                await table.SchemaRootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
+				// Load the next page so we can fix up the linkage
+				if (NextLogicalPageId != LogicalPageId.Zero)
+				{
+				    nextPage = new TableDataPage
+				    {
+				        LogicalPageId = NextLogicalPageId,
+				        FileGroupId = FileGroupId,
+				    };
+				    await nextPage.SetObjectLockAsync(ObjectLock).ConfigureAwait(false);
 
-                // We must be splitting the last page and therefore the split
-                //	page must be the new last page so update schema
-                table.DataLastLogicalPageId = splitPage.LogicalPageId;
-			}
+                    await table.FileGroupDevice
+						.LoadDataPageAsync(new LoadDataPageParameters(nextPage, false, true))
+						.ConfigureAwait(false);
+				}
+				else
+				{
+					// We will need a schema modification lock on the schema root page
+					await table.SchemaRootPage.SetSchemaLockAsync(SchemaLockType.SchemaModification).ConfigureAwait(false);
+				}
 
-			if (totalSize >= length)
-			{
-				// Split the page at the current row and do row update
-				if (!SplitPage(splitPage, splitAtRowIndex) ||
-					!WriteRowIfSpace(rowIndex, newRowData, length, out newRowIndex))
+				// Create a new page and link to this page
+				splitPage = await CreateLinkedPageAsync(table, this, nextPage).ConfigureAwait(false);
+				if (nextPage == null)
 				{
-					throw new InvalidOperationException(
-						"Split/insert failed after creating split page.");
+					// We must be splitting the last page and therefore the split
+					//	page must be the new last page so update schema
+					table.DataLastLogicalPageId = splitPage.LogicalPageId;
 				}
-				return new Tuple<LogicalPageId, ushort>(LogicalPageId, newRowIndex);
-			}
-			else
-			{
-				// Split page at insert point
-				if (!SplitPage(splitPage, rowIndex))
+
+				// Split page at insert point; appending to the end of the
+				//	page leaves the split page empty for the new row
+				if (rowIndex < RowInfos.Count && !SplitPage(splitPage, rowIndex))
 				{
 					throw new InvalidOperationException(
 						"Split failed after creating split page.");
@@ -333,23 +346,7 @@ namespace Zen.Trunk.Storage.Data.Table
 				}
 
 				// Insert new row between this row and the split page
-			    var extraPage = new TableDataPage
-			    {
-			        FileGroupId = FileGroupId,
-			    };
-			    await extraPage.SetObjectLockAsync(ObjectLock).ConfigureAwait(false);
-
-                await table.FileGroupDevice
-					.InitDataPageAsync(new InitDataPageParameters(extraPage, true, true, true))
-					.ConfigureAwait(false);
-
-				// Update linked list
-				NextLogicalPageId = extraPage.LogicalPageId;
-				extraPage.PrevLogicalPageId = LogicalPageId;
-				extraPage.NextLogicalPageId = splitPage.LogicalPageId;
-				splitPage.PrevLogicalPageId = extraPage.LogicalPageId;
-
-				// Insert data into new extra page
+				extraPage = await CreateLinkedPageAsync(table, this, splitPage).ConfigureAwait(false);
 				if (!extraPage.WriteRowIfSpace(0, newRowData, length, out newRowIndex))
 				{
 					throw new InvalidOperationException(
@@ -357,6 +354,12 @@ namespace Zen.Trunk.Storage.Data.Table
 				}
 				return new Tuple<LogicalPageId, ushort>(extraPage.LogicalPageId, newRowIndex);
 			}
+			finally
+			{
+				extraPage?.Dispose();
+				splitPage?.Dispose();
+				nextPage?.Dispose();
+			}
 		}
 
 		/// <summary>
@@ -374,23 +377,23 @@ namespace Zen.Trunk.Storage.Data.Table
 		/// <returns></returns>
 		public bool SplitPage(TableDataPage nextPage, ushort splitRowIndex)
 		{
-			var splitSize = (ushort)(_totalRowDataSize.Value - _rowInfo[splitRowIndex].Offset);
-			var splitRows = (ushort)(_rowInfo.Count - splitRowIndex);
-			if (nextPage._rowInfo.Count == 0)
+			var splitSize = (ushort)(_totalRowDataSize.Value - RowInfos[splitRowIndex].Offset);
+			var splitRows = (ushort)(RowInfos.Count - splitRowIndex);
+			if (nextPage.RowInfos.Count == 0)
 			{
 				// Copy page data to other page
-				Array.Copy(_pageData, _rowInfo[splitRowIndex].Offset,
+				Array.Copy(_pageData, RowInfos[splitRowIndex].Offset,
 					nextPage._pageData, 0,
 					splitSize);
 
 				// Move row information
-				nextPage._rowInfo.AddRange(_rowInfo.GetRange(splitRowIndex,
+				var splitOffset = RowInfos[splitRowIndex].Offset;
+				nextPage.RowInfos.AddRange(RowInfos.GetRange(splitRowIndex,
 					splitRows));
-				_rowInfo.RemoveRange(splitRowIndex, splitRows);
+				RowInfos.RemoveRange(splitRowIndex, splitRows);
 
 				// Clear source page
-				Array.Clear(_pageData, _rowInfo[splitRowIndex].Offset,
-					splitSize);
+				Array.Clear(_pageData, splitOffset, splitSize);
 			}
 			else
 			{
@@ -407,20 +410,22 @@ namespace Zen.Trunk.Storage.Data.Table
 					nextPage._totalRowDataSize.Value);
 
 				// Copy row data into place
-				Array.Copy(_pageData, _rowInfo[splitRowIndex].Offset,
+				var splitOffset = RowInfos[splitRowIndex].Offset;
+				Array.Copy(_pageData, splitOffset,
 					nextPage._pageData, 0, splitSize);
 
 				// Move split row information
-				nextPage._rowInfo.InsertRange(0, _rowInfo.GetRange(
+				nextPage.RowInfos.InsertRange(0, RowInfos.GetRange(
 					splitRowIndex, splitRows));
-				_rowInfo.RemoveRange(splitRowIndex, splitRows);
+				RowInfos.RemoveRange(splitRowIndex, splitRows);
+				Array.Clear(_pageData, splitOffset, splitSize);
 
 				// Adjust row offsets for other page rows
 				ushort offset = 0;
-				for (var index = 0; index < nextPage._rowInfo.Count; ++index)
+				for (var index = 0; index < nextPage.RowInfos.Count; ++index)
 				{
-					nextPage._rowInfo[index].Offset = offset;
-					offset += nextPage._rowInfo[index].Length;
+					nextPage.RowInfos[index].Offset = offset;
+					offset += nextPage.RowInfos[index].Length;
 				}
 			}
 
@@ -431,6 +436,8 @@ namespace Zen.Trunk.Storage.Data.Table
 			nextPage.SetDataDirty();
 			SetHeaderDirty();
 			SetDataDirty();
+			nextPage.UpdateFreeSpaceMap();
+			UpdateFreeSpaceMap();
 			return true;
 		}
 
@@ -458,46 +465,49 @@ namespace Zen.Trunk.Storage.Data.Table
 
 			// If current row is longer (or the same length) as the new
 			//	data then perform an in-place update.
-			if (_rowInfo[rowIndex].Length >= reservationLength)
+			if (RowInfos[rowIndex].Length >= reservationLength)
 			{
 				// Clear page area
-				Array.Clear(_pageData, _rowInfo[rowIndex].Offset,
+				Array.Clear(_pageData, RowInfos[rowIndex].Offset,
 					reservationLength);
 
 				// Copy row data into place
 				Array.Copy(newRowData, 0, _pageData,
-					_rowInfo[rowIndex].Offset, length);
+					RowInfos[rowIndex].Offset, length);
 
 				// More work to do when row is different size and modified
 				//	row is not the last row of the page.
-				if (_rowInfo[rowIndex].Length > reservationLength)
+				if (RowInfos[rowIndex].Length > reservationLength)
 				{
-					var difference = (ushort)(_rowInfo[rowIndex].Length - reservationLength);
-					if (rowIndex < (_rowInfo.Count - 1))
+					var difference = (ushort)(RowInfos[rowIndex].Length - reservationLength);
+					if (rowIndex < (RowInfos.Count - 1))
 					{
 						// Reclaim unused space
-						Array.Copy(_pageData, _rowInfo[rowIndex + 1].Offset,
-							_pageData, _rowInfo[rowIndex].Offset + reservationLength,
-							_totalRowDataSize.Value - _rowInfo[rowIndex + 1].Offset);
+						Array.Copy(_pageData, RowInfos[rowIndex + 1].Offset,
+							_pageData, RowInfos[rowIndex].Offset + reservationLength,
+							_totalRowDataSize.Value - RowInfos[rowIndex + 1].Offset);
 
 						// Adjust row length
-						_rowInfo[rowIndex].Length = reservationLength;
+						RowInfos[rowIndex].Length = reservationLength;
 
 						// Adjust row offsets for following rows
-						for (var index = (ushort)(rowIndex + 1); index < _rowInfo.Count; ++index)
+						for (var index = (ushort)(rowIndex + 1); index < RowInfos.Count; ++index)
 						{
-							_rowInfo[rowIndex].Offset -= difference;
+							RowInfos[index].Offset -= difference;
 						}
 					}
 
 					// Adjust total row-data size
 					_totalRowDataSize.Value -= difference;
 				}
+				SetHeaderDirty();
+				SetDataDirty();
+				UpdateFreeSpaceMap();
 			}
 			else
 			{
 				// Determine whether updated row will fit on page
-				if ((reservationLength - _rowInfo[rowIndex].Length) > FreeSpace)
+				if ((reservationLength - RowInfos[rowIndex].Length) > FreeSpace)
 				{
 					// Page must be split on following row if this is
 					//	not the last row in the page
@@ -528,28 +538,34 @@ namespace Zen.Trunk.Storage.Data.Table
 		/// <param name="rowIndex"></param>
 		public void DeleteRow(ushort rowIndex)
 		{
-			if (rowIndex == (_rowInfo.Count - 1))
+			if (rowIndex == (RowInfos.Count - 1))
 			{
-				_totalRowDataSize.Value -= _rowInfo[rowIndex].Length;
+				_totalRowDataSize.Value -= RowInfos[rowIndex].Length;
 				Array.Clear(_pageData,
-					_rowInfo[rowIndex].Offset,
-					_rowInfo[rowIndex].Length);
-				_rowInfo.RemoveAt(rowIndex);
+					RowInfos[rowIndex].Offset,
+					RowInfos[rowIndex].Length);
+				RowInfos.RemoveAt(rowIndex);
 			}
 			else
 			{
-				// Move row data into place
+				// Move row data into place and clear the space left behind
 				Array.Copy(
-					_pageData, _rowInfo[rowIndex + 1].Offset,
-					_pageData, _rowInfo[rowIndex].Offset,
-					_totalRowDataSize.Value - _rowInfo[rowIndex].Length);
-				for (var index = rowIndex + 1; index < _rowInfo.Count; ++index)
+					_pageData, RowInfos[rowIndex + 1].Offset,
+					_pageData, RowInfos[rowIndex].Offset,
+					_totalRowDataSize.Value - RowInfos[rowIndex + 1].Offset);
+				Array.Clear(_pageData,
+					_totalRowDataSize.Value - RowInfos[rowIndex].Length,
+					RowInfos[rowIndex].Length);
+				for (var index = rowIndex + 1; index < RowInfos.Count; ++index)
 				{
-					_rowInfo[index].Offset -= _rowInfo[rowIndex].Length;
+					RowInfos[index].Offset -= RowInfos[rowIndex].Length;
 				}
-				_totalRowDataSize.Value -= _rowInfo[rowIndex].Length;
-				_rowInfo.RemoveAt(rowIndex);
+				_totalRowDataSize.Value -= RowInfos[rowIndex].Length;
+				RowInfos.RemoveAt(rowIndex);
 			}
+			SetHeaderDirty();
+			SetDataDirty();
+			UpdateFreeSpaceMap();
 		}
 
 		/// <summary>
@@ -573,7 +589,7 @@ namespace Zen.Trunk.Storage.Data.Table
 			var newInfo = new RowInfo();
 			newInfo.Length = Math.Max((ushort)MinRowBytes, length);
 
-			if (insertRow >= _rowInfo.Count)
+			if (insertRow >= RowInfos.Count)
 			{
 				// Add
 				// Determine row offset
@@ -587,41 +603,110 @@ namespace Zen.Trunk.Storage.Data.Table
 					length);
 
 				// Add row information and update return value
-				rowIndex = (ushort)_rowInfo.Count;
-				_rowInfo.Add(newInfo);
+				rowIndex = (ushort)RowInfos.Count;
+				RowInfos.Add(newInfo);
 			}
 			else
 			{
 				// Insert
 				// Make space for entry
-				Array.Copy(_pageData, _rowInfo[insertRow].Offset,
-					_pageData, _rowInfo[insertRow].Offset + newInfo.Length,
-					_totalRowDataSize.Value - _rowInfo[insertRow].Offset);
+				Array.Copy(_pageData, RowInfos[insertRow].Offset,
+					_pageData, RowInfos[insertRow].Offset + newInfo.Length,
+					_totalRowDataSize.Value - RowInfos[insertRow].Offset);
 
 				// Zero rowspace for security
-				Array.Clear(_pageData, _rowInfo[insertRow].Offset,
+				Array.Clear(_pageData, RowInfos[insertRow].Offset,
 					newInfo.Length);
 
 				// Copy row data into place
-				Array.Copy(rowData, 0, _pageData, _rowInfo[insertRow].Offset,
+				Array.Copy(rowData, 0, _pageData, RowInfos[insertRow].Offset,
 					length);
 
 				// Adjust row offsets for following rows
-				newInfo.Offset = _rowInfo[insertRow].Offset;
-				for (int index = insertRow; index < _rowInfo.Count; ++index)
+				newInfo.Offset = RowInfos[insertRow].Offset;
+				for (int index = insertRow; index < RowInfos.Count; ++index)
 				{
-					_rowInfo[index].Offset += newInfo.Length;
+					RowInfos[index].Offset += newInfo.Length;
 				}
 
 				// Add row and setup return value
-				_rowInfo.Insert(insertRow, newInfo);
+				RowInfos.Insert(insertRow, newInfo);
 				rowIndex = insertRow;
 			}
 			_totalRowDataSize.Value += newInfo.Length;
 			SetHeaderDirty();
 			SetDataDirty();
+			UpdateFreeSpaceMap();
 			return true;
 		}
+
+		/// <summary>
+		/// Appends as many rows from a block of serialized rows as will fit
+		/// at the end of this page.
+		/// </summary>
+		/// <param name="rowData">Buffer holding the rows back-to-back.</param>
+		/// <param name="rowDataOffset">Offset of the first row to append.</param>
+		/// <param name="rowLengths">Length of every row in the buffer.</param>
+		/// <param name="firstRow">Index into <paramref name="rowLengths"/> of the first row to append.</param>
+		/// <returns>
+		/// The number of rows appended; the first appended row has the row
+		/// index <see cref="RowCount"/> minus the return value.
+		/// </returns>
+		public int AppendRowBlock(byte[] rowData, int rowDataOffset,
+			IList<ushort> rowLengths, int firstRow)
+		{
+			// Determine how many rows fit before copying anything
+			ushort blockSize = 0;
+			ushort rowCount = 0;
+			var isPadded = false;
+			while (firstRow + rowCount < rowLengths.Count)
+			{
+				var length = rowLengths[firstRow + rowCount];
+				var reservationLength = Math.Max(length, (ushort)MinRowBytes);
+				if (!CanAddRowBlock((ushort)(blockSize + reservationLength), (ushort)(rowCount + 1)))
+				{
+					break;
+				}
+
+				isPadded |= reservationLength != length;
+				blockSize += reservationLength;
+				++rowCount;
+			}
+			if (rowCount == 0)
+			{
+				return 0;
+			}
+
+			// Rows that need no padding are copied in a single operation
+			var pageOffset = _totalRowDataSize.Value;
+			if (!isPadded)
+			{
+				Array.Copy(rowData, rowDataOffset, _pageData, pageOffset, blockSize);
+			}
+
+			for (var index = 0; index < rowCount; ++index)
+			{
+				var length = rowLengths[firstRow + index];
+				var newInfo = new RowInfo();
+				newInfo.Offset = pageOffset;
+				newInfo.Length = Math.Max(length, (ushort)MinRowBytes);
+				if (isPadded)
+				{
+					Array.Clear(_pageData, newInfo.Offset, newInfo.Length);
+					Array.Copy(rowData, rowDataOffset, _pageData, newInfo.Offset, length);
+				}
+				RowInfos.Add(newInfo);
+
+				rowDataOffset += length;
+				pageOffset += newInfo.Length;
+			}
+
+			_totalRowDataSize.Value += blockSize;
+			SetHeaderDirty();
+			SetDataDirty();
+			UpdateFreeSpaceMap();
+			return rowCount;
+		}
         #endregion
 
         #region Protected Methods
@@ -632,6 +717,10 @@ namespace Zen.Trunk.Storage.Data.Table
         protected override Task OnInitAsync()
 		{
 			PageType = PageType.Table;
+
+			// New pages start with an empty row offset table
+			_pageData = new byte[DataSize];
+			_rowInfo = new List<RowInfo>();
 			return base.OnInitAsync();
 		}
         /// <summary>
@@ -670,8 +759,7 @@ namespace Zen.Trunk.Storage.Data.Table
         /// <returns></returns>
         protected override Task OnPostLoadAsync()
 		{
-			// Setup page row information
-			ReadPageInfo();
+			// Row information is built from the row offset table on demand
 			return base.OnPostLoadAsync();
 		}
 
@@ -699,6 +787,38 @@ namespace Zen.Trunk.Storage.Data.Table
 		#endregion
 
 		#region Private Methods
+		private async Task<TableDataPage> CreateLinkedPageAsync(
+			DatabaseTable table, TableDataPage prevPage, TableDataPage nextPage)
+		{
+		    var newPage = new TableDataPage
+		    {
+		        ObjectId = ObjectId,
+		        FileGroupId = FileGroupId,
+		        FreeSpaceMap = FreeSpaceMap,
+		    };
+		    await newPage.SetObjectLockAsync(ObjectLock).ConfigureAwait(false);
+
+            await table.FileGroupDevice
+				.InitDataPageAsync(new InitDataPageParameters(newPage, true, true, true))
+				.ConfigureAwait(false);
+			newPage.UpdateFreeSpaceMap();
+
+			// Link the new page between the pages either side of it
+			newPage.PrevLogicalPageId = prevPage.LogicalPageId;
+			prevPage.NextLogicalPageId = newPage.LogicalPageId;
+			if (nextPage != null)
+			{
+				newPage.NextLogicalPageId = nextPage.LogicalPageId;
+				nextPage.PrevLogicalPageId = newPage.LogicalPageId;
+			}
+			return newPage;
+		}
+
+		private void UpdateFreeSpaceMap()
+		{
+			FreeSpaceMap?.Update(this);
+		}
+
 		private void ReadPageInfo()
 		{
 			_rowInfo = new List<RowInfo>();
@@ -708,12 +828,15 @@ namespace Zen.Trunk.Storage.Data.Table
 			for (var index = 0; index < MaxRows; ++index)
 			{
 				// Read row data
+				//	entries hold the row offset plus one so zero is free to
+				//	act as the terminator
 				ushort rowDataOffset = _pageData[--offset];
 				rowDataOffset |= (ushort)(_pageData[--offset] << 8);
 				if (rowDataOffset == 0)
 				{
 					break;
 				}
+				--rowDataOffset;
 
 				// Build row information block
 				var newInfo = new RowInfo();
@@ -737,13 +860,20 @@ namespace Zen.Trunk.Storage.Data.Table
 
 		private void WritePageInfo()
 		{
+			// Row offset table is unchanged unless row information exists
+			if (_rowInfo == null)
+			{
+				return;
+			}
+
 			// Build row offset table
 			var offset = DataSize;
 			for (var index = 0; index < _rowInfo.Count; ++index)
 			{
 				// Write row data
-				_pageData[--offset] = (byte)(_rowInfo[index].Offset & 0xff);
-				_pageData[--offset] = (byte)(_rowInfo[index].Offset >> 8);
+				var rowDataOffset = (ushort)(_rowInfo[index].Offset + 1);
+				_pageData[--offset] = (byte)(rowDataOffset & 0xff);
+				_pageData[--offset] = (byte)(rowDataOffset >> 8);
 			}
 
 			// Account for terminator
@@ -761,7 +891,7 @@ namespace Zen.Trunk.Storage.Data.Table
 		/// <returns></returns>
 		private bool CanAddRow(ushort rowSize)
 		{
-			if (_rowInfo.Count == MaxRows)
+			if (RowInfos.Count == MaxRows)
 			{
 				return false;
 			}
@@ -770,7 +900,7 @@ namespace Zen.Trunk.Storage.Data.Table
 			rowSize = Math.Max(rowSize, (ushort)8);
 
 			// Account for row offset
-			if (_rowInfo.Count < MaxRows)
+			if (RowInfos.Count < MaxRows)
 			{
 				rowSize += 2;
 			}
@@ -787,7 +917,7 @@ namespace Zen.Trunk.Storage.Data.Table
 	    /// <returns></returns>
 	    private bool CanAddRowBlock(ushort totalSize, ushort numberOfRows)
 		{
-			if ((_rowInfo.Count + numberOfRows) > MaxRows)
+			if ((RowInfos.Count + numberOfRows) > MaxRows)
 			{
 				return false;
 			}
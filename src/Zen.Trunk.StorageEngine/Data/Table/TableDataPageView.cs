@@ -0,0 +1,405 @@
+using System;
+using System.Collections.Generic;
+
+namespace Zen.Trunk.Storage.Data.Table
+{
+    /// <summary>
+    /// <c>TableDataPageView</c> provides read-only access to the rows held
+    /// on a table data page directly from the page data.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The view reads the row offset table at the end of the page data and
+    /// decodes column values in place; no row information list, stream,
+    /// reader or boxed column value is created so scans and predicate
+    /// evaluation do not allocate.
+    /// </para>
+    /// <para>
+    /// Each row offset table entry holds the row offset plus one; a zero
+    /// entry terminates the table.
+    /// </para>
+    /// <para>
+    /// Column values are located using the row layout of the
+    /// <see cref="TableRowSerializer"/> for the row definition.
+    /// </para>
+    /// <para>
+    /// A view is only valid while the caller holds a lock on the page that
+    /// prevents the page from being modified.
+    /// </para>
+    /// </remarks>
+    public struct TableDataPageView
+    {
+        #region Private Fields
+        private readonly byte[] _pageData;
+        private readonly int _dataSize;
+        private readonly ushort _totalRowDataSize;
+        private readonly IList<TableColumnInfo> _rowDef;
+        private readonly TableRowSerializer _serializer;
+        #endregion
+
+        #region Internal Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TableDataPageView"/> struct.
+        /// </summary>
+        /// <param name="pageData">The page data.</param>
+        /// <param name="dataSize">Size of the page data block.</param>
+        /// <param name="totalRowDataSize">The number of bytes used by row data.</param>
+        /// <param name="rowDef">The row definition.</param>
+        internal TableDataPageView(
+            byte[] pageData, int dataSize, ushort totalRowDataSize, IList<TableColumnInfo> rowDef)
+        {
+            _pageData = pageData;
+            _dataSize = dataSize;
+            _totalRowDataSize = totalRowDataSize;
+            _rowDef = rowDef;
+            _serializer = TableRowSerializer.GetSerializer(rowDef);
+            RowCount = pageData != null ? CountRows(pageData, dataSize) : 0;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the number of rows on the page.
+        /// </summary>
+        /// <value>
+        /// The row count.
+        /// </value>
+        public uint RowCount { get; }
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Gets the data for the specified row.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <returns>
+        /// An <see cref="ArraySegment{T}"/> over the row data.
+        /// </returns>
+        public ArraySegment<byte> GetRow(uint rowIndex)
+        {
+            var rowOffset = GetRowOffset(rowIndex, out var rowLength);
+            return new ArraySegment<byte>(_pageData, rowOffset, rowLength);
+        }
+
+        /// <summary>
+        /// Gets the encoded data for the specified column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>
+        /// An <see cref="ArraySegment{T}"/> over the column data excluding
+        /// any length prefix.
+        /// </returns>
+        public ArraySegment<byte> GetColumn(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, out var length);
+            return new ArraySegment<byte>(_pageData, offset, length);
+        }
+
+        /// <summary>
+        /// Determines whether the specified column is null.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>
+        /// <c>true</c> if the column is null; otherwise, <c>false</c>.
+        /// </returns>
+        public bool IsNull(uint rowIndex, int columnIndex)
+        {
+            if (columnIndex < 0 || columnIndex >= _rowDef.Count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(columnIndex));
+            }
+            return _serializer.IsNull(_pageData, GetRowOffset(rowIndex, out _), columnIndex);
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Bit"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public bool GetBoolean(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Bit);
+            return (_pageData[offset] & 1) != 0;
+        }
+
+        /// <summary>
+        /// Gets the value of the specified single byte <see cref="TableColumnDataType.Byte"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public byte GetByte(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Byte);
+            return _pageData[offset];
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Short"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public short GetInt16(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Short);
+            return BitConverter.ToInt16(_pageData, offset);
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Int"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public int GetInt32(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Int);
+            return BitConverter.ToInt32(_pageData, offset);
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Long"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public long GetInt64(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Long);
+            return BitConverter.ToInt64(_pageData, offset);
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Timestamp"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public ulong GetTimestamp(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Timestamp);
+            return BitConverter.ToUInt64(_pageData, offset);
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Float"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public float GetSingle(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Float);
+            return BitConverter.ToSingle(_pageData, offset);
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Double"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public double GetDouble(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Double);
+            return BitConverter.ToDouble(_pageData, offset);
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Money"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public decimal GetDecimal(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Money);
+            var flags = BitConverter.ToInt32(_pageData, offset + 12);
+            return new decimal(
+                BitConverter.ToInt32(_pageData, offset),
+                BitConverter.ToInt32(_pageData, offset + 4),
+                BitConverter.ToInt32(_pageData, offset + 8),
+                flags < 0,
+                (byte)((flags >> 16) & 0xff));
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.DateTime"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public DateTime GetDateTime(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.DateTime);
+            return new DateTime(BitConverter.ToInt64(_pageData, offset));
+        }
+
+        /// <summary>
+        /// Gets the value of the specified <see cref="TableColumnDataType.Guid"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>The column value.</returns>
+        public Guid GetGuid(uint rowIndex, int columnIndex)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, TableColumnDataType.Guid);
+            return new Guid(
+                BitConverter.ToInt32(_pageData, offset),
+                BitConverter.ToInt16(_pageData, offset + 4),
+                BitConverter.ToInt16(_pageData, offset + 6),
+                _pageData[offset + 8], _pageData[offset + 9],
+                _pageData[offset + 10], _pageData[offset + 11],
+                _pageData[offset + 12], _pageData[offset + 13],
+                _pageData[offset + 14], _pageData[offset + 15]);
+        }
+
+        /// <summary>
+        /// Gets the UTF-16 encoded characters of the specified
+        /// <see cref="TableColumnDataType.NChar"/> or
+        /// <see cref="TableColumnDataType.NVarChar"/> column.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>
+        /// An <see cref="ArraySegment{T}"/> over the character data; padding
+        /// on fixed length columns is excluded.
+        /// </returns>
+        public ArraySegment<byte> GetUtf16Span(uint rowIndex, int columnIndex)
+        {
+            var offset = GetUtf16Offset(rowIndex, columnIndex, out var length);
+            return new ArraySegment<byte>(_pageData, offset, length);
+        }
+
+        /// <summary>
+        /// Compares the specified <see cref="TableColumnDataType.NChar"/> or
+        /// <see cref="TableColumnDataType.NVarChar"/> column with a string
+        /// using an ordinal comparison.
+        /// </summary>
+        /// <param name="rowIndex">Zero based row index.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <param name="value">The value to compare with.</param>
+        /// <returns>
+        /// Less than zero if the column value sorts before
+        /// <paramref name="value"/>, zero if they are equal and greater than
+        /// zero if the column value sorts after <paramref name="value"/>.
+        /// </returns>
+        public int CompareUtf16(uint rowIndex, int columnIndex, string value)
+        {
+            if (value == null)
+            {
+                throw new ArgumentNullException(nameof(value));
+            }
+
+            var offset = GetUtf16Offset(rowIndex, columnIndex, out var length);
+            var charCount = length / 2;
+            var compareCount = Math.Min(charCount, value.Length);
+            for (var index = 0; index < compareCount; ++index)
+            {
+                var columnChar = (char)(_pageData[offset] | (_pageData[offset + 1] << 8));
+                offset += 2;
+                if (columnChar != value[index])
+                {
+                    return columnChar < value[index] ? -1 : 1;
+                }
+            }
+            return charCount.CompareTo(value.Length);
+        }
+        #endregion
+
+        #region Internal Methods
+        /// <summary>
+        /// Counts the rows recorded in the row offset table of the specified
+        /// page data.
+        /// </summary>
+        /// <param name="pageData">The page data.</param>
+        /// <param name="dataSize">Size of the page data block.</param>
+        /// <returns>The row count.</returns>
+        internal static uint CountRows(byte[] pageData, int dataSize)
+        {
+            uint rowCount = 0;
+            while (rowCount < TableDataPage.MaxRows &&
+                GetRowSlot(pageData, dataSize, rowCount) != 0)
+            {
+                ++rowCount;
+            }
+            return rowCount;
+        }
+        #endregion
+
+        #region Private Methods
+        private static int GetRowSlot(byte[] pageData, int dataSize, uint rowIndex)
+        {
+            var offset = dataSize - ((int)rowIndex * 2);
+            return pageData[offset - 1] | (pageData[offset - 2] << 8);
+        }
+
+        private int GetRowOffset(uint rowIndex, out int rowLength)
+        {
+            if (rowIndex >= RowCount)
+            {
+                throw new ArgumentOutOfRangeException(nameof(rowIndex));
+            }
+
+            var rowOffset = GetRowSlot(_pageData, _dataSize, rowIndex) - 1;
+            if (rowIndex + 1 < RowCount)
+            {
+                rowLength = GetRowSlot(_pageData, _dataSize, rowIndex + 1) - 1 - rowOffset;
+            }
+            else
+            {
+                rowLength = _totalRowDataSize - rowOffset;
+            }
+            return rowOffset;
+        }
+
+        private int GetColumnOffset(uint rowIndex, int columnIndex, out int length)
+        {
+            if (columnIndex < 0 || columnIndex >= _rowDef.Count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(columnIndex));
+            }
+
+            return _serializer.GetColumnOffset(
+                _pageData, GetRowOffset(rowIndex, out _), columnIndex, out length);
+        }
+
+        private int GetColumnOffset(uint rowIndex, int columnIndex, TableColumnDataType dataType)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, out _);
+            if (_rowDef[columnIndex].DataType != dataType)
+            {
+                throw new InvalidOperationException(
+                    $"Column {columnIndex} is not of type {dataType}.");
+            }
+            return offset;
+        }
+
+        private int GetUtf16Offset(uint rowIndex, int columnIndex, out int length)
+        {
+            var offset = GetColumnOffset(rowIndex, columnIndex, out length);
+            var dataType = _rowDef[columnIndex].DataType;
+            if (dataType == TableColumnDataType.NChar)
+            {
+                // Fixed length columns are padded with null characters
+                while (length >= 2 &&
+                    _pageData[offset + length - 1] == 0 &&
+                    _pageData[offset + length - 2] == 0)
+                {
+                    length -= 2;
+                }
+            }
+            else if (dataType != TableColumnDataType.NVarChar)
+            {
+                throw new InvalidOperationException(
+                    $"Column {columnIndex} is not a unicode character column.");
+            }
+            return offset;
+        }
+        #endregion
+    }
+}
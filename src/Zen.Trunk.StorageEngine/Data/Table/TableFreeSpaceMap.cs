@@ -0,0 +1,418 @@
+using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+
+namespace Zen.Trunk.Storage.Data.Table
+{
+    /// <summary>
+    /// <c>TableFreeSpaceMap</c> tracks how full each data page of a heap
+    /// table is so that inserts can go directly to a page with room instead
+    /// of only appending to the last page.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Every data page is placed in one of eight buckets by the fraction of
+    /// its data area that is free, with a separate bucket for pages holding
+    /// no rows. A page in bucket <c>n</c> has at least <c>n</c> eighths of
+    /// its data area free so finding a page for a row only needs to look at
+    /// the first page of each bucket that can hold it.
+    /// </para>
+    /// <para>
+    /// The map is persisted in a chain of <see cref="TableFreeSpacePage"/>
+    /// objects with one slot per data page; only slots that have changed
+    /// since the map was loaded are written back.
+    /// </para>
+    /// <para>
+    /// The map is a hint; it is updated whenever a data page attached to it
+    /// is modified. Callers must always re-validate a candidate page after
+    /// loading it.
+    /// </para>
+    /// </remarks>
+    internal sealed class TableFreeSpaceMap
+    {
+        #region Private Types
+        private class PageEntry
+        {
+            public LogicalPageId LogicalPageId;
+            public int Bucket;
+            public LinkedListNode<PageEntry> Node;
+            public LogicalPageId MapPageId;
+            public int Slot = -1;
+        }
+
+        private struct MapSlot
+        {
+            public MapSlot(LogicalPageId mapPageId, int slot)
+            {
+                MapPageId = mapPageId;
+                Slot = slot;
+            }
+
+            public LogicalPageId MapPageId { get; }
+
+            public int Slot { get; }
+        }
+        #endregion
+
+        #region Public Fields
+        /// <summary>
+        /// The number of buckets that track pages holding rows.
+        /// </summary>
+        public const int BucketCount = 8;
+
+        /// <summary>
+        /// The bucket that tracks pages holding no rows.
+        /// </summary>
+        public const int EmptyBucket = BucketCount;
+        #endregion
+
+        #region Private Fields
+        private readonly Dictionary<LogicalPageId, PageEntry> _entries =
+            new Dictionary<LogicalPageId, PageEntry>();
+        private readonly LinkedList<PageEntry>[] _buckets = new LinkedList<PageEntry>[BucketCount + 1];
+        private readonly HashSet<PageEntry> _dirtyEntries = new HashSet<PageEntry>();
+        private readonly List<MapSlot> _clearedSlots = new List<MapSlot>();
+        private readonly Stack<MapSlot> _freeSlots = new Stack<MapSlot>();
+        private uint _dataSize;
+        private LogicalPageId _lastMapPageId;
+        private int _lastMapPageEntryCount;
+        private int _lastMapPageCapacity;
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TableFreeSpaceMap"/> class.
+        /// </summary>
+        public TableFreeSpaceMap()
+        {
+            for (var index = 0; index < _buckets.Length; ++index)
+            {
+                _buckets[index] = new LinkedList<PageEntry>();
+            }
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the number of data pages tracked by the map.
+        /// </summary>
+        /// <value>
+        /// The page count.
+        /// </value>
+        public int PageCount => _entries.Count;
+
+        /// <summary>
+        /// Gets a value indicating whether the map has changes that have not
+        /// been written to the free space pages.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if this instance is dirty; otherwise, <c>false</c>.
+        /// </value>
+        public bool IsDirty => _dirtyEntries.Count > 0 || _clearedSlots.Count > 0;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Gets the bucket for a data page.
+        /// </summary>
+        /// <param name="rowCount">The number of rows on the page.</param>
+        /// <param name="freeSpace">The free space on the page.</param>
+        /// <param name="dataSize">The size of the page data area.</param>
+        /// <returns>The bucket index.</returns>
+        public static int GetBucket(uint rowCount, ushort freeSpace, uint dataSize)
+        {
+            if (rowCount == 0)
+            {
+                return EmptyBucket;
+            }
+            if (rowCount >= TableDataPage.MaxRows)
+            {
+                return 0;
+            }
+            return (int)Math.Min(BucketCount - 1, ((ulong)freeSpace * BucketCount) / dataSize);
+        }
+
+        /// <summary>
+        /// Determines whether the map tracks the specified data page.
+        /// </summary>
+        /// <param name="logicalPageId">The data page logical identifier.</param>
+        /// <returns>
+        /// <c>true</c> if the page is tracked; otherwise, <c>false</c>.
+        /// </returns>
+        public bool Contains(LogicalPageId logicalPageId)
+        {
+            return _entries.ContainsKey(logicalPageId);
+        }
+
+        /// <summary>
+        /// Adds the entries held on a free space page to the map.
+        /// </summary>
+        /// <param name="mapPage">The free space page.</param>
+        /// <remarks>
+        /// Pages must be loaded in chain order so new entries are appended
+        /// to the last page.
+        /// </remarks>
+        public void Load(TableFreeSpacePage mapPage)
+        {
+            // Data pages share the data area size of free space pages
+            _dataSize = mapPage.DataSize;
+            for (var slot = 0; slot < mapPage.EntryCount; ++slot)
+            {
+                var logicalPageId = mapPage.GetLogicalPageId(slot);
+                if (logicalPageId == LogicalPageId.Zero)
+                {
+                    _freeSlots.Push(new MapSlot(mapPage.LogicalPageId, slot));
+                    continue;
+                }
+
+                var entry =
+                    new PageEntry
+                    {
+                        LogicalPageId = logicalPageId,
+                        Bucket = Math.Min((int)mapPage.GetBucket(slot), EmptyBucket),
+                        MapPageId = mapPage.LogicalPageId,
+                        Slot = slot
+                    };
+                entry.Node = _buckets[entry.Bucket].AddLast(entry);
+                _entries[logicalPageId] = entry;
+            }
+
+            _lastMapPageId = mapPage.LogicalPageId;
+            _lastMapPageEntryCount = mapPage.EntryCount;
+            _lastMapPageCapacity = mapPage.MaxEntries;
+        }
+
+        /// <summary>
+        /// Updates the entry for a data page.
+        /// </summary>
+        /// <param name="page">The data page.</param>
+        public void Update(TableDataPage page)
+        {
+            Update(page.LogicalPageId, page.RowCount, page.FreeSpace, page.DataSize);
+        }
+
+        /// <summary>
+        /// Updates the entry for a data page.
+        /// </summary>
+        /// <param name="logicalPageId">The data page logical identifier.</param>
+        /// <param name="rowCount">The number of rows on the page.</param>
+        /// <param name="freeSpace">The free space on the page.</param>
+        /// <param name="dataSize">The size of the page data area.</param>
+        public void Update(LogicalPageId logicalPageId, uint rowCount, ushort freeSpace, uint dataSize)
+        {
+            _dataSize = dataSize;
+            var bucket = GetBucket(rowCount, freeSpace, dataSize);
+            if (!_entries.TryGetValue(logicalPageId, out var entry))
+            {
+                entry =
+                    new PageEntry
+                    {
+                        LogicalPageId = logicalPageId,
+                        Bucket = bucket
+                    };
+                entry.Node = _buckets[bucket].AddLast(entry);
+                _entries.Add(logicalPageId, entry);
+                _dirtyEntries.Add(entry);
+            }
+            else if (entry.Bucket != bucket)
+            {
+                _buckets[entry.Bucket].Remove(entry.Node);
+                entry.Bucket = bucket;
+                entry.Node = _buckets[bucket].AddLast(entry);
+                _dirtyEntries.Add(entry);
+            }
+        }
+
+        /// <summary>
+        /// Removes the entry for a data page that no longer belongs to the
+        /// table.
+        /// </summary>
+        /// <param name="logicalPageId">The data page logical identifier.</param>
+        public void Remove(LogicalPageId logicalPageId)
+        {
+            if (!_entries.TryGetValue(logicalPageId, out var entry))
+            {
+                return;
+            }
+
+            _buckets[entry.Bucket].Remove(entry.Node);
+            _entries.Remove(logicalPageId);
+            _dirtyEntries.Remove(entry);
+            if (entry.Slot >= 0)
+            {
+                var slot = new MapSlot(entry.MapPageId, entry.Slot);
+                _clearedSlots.Add(slot);
+                _freeSlots.Push(slot);
+            }
+        }
+
+        /// <summary>
+        /// Finds a data page that should have room for a row of the
+        /// specified size.
+        /// </summary>
+        /// <param name="rowSize">The row size.</param>
+        /// <param name="excludeLogicalPageId">
+        /// A page that is already known to be unsuitable.
+        /// </param>
+        /// <param name="logicalPageId">The candidate page.</param>
+        /// <returns>
+        /// <c>true</c> if a candidate was found; otherwise, <c>false</c>.
+        /// </returns>
+        /// <remarks>
+        /// The fullest pages that can hold the row are preferred so pages
+        /// that are mostly empty drain and can be reclaimed.
+        /// </remarks>
+        public bool TryFindPage(ushort rowSize, LogicalPageId excludeLogicalPageId, out LogicalPageId logicalPageId)
+        {
+            logicalPageId = LogicalPageId.Zero;
+            if (_dataSize == 0)
+            {
+                return false;
+            }
+
+            // Account for row padding and the row offset table entry
+            var required = (ulong)Math.Max(rowSize, (ushort)TableDataPage.MinRowBytes) + 2;
+            var firstBucket = Math.Max(1UL, ((required * BucketCount) + _dataSize - 1) / _dataSize);
+
+            // Rows needing more than the emptiest bucket only fit empty pages
+            for (var bucket = (int)Math.Min(firstBucket, EmptyBucket); bucket <= EmptyBucket; ++bucket)
+            {
+                foreach (var entry in _buckets[bucket])
+                {
+                    if (entry.LogicalPageId != excludeLogicalPageId)
+                    {
+                        logicalPageId = entry.LogicalPageId;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Gets the data pages that compaction should try to reclaim.
+        /// </summary>
+        /// <param name="includeMostlyEmpty">
+        /// <c>true</c> to include pages holding rows in the emptiest bucket;
+        /// otherwise, <c>false</c> to only include pages holding no rows.
+        /// </param>
+        /// <returns>The candidate pages.</returns>
+        public IList<LogicalPageId> GetReclaimCandidates(bool includeMostlyEmpty)
+        {
+            var candidates = new List<LogicalPageId>();
+            foreach (var entry in _buckets[EmptyBucket])
+            {
+                candidates.Add(entry.LogicalPageId);
+            }
+            if (includeMostlyEmpty)
+            {
+                foreach (var entry in _buckets[BucketCount - 1])
+                {
+                    candidates.Add(entry.LogicalPageId);
+                }
+            }
+            return candidates;
+        }
+
+        /// <summary>
+        /// Writes the changed entries back to the free space pages.
+        /// </summary>
+        /// <param name="loadMapPageAsync">
+        /// Loads the free space page with the specified identifier.
+        /// </param>
+        /// <param name="createMapPageAsync">
+        /// Creates a new free space page linked after the specified page or
+        /// as the first page when the identifier is zero.
+        /// </param>
+        /// <returns></returns>
+        public async Task SaveAsync(
+            Func<LogicalPageId, Task<TableFreeSpacePage>> loadMapPageAsync,
+            Func<LogicalPageId, Task<TableFreeSpacePage>> createMapPageAsync)
+        {
+            if (!IsDirty)
+            {
+                return;
+            }
+
+            // Group slot writes by free space page; cleared slots come first
+            //	so a slot reused since it was cleared takes the new entry
+            var writes = new Dictionary<LogicalPageId, Dictionary<int, PageEntry>>();
+            foreach (var slot in _clearedSlots)
+            {
+                GetPageWrites(writes, slot.MapPageId)[slot.Slot] = null;
+            }
+
+            foreach (var entry in _dirtyEntries)
+            {
+                if (entry.Slot < 0)
+                {
+                    await AssignSlotAsync(entry, createMapPageAsync).ConfigureAwait(false);
+                }
+                GetPageWrites(writes, entry.MapPageId)[entry.Slot] = entry;
+            }
+
+            foreach (var pageWrites in writes)
+            {
+                using (var mapPage = await loadMapPageAsync(pageWrites.Key).ConfigureAwait(false))
+                {
+                    foreach (var write in pageWrites.Value)
+                    {
+                        if (write.Value == null)
+                        {
+                            mapPage.SetEntry(write.Key, LogicalPageId.Zero, 0);
+                        }
+                        else
+                        {
+                            mapPage.SetEntry(write.Key, write.Value.LogicalPageId, (byte)write.Value.Bucket);
+                        }
+                    }
+                }
+            }
+
+            _clearedSlots.Clear();
+            _dirtyEntries.Clear();
+        }
+        #endregion
+
+        #region Private Methods
+        private static Dictionary<int, PageEntry> GetPageWrites(
+            Dictionary<LogicalPageId, Dictionary<int, PageEntry>> writes, LogicalPageId mapPageId)
+        {
+            if (!writes.TryGetValue(mapPageId, out var pageWrites))
+            {
+                pageWrites = new Dictionary<int, PageEntry>();
+                writes.Add(mapPageId, pageWrites);
+            }
+            return pageWrites;
+        }
+
+        private async Task AssignSlotAsync(
+            PageEntry entry, Func<LogicalPageId, Task<TableFreeSpacePage>> createMapPageAsync)
+        {
+            // Reuse slots of pages that have been removed first
+            if (_freeSlots.Count > 0)
+            {
+                var slot = _freeSlots.Pop();
+                entry.MapPageId = slot.MapPageId;
+                entry.Slot = slot.Slot;
+                return;
+            }
+
+            // Chain a new free space page when the last page is full
+            if (_lastMapPageId == LogicalPageId.Zero ||
+                _lastMapPageEntryCount >= _lastMapPageCapacity)
+            {
+                using (var mapPage = await createMapPageAsync(_lastMapPageId).ConfigureAwait(false))
+                {
+                    _lastMapPageId = mapPage.LogicalPageId;
+                    _lastMapPageEntryCount = 0;
+                    _lastMapPageCapacity = mapPage.MaxEntries;
+                }
+            }
+
+            entry.MapPageId = _lastMapPageId;
+            entry.Slot = _lastMapPageEntryCount++;
+        }
+        #endregion
+    }
+}
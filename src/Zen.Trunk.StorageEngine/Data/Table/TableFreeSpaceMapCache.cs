@@ -0,0 +1,90 @@
+using System.Collections.Concurrent;
+
+namespace Zen.Trunk.Storage.Data.Table
+{
+    /// <summary>
+    /// <c>TableFreeSpaceMapCache</c> keeps the free space map of each heap
+    /// table between statements so that it is not reloaded from the free
+    /// space pages every time a table is opened.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// A map is taken out of the cache by the statement that uses it and
+    /// returned once the statement has saved it; a statement that finds no
+    /// map loads it from the free space pages.
+    /// </para>
+    /// <para>
+    /// Each map is stored with the logical id and timestamp of the first
+    /// free space page as they were when the map was saved. Every save
+    /// rewrites the first page so a map is only reused when the page still
+    /// has that timestamp; a transaction that rolled back the map restores
+    /// the earlier timestamp and the map is discarded.
+    /// </para>
+    /// </remarks>
+    internal sealed class TableFreeSpaceMapCache
+    {
+        #region Private Types
+        private class CacheEntry
+        {
+            public CacheEntry(TableFreeSpaceMap freeSpaceMap, LogicalPageId firstLogicalPageId, long timestamp)
+            {
+                FreeSpaceMap = freeSpaceMap;
+                FirstLogicalPageId = firstLogicalPageId;
+                Timestamp = timestamp;
+            }
+
+            public TableFreeSpaceMap FreeSpaceMap { get; }
+
+            public LogicalPageId FirstLogicalPageId { get; }
+
+            public long Timestamp { get; }
+        }
+        #endregion
+
+        #region Private Fields
+        private readonly ConcurrentDictionary<ObjectId, CacheEntry> _entries =
+            new ConcurrentDictionary<ObjectId, CacheEntry>();
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Takes the cached map for the specified table if it matches the
+        /// first free space page.
+        /// </summary>
+        /// <param name="objectId">The table object identifier.</param>
+        /// <param name="firstLogicalPageId">The logical id of the first free space page.</param>
+        /// <param name="timestamp">The timestamp of the first free space page.</param>
+        /// <param name="freeSpaceMap">When this method returns <c>true</c>, the cached map.</param>
+        /// <returns>
+        /// <c>true</c> if a current map was taken from the cache; otherwise, <c>false</c>.
+        /// </returns>
+        public bool TryTake(
+            ObjectId objectId, LogicalPageId firstLogicalPageId, long timestamp, out TableFreeSpaceMap freeSpaceMap)
+        {
+            freeSpaceMap = null;
+            if (!_entries.TryRemove(objectId, out var entry) ||
+                entry.FirstLogicalPageId != firstLogicalPageId ||
+                entry.Timestamp != timestamp)
+            {
+                return false;
+            }
+
+            freeSpaceMap = entry.FreeSpaceMap;
+            return true;
+        }
+
+        /// <summary>
+        /// Returns a saved map for the specified table to the cache.
+        /// </summary>
+        /// <param name="objectId">The table object identifier.</param>
+        /// <param name="freeSpaceMap">The free space map.</param>
+        /// <param name="firstLogicalPageId">The logical id of the first free space page.</param>
+        /// <param name="timestamp">The timestamp of the first free space page after the save.</param>
+        public void Return(
+            ObjectId objectId, TableFreeSpaceMap freeSpaceMap, LogicalPageId firstLogicalPageId, long timestamp)
+        {
+            _entries[objectId] = new CacheEntry(freeSpaceMap, firstLogicalPageId, timestamp);
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,171 @@
+using System.Collections.Generic;
+using System.Threading.Tasks;
+using Zen.Trunk.IO;
+using Zen.Trunk.Storage.BufferFields;
+
+namespace Zen.Trunk.Storage.Data.Table
+{
+    /// <summary>
+    /// <c>TableFreeSpacePage</c> holds part of the free space map of a heap
+    /// table.
+    /// </summary>
+    /// <remarks>
+    /// Each slot holds the logical identifier of a data page together with
+    /// the free space bucket it was last placed in. Slots of pages that have
+    /// been removed from the table are cleared and reused.
+    /// </remarks>
+    public class TableFreeSpacePage : ObjectDataPage
+    {
+        #region Private Fields
+        private const int EntrySize = 9;
+
+        private readonly BufferFieldUInt16 _entryCount;
+        private readonly List<ulong> _logicalPageIds = new List<ulong>();
+        private readonly List<byte> _buckets = new List<byte>();
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TableFreeSpacePage"/> class.
+        /// </summary>
+        public TableFreeSpacePage()
+        {
+            _entryCount = new BufferFieldUInt16(base.LastHeaderField);
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the minimum size of the header.
+        /// </summary>
+        /// <value>
+        /// The minimum size of the header.
+        /// </value>
+        public override uint MinHeaderSize => base.MinHeaderSize + 2;
+
+        /// <summary>
+        /// Gets the number of slots in use on this page.
+        /// </summary>
+        /// <value>
+        /// The entry count.
+        /// </value>
+        public int EntryCount => _logicalPageIds.Count;
+
+        /// <summary>
+        /// Gets the maximum number of slots this page can hold.
+        /// </summary>
+        /// <value>
+        /// The maximum entry count.
+        /// </value>
+        public int MaxEntries => (int)(DataSize / EntrySize);
+        #endregion
+
+        #region Protected Properties
+        /// <summary>
+        /// Gets the last header field.
+        /// </summary>
+        /// <value>
+        /// The last header field.
+        /// </value>
+        protected override BufferField LastHeaderField => _entryCount;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Gets the data page logical identifier held in a slot.
+        /// </summary>
+        /// <param name="slot">The slot.</param>
+        /// <returns>
+        /// The logical page identifier or <see cref="LogicalPageId.Zero"/>
+        /// if the slot is free.
+        /// </returns>
+        public LogicalPageId GetLogicalPageId(int slot)
+        {
+            return new LogicalPageId(_logicalPageIds[slot]);
+        }
+
+        /// <summary>
+        /// Gets the free space bucket held in a slot.
+        /// </summary>
+        /// <param name="slot">The slot.</param>
+        /// <returns>The bucket.</returns>
+        public byte GetBucket(int slot)
+        {
+            return _buckets[slot];
+        }
+
+        /// <summary>
+        /// Sets the entry held in a slot.
+        /// </summary>
+        /// <param name="slot">The slot.</param>
+        /// <param name="logicalPageId">The data page logical identifier.</param>
+        /// <param name="bucket">The free space bucket.</param>
+        /// <remarks>
+        /// Slots beyond the current entry count are added as free slots.
+        /// </remarks>
+        public void SetEntry(int slot, LogicalPageId logicalPageId, byte bucket)
+        {
+            while (_logicalPageIds.Count <= slot)
+            {
+                _logicalPageIds.Add(0);
+                _buckets.Add(0);
+            }
+
+            _logicalPageIds[slot] = logicalPageId.Value;
+            _buckets[slot] = bucket;
+            SetHeaderDirty();
+            SetDataDirty();
+        }
+        #endregion
+
+        #region Protected Methods
+        /// <summary>
+        /// Raises the <see cref="E:Init" /> event.
+        /// </summary>
+        /// <returns></returns>
+        protected override Task OnInitAsync()
+        {
+            PageType = PageType.Table;
+            return base.OnInitAsync();
+        }
+
+        /// <summary>
+        /// Writes the page header block to the specified buffer writer.
+        /// </summary>
+        /// <param name="streamManager">The stream manager.</param>
+        protected override void WriteHeader(SwitchingBinaryWriter streamManager)
+        {
+            _entryCount.Value = (ushort)_logicalPageIds.Count;
+            base.WriteHeader(streamManager);
+        }
+
+        /// <summary>
+        /// Reads the page data block from the specified buffer reader.
+        /// </summary>
+        /// <param name="streamManager">The stream manager.</param>
+        protected override void ReadData(SwitchingBinaryReader streamManager)
+        {
+            _logicalPageIds.Clear();
+            _buckets.Clear();
+            for (var index = 0; index < _entryCount.Value; ++index)
+            {
+                _logicalPageIds.Add(streamManager.ReadUInt64());
+                _buckets.Add(streamManager.ReadByte());
+            }
+        }
+
+        /// <summary>
+        /// Writes the page data block to the specified buffer writer.
+        /// </summary>
+        /// <param name="streamManager">The stream manager.</param>
+        protected override void WriteData(SwitchingBinaryWriter streamManager)
+        {
+            for (var index = 0; index < _logicalPageIds.Count; ++index)
+            {
+                streamManager.Write(_logicalPageIds[index]);
+                streamManager.Write(_buckets[index]);
+            }
+        }
+        #endregion
+    }
+}
@@ -17,7 +17,10 @@ namespace Zen.Trunk.Storage.Data.Table
     {
         #region Private Fields
         private RootTableIndexInfo _rootInfo;
+        private TableColumnInfo[] _columns;
         private readonly BufferFieldTableRow _keyRow;
+        private byte[] _normalizedKey;
+        private bool _isPartialKey;
         #endregion
 
         #region Public Constructors
@@ -52,7 +55,11 @@ namespace Zen.Trunk.Storage.Data.Table
         public object this[int index]
         {
             get => _keyRow[index];
-            set => _keyRow[index] = value;
+            set
+            {
+                _keyRow[index] = value;
+                _normalizedKey = null;
+            }
         }
 
         /// <summary>
@@ -120,6 +127,8 @@ namespace Zen.Trunk.Storage.Data.Table
 
             // Set row context
             _keyRow.SetContext(columns);
+            _columns = columns;
+            _normalizedKey = null;
         }
 
         /// <summary>
@@ -151,25 +160,48 @@ namespace Zen.Trunk.Storage.Data.Table
                 throw new ArgumentException("Key length mismatch.");
             }
 
-            for (var index = 0; index < _keyRow.KeyLength; ++index)
+            // Normalized keys already account for sort direction so this
+            //	is a plain byte comparison
+            var lhsKey = GetNormalizedKey(tiRhs, out var lhsPartial);
+            var rhsKey = tiRhs.GetNormalizedKey(this, out var rhsPartial);
+            return TableIndexKeyEncoder.Compare(lhsKey, lhsPartial, rhsKey, rhsPartial);
+        }
+        #endregion
+
+        #region Internal Methods
+        /// <summary>
+        /// Gets the normalized (byte comparable) encoding of the keys.
+        /// </summary>
+        /// <param name="context">
+        /// An index entry whose context is used when this instance has none,
+        /// as is the case for search keys.
+        /// </param>
+        /// <param name="isPartial">
+        /// Set to <c>true</c> when the key ends in a wildcard column.
+        /// </param>
+        /// <returns>The normalized key.</returns>
+        /// <exception cref="InvalidOperationException">No context.</exception>
+        internal byte[] GetNormalizedKey(TableIndexInfo context, out bool isPartial)
+        {
+            if (_normalizedKey == null)
             {
-                var comp = _keyRow.GetComparer(index);
-                var value = comp.Compare(_keyRow[index], tiRhs._keyRow[index]);
-                if (value != 0)
+                var source = _columns != null ? this : context;
+                if (source?._columns == null)
                 {
-                    // When sort order is descending then flip sign
-                    if (_rootInfo.ColumnDirections[index] == TableIndexSortDirection.Descending)
-                    {
-                        value = -value;
-                    }
+                    throw new InvalidOperationException("No context.");
+                }
 
-                    // Return the value
-                    return value;
+                var keys = new object[_keyRow.KeyLength];
+                for (var index = 0; index < keys.Length; ++index)
+                {
+                    keys[index] = _keyRow[index];
                 }
+                _normalizedKey = TableIndexKeyEncoder.Encode(
+                    keys, source._columns, source._rootInfo.ColumnDirections, out _isPartialKey);
             }
 
-            // Indices are the same
-            return 0;
+            isPartial = _isPartialKey;
+            return _normalizedKey;
         }
         #endregion
 
@@ -183,6 +215,7 @@ namespace Zen.Trunk.Storage.Data.Table
             // Wire up columns
             base.OnRead(reader);
             _keyRow.Read(reader);
+            _normalizedKey = null;
         }
 
         /// <summary>
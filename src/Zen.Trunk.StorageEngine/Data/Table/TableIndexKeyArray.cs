@@ -0,0 +1,161 @@
+using System;
+using System.Collections.Generic;
+
+namespace Zen.Trunk.Storage.Data.Table
+{
+    /// <summary>
+    /// Compact, prefix compressed array of the normalized keys held on an
+    /// index page used to binary search for a descent point.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Entries on a page are sorted so the bytes shared by the first and
+    /// last keys are shared by every key; they are stored once and only the
+    /// remaining suffix of each key is kept, back-to-back in a single buffer.
+    /// </para>
+    /// <para>
+    /// The array keeps the entries it was built from so a search can detect
+    /// that the page has changed since. Binary search only depends on the
+    /// entries it probes so checking those is enough to trust the result.
+    /// </para>
+    /// </remarks>
+    internal sealed class TableIndexKeyArray
+    {
+        #region Private Fields
+        private readonly TableIndexInfo[] _entries;
+        private readonly byte[] _prefix;
+        private readonly byte[] _suffixData;
+        private readonly int[] _suffixOffsets;
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TableIndexKeyArray"/> class.
+        /// </summary>
+        /// <param name="entries">The sorted index entries.</param>
+        public TableIndexKeyArray(IList<TableIndexInfo> entries)
+        {
+            _entries = new TableIndexInfo[entries.Count];
+            entries.CopyTo(_entries, 0);
+
+            var keys = new byte[_entries.Length][];
+            var context = _entries.Length > 0 ? _entries[0] : null;
+            for (var index = 0; index < _entries.Length; ++index)
+            {
+                keys[index] = _entries[index].GetNormalizedKey(context, out _);
+            }
+
+            // Strip the prefix common to the whole page
+            var prefixLength = keys.Length > 0
+                ? TableIndexKeyEncoder.GetCommonPrefixLength(keys[0], keys[keys.Length - 1])
+                : 0;
+            _prefix = new byte[prefixLength];
+            if (prefixLength > 0)
+            {
+                Array.Copy(keys[0], _prefix, prefixLength);
+            }
+
+            var suffixSize = 0;
+            foreach (var key in keys)
+            {
+                suffixSize += key.Length - prefixLength;
+            }
+
+            _suffixData = new byte[suffixSize];
+            _suffixOffsets = new int[keys.Length + 1];
+            var offset = 0;
+            for (var index = 0; index < keys.Length; ++index)
+            {
+                var suffixLength = keys[index].Length - prefixLength;
+                Array.Copy(keys[index], prefixLength, _suffixData, offset, suffixLength);
+                _suffixOffsets[index] = offset;
+                offset += suffixLength;
+            }
+            _suffixOffsets[keys.Length] = offset;
+        }
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Finds the last entry with a key less than or equal to the search
+        /// key.
+        /// </summary>
+        /// <param name="entries">The current page entries.</param>
+        /// <param name="key">The normalized search key.</param>
+        /// <param name="isPartial">Whether the search key is partial.</param>
+        /// <param name="entryIndex">
+        /// The entry index or -1 when the search key sorts before every entry.
+        /// </param>
+        /// <returns>
+        /// <c>true</c> if the search succeeded; otherwise, <c>false</c> when
+        /// the page entries have changed and the array must be rebuilt.
+        /// </returns>
+        public bool TryFindLastLessOrEqual(
+            IList<TableIndexInfo> entries, byte[] key, bool isPartial, out int entryIndex)
+        {
+            entryIndex = -1;
+            if (entries.Count != _entries.Length)
+            {
+                return false;
+            }
+            if (_entries.Length == 0)
+            {
+                return true;
+            }
+
+            // The shared prefix is only valid while the end entries are
+            var lastIndex = _entries.Length - 1;
+            if (!ReferenceEquals(entries[0], _entries[0]) ||
+                !ReferenceEquals(entries[lastIndex], _entries[lastIndex]))
+            {
+                return false;
+            }
+
+            // Compare against the shared prefix once for the whole page
+            var compareLength = Math.Min(key.Length, _prefix.Length);
+            var prefixComparison = TableIndexKeyEncoder.Compare(
+                key, 0, compareLength, false,
+                _prefix, 0, compareLength, false);
+            if (prefixComparison == 0 && key.Length < _prefix.Length)
+            {
+                // A partial key ending within the prefix matches every entry
+                prefixComparison = isPartial ? 1 : -1;
+            }
+            if (prefixComparison < 0)
+            {
+                return true;
+            }
+            if (prefixComparison > 0)
+            {
+                entryIndex = lastIndex;
+                return true;
+            }
+
+            var low = 0;
+            var high = lastIndex;
+            while (low <= high)
+            {
+                var middle = low + ((high - low) / 2);
+                if (!ReferenceEquals(entries[middle], _entries[middle]))
+                {
+                    return false;
+                }
+
+                var comparison = TableIndexKeyEncoder.Compare(
+                    _suffixData, _suffixOffsets[middle], _suffixOffsets[middle + 1] - _suffixOffsets[middle], false,
+                    key, _prefix.Length, key.Length - _prefix.Length, isPartial);
+                if (comparison <= 0)
+                {
+                    entryIndex = middle;
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle - 1;
+                }
+            }
+            return true;
+        }
+        #endregion
+    }
+}
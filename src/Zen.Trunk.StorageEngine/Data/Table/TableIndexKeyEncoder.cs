@@ -0,0 +1,355 @@
+using System;
+using System.Collections.Generic;
+
+namespace Zen.Trunk.Storage.Data.Table
+{
+    /// <summary>
+    /// Encodes index keys into normalized byte strings that sort in index
+    /// order under a plain unsigned byte comparison.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each key column is encoded in turn so composite keys compare column
+    /// by column. Nullable columns are preceded by a marker byte that sorts
+    /// nulls after all other values and descending columns have every byte
+    /// of their encoding inverted.
+    /// </para>
+    /// <para>
+    /// Strings compare by UTF-16 code unit (ordinal) and trailing padding on
+    /// fixed length character columns is ignored. Variable length values
+    /// escape zero bytes as 0x00 0xFF and end with 0x00 0x00 so a value
+    /// sorts before any longer value it is a prefix of.
+    /// </para>
+    /// <para>
+    /// A null value for a non-nullable column acts as a wildcard (used to
+    /// search a non-unique clustered index without its uniquifier); the
+    /// encoding stops at that column and the key is marked as partial so it
+    /// compares equal to every key it is a prefix of.
+    /// </para>
+    /// </remarks>
+    internal static class TableIndexKeyEncoder
+    {
+        #region Private Fields
+        private const byte ValueMarker = 0x00;
+        private const byte NullMarker = 0x01;
+        private const byte EscapeByte = 0xff;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Encodes the specified key values.
+        /// </summary>
+        /// <param name="keys">The key values.</param>
+        /// <param name="columns">The key column definitions.</param>
+        /// <param name="directions">The key column sort directions.</param>
+        /// <param name="isPartial">
+        /// Set to <c>true</c> when encoding stopped at a wildcard column.
+        /// </param>
+        /// <returns>The normalized key.</returns>
+        public static byte[] Encode(
+            IList<object> keys,
+            IList<TableColumnInfo> columns,
+            IList<TableIndexSortDirection> directions,
+            out bool isPartial)
+        {
+            var buffer = new byte[GetEncodedSizeEstimate(columns)];
+            var length = 0;
+            isPartial = false;
+            for (var index = 0; index < keys.Count; ++index)
+            {
+                var column = columns[index];
+                var value = keys[index];
+                var isNull = value == null || value == DBNull.Value;
+                if (isNull && !column.Nullable)
+                {
+                    isPartial = true;
+                    break;
+                }
+
+                var start = length;
+                if (column.Nullable)
+                {
+                    Append(ref buffer, ref length, isNull ? NullMarker : ValueMarker);
+                }
+                if (!isNull)
+                {
+                    EncodeValue(ref buffer, ref length, column, value);
+                }
+
+                if (directions != null &&
+                    index < directions.Count &&
+                    directions[index] == TableIndexSortDirection.Descending)
+                {
+                    for (var offset = start; offset < length; ++offset)
+                    {
+                        buffer[offset] = (byte)~buffer[offset];
+                    }
+                }
+            }
+
+            var result = new byte[length];
+            Array.Copy(buffer, result, length);
+            return result;
+        }
+
+        /// <summary>
+        /// Compares two normalized keys.
+        /// </summary>
+        /// <param name="lhs">The left hand key buffer.</param>
+        /// <param name="lhsOffset">The offset of the left hand key.</param>
+        /// <param name="lhsLength">The length of the left hand key.</param>
+        /// <param name="lhsPartial">Whether the left hand key is partial.</param>
+        /// <param name="rhs">The right hand key buffer.</param>
+        /// <param name="rhsOffset">The offset of the right hand key.</param>
+        /// <param name="rhsLength">The length of the right hand key.</param>
+        /// <param name="rhsPartial">Whether the right hand key is partial.</param>
+        /// <returns>
+        /// Less than zero when the left hand key sorts first, zero when they
+        /// are equal and greater than zero when the right hand key sorts first.
+        /// </returns>
+        public static int Compare(
+            byte[] lhs, int lhsOffset, int lhsLength, bool lhsPartial,
+            byte[] rhs, int rhsOffset, int rhsLength, bool rhsPartial)
+        {
+            var length = Math.Min(lhsLength, rhsLength);
+            for (var index = 0; index < length; ++index)
+            {
+                var lhsByte = lhs[lhsOffset + index];
+                var rhsByte = rhs[rhsOffset + index];
+                if (lhsByte != rhsByte)
+                {
+                    return lhsByte < rhsByte ? -1 : 1;
+                }
+            }
+
+            // A partial key matches every key it is a prefix of
+            if ((lhsPartial && lhsLength <= rhsLength) ||
+                (rhsPartial && rhsLength <= lhsLength))
+            {
+                return 0;
+            }
+            return lhsLength.CompareTo(rhsLength);
+        }
+
+        /// <summary>
+        /// Compares two normalized keys.
+        /// </summary>
+        /// <param name="lhs">The left hand key.</param>
+        /// <param name="lhsPartial">Whether the left hand key is partial.</param>
+        /// <param name="rhs">The right hand key.</param>
+        /// <param name="rhsPartial">Whether the right hand key is partial.</param>
+        /// <returns>
+        /// Less than zero when the left hand key sorts first, zero when they
+        /// are equal and greater than zero when the right hand key sorts first.
+        /// </returns>
+        public static int Compare(byte[] lhs, bool lhsPartial, byte[] rhs, bool rhsPartial)
+        {
+            return Compare(lhs, 0, lhs.Length, lhsPartial, rhs, 0, rhs.Length, rhsPartial);
+        }
+
+        /// <summary>
+        /// Gets the length of the prefix shared by two normalized keys.
+        /// </summary>
+        /// <param name="lhs">The left hand key.</param>
+        /// <param name="rhs">The right hand key.</param>
+        /// <returns>The number of leading bytes the keys have in common.</returns>
+        public static int GetCommonPrefixLength(byte[] lhs, byte[] rhs)
+        {
+            var length = Math.Min(lhs.Length, rhs.Length);
+            var index = 0;
+            while (index < length && lhs[index] == rhs[index])
+            {
+                ++index;
+            }
+            return index;
+        }
+        #endregion
+
+        #region Private Methods
+        private static int GetEncodedSizeEstimate(IList<TableColumnInfo> columns)
+        {
+            var size = 0;
+            foreach (var column in columns)
+            {
+                size += column.MaxDataSize + 3;
+            }
+            return Math.Max(size, 16);
+        }
+
+        private static void EncodeValue(ref byte[] buffer, ref int length, TableColumnInfo column, object value)
+        {
+            switch (column.DataType)
+            {
+                case TableColumnDataType.Bit:
+                    Append(ref buffer, ref length, (bool)value ? (byte)1 : (byte)0);
+                    break;
+
+                case TableColumnDataType.Byte:
+                    if (value is byte[] bytes)
+                    {
+                        AppendEscaped(ref buffer, ref length, bytes, bytes.Length);
+                    }
+                    else
+                    {
+                        Append(ref buffer, ref length, (byte)value);
+                    }
+                    break;
+
+                case TableColumnDataType.Short:
+                    AppendBigEndian(ref buffer, ref length, (ulong)(ushort)((short)value ^ short.MinValue), 2);
+                    break;
+
+                case TableColumnDataType.Int:
+                    AppendBigEndian(ref buffer, ref length, (uint)((int)value ^ int.MinValue), 4);
+                    break;
+
+                case TableColumnDataType.Long:
+                    AppendBigEndian(ref buffer, ref length, (ulong)((long)value ^ long.MinValue), 8);
+                    break;
+
+                case TableColumnDataType.Timestamp:
+                    AppendBigEndian(ref buffer, ref length, (ulong)value, 8);
+                    break;
+
+                case TableColumnDataType.DateTime:
+                    AppendBigEndian(ref buffer, ref length, (ulong)(((DateTime)value).Ticks ^ long.MinValue), 8);
+                    break;
+
+                case TableColumnDataType.Float:
+                    AppendBigEndian(ref buffer, ref length, GetOrderedBits(BitConverter.DoubleToInt64Bits((float)value)), 8);
+                    break;
+
+                case TableColumnDataType.Double:
+                    AppendBigEndian(ref buffer, ref length, GetOrderedBits(BitConverter.DoubleToInt64Bits((double)value)), 8);
+                    break;
+
+                case TableColumnDataType.Money:
+                    AppendDecimal(ref buffer, ref length, (decimal)value);
+                    break;
+
+                case TableColumnDataType.Guid:
+                    AppendGuid(ref buffer, ref length, (Guid)value);
+                    break;
+
+                case TableColumnDataType.Char:
+                case TableColumnDataType.NChar:
+                case TableColumnDataType.VarChar:
+                case TableColumnDataType.NVarChar:
+                    if (value is char ch)
+                    {
+                        AppendBigEndian(ref buffer, ref length, ch, 2);
+                    }
+                    else
+                    {
+                        var text = (string)value;
+                        if (column.DataType == TableColumnDataType.Char ||
+                            column.DataType == TableColumnDataType.NChar)
+                        {
+                            text = text.TrimEnd(' ');
+                        }
+
+                        var textBytes = new byte[text.Length * 2];
+                        for (var index = 0; index < text.Length; ++index)
+                        {
+                            textBytes[index * 2] = (byte)(text[index] >> 8);
+                            textBytes[(index * 2) + 1] = (byte)text[index];
+                        }
+                        AppendEscaped(ref buffer, ref length, textBytes, textBytes.Length);
+                    }
+                    break;
+
+                default:
+                    throw new InvalidOperationException("Unknown column type specified.");
+            }
+        }
+
+        private static ulong GetOrderedBits(long bits)
+        {
+            // Negative zero compares equal to zero
+            if (bits == long.MinValue)
+            {
+                bits = 0;
+            }
+
+            // Negative values have all bits flipped so larger magnitudes sort
+            //  first; positive values only need the sign bit set
+            return bits < 0 ? (ulong)~bits : (ulong)bits ^ 0x8000000000000000UL;
+        }
+
+        private static void AppendDecimal(ref byte[] buffer, ref int length, decimal value)
+        {
+            // Encode the magnitude as a 96-bit integer part followed by the
+            //  fraction scaled to 28 digits; both fit exactly in a decimal
+            var isNegative = value < 0m;
+            var magnitude = Math.Abs(value);
+            var integerPart = decimal.Truncate(magnitude);
+            var fractionPart = (magnitude - integerPart) * 10000000000000000000000000000m;
+
+            var start = length;
+            Append(ref buffer, ref length, isNegative ? (byte)0 : (byte)1);
+            AppendDecimalMantissa(ref buffer, ref length, integerPart);
+            AppendDecimalMantissa(ref buffer, ref length, decimal.Truncate(fractionPart));
+            if (isNegative)
+            {
+                for (var offset = start + 1; offset < length; ++offset)
+                {
+                    buffer[offset] = (byte)~buffer[offset];
+                }
+            }
+        }
+
+        private static void AppendDecimalMantissa(ref byte[] buffer, ref int length, decimal value)
+        {
+            var bits = decimal.GetBits(value);
+            AppendBigEndian(ref buffer, ref length, (uint)bits[2], 4);
+            AppendBigEndian(ref buffer, ref length, (uint)bits[1], 4);
+            AppendBigEndian(ref buffer, ref length, (uint)bits[0], 4);
+        }
+
+        private static void AppendGuid(ref byte[] buffer, ref int length, Guid value)
+        {
+            // Match Guid.CompareTo which orders by the leading fields as
+            //  unsigned integers and then the remaining bytes
+            var bytes = value.ToByteArray();
+            AppendBigEndian(ref buffer, ref length, BitConverter.ToUInt32(bytes, 0), 4);
+            AppendBigEndian(ref buffer, ref length, BitConverter.ToUInt16(bytes, 4), 2);
+            AppendBigEndian(ref buffer, ref length, BitConverter.ToUInt16(bytes, 6), 2);
+            for (var index = 8; index < 16; ++index)
+            {
+                Append(ref buffer, ref length, bytes[index]);
+            }
+        }
+
+        private static void AppendEscaped(ref byte[] buffer, ref int length, byte[] value, int count)
+        {
+            for (var index = 0; index < count; ++index)
+            {
+                Append(ref buffer, ref length, value[index]);
+                if (value[index] == 0)
+                {
+                    Append(ref buffer, ref length, EscapeByte);
+                }
+            }
+            Append(ref buffer, ref length, 0);
+            Append(ref buffer, ref length, 0);
+        }
+
+        private static void AppendBigEndian(ref byte[] buffer, ref int length, ulong value, int size)
+        {
+            for (var shift = (size - 1) * 8; shift >= 0; shift -= 8)
+            {
+                Append(ref buffer, ref length, (byte)(value >> shift));
+            }
+        }
+
+        private static void Append(ref byte[] buffer, ref int length, byte value)
+        {
+            if (length == buffer.Length)
+            {
+                Array.Resize(ref buffer, buffer.Length * 2);
+            }
+            buffer[length++] = value;
+        }
+        #endregion
+    }
+}
@@ -193,6 +193,24 @@ namespace Zen.Trunk.Storage.Data.Table
         #endregion
 
         #region Public Properties
+        /// <summary>
+        /// Gets the clustered keys of the row this entry refers to.
+        /// </summary>
+        /// <value>
+        /// The clustered keys.
+        /// </value>
+        public object[] ClusteredKeys
+        {
+            get
+            {
+                var keys = new object[_clusteredKey.KeyLength];
+                for (var index = 0; index < _clusteredKey.KeyLength; ++index)
+                {
+                    keys[index] = _clusteredKey[index];
+                }
+                return keys;
+            }
+        }
         #endregion
 
         #region Public Methods
@@ -1,6 +1,8 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.Linq;
+using System.Threading;
 using System.Threading.Tasks;
 using System.Threading.Tasks.Dataflow;
 using Autofac;
@@ -72,6 +74,42 @@ namespace Zen.Trunk.Storage.Data.Table
             }
             #endregion
         }
+
+        private class BuildTableIndexRequest : TransactionContextTaskRequest<BuildTableIndexParameters, bool>
+        {
+            #region Public Constructors
+            public BuildTableIndexRequest(BuildTableIndexParameters parameters)
+                : base(parameters)
+            {
+            }
+            #endregion
+        }
+
+        private sealed class PageLatch : IDisposable
+        {
+            #region Private Fields
+            private readonly Action _unlock;
+            private bool _isReleased;
+            #endregion
+
+            #region Public Constructors
+            public PageLatch(Action unlock)
+            {
+                _unlock = unlock;
+            }
+            #endregion
+
+            #region Public Methods
+            public void Dispose()
+            {
+                if (!_isReleased)
+                {
+                    _isReleased = true;
+                    _unlock();
+                }
+            }
+            #endregion
+        }
         #endregion
 
         #region Private Fields
@@ -81,6 +119,7 @@ namespace Zen.Trunk.Storage.Data.Table
         private readonly ITargetBlock<MergeTableIndexPagesRequest> _mergePagesPort;
         private readonly ITargetBlock<FindTableIndexRequest> _findIndexPort;
         private readonly ITargetBlock<EnumerateIndexEntriesRequest> _enumerateIndexEntriesPort;
+        private readonly ITargetBlock<BuildTableIndexRequest> _buildIndexPort;
         #endregion
 
         #region Public Constructors
@@ -123,6 +162,12 @@ namespace Zen.Trunk.Storage.Data.Table
                 {
                     TaskScheduler = taskInterleave.ConcurrentScheduler,
                 });
+            _buildIndexPort = new TransactionContextActionBlock<BuildTableIndexRequest, bool>(
+                request => BuildIndexHandlerAsync(request),
+                new ExecutionDataflowBlockOptions
+                {
+                    TaskScheduler = taskInterleave.ExclusiveScheduler,
+                });
         }
         #endregion
 
@@ -206,6 +251,110 @@ namespace Zen.Trunk.Storage.Data.Table
             _enumerateIndexEntriesPort.Post(iter);
             return iter.Task;
         }
+
+        /// <summary>
+        /// Builds an empty index from the bottom up using the given leaf
+        /// entries.
+        /// </summary>
+        /// <param name="parameters">The parameters.</param>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <remarks>
+        /// Leaf pages are filled in key order up to the index fill-factor and
+        /// each level is linked into the level above as its pages fill, so no
+        /// page is ever split.
+        /// </remarks>
+        public Task<bool> BuildIndexAsync(BuildTableIndexParameters parameters)
+        {
+            var request = new BuildTableIndexRequest(parameters);
+            _buildIndexPort.Post(request);
+            return request.Task;
+        }
+
+        /// <summary>
+        /// Opens a cursor over a range of index entries.
+        /// </summary>
+        /// <param name="parameters">The parameters.</param>
+        /// <returns>
+        /// A <see cref="TableIndexRangeCursor"/> positioned before the first
+        /// entry in the range.
+        /// </returns>
+        /// <remarks>
+        /// Cursors read pages directly rather than through this manager's
+        /// ports so concurrent scans never queue behind each other.
+        /// </remarks>
+        public TableIndexRangeCursor OpenRangeCursor(ScanTableIndexParameters parameters)
+        {
+            return new TableIndexRangeCursor(this, parameters);
+        }
+        #endregion
+
+        #region Internal Methods
+        /// <summary>
+        /// Loads a copy of the specified leaf page under a shared latch.
+        /// </summary>
+        /// <param name="rootInfo">The root index information.</param>
+        /// <param name="logicalPageId">The logical page identifier.</param>
+        /// <returns>
+        /// The loaded page; the latch has already been released.
+        /// </returns>
+        internal async Task<TableIndexPage> LoadLeafPageAsync(RootTableIndexInfo rootInfo, LogicalPageId logicalPageId)
+        {
+            var page = await LatchAndLoadPageAsync(rootInfo, logicalPageId, true, false).ConfigureAwait(false);
+            page.ReleaseLatch();
+            return page;
+        }
+
+        /// <summary>
+        /// Reads ahead a run of sibling leaf pages to warm the buffer cache.
+        /// </summary>
+        /// <param name="rootInfo">The root index information.</param>
+        /// <param name="logicalPageId">The logical id of the first page.</param>
+        /// <param name="pageCount">The maximum number of pages to read.</param>
+        /// <param name="isReverse">
+        /// <c>true</c> to follow previous page links; otherwise, <c>false</c>.
+        /// </param>
+        /// <param name="cancellationToken">
+        /// The cancellation token used to stop reading ahead.
+        /// </param>
+        /// <returns>
+        /// The logical id of the page following the last page read or
+        /// <see cref="LogicalPageId.Zero"/> when there are no more pages or
+        /// read-ahead was cancelled.
+        /// </returns>
+        /// <remarks>
+        /// Pages are loaded outside the caller's transaction so read-ahead
+        /// takes no locks or latches and never enlists the page buffers; it
+        /// only ever sees the committed image of each page.
+        /// </remarks>
+        internal async Task<LogicalPageId> ReadAheadLeafPagesAsync(
+            RootTableIndexInfo rootInfo,
+            LogicalPageId logicalPageId,
+            int pageCount,
+            bool isReverse,
+            CancellationToken cancellationToken)
+        {
+            using (TrunkTransactionContext.SwitchTransactionContext(null))
+            {
+                try
+                {
+                    for (; pageCount > 0 && logicalPageId != LogicalPageId.Zero; --pageCount)
+                    {
+                        cancellationToken.ThrowIfCancellationRequested();
+                        using (var page = await LoadPageAsync(rootInfo, logicalPageId).ConfigureAwait(false))
+                        {
+                            logicalPageId = isReverse ? page.PrevLogicalPageId : page.NextLogicalPageId;
+                        }
+                    }
+                    return logicalPageId;
+                }
+                catch (OperationCanceledException)
+                {
+                    return LogicalPageId.Zero;
+                }
+            }
+        }
         #endregion
 
         #region Private Methods
@@ -275,6 +424,7 @@ namespace Zen.Trunk.Storage.Data.Table
                 rootPage.SetContext(_ownerTable, rootTableIndexInfo);
                 rootTableIndexInfo.RootLogicalPageId = rootPage.LogicalPageId;
                 AddIndexInfo(rootTableIndexInfo);
+                await _ownerTable.UpdateIndexRootAsync(rootTableIndexInfo).ConfigureAwait(false);
 
                 // We need the zero-based ordinal positions of the columns used
                 //	in the index being created
@@ -445,129 +595,142 @@ namespace Zen.Trunk.Storage.Data.Table
 
         private async Task<bool> SplitPageHandlerAsync(SplitTableIndexPageRequest request)
         {
+            // NOTE: Callers must already hold exclusive latches on the page
+            //  being split and on its parent (if it is not the root)
+            var parentPage = request.Message.ParentPage;
             var currentPage = request.Message.PageToSplit;
-            var splitPage = request.Message.SplitPage;
+            var rootInfo = GetIndexInfo(currentPage.IndexId);
+            var newParentPage = await SplitPageCoreAsync(
+                    rootInfo, parentPage, currentPage, request.Message.SplitPage)
+                .ConfigureAwait(false);
 
-            // TODO: Setup appropriate locking mode (should be exclusive)
-            // Technically since this method is only called during writable 
-            //	FindIndex searches the pages we are working on should already
-            //	be locked.
+            // A root split creates a parent the caller knows nothing about
+            if (newParentPage != parentPage)
+            {
+                newParentPage.Dispose();
+            }
+            return true;
+        }
 
+        private async Task<TableIndexPage> SplitPageCoreAsync(
+            RootTableIndexInfo rootInfo, TableIndexPage parentPage, TableIndexPage currentPage, TableIndexPage splitPage)
+        {
             // Make sure split page will use same identifiers as original
             splitPage.FileGroupId = currentPage.FileGroupId;
             splitPage.ObjectId = currentPage.ObjectId;
             splitPage.IndexId = currentPage.IndexId;
+            splitPage.IndexType = currentPage.IsLeafIndex ? IndexType.Leaf : IndexType.Intermediate;
             await Database
                 .InitFileGroupPageAsync(
-                    new InitFileGroupPageParameters(null, splitPage))
+                    new InitFileGroupPageParameters(
+                        null, splitPage, true, false, true))
                 .ConfigureAwait(false);
+            splitPage.Depth = currentPage.Depth;
+            splitPage.SetContext(_ownerTable, rootInfo);
 
-            // Root page splits have extra operations...
-            var parentPage = await SplitRootIfNecessaryAndReturnParentAsync(currentPage)
+            // Nothing can reach the new page until it has been linked so
+            //  this latch is granted immediately
+            splitPage.Latch = await LatchPageAsync(rootInfo, splitPage.LogicalPageId, splitPage.IsLeafIndex, true)
                 .ConfigureAwait(false);
 
-            // Sanity check - no root index pages beyond this point
-            //Debug.Assert(!currentPage.IsRootIndex);
-            //Debug.Assert(parentPage != null);
+            // Root page splits have extra operations...
+            if (parentPage == null)
+            {
+                if (!currentPage.IsRootIndex)
+                {
+                    throw new InvalidOperationException("Parent page must be latched to split a non-root index page.");
+                }
+                parentPage = await SplitRootAsync(rootInfo, currentPage).ConfigureAwait(false);
+            }
 
             // Setup linkage following split (double linked list)
+            // NOTE: The parent logical id is only a hint; descents always
+            //  arrive from a latched parent so children of moved entries are
+            //  not rewritten
             splitPage.PrevLogicalPageId = currentPage.LogicalPageId;
             splitPage.NextLogicalPageId = currentPage.NextLogicalPageId;
             currentPage.NextLogicalPageId = splitPage.LogicalPageId;
             splitPage.ParentLogicalPageId = parentPage.LogicalPageId;
 
-            // Copy across page state information
-            splitPage.IndexType = currentPage.IndexType;
-            splitPage.Depth = currentPage.Depth;
-
-            // If the next logical id is non-zero on the split page
-            //	then we need to load the page and rewire the prev id
+            // If the next logical id is non-zero on the split page then we
+            //  need to rewire the prev id of that page; siblings are only
+            //  ever latched left to right so this cannot deadlock
             if (splitPage.NextLogicalPageId != LogicalPageId.Zero)
             {
-                // Prepare page for loading
-                var pageAfterSplit =
-                    new TableIndexPage
-                    {
-                        FileGroupId = currentPage.FileGroupId,
-                        LogicalPageId = splitPage.NextLogicalPageId
-                    };
-                await Database
-                    .LoadFileGroupPageAsync(
-                        new LoadFileGroupPageParameters(
-                            null, pageAfterSplit, false, true))
-                    .ConfigureAwait(false);
-
-                // Update the previous logical index
-                pageAfterSplit.PrevLogicalPageId = splitPage.LogicalPageId;
+                using (var pageAfterSplit = await LatchAndLoadPageAsync(
+                    rootInfo, splitPage.NextLogicalPageId, splitPage.IsLeafIndex, true).ConfigureAwait(false))
+                {
+                    pageAfterSplit.PrevLogicalPageId = splitPage.LogicalPageId;
+                }
             }
 
-            // Move half entries to new page
+            // Move upper half of the entries to the new page
             var startIndex = currentPage.IndexCount / 2;
-            while (startIndex < currentPage.IndexCount)
-            {
-                splitPage.IndexEntries.Add(currentPage.IndexEntries[startIndex]);
-                currentPage.IndexEntries.RemoveAt(startIndex);
-            }
-
-            // Setup pointer to new page in parent page
-            parentPage.AddLinkToPage(splitPage);
-            return true;
+            var moveCount = currentPage.IndexCount - startIndex;
+            splitPage.IndexEntries.AddRange(currentPage.IndexEntries.GetRange(startIndex, moveCount));
+            currentPage.IndexEntries.RemoveRange(startIndex, moveCount);
+            currentPage.SetDirty();
+            splitPage.SetDirty();
+
+            // Setup pointer to new page in parent page; the parent was split
+            //  on the way down (or has just been created) so it has room
+            AddLinkToChildPage(rootInfo, parentPage, splitPage);
+            return parentPage;
         }
 
-        private async Task<TableIndexPage> SplitRootIfNecessaryAndReturnParentAsync(TableIndexPage currentPage)
+        private async Task<TableIndexPage> SplitRootAsync(RootTableIndexInfo rootInfo, TableIndexPage currentPage)
         {
-            TableIndexPage parentPage;
+            // Initialise new page (it will become the new root)
+            var newRootPage =
+                new TableIndexPage
+                {
+                    FileGroupId = currentPage.FileGroupId,
+                    ObjectId = currentPage.ObjectId,
+                    IndexId = currentPage.IndexId,
+                    IndexType = IndexType.Root
+                };
+            await Database
+                .InitFileGroupPageAsync(
+                    new InitFileGroupPageParameters(
+                        null, newRootPage, true, false, true))
+                .ConfigureAwait(false);
+            newRootPage.Depth = (byte)(currentPage.Depth + 1);
+            newRootPage.SetContext(_ownerTable, rootInfo);
 
-            if (!currentPage.IsRootIndex)
+            // Update parent/child relationship and update state of pages
+            currentPage.ParentLogicalPageId = newRootPage.LogicalPageId;
+            currentPage.IsRootIndex = false;
+            if (!currentPage.IsLeafIndex)
             {
-                // Current page is non-root page; just load the parent page
-                parentPage =
-                    new TableIndexPage
-                    {
-                        FileGroupId = currentPage.FileGroupId,
-                        ObjectId = currentPage.ObjectId,
-                        IndexId = currentPage.IndexId,
-                        LogicalPageId = currentPage.LogicalPageId
-                    };
-                await Database
-                    .LoadFileGroupPageAsync(new LoadFileGroupPageParameters(null, parentPage, false, true))
-                    .ConfigureAwait(false);
+                currentPage.IndexType = IndexType.Intermediate;
             }
-            else
-            {
-                // Initialise new page (it will become the new root)
-                var newRootPage =
-                    new TableIndexPage
-                    {
-                        FileGroupId = currentPage.FileGroupId,
-                        ObjectId = currentPage.ObjectId,
-                        IndexId = currentPage.IndexId
-                    };
-                await Database
-                    .InitFileGroupPageAsync(new InitFileGroupPageParameters(null, newRootPage))
-                    .ConfigureAwait(false);
 
-                // Update parent/child relationship and update state of pages
-                currentPage.ParentLogicalPageId = newRootPage.LogicalPageId;
-                currentPage.IsRootIndex = false;
-                newRootPage.Depth = (byte) (currentPage.Depth + 1);
-                newRootPage.IndexType = IndexType.Root;
-                if (!currentPage.IsLeafIndex)
-                {
-                    currentPage.IndexType = IndexType.Intermediate;
-                }
+            // The new root takes over the root latch held on the current
+            //  page which is latched again at its new level; the page can
+            //  only be reached through the new root so this is granted
+            //  immediately
+            newRootPage.Latch = currentPage.Latch;
+            currentPage.Latch = await LatchPageAsync(
+                    rootInfo, currentPage.LogicalPageId, currentPage.IsLeafIndex, true)
+                .ConfigureAwait(false);
 
-                // Ensure new root page has linkage to current page
-                newRootPage.AddLinkToPage(currentPage);
+            // Ensure new root page has linkage to current page
+            AddLinkToChildPage(rootInfo, newRootPage, currentPage);
 
-                // Notify index manager
-                var root = GetIndexInfo(currentPage.IndexId);
-                root.RootLogicalPageId = newRootPage.LogicalPageId;
-                root.RootIndexDepth = newRootPage.Depth;
-                parentPage = newRootPage;
-            }
+            // Publish the new root and record it in the table schema as part
+            //  of this transaction; descents waiting on the root latch will
+            //  pick up the new root once it is released
+            rootInfo.RootLogicalPageId = newRootPage.LogicalPageId;
+            rootInfo.RootIndexDepth = newRootPage.Depth;
+            await _ownerTable.UpdateIndexRootAsync(rootInfo).ConfigureAwait(false);
+            return newRootPage;
+        }
 
-            return parentPage;
+        private void AddLinkToChildPage(RootTableIndexInfo rootInfo, TableIndexPage parentPage, TableIndexPage childPage)
+        {
+            var link = new TableIndexLogicalInfo(childPage.IndexEntries[0].Keys, childPage.LogicalPageId);
+            link.SetContext(_ownerTable, rootInfo);
+            parentPage.AddLinkToPage(link);
         }
 
         private async Task<bool> MergePagesHandlerAsync(MergeTableIndexPagesRequest request)
@@ -621,127 +784,349 @@ namespace Zen.Trunk.Storage.Data.Table
             return true;
         }
 
-        private async Task<FindTableIndexResult> FindIndexHandlerAsync(FindTableIndexRequest request)
+        private async Task<bool> BuildIndexHandlerAsync(BuildTableIndexRequest request)
         {
-            TableIndexPage prevPage = null, parentPage = null;
-            var logicalId = request.Message.RootInfo.RootLogicalPageId;
-            var isForInsert = request.Message.IsForInsert;
-            var findInfo = new TableIndexInfo(request.Message.Keys);
-
-            // Main find loop
-            while (true)
+            var rootInfo = request.Message.Index;
+            if (request.Message.LeafEntries.Count == 0)
             {
-                // Load the current index page
-                var indexPage = 
-                    new TableIndexPage
-                    {
-                        FileGroupId = request.Message.RootInfo.IndexFileGroupId,
-                        LogicalPageId = logicalId
-                    };
-                await Database
-                    .LoadFileGroupPageAsync(
-                        new LoadFileGroupPageParameters(
-                            null, indexPage, false, true))
-                    .ConfigureAwait(false);
+                return false;
+            }
 
-                // Perform crab-search through index table entries and split
-                //  as necessary
-                if (isForInsert && indexPage.IndexCount >= (indexPage.MaxIndexEntries - 2))
+            // The existing root page must be empty as it will be replaced
+            var oldRootPage =
+                new TableIndexPage
                 {
-                    var newPage = new TableIndexPage();
-                    var split = new SplitTableIndexPageParameters(
-                        parentPage, indexPage, newPage);
-                    var updateParentPageAfterSplit = await SplitPageAsync(split)
-                        .ConfigureAwait(false);
-                    if (updateParentPageAfterSplit && parentPage != null)
-                    {
+                    FileGroupId = rootInfo.IndexFileGroupId,
+                    LogicalPageId = rootInfo.RootLogicalPageId
+                };
+            await Database
+                .LoadFileGroupPageAsync(
+                    new LoadFileGroupPageParameters(
+                        null, oldRootPage, false, true))
+                .ConfigureAwait(false);
+            if (oldRootPage.IndexCount > 0)
+            {
+                throw new InvalidOperationException("Only empty indices can be built from the bottom up.");
+            }
 
-                    }
+            // Sort leaf entries into index order
+            var leafEntries = new List<TableIndexLeafInfo>(request.Message.LeafEntries);
+            foreach (var entry in leafEntries)
+            {
+                entry.SetContext(_ownerTable, rootInfo);
+            }
+            leafEntries.Sort();
+
+            // Fill leaf pages in order; full pages are linked into the level
+            //  above as we go so we only ever hold one page per level
+            var openPages = new List<TableIndexPage>();
+            foreach (var entry in leafEntries)
+            {
+                await AddBuildEntryAsync(rootInfo, openPages, 0, entry).ConfigureAwait(false);
+            }
+
+            // Link the last page of each level into the level above; the
+            //  only page on the top level becomes the new root
+            for (var depth = 0; depth < openPages.Count; ++depth)
+            {
+                var page = openPages[depth];
+                if (depth == openPages.Count - 1 &&
+                    page.PrevLogicalPageId == LogicalPageId.Zero)
+                {
+                    page.IndexType |= IndexType.Root;
+                    rootInfo.RootLogicalPageId = page.LogicalPageId;
+                    rootInfo.RootIndexDepth = page.Depth;
                 }
+                else
+                {
+                    await LinkBuildPageToParentAsync(rootInfo, openPages, depth).ConfigureAwait(false);
+                }
+                page.Save();
+            }
+            await _ownerTable.UpdateIndexRootAsync(rootInfo).ConfigureAwait(false);
+
+            // Free the old root page
+            await Database
+                .DeallocateFileGroupPageAsync(
+                    new DeallocateFileGroupDataPageParameters(
+                        string.Empty, oldRootPage))
+                .ConfigureAwait(false);
+            return true;
+        }
+
+        private async Task AddBuildEntryAsync(
+            RootTableIndexInfo rootInfo, List<TableIndexPage> openPages, byte depth, TableIndexInfo entry)
+        {
+            var page = depth < openPages.Count ? openPages[depth] : null;
+            if (page == null)
+            {
+                page = await InitBuildPageAsync(rootInfo, depth).ConfigureAwait(false);
+                openPages.Add(page);
+            }
+            else if (page.IndexCount >= GetBuildPageCapacity(page, rootInfo.FillFactor))
+            {
+                // Current page is full; link it into the parent and continue
+                //  on a new page chained after it
+                await LinkBuildPageToParentAsync(rootInfo, openPages, depth).ConfigureAwait(false);
+                var nextPage = await InitBuildPageAsync(rootInfo, depth).ConfigureAwait(false);
+                nextPage.PrevLogicalPageId = page.LogicalPageId;
+                page.NextLogicalPageId = nextPage.LogicalPageId;
+                page.Save();
+
+                openPages[depth] = page = nextPage;
+            }
+
+            page.IndexEntries.Add(entry);
+            page.SetDirty();
+        }
+
+        private async Task LinkBuildPageToParentAsync(
+            RootTableIndexInfo rootInfo, List<TableIndexPage> openPages, int depth)
+        {
+            var page = openPages[depth];
+            var link = new TableIndexLogicalInfo(page.IndexEntries[0].Keys, page.LogicalPageId);
+            link.SetContext(_ownerTable, rootInfo);
+            await AddBuildEntryAsync(rootInfo, openPages, (byte)(depth + 1), link).ConfigureAwait(false);
+            page.ParentLogicalPageId = openPages[depth + 1].LogicalPageId;
+        }
 
-                // Check whether we were supposed to go via prev page.
-                if (prevPage != null && indexPage.IndexCount > 0)
+        private async Task<TableIndexPage> InitBuildPageAsync(RootTableIndexInfo rootInfo, byte depth)
+        {
+            var page =
+                new TableIndexPage
                 {
-                    // If current page's first index is past cursor
-                    //	then backtrack
-                    if (indexPage.CompareIndex(0, findInfo) > 0)
-                    {
-                        // Dispose parent page (will unlock)
-                        if (parentPage != null)
-                        {
-                            parentPage.Dispose();
-                            parentPage = null;
-                        }
+                    FileGroupId = rootInfo.IndexFileGroupId,
+                    ObjectId = rootInfo.ObjectId,
+                    IndexId = rootInfo.IndexId,
+                    IndexType = depth == 0 ? IndexType.Leaf : IndexType.Intermediate
+                };
+            await Database
+                .InitFileGroupPageAsync(
+                    new InitFileGroupPageParameters(
+                        null, page, true, false, true))
+                .ConfigureAwait(false);
+
+            page.Depth = depth;
+            page.SetContext(_ownerTable, rootInfo);
+            return page;
+        }
 
-                        // Dispose of index page (will unlock)
-                        indexPage.Dispose();
+        private static int GetBuildPageCapacity(TableIndexPage page, byte fillFactor)
+        {
+            // NOTE: We treat a fill-factor of zero the same as 100...
+            if (fillFactor == 0 || fillFactor == 100)
+            {
+                return page.MaxIndexEntries;
+            }
+
+            // Pages must hold at least two entries for the levels to converge
+            return Math.Max(2, page.MaxIndexEntries * fillFactor / 100);
+        }
+
+        private async Task<FindTableIndexResult> FindIndexHandlerAsync(FindTableIndexRequest request)
+        {
+            var rootInfo = request.Message.RootInfo;
+            var isForInsert = request.Message.IsForInsert;
+            var findInfo = new TableIndexInfo(request.Message.Keys);
 
-                        // Backtrack to previous page
-                        indexPage = prevPage;
-                        prevPage = null;
+            // Pages are latch-coupled on the way down: the child is latched
+            //  before the parent is released. Inserts latch exclusively so a
+            //  nearly full page can be split while its parent is still held;
+            //  lookups only need shared latches.
+            TableIndexPage parentPage = null, indexPage = null;
+            try
+            {
+                indexPage = await LatchRootPageAsync(rootInfo, isForInsert).ConfigureAwait(false);
+                while (true)
+                {
+                    // Split nearly full pages proactively so every parent
+                    //  has room for a link by the time its child splits
+                    if (isForInsert && indexPage.IndexCount >= (indexPage.MaxIndexEntries - 2))
+                    {
+                        var splitPage = new TableIndexPage();
+                        parentPage = await SplitPageCoreAsync(rootInfo, parentPage, indexPage, splitPage)
+                            .ConfigureAwait(false);
 
-                        // When we reach depth of zero we are finished
-                        if (indexPage.Depth == 0)
+                        // Continue with whichever half now covers the keys
+                        if (splitPage.CompareIndex(0, findInfo) <= 0)
+                        {
+                            indexPage.Dispose();
+                            indexPage = splitPage;
+                        }
+                        else
                         {
-                            // Return whatever we found
-                            return new FindTableIndexResult(
-                                indexPage,
-                                (TableIndexLeafInfo)indexPage.IndexEntries[indexPage.IndexCount - 1]);
+                            splitPage.Dispose();
                         }
+                    }
 
-                        // Iterate down stack
-                        var logicalInfo = (TableIndexLogicalInfo)
-                            indexPage.IndexEntries[indexPage.IndexCount - 1];
-                        parentPage = indexPage;
-                        logicalId = logicalInfo.LogicalPageId;
-                        continue;
+                    // The current page cannot split into the parent now so
+                    //  release it (will unlatch)
+                    if (parentPage != null)
+                    {
+                        parentPage.Dispose();
+                        parentPage = null;
                     }
 
-                    // Dispose previous page (will unlock)
-                    prevPage.Dispose();
-                    prevPage = null;
-                }
+                    // Only an empty index has an empty page on the path
+                    if (indexPage.IndexCount == 0)
+                    {
+                        if (!isForInsert)
+                        {
+                            indexPage.Dispose();
+                            return null;
+                        }
+                        return new FindTableIndexResult(indexPage, null);
+                    }
 
-                // Search for descent point
-                for (var index = 0;
-                    indexPage != null && index < indexPage.IndexCount;
-                    ++index)
-                {
-                    // Is this the descent point for the current index page
-                    var compLower = indexPage.CompareIndex(index, findInfo);
-                    var compHigher = indexPage.CompareIndex(index + 1, findInfo);
-                    if (compLower >= 0 || compHigher >= 0) continue;
+                    // Binary search for the descent point; keys before the
+                    //  first entry descend through the first entry
+                    var index = Math.Max(0, indexPage.FindDescentIndex(findInfo));
 
                     // If this is a leaf index page then we are finished
                     if (indexPage.TryGetIndexEntryLeafInfo(index, out var leaf))
                     {
+                        // Lookups work from the loaded copy of the page so
+                        //  only inserts hold the leaf latch until disposed
+                        if (!isForInsert)
+                        {
+                            indexPage.ReleaseLatch();
+                        }
                         return new FindTableIndexResult(indexPage, leaf);
                     }
 
-                    // Determine new logical id of child page and descend
-                    indexPage.TryGetIndexEntryLogicalPageId(index, out logicalId);
+                    // Latch the child page before releasing this one
+                    indexPage.TryGetIndexEntryLogicalPageId(index, out var logicalId);
                     parentPage = indexPage;
-
-                    // Cause index scan of this page to terminate
                     indexPage = null;
+                    indexPage = await LatchAndLoadPageAsync(rootInfo, logicalId, parentPage.Depth == 1, isForInsert)
+                        .ConfigureAwait(false);
                 }
+            }
+            catch
+            {
+                parentPage?.Dispose();
+                indexPage?.Dispose();
+                throw;
+            }
+        }
 
-                // If current index page is still valid and we have a next page then go
-                // NOTE: Typically this should never occur but due to page splits we
-                //  cannot fully discount this as a possibility...
-                if (indexPage != null &&
-                    indexPage.NextLogicalPageId != LogicalPageId.Zero)
+        private async Task<TableIndexPage> LatchRootPageAsync(RootTableIndexInfo rootInfo, bool writable)
+        {
+            // The root page id is read under the root latch; a root split
+            //  holds that latch until the new root is published so a page
+            //  that is no longer the root can only be seen once
+            var previousPageId = LogicalPageId.Zero;
+            while (true)
+            {
+                var latch = await LatchRootAsync(rootInfo, writable).ConfigureAwait(false);
+                var logicalPageId = rootInfo.RootLogicalPageId;
+                if (logicalPageId == previousPageId)
                 {
-                    // Determine new logical id and make this page
-                    //	the new previous page.
-                    logicalId = indexPage.NextLogicalPageId;
-                    prevPage = indexPage;
-                    indexPage = null;
+                    latch.Dispose();
+                    throw new InvalidOperationException(
+                        $"Root page {logicalPageId} of index {rootInfo.IndexId} is not marked as an index root page.");
+                }
+
+                var page = await LoadLatchedPageAsync(rootInfo, logicalPageId, latch).ConfigureAwait(false);
+                if (page.IsRootIndex)
+                {
+                    return page;
                 }
 
-                // Sanity check
-                System.Diagnostics.Debug.Assert(indexPage == null);
+                previousPageId = logicalPageId;
+                page.Dispose();
+            }
+        }
+
+        private async Task<TableIndexPage> LatchAndLoadPageAsync(
+            RootTableIndexInfo rootInfo, LogicalPageId logicalPageId, bool isLeaf, bool writable)
+        {
+            // The root page is always latched through the root index lock
+            var isRoot = logicalPageId == rootInfo.RootLogicalPageId;
+            var latch = isRoot
+                ? await LatchRootAsync(rootInfo, writable).ConfigureAwait(false)
+                : await LatchPageAsync(rootInfo, logicalPageId, isLeaf, writable).ConfigureAwait(false);
+            var page = await LoadLatchedPageAsync(rootInfo, logicalPageId, latch).ConfigureAwait(false);
+
+            // If the root was split while we waited then latch the page
+            //  again at its new level; the root id has been updated by now
+            //  so this cannot recurse more than once
+            if (isRoot && !page.IsRootIndex)
+            {
+                isLeaf = page.IsLeafIndex;
+                page.Dispose();
+                return await LatchAndLoadPageAsync(rootInfo, logicalPageId, isLeaf, writable)
+                    .ConfigureAwait(false);
+            }
+            return page;
+        }
+
+        private async Task<TableIndexPage> LoadLatchedPageAsync(
+            RootTableIndexInfo rootInfo, LogicalPageId logicalPageId, IDisposable latch)
+        {
+            TableIndexPage page;
+            try
+            {
+                page = await LoadPageAsync(rootInfo, logicalPageId).ConfigureAwait(false);
             }
+            catch
+            {
+                latch.Dispose();
+                throw;
+            }
+
+            page.Latch = latch;
+            return page;
+        }
+
+        private async Task<TableIndexPage> LoadPageAsync(RootTableIndexInfo rootInfo, LogicalPageId logicalPageId)
+        {
+            var page =
+                new TableIndexPage
+                {
+                    FileGroupId = rootInfo.IndexFileGroupId,
+                    LogicalPageId = logicalPageId
+                };
+            page.SetContext(_ownerTable, rootInfo);
+            await Database
+                .LoadFileGroupPageAsync(
+                    new LoadFileGroupPageParameters(
+                        null, page, false, true))
+                .ConfigureAwait(false);
+            return page;
+        }
+
+        private async Task<IDisposable> LatchRootAsync(RootTableIndexInfo rootInfo, bool writable)
+        {
+            var lockManager = _ownerTable.LockingManager;
+            var objectId = rootInfo.ObjectId;
+            var indexId = rootInfo.IndexId;
+            await lockManager
+                .LockRootIndexAsync(objectId, indexId, writable, _ownerTable.LockTimeout)
+                .ConfigureAwait(false);
+            return new PageLatch(() => lockManager.UnlockRootIndex(objectId, indexId, writable));
+        }
+
+        private async Task<IDisposable> LatchPageAsync(
+            RootTableIndexInfo rootInfo, LogicalPageId logicalPageId, bool isLeaf, bool writable)
+        {
+            // Latches are index locks held by the database lock manager so
+            //  they are qualified by the database that owns this table
+            var lockManager = _ownerTable.LockingManager;
+            var objectId = rootInfo.ObjectId;
+            var indexId = rootInfo.IndexId;
+            if (isLeaf)
+            {
+                await lockManager
+                    .LockLeafIndexAsync(objectId, indexId, logicalPageId, writable, _ownerTable.LockTimeout)
+                    .ConfigureAwait(false);
+                return new PageLatch(() => lockManager.UnlockLeafIndex(objectId, indexId, logicalPageId, writable));
+            }
+
+            await lockManager
+                .LockInternalIndexAsync(objectId, indexId, logicalPageId, writable, _ownerTable.LockTimeout)
+                .ConfigureAwait(false);
+            return new PageLatch(() => lockManager.UnlockInternalIndex(objectId, indexId, logicalPageId, writable));
         }
 
         private async Task<bool> EnumerateIndexEntriesHandlerAsync(EnumerateIndexEntriesRequest request)
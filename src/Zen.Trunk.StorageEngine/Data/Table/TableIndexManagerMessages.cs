@@ -369,4 +369,107 @@ namespace Zen.Trunk.Storage.Data.Table
         /// </value>
         public Func<TableIndexPage, TableIndexLeafInfo, int, bool> OnIteration { get; }
     }
+
+    /// <summary>
+    /// 
+    /// </summary>
+    public class BuildTableIndexParameters
+    {
+        #region Public Constructors
+        /// <summary>
+        /// Initialises an instance of <see cref="T:BuildTableIndexParameters" />.
+        /// </summary>
+        /// <param name="index">The index to build.</param>
+        /// <param name="leafEntries">The leaf entries for every row.</param>
+        public BuildTableIndexParameters(
+            RootTableIndexInfo index,
+            IList<TableIndexLeafInfo> leafEntries)
+        {
+            Index = index;
+            LeafEntries = leafEntries;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the index.
+        /// </summary>
+        /// <value>
+        /// The index.
+        /// </value>
+        public RootTableIndexInfo Index { get; }
+
+        /// <summary>
+        /// Gets the leaf entries.
+        /// </summary>
+        /// <value>
+        /// The leaf entries in any order; they are sorted by the build.
+        /// </value>
+        public IList<TableIndexLeafInfo> LeafEntries { get; }
+        #endregion
+    }
+
+    /// <summary>
+    /// Describes an ordered scan over a range of index entries.
+    /// </summary>
+    public class ScanTableIndexParameters
+    {
+        #region Public Constructors
+        /// <summary>
+        /// Initialises an instance of <see cref="T:ScanTableIndexParameters" />.
+        /// </summary>
+        /// <param name="index">The index to scan.</param>
+        /// <param name="fromKeys">The lower bound keys (inclusive).</param>
+        /// <param name="toKeys">The upper bound keys (inclusive).</param>
+        /// <param name="isReverse">
+        /// <c>true</c> to return entries in descending index order.
+        /// </param>
+        public ScanTableIndexParameters(
+            RootTableIndexInfo index,
+            object[] fromKeys,
+            object[] toKeys,
+            bool isReverse = false)
+        {
+            Index = index;
+            FromKeys = fromKeys;
+            ToKeys = toKeys;
+            IsReverse = isReverse;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the index.
+        /// </summary>
+        /// <value>
+        /// The index.
+        /// </value>
+        public RootTableIndexInfo Index { get; }
+
+        /// <summary>
+        /// Gets the lower bound keys.
+        /// </summary>
+        /// <value>
+        /// The lower bound keys (inclusive).
+        /// </value>
+        public object[] FromKeys { get; }
+
+        /// <summary>
+        /// Gets the upper bound keys.
+        /// </summary>
+        /// <value>
+        /// The upper bound keys (inclusive).
+        /// </value>
+        public object[] ToKeys { get; }
+
+        /// <summary>
+        /// Gets a value indicating whether the scan runs in reverse.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if entries are returned in descending index order;
+        /// otherwise, <c>false</c>.
+        /// </value>
+        public bool IsReverse { get; }
+        #endregion
+    }
 }
\ No newline at end of file
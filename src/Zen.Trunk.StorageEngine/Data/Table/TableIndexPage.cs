@@ -1,7 +1,10 @@
 ﻿namespace Zen.Trunk.Storage.Data.Table
 {
+    using Extensions;
     using Index;
+    using Locking;
     using System;
+    using System.Threading.Tasks;
 
     /// <summary>
     /// Class containing the implementation for index page splitting for
@@ -12,6 +15,7 @@
         #region Private Fields
         private DatabaseTable _ownerTable;
         private RootTableIndexInfo _rootIndex;
+        private TableIndexKeyArray _keyArray;
         #endregion
 
         #region Public Properties
@@ -119,6 +123,17 @@
         public bool IsOwnerTableClustered => !_ownerTable.IsHeap;
         #endregion
 
+        #region Internal Properties
+        /// <summary>
+        /// Gets or sets the latch held on this page by the index manager.
+        /// </summary>
+        /// <value>The latch or <c>null</c> if the page is not latched.</value>
+        /// <remarks>
+        /// The latch is released when the page is disposed.
+        /// </remarks>
+        internal IDisposable Latch { get; set; }
+        #endregion
+
         #region Public Methods
         /// <summary>
         /// Sets the context.
@@ -148,6 +163,35 @@
             return index < IndexCount ? IndexEntries[index].CompareTo(keys) : -1;
         }
 
+        /// <summary>
+        /// Finds the last index entry with keys less than or equal to the
+        /// specified keys.
+        /// </summary>
+        /// <param name="keys">The keys.</param>
+        /// <returns>
+        /// The entry ordinal or -1 when the keys appear before every entry.
+        /// </returns>
+        /// <remarks>
+        /// This performs a binary search over a prefix compressed array of
+        /// normalized keys that is rebuilt whenever the entries change.
+        /// </remarks>
+        public int FindDescentIndex(TableIndexInfo keys)
+        {
+            if (IndexCount == 0)
+            {
+                return -1;
+            }
+
+            var key = keys.GetNormalizedKey(IndexEntries[0], out var isPartial);
+            if (_keyArray == null ||
+                !_keyArray.TryFindLastLessOrEqual(IndexEntries, key, isPartial, out var entryIndex))
+            {
+                _keyArray = new TableIndexKeyArray(IndexEntries);
+                _keyArray.TryFindLastLessOrEqual(IndexEntries, key, isPartial, out entryIndex);
+            }
+            return entryIndex;
+        }
+
         /// <summary>
         /// Attempts to get the index leaf information for the index entry at
         /// the specified ordinal.
@@ -188,7 +232,65 @@
         }
         #endregion
 
+        #region Internal Methods
+        /// <summary>
+        /// Releases the latch held on this page (if any) without disposing
+        /// the page.
+        /// </summary>
+        internal void ReleaseLatch()
+        {
+            Latch?.Dispose();
+            Latch = null;
+        }
+        #endregion
+
         #region Protected Methods
+        /// <summary>
+        /// Releases unmanaged and - optionally - managed resources.
+        /// </summary>
+        /// <param name="disposing">
+        /// <c>true</c> to release both managed and unmanaged resources; 
+        /// <c>false</c> to release only unmanaged resources.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            // Save any changes before other latch holders can see the page
+            base.Dispose(disposing);
+            if (disposing)
+            {
+                ReleaseLatch();
+            }
+        }
+
+        /// <summary>
+        /// Overridden. Root and intermediate pages are latched by the
+        /// <see cref="TableIndexManager"/> through the same index locks so
+        /// only leaf pages are locked here.
+        /// </summary>
+        /// <param name="lockManager">The lock manager.</param>
+        protected override Task OnLockPageAsync(IDatabaseLockManager lockManager)
+        {
+            if (IndexType != IndexType.Leaf)
+            {
+                return CompletedTask.Default;
+            }
+            return base.OnLockPageAsync(lockManager);
+        }
+
+        /// <summary>
+        /// Overridden. Removes the lock taken on leaf pages in a prior call
+        /// to <see cref="OnLockPageAsync"/>.
+        /// </summary>
+        /// <param name="lockManager">The lock manager.</param>
+        protected override Task OnUnlockPageAsync(IDatabaseLockManager lockManager)
+        {
+            if (IndexType != IndexType.Leaf)
+            {
+                return CompletedTask.Default;
+            }
+            return base.OnUnlockPageAsync(lockManager);
+        }
+
         /// <summary>
         /// Creates an index link to the first entry in this index page
         /// </summary>
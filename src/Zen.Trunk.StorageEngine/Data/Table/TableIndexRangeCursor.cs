@@ -0,0 +1,313 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Zen.Trunk.Storage.Data.Table
+{
+    /// <summary>
+    /// Pull-based cursor over a key range of a table index.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Entries are copied out of the leaf pages a page at a time and each
+    /// leaf is only latched while it is being loaded, so a slow consumer
+    /// never blocks writers. The sibling link read with each batch is then
+    /// followed to the next leaf while the leaves beyond it are read ahead
+    /// in the background.
+    /// </para>
+    /// <para>
+    /// Read-ahead runs outside the scanning transaction and takes no locks;
+    /// it is cancelled when the cursor is disposed and
+    /// <see cref="DisposeAsync"/> also waits for it to stop.
+    /// </para>
+    /// <para>
+    /// Reverse scans follow the previous page links. A left sibling can be
+    /// split between batches so the cursor walks right from it until it
+    /// finds the page adjacent to the last one returned.
+    /// </para>
+    /// </remarks>
+    public sealed class TableIndexRangeCursor : IDisposable
+    {
+        #region Private Fields
+        private const int ReadAheadPageCount = 4;
+
+        private readonly TableIndexManager _manager;
+        private readonly ScanTableIndexParameters _parameters;
+        private readonly TableIndexInfo _fromInfo;
+        private readonly TableIndexInfo _toInfo;
+        private readonly List<TableIndexLeafInfo> _batch = new List<TableIndexLeafInfo>();
+        private readonly CancellationTokenSource _readAheadCancellation = new CancellationTokenSource();
+        private int _batchIndex;
+        private LogicalPageId _currentPageId;
+        private LogicalPageId _nextPageId;
+        private bool _isStarted;
+        private bool _isFinished;
+        private Task<LogicalPageId> _readAheadTask;
+        private int _pagesReadAhead;
+        #endregion
+
+        #region Internal Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TableIndexRangeCursor"/> class.
+        /// </summary>
+        /// <param name="manager">The index manager.</param>
+        /// <param name="parameters">The scan parameters.</param>
+        internal TableIndexRangeCursor(TableIndexManager manager, ScanTableIndexParameters parameters)
+        {
+            _manager = manager;
+            _parameters = parameters;
+            _fromInfo = new TableIndexInfo(parameters.FromKeys);
+            _toInfo = new TableIndexInfo(parameters.ToKeys);
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the current index entry.
+        /// </summary>
+        /// <value>
+        /// The current entry or <c>null</c> when the cursor is not positioned
+        /// on an entry.
+        /// </value>
+        public TableIndexLeafInfo Current { get; private set; }
+
+        /// <summary>
+        /// Gets a value indicating whether this cursor runs in reverse.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if entries are returned in descending index order;
+        /// otherwise, <c>false</c>.
+        /// </value>
+        public bool IsReverse => _parameters.IsReverse;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Advances the cursor to the next entry in the range.
+        /// </summary>
+        /// <returns>
+        /// <c>true</c> if the cursor moved to an entry; otherwise,
+        /// <c>false</c> when the end of the range has been reached.
+        /// </returns>
+        public async Task<bool> MoveNextAsync()
+        {
+            while (_batchIndex >= _batch.Count)
+            {
+                if (_isFinished)
+                {
+                    Current = null;
+                    return false;
+                }
+
+                _batch.Clear();
+                _batchIndex = 0;
+                if (!_isStarted)
+                {
+                    _isStarted = true;
+                    await LoadFirstBatchAsync().ConfigureAwait(false);
+                }
+                else
+                {
+                    await LoadNextBatchAsync().ConfigureAwait(false);
+                }
+            }
+
+            Current = _batch[_batchIndex++];
+            return true;
+        }
+
+        /// <summary>
+        /// Performs application-defined tasks associated with freeing,
+        /// releasing, or resetting unmanaged resources.
+        /// </summary>
+        /// <remarks>
+        /// No latches are held between calls and read-ahead holds no locks
+        /// so any read-ahead in progress is cancelled but not waited for.
+        /// </remarks>
+        public void Dispose()
+        {
+            _readAheadCancellation.Cancel();
+            _isFinished = true;
+            _batch.Clear();
+            _batchIndex = 0;
+            Current = null;
+        }
+
+        /// <summary>
+        /// Cancels any read-ahead in progress, waits for it to stop and then
+        /// disposes the cursor.
+        /// </summary>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        public async Task DisposeAsync()
+        {
+            _readAheadCancellation.Cancel();
+            if (_readAheadTask != null)
+            {
+                await _readAheadTask.ConfigureAwait(false);
+            }
+            Dispose();
+        }
+        #endregion
+
+        #region Private Methods
+        private async Task LoadFirstBatchAsync()
+        {
+            // Position on the leaf holding the first key in scan order
+            var startKeys = IsReverse ? _parameters.ToKeys : _parameters.FromKeys;
+            var result = await _manager
+                .FindIndexAsync(new FindTableIndexParameters(_parameters.Index, startKeys))
+                .ConfigureAwait(false);
+            if (result == null)
+            {
+                _isFinished = true;
+                return;
+            }
+
+            var page = result.Page;
+            try
+            {
+                int startIndex;
+                if (IsReverse)
+                {
+                    // The descent finds the last entry at or before the
+                    //  upper bound so no matching entry lies to the right
+                    startIndex = page.FindDescentIndex(_toInfo);
+                }
+                else
+                {
+                    // Duplicates of the lower bound can start on an earlier
+                    //  leaf than the one the descent arrives at
+                    startIndex = FindFirstEntryInRange(page);
+                    while (startIndex == 0 && page.PrevLogicalPageId != LogicalPageId.Zero)
+                    {
+                        var prevPage = await _manager
+                            .LoadLeafPageAsync(_parameters.Index, page.PrevLogicalPageId)
+                            .ConfigureAwait(false);
+                        if (prevPage.IndexCount == 0 ||
+                            prevPage.IndexEntries[prevPage.IndexCount - 1].CompareTo(_fromInfo) < 0)
+                        {
+                            prevPage.Dispose();
+                            break;
+                        }
+
+                        page.Dispose();
+                        page = prevPage;
+                        startIndex = FindFirstEntryInRange(page);
+                    }
+                }
+
+                CopyBatch(page, startIndex);
+            }
+            finally
+            {
+                page.Dispose();
+            }
+            await ReadAheadAsync().ConfigureAwait(false);
+        }
+
+        private async Task LoadNextBatchAsync()
+        {
+            var page = await _manager
+                .LoadLeafPageAsync(_parameters.Index, _nextPageId)
+                .ConfigureAwait(false);
+            try
+            {
+                // Walk right past any pages split off our left sibling since
+                //  the last batch was copied
+                while (IsReverse &&
+                    page.NextLogicalPageId != _currentPageId &&
+                    page.NextLogicalPageId != LogicalPageId.Zero)
+                {
+                    var nextPageId = page.NextLogicalPageId;
+                    page.Dispose();
+                    page = null;
+                    page = await _manager
+                        .LoadLeafPageAsync(_parameters.Index, nextPageId)
+                        .ConfigureAwait(false);
+                }
+
+                CopyBatch(page, IsReverse ? page.IndexCount - 1 : 0);
+            }
+            finally
+            {
+                page?.Dispose();
+            }
+
+            if (_pagesReadAhead > 0)
+            {
+                --_pagesReadAhead;
+            }
+            await ReadAheadAsync().ConfigureAwait(false);
+        }
+
+        private int FindFirstEntryInRange(TableIndexPage page)
+        {
+            var index = page.FindDescentIndex(_fromInfo);
+            while (index >= 0 && page.IndexEntries[index].CompareTo(_fromInfo) >= 0)
+            {
+                --index;
+            }
+            return index + 1;
+        }
+
+        private void CopyBatch(TableIndexPage page, int startIndex)
+        {
+            // Copy every entry in range so the sibling link read with this
+            //  page covers everything after the batch
+            var step = IsReverse ? -1 : 1;
+            for (var index = startIndex; index >= 0 && index < page.IndexCount; index += step)
+            {
+                var entry = (TableIndexLeafInfo)page.IndexEntries[index];
+                if (IsReverse ? entry.CompareTo(_fromInfo) < 0 : entry.CompareTo(_toInfo) > 0)
+                {
+                    _isFinished = true;
+                    return;
+                }
+                _batch.Add(entry);
+            }
+
+            _currentPageId = page.LogicalPageId;
+            _nextPageId = IsReverse ? page.PrevLogicalPageId : page.NextLogicalPageId;
+            if (_nextPageId == LogicalPageId.Zero)
+            {
+                _isFinished = true;
+            }
+        }
+
+        private async Task ReadAheadAsync()
+        {
+            // Keep a window of pages ahead of the consumer warm; the next
+            //  window starts where the last one ended once we are close to it
+            if (_isFinished ||
+                _pagesReadAhead > 1 ||
+                (_readAheadTask != null && !_readAheadTask.IsCompleted))
+            {
+                return;
+            }
+
+            // The previous window has completed so awaiting it never blocks
+            //  and surfaces any read failure
+            var startPageId = _nextPageId;
+            if (_readAheadTask != null)
+            {
+                var endPageId = await _readAheadTask.ConfigureAwait(false);
+                if (_pagesReadAhead > 0)
+                {
+                    startPageId = endPageId;
+                }
+            }
+            if (startPageId == LogicalPageId.Zero)
+            {
+                return;
+            }
+
+            _readAheadTask = _manager.ReadAheadLeafPagesAsync(
+                _parameters.Index, startPageId, ReadAheadPageCount, IsReverse, _readAheadCancellation.Token);
+            _pagesReadAhead += ReadAheadPageCount;
+        }
+        #endregion
+    }
+}
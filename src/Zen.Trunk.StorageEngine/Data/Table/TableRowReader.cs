@@ -1,8 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.IO;
-using System.Linq;
-using Zen.Trunk.IO;
 
 namespace Zen.Trunk.Storage.Data.Table
 {
@@ -12,8 +10,10 @@ namespace Zen.Trunk.Storage.Data.Table
     public class TableRowReader
 	{
 		#region Private Fields
-		private readonly SwitchingBinaryReader _bufferReader;
-		private readonly IList<TableColumnInfo> _rowDef;
+		private readonly Stream _stream;
+		private readonly byte[] _buffer;
+		private readonly int _bufferOffset;
+		private readonly TableRowSerializer _serializer;
 		private readonly object[] _rowValues;
         #endregion
 
@@ -24,10 +24,38 @@ namespace Zen.Trunk.Storage.Data.Table
         /// <param name="stream">The stream.</param>
         /// <param name="rowDef">The row definition.</param>
         public TableRowReader(Stream stream, IList<TableColumnInfo> rowDef)
+			: this(stream, TableRowSerializer.GetSerializer(rowDef))
 		{
-			_bufferReader = new SwitchingBinaryReader(stream, true);
-			_rowDef = rowDef;
-			_rowValues = new object[_rowDef.Count];
+		}
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TableRowReader"/> class.
+        /// </summary>
+        /// <param name="stream">The stream.</param>
+        /// <param name="serializer">The row serializer.</param>
+        public TableRowReader(Stream stream, TableRowSerializer serializer)
+		{
+			_stream = stream;
+			_serializer = serializer;
+			_buffer = new byte[serializer.MaxRowSize];
+			_rowValues = new object[serializer.ColumnCount];
+		}
+		#endregion
+
+		#region Internal Constructors
+		/// <summary>
+		/// Initializes a new instance of the <see cref="TableRowReader"/> class
+		/// for the row held at the specified offset within a buffer.
+		/// </summary>
+		/// <param name="buffer">The buffer.</param>
+		/// <param name="offset">The offset of the row in the buffer.</param>
+		/// <param name="serializer">The row serializer.</param>
+		internal TableRowReader(byte[] buffer, int offset, TableRowSerializer serializer)
+		{
+			_buffer = buffer;
+			_bufferOffset = offset;
+			_serializer = serializer;
+			_rowValues = new object[serializer.ColumnCount];
 		}
 		#endregion
 
@@ -58,23 +86,25 @@ namespace Zen.Trunk.Storage.Data.Table
 		{
 			get
 			{
-				return (ushort)_rowDef
-					.Zip(_rowValues, (def, val) => def.GetActualDataSize(val))
-					.Sum();
+				return (ushort)_serializer.GetRowSize(_rowValues);
 			}
 		}
 		#endregion
 
 		#region Public Methods
 		/// <summary>
-		/// Reads a row from the underlying buffer reader into this instance.
+		/// Reads a row from the underlying stream or buffer into this instance.
 		/// </summary>
+		/// <exception cref="EndOfStreamException">
+		/// The underlying stream does not hold another row.
+		/// </exception>
 		public void Read()
 		{
-			for (var index = 0; index < _rowDef.Count; ++index)
+			if (_stream != null)
 			{
-				_rowValues[index] = _rowDef[index].ReadData(_bufferReader);
+				_serializer.ReadFrom(_stream, _buffer);
 			}
+			_serializer.Read(_buffer, _bufferOffset, _rowValues);
 		}
 		#endregion
 	}
@@ -0,0 +1,796 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq.Expressions;
+using System.Reflection;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace Zen.Trunk.Storage.Data.Table
+{
+    /// <summary>
+    /// <c>TableRowSerializer</c> reads and writes table rows using code
+    /// compiled for a specific row definition.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Rows are laid out as a null bitmap holding one bit for each nullable
+    /// column, followed by every fixed length column at an offset determined
+    /// when the serializer is built, followed by every variable length column
+    /// prefixed with its length in bytes. Null fixed length columns are
+    /// zero filled and null variable length columns have zero length.
+    /// </para>
+    /// <para>
+    /// Serializers are cached against a signature of the row definition made
+    /// up of the identifier, type, length and nullability of each column, so
+    /// every table and page sharing a schema shares one serializer no matter
+    /// which column collection instance it holds.
+    /// </para>
+    /// </remarks>
+    public sealed class TableRowSerializer
+    {
+        #region Private Types
+        [StructLayout(LayoutKind.Explicit)]
+        private struct SingleBits
+        {
+            [FieldOffset(0)]
+            public float Single;
+
+            [FieldOffset(0)]
+            public int Bits;
+        }
+
+        private sealed class RowSignature : IEquatable<RowSignature>
+        {
+            private readonly long[] _columns;
+            private readonly int _hashCode;
+
+            public RowSignature(IList<TableColumnInfo> rowDef)
+            {
+                _columns = new long[rowDef.Count];
+                var hashCode = rowDef.Count;
+                for (var index = 0; index < rowDef.Count; ++index)
+                {
+                    var column = rowDef[index];
+                    _columns[index] =
+                        ((long)column.Id << 32) |
+                        ((long)column.DataType << 24) |
+                        ((column.Nullable ? 1L : 0L) << 16) |
+                        column.Length;
+                    hashCode = (hashCode * 397) ^ _columns[index].GetHashCode();
+                }
+                _hashCode = hashCode;
+            }
+
+            public bool Equals(RowSignature other)
+            {
+                if (other == null || other._hashCode != _hashCode || other._columns.Length != _columns.Length)
+                {
+                    return false;
+                }
+
+                for (var index = 0; index < _columns.Length; ++index)
+                {
+                    if (other._columns[index] != _columns[index])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            public override bool Equals(object obj)
+            {
+                return Equals(obj as RowSignature);
+            }
+
+            public override int GetHashCode()
+            {
+                return _hashCode;
+            }
+        }
+        #endregion
+
+        #region Private Fields
+        private static readonly ConcurrentDictionary<RowSignature, TableRowSerializer> Serializers =
+            new ConcurrentDictionary<RowSignature, TableRowSerializer>();
+
+        private readonly IList<TableColumnInfo> _rowDef;
+        private readonly int[] _columnOffsets;
+        private readonly int[] _nullBits;
+        private readonly int[] _variableColumns;
+        private readonly Func<object[], int> _getRowSize;
+        private readonly Func<object[], byte[], int, int> _write;
+        private readonly Action<byte[], int, object[]> _read;
+        #endregion
+
+        #region Private Constructors
+        private TableRowSerializer(IList<TableColumnInfo> rowDef)
+        {
+            _rowDef = rowDef;
+            _columnOffsets = new int[rowDef.Count];
+            _nullBits = new int[rowDef.Count];
+
+            // Assign null bits
+            var nullableCount = 0;
+            for (var index = 0; index < rowDef.Count; ++index)
+            {
+                _nullBits[index] = rowDef[index].Nullable ? nullableCount++ : -1;
+            }
+            NullBitmapSize = (nullableCount + 7) / 8;
+
+            // Assign fixed column offsets and variable column ordinals
+            var offset = NullBitmapSize;
+            var variableColumns = new List<int>();
+            MaxRowSize = NullBitmapSize;
+            for (var index = 0; index < rowDef.Count; ++index)
+            {
+                var column = rowDef[index];
+                if (column.IsVariableLength)
+                {
+                    _columnOffsets[index] = -(variableColumns.Count + 1);
+                    variableColumns.Add(index);
+                }
+                else
+                {
+                    _columnOffsets[index] = offset;
+                    offset += column.MaxDataSize;
+                }
+                MaxRowSize += column.MaxDataSize;
+            }
+            FixedSize = offset;
+            _variableColumns = variableColumns.ToArray();
+
+            _getRowSize = CompileGetRowSize();
+            _write = CompileWrite();
+            _read = CompileRead();
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the number of columns in the row definition.
+        /// </summary>
+        /// <value>
+        /// The column count.
+        /// </value>
+        public int ColumnCount => _rowDef.Count;
+
+        /// <summary>
+        /// Gets the size of the null bitmap in bytes.
+        /// </summary>
+        /// <value>
+        /// The size of the null bitmap.
+        /// </value>
+        public int NullBitmapSize { get; }
+
+        /// <summary>
+        /// Gets the size in bytes of the null bitmap and fixed length columns.
+        /// </summary>
+        /// <value>
+        /// The size of the fixed portion of every row.
+        /// </value>
+        public int FixedSize { get; }
+
+        /// <summary>
+        /// Gets the maximum size of a row in bytes.
+        /// </summary>
+        /// <value>
+        /// The maximum size of a row.
+        /// </value>
+        public int MaxRowSize { get; }
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Gets the serializer for the specified row definition.
+        /// </summary>
+        /// <param name="rowDef">The row definition.</param>
+        /// <returns>
+        /// A <see cref="TableRowSerializer"/> compiled for the row definition.
+        /// </returns>
+        public static TableRowSerializer GetSerializer(IList<TableColumnInfo> rowDef)
+        {
+            if (rowDef == null)
+            {
+                throw new ArgumentNullException(nameof(rowDef));
+            }
+            return Serializers.GetOrAdd(new RowSignature(rowDef), key => new TableRowSerializer(rowDef));
+        }
+
+        /// <summary>
+        /// Gets the size in bytes of a row holding the specified values.
+        /// </summary>
+        /// <param name="values">The column values.</param>
+        /// <returns>The row size.</returns>
+        public int GetRowSize(object[] values)
+        {
+            return _getRowSize(values);
+        }
+
+        /// <summary>
+        /// Writes a row holding the specified values to a buffer.
+        /// </summary>
+        /// <param name="values">The column values.</param>
+        /// <param name="buffer">The buffer.</param>
+        /// <param name="offset">The offset of the row in the buffer.</param>
+        /// <returns>The number of bytes written.</returns>
+        public int Write(object[] values, byte[] buffer, int offset)
+        {
+            return _write(values, buffer, offset);
+        }
+
+        /// <summary>
+        /// Reads the column values of the row held in a buffer.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        /// <param name="offset">The offset of the row in the buffer.</param>
+        /// <param name="values">The array receiving the column values.</param>
+        public void Read(byte[] buffer, int offset, object[] values)
+        {
+            _read(buffer, offset, values);
+        }
+
+        /// <summary>
+        /// Determines whether the specified column of a row is null.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        /// <param name="rowOffset">The offset of the row in the buffer.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <returns>
+        /// <c>true</c> if the column is null; otherwise, <c>false</c>.
+        /// </returns>
+        public bool IsNull(byte[] buffer, int rowOffset, int columnIndex)
+        {
+            var nullBit = _nullBits[columnIndex];
+            return nullBit >= 0 && IsNullBitSet(buffer, rowOffset, nullBit);
+        }
+
+        /// <summary>
+        /// Gets the offset of the specified column data within a row.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        /// <param name="rowOffset">The offset of the row in the buffer.</param>
+        /// <param name="columnIndex">Zero based column index.</param>
+        /// <param name="length">The length of the column data.</param>
+        /// <returns>
+        /// The offset in the buffer of the column data excluding any length
+        /// prefix.
+        /// </returns>
+        public int GetColumnOffset(byte[] buffer, int rowOffset, int columnIndex, out int length)
+        {
+            var columnOffset = _columnOffsets[columnIndex];
+            if (columnOffset >= 0)
+            {
+                length = _rowDef[columnIndex].MaxDataSize;
+                return rowOffset + columnOffset;
+            }
+
+            // Skip preceding variable length columns
+            var position = rowOffset + FixedSize;
+            for (var ordinal = -columnOffset - 1; ordinal > 0; --ordinal)
+            {
+                position += 2 + ReadUInt16(buffer, position);
+            }
+            length = ReadUInt16(buffer, position);
+            return position + 2;
+        }
+        #endregion
+
+        #region Internal Methods
+        /// <summary>
+        /// Reads the next row from a stream into a buffer.
+        /// </summary>
+        /// <param name="stream">The stream.</param>
+        /// <param name="buffer">
+        /// The buffer; must be at least <see cref="MaxRowSize"/> bytes.
+        /// </param>
+        /// <returns>The number of bytes read.</returns>
+        /// <exception cref="EndOfStreamException">
+        /// The stream ended before a complete row was read.
+        /// </exception>
+        internal int ReadFrom(Stream stream, byte[] buffer)
+        {
+            var position = 0;
+            ReadExact(stream, buffer, ref position, FixedSize);
+            for (var ordinal = 0; ordinal < _variableColumns.Length; ++ordinal)
+            {
+                ReadExact(stream, buffer, ref position, 2);
+                ReadExact(stream, buffer, ref position, ReadUInt16(buffer, position - 2));
+            }
+            return position;
+        }
+        #endregion
+
+        #region Private Methods
+        private Func<object[], int> CompileGetRowSize()
+        {
+            var values = Expression.Parameter(typeof(object[]), "values");
+            Expression size = Expression.Constant(FixedSize);
+            foreach (var index in _variableColumns)
+            {
+                var method = _rowDef[index].DataType == TableColumnDataType.NVarChar
+                    ? nameof(GetUnicodeStringSize)
+                    : nameof(GetAnsiStringSize);
+                size = Expression.Add(
+                    size,
+                    Expression.Call(
+                        GetHelper(method),
+                        Expression.TypeAs(GetValue(values, index), typeof(string))));
+            }
+            return Expression.Lambda<Func<object[], int>>(size, values).Compile();
+        }
+
+        private Func<object[], byte[], int, int> CompileWrite()
+        {
+            var values = Expression.Parameter(typeof(object[]), "values");
+            var buffer = Expression.Parameter(typeof(byte[]), "buffer");
+            var offset = Expression.Parameter(typeof(int), "offset");
+            var position = Expression.Variable(typeof(int), "position");
+            var body = new List<Expression>
+            {
+                Expression.Call(
+                    typeof(Array).GetMethod(nameof(Array.Clear)),
+                    buffer, offset, Expression.Constant(FixedSize))
+            };
+
+            for (var index = 0; index < _rowDef.Count; ++index)
+            {
+                if (_columnOffsets[index] < 0)
+                {
+                    continue;
+                }
+
+                var value = GetValue(values, index);
+                Expression write = GetWriteFixed(
+                    _rowDef[index], buffer,
+                    Expression.Add(offset, Expression.Constant(_columnOffsets[index])), value);
+                if (_nullBits[index] >= 0)
+                {
+                    write = Expression.IfThenElse(
+                        Expression.ReferenceEqual(value, Expression.Constant(null)),
+                        GetSetNullBit(buffer, offset, _nullBits[index]),
+                        write);
+                }
+                body.Add(write);
+            }
+
+            body.Add(Expression.Assign(position, Expression.Add(offset, Expression.Constant(FixedSize))));
+            foreach (var index in _variableColumns)
+            {
+                var value = GetValue(values, index);
+                var method = _rowDef[index].DataType == TableColumnDataType.NVarChar
+                    ? nameof(WriteUnicodeString)
+                    : nameof(WriteAnsiString);
+                if (_nullBits[index] >= 0)
+                {
+                    body.Add(Expression.IfThen(
+                        Expression.ReferenceEqual(value, Expression.Constant(null)),
+                        GetSetNullBit(buffer, offset, _nullBits[index])));
+                }
+                body.Add(Expression.Assign(
+                    position,
+                    Expression.Call(
+                        GetHelper(method), buffer, position,
+                        Expression.TypeAs(value, typeof(string)))));
+            }
+
+            body.Add(Expression.Subtract(position, offset));
+            return Expression
+                .Lambda<Func<object[], byte[], int, int>>(
+                    Expression.Block(new[] { position }, body), values, buffer, offset)
+                .Compile();
+        }
+
+        private Action<byte[], int, object[]> CompileRead()
+        {
+            var buffer = Expression.Parameter(typeof(byte[]), "buffer");
+            var offset = Expression.Parameter(typeof(int), "offset");
+            var values = Expression.Parameter(typeof(object[]), "values");
+            var position = Expression.Variable(typeof(int), "position");
+            var body = new List<Expression>();
+
+            for (var index = 0; index < _rowDef.Count; ++index)
+            {
+                if (_columnOffsets[index] < 0)
+                {
+                    continue;
+                }
+
+                var read = GetReadFixed(
+                    _rowDef[index], buffer,
+                    Expression.Add(offset, Expression.Constant(_columnOffsets[index])));
+                body.Add(Expression.Assign(
+                    Expression.ArrayAccess(values, Expression.Constant(index)),
+                    GetNullableValue(buffer, offset, index, read)));
+            }
+
+            body.Add(Expression.Assign(position, Expression.Add(offset, Expression.Constant(FixedSize))));
+            foreach (var index in _variableColumns)
+            {
+                var method = _rowDef[index].DataType == TableColumnDataType.NVarChar
+                    ? nameof(ReadUnicodeString)
+                    : nameof(ReadAnsiString);
+                body.Add(Expression.Assign(
+                    Expression.ArrayAccess(values, Expression.Constant(index)),
+                    GetNullableValue(buffer, offset, index, Expression.Call(GetHelper(method), buffer, position))));
+                body.Add(Expression.Assign(
+                    position,
+                    Expression.Call(GetHelper(nameof(SkipVariable)), buffer, position)));
+            }
+
+            body.Add(Expression.Empty());
+            return Expression
+                .Lambda<Action<byte[], int, object[]>>(
+                    Expression.Block(new[] { position }, body), buffer, offset, values)
+                .Compile();
+        }
+
+        private Expression GetNullableValue(
+            Expression buffer, Expression offset, int index, Expression read)
+        {
+            Expression value = Expression.Convert(read, typeof(object));
+            if (_nullBits[index] >= 0)
+            {
+                value = Expression.Condition(
+                    Expression.Call(
+                        GetHelper(nameof(IsNullBitSet)), buffer, offset,
+                        Expression.Constant(_nullBits[index])),
+                    Expression.Constant(null),
+                    value);
+            }
+            return value;
+        }
+
+        private static Expression GetValue(Expression values, int index)
+        {
+            return Expression.ArrayIndex(values, Expression.Constant(index));
+        }
+
+        private static Expression GetSetNullBit(Expression buffer, Expression offset, int nullBit)
+        {
+            return Expression.Call(
+                GetHelper(nameof(SetNullBit)), buffer, offset, Expression.Constant(nullBit));
+        }
+
+        private static Expression GetWriteFixed(
+            TableColumnInfo column, Expression buffer, Expression offset, Expression value)
+        {
+            var valueType = column.ColumnType;
+            var typedValue = Expression.Convert(value, valueType);
+            switch (column.DataType)
+            {
+                case TableColumnDataType.Byte:
+                    if (valueType == typeof(byte[]))
+                    {
+                        return Expression.Call(
+                            GetHelper(nameof(WriteBytes)), buffer, offset, typedValue,
+                            Expression.Constant((int)column.Length));
+                    }
+                    break;
+                case TableColumnDataType.Char:
+                case TableColumnDataType.NChar:
+                    var isUnicode = column.DataType == TableColumnDataType.NChar;
+                    if (valueType == typeof(char))
+                    {
+                        return Expression.Call(
+                            GetHelper(isUnicode ? nameof(WriteUnicodeChar) : nameof(WriteAnsiChar)),
+                            buffer, offset, typedValue);
+                    }
+                    return Expression.Call(
+                        GetHelper(isUnicode ? nameof(WriteUnicodeFixed) : nameof(WriteAnsiFixed)),
+                        buffer, offset, typedValue, Expression.Constant((int)column.Length));
+            }
+            return Expression.Call(GetHelper("Write", valueType), buffer, offset, typedValue);
+        }
+
+        private static Expression GetReadFixed(
+            TableColumnInfo column, Expression buffer, Expression offset)
+        {
+            var valueType = column.ColumnType;
+            switch (column.DataType)
+            {
+                case TableColumnDataType.Byte:
+                    if (valueType == typeof(byte[]))
+                    {
+                        return Expression.Call(
+                            GetHelper(nameof(ReadBytes)), buffer, offset,
+                            Expression.Constant((int)column.Length));
+                    }
+                    break;
+                case TableColumnDataType.Char:
+                case TableColumnDataType.NChar:
+                    var isUnicode = column.DataType == TableColumnDataType.NChar;
+                    if (valueType == typeof(char))
+                    {
+                        return Expression.Call(
+                            GetHelper(isUnicode ? nameof(ReadUnicodeChar) : nameof(ReadAnsiChar)),
+                            buffer, offset);
+                    }
+                    return Expression.Call(
+                        GetHelper(isUnicode ? nameof(ReadUnicodeFixed) : nameof(ReadAnsiFixed)),
+                        buffer, offset, Expression.Constant((int)column.Length));
+            }
+            return Expression.Call(GetHelper("Read", valueType), buffer, offset);
+        }
+
+        private static MethodInfo GetHelper(string name)
+        {
+            return typeof(TableRowSerializer).GetMethod(
+                name, BindingFlags.NonPublic | BindingFlags.Static);
+        }
+
+        private static MethodInfo GetHelper(string prefix, Type valueType)
+        {
+            var method = GetHelper(prefix + valueType.Name);
+            if (method == null)
+            {
+                throw new InvalidOperationException("Unknown column type specified.");
+            }
+            return method;
+        }
+
+        private static void ReadExact(Stream stream, byte[] buffer, ref int position, int count)
+        {
+            while (count > 0)
+            {
+                var bytesRead = stream.Read(buffer, position, count);
+                if (bytesRead == 0)
+                {
+                    throw new EndOfStreamException();
+                }
+                position += bytesRead;
+                count -= bytesRead;
+            }
+        }
+        #endregion
+
+        #region Encoding Helpers
+        private static bool IsNullBitSet(byte[] buffer, int offset, int nullBit)
+        {
+            return (buffer[offset + (nullBit >> 3)] & (1 << (nullBit & 7))) != 0;
+        }
+
+        private static void SetNullBit(byte[] buffer, int offset, int nullBit)
+        {
+            buffer[offset + (nullBit >> 3)] |= (byte)(1 << (nullBit & 7));
+        }
+
+        private static int ReadUInt16(byte[] buffer, int offset)
+        {
+            return buffer[offset] | (buffer[offset + 1] << 8);
+        }
+
+        private static int SkipVariable(byte[] buffer, int position)
+        {
+            return position + 2 + ReadUInt16(buffer, position);
+        }
+
+        private static int GetAnsiStringSize(string value)
+        {
+            return 2 + (value?.Length ?? 0);
+        }
+
+        private static int GetUnicodeStringSize(string value)
+        {
+            return 2 + ((value?.Length ?? 0) * 2);
+        }
+
+        private static void WriteBoolean(byte[] buffer, int offset, bool value)
+        {
+            buffer[offset] = value ? (byte)1 : (byte)0;
+        }
+
+        private static void WriteByte(byte[] buffer, int offset, byte value)
+        {
+            buffer[offset] = value;
+        }
+
+        private static void WriteBytes(byte[] buffer, int offset, byte[] value, int count)
+        {
+            Buffer.BlockCopy(value, 0, buffer, offset, Math.Min(value.Length, count));
+        }
+
+        private static void WriteInt16(byte[] buffer, int offset, short value)
+        {
+            buffer[offset] = (byte)value;
+            buffer[offset + 1] = (byte)(value >> 8);
+        }
+
+        private static void WriteInt32(byte[] buffer, int offset, int value)
+        {
+            buffer[offset] = (byte)value;
+            buffer[offset + 1] = (byte)(value >> 8);
+            buffer[offset + 2] = (byte)(value >> 16);
+            buffer[offset + 3] = (byte)(value >> 24);
+        }
+
+        private static void WriteInt64(byte[] buffer, int offset, long value)
+        {
+            WriteInt32(buffer, offset, (int)value);
+            WriteInt32(buffer, offset + 4, (int)(value >> 32));
+        }
+
+        private static void WriteUInt64(byte[] buffer, int offset, ulong value)
+        {
+            WriteInt64(buffer, offset, (long)value);
+        }
+
+        private static void WriteSingle(byte[] buffer, int offset, float value)
+        {
+            WriteInt32(buffer, offset, new SingleBits { Single = value }.Bits);
+        }
+
+        private static void WriteDouble(byte[] buffer, int offset, double value)
+        {
+            WriteInt64(buffer, offset, BitConverter.DoubleToInt64Bits(value));
+        }
+
+        private static void WriteDecimal(byte[] buffer, int offset, decimal value)
+        {
+            var bits = decimal.GetBits(value);
+            for (var index = 0; index < bits.Length; ++index)
+            {
+                WriteInt32(buffer, offset + (index * 4), bits[index]);
+            }
+        }
+
+        private static void WriteDateTime(byte[] buffer, int offset, DateTime value)
+        {
+            WriteInt64(buffer, offset, value.Ticks);
+        }
+
+        private static void WriteGuid(byte[] buffer, int offset, Guid value)
+        {
+            Buffer.BlockCopy(value.ToByteArray(), 0, buffer, offset, 16);
+        }
+
+        private static void WriteAnsiChar(byte[] buffer, int offset, char value)
+        {
+            buffer[offset] = value < 0x80 ? (byte)value : (byte)'?';
+        }
+
+        private static void WriteUnicodeChar(byte[] buffer, int offset, char value)
+        {
+            WriteInt16(buffer, offset, (short)value);
+        }
+
+        private static void WriteAnsiFixed(byte[] buffer, int offset, string value, int count)
+        {
+            Encoding.ASCII.GetBytes(value, 0, Math.Min(value.Length, count), buffer, offset);
+        }
+
+        private static void WriteUnicodeFixed(byte[] buffer, int offset, string value, int count)
+        {
+            Encoding.Unicode.GetBytes(value, 0, Math.Min(value.Length, count), buffer, offset);
+        }
+
+        private static int WriteAnsiString(byte[] buffer, int position, string value)
+        {
+            var byteCount = value != null
+                ? Encoding.ASCII.GetBytes(value, 0, value.Length, buffer, position + 2)
+                : 0;
+            WriteInt16(buffer, position, (short)byteCount);
+            return position + 2 + byteCount;
+        }
+
+        private static int WriteUnicodeString(byte[] buffer, int position, string value)
+        {
+            var byteCount = value != null
+                ? Encoding.Unicode.GetBytes(value, 0, value.Length, buffer, position + 2)
+                : 0;
+            WriteInt16(buffer, position, (short)byteCount);
+            return position + 2 + byteCount;
+        }
+
+        private static bool ReadBoolean(byte[] buffer, int offset)
+        {
+            return (buffer[offset] & 1) != 0;
+        }
+
+        private static byte ReadByte(byte[] buffer, int offset)
+        {
+            return buffer[offset];
+        }
+
+        private static byte[] ReadBytes(byte[] buffer, int offset, int count)
+        {
+            var value = new byte[count];
+            Buffer.BlockCopy(buffer, offset, value, 0, count);
+            return value;
+        }
+
+        private static short ReadInt16(byte[] buffer, int offset)
+        {
+            return (short)ReadUInt16(buffer, offset);
+        }
+
+        private static int ReadInt32(byte[] buffer, int offset)
+        {
+            return buffer[offset] |
+                (buffer[offset + 1] << 8) |
+                (buffer[offset + 2] << 16) |
+                (buffer[offset + 3] << 24);
+        }
+
+        private static long ReadInt64(byte[] buffer, int offset)
+        {
+            return (uint)ReadInt32(buffer, offset) | ((long)ReadInt32(buffer, offset + 4) << 32);
+        }
+
+        private static ulong ReadUInt64(byte[] buffer, int offset)
+        {
+            return (ulong)ReadInt64(buffer, offset);
+        }
+
+        private static float ReadSingle(byte[] buffer, int offset)
+        {
+            return new SingleBits { Bits = ReadInt32(buffer, offset) }.Single;
+        }
+
+        private static double ReadDouble(byte[] buffer, int offset)
+        {
+            return BitConverter.Int64BitsToDouble(ReadInt64(buffer, offset));
+        }
+
+        private static decimal ReadDecimal(byte[] buffer, int offset)
+        {
+            var flags = ReadInt32(buffer, offset + 12);
+            return new decimal(
+                ReadInt32(buffer, offset),
+                ReadInt32(buffer, offset + 4),
+                ReadInt32(buffer, offset + 8),
+                flags < 0,
+                (byte)((flags >> 16) & 0xff));
+        }
+
+        private static DateTime ReadDateTime(byte[] buffer, int offset)
+        {
+            return new DateTime(ReadInt64(buffer, offset));
+        }
+
+        private static Guid ReadGuid(byte[] buffer, int offset)
+        {
+            return new Guid(
+                ReadInt32(buffer, offset),
+                ReadInt16(buffer, offset + 4),
+                ReadInt16(buffer, offset + 6),
+                buffer[offset + 8], buffer[offset + 9],
+                buffer[offset + 10], buffer[offset + 11],
+                buffer[offset + 12], buffer[offset + 13],
+                buffer[offset + 14], buffer[offset + 15]);
+        }
+
+        private static char ReadAnsiChar(byte[] buffer, int offset)
+        {
+            return (char)buffer[offset];
+        }
+
+        private static char ReadUnicodeChar(byte[] buffer, int offset)
+        {
+            return (char)ReadUInt16(buffer, offset);
+        }
+
+        private static string ReadAnsiFixed(byte[] buffer, int offset, int count)
+        {
+            return Encoding.ASCII.GetString(buffer, offset, count).TrimEnd('\0');
+        }
+
+        private static string ReadUnicodeFixed(byte[] buffer, int offset, int count)
+        {
+            return Encoding.Unicode.GetString(buffer, offset, count * 2).TrimEnd('\0');
+        }
+
+        private static string ReadAnsiString(byte[] buffer, int position)
+        {
+            return Encoding.ASCII.GetString(buffer, position + 2, ReadUInt16(buffer, position));
+        }
+
+        private static string ReadUnicodeString(byte[] buffer, int position)
+        {
+            return Encoding.Unicode.GetString(buffer, position + 2, ReadUInt16(buffer, position));
+        }
+        #endregion
+    }
+}
@@ -1,8 +1,6 @@
 using System;
 using System.Collections.Generic;
 using System.IO;
-using System.Linq;
-using Zen.Trunk.IO;
 
 namespace Zen.Trunk.Storage.Data.Table
 {
@@ -12,9 +10,10 @@ namespace Zen.Trunk.Storage.Data.Table
     public class TableRowWriter
     {
         #region Private Fields
-        private readonly SwitchingBinaryWriter _bufferWriter;
-        private readonly IList<TableColumnInfo> _rowDef;
+        private readonly Stream _stream;
+        private readonly TableRowSerializer _serializer;
         private readonly object[] _rowValues;
+        private byte[] _buffer;
         #endregion
 
         #region Public Constructors
@@ -24,10 +23,21 @@ namespace Zen.Trunk.Storage.Data.Table
         /// <param name="stream">The stream.</param>
         /// <param name="rowDef">The row definition.</param>
         public TableRowWriter(Stream stream, IList<TableColumnInfo> rowDef)
+            : this(stream, TableRowSerializer.GetSerializer(rowDef))
         {
-            _bufferWriter = new SwitchingBinaryWriter(stream, true);
-            _rowDef = rowDef;
-            _rowValues = new object[_rowDef.Count];
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="TableRowWriter"/> class.
+        /// </summary>
+        /// <param name="stream">The stream.</param>
+        /// <param name="serializer">The row serializer.</param>
+        public TableRowWriter(Stream stream, TableRowSerializer serializer)
+        {
+            _stream = stream;
+            _serializer = serializer;
+            _rowValues = new object[serializer.ColumnCount];
+            _buffer = new byte[serializer.MaxRowSize];
         }
         #endregion
 
@@ -58,23 +68,25 @@ namespace Zen.Trunk.Storage.Data.Table
         {
             get
             {
-                return (ushort)_rowDef
-                    .Zip(_rowValues, (def, val) => def.GetActualDataSize(val))
-                    .Sum();
+                return (ushort)_serializer.GetRowSize(_rowValues);
             }
         }
         #endregion
 
         #region Public Methods
         /// <summary>
-        /// Writes the row data in this instance to the underlying buffer writer.
+        /// Writes the row data in this instance to the underlying stream.
         /// </summary>
         public void Write()
         {
-            for (var index = 0; index < _rowDef.Count; ++index)
+            var rowSize = _serializer.GetRowSize(_rowValues);
+            if (_buffer.Length < rowSize)
             {
-                _rowDef[index].WriteData(_bufferWriter, _rowValues[index]);
+                _buffer = new byte[rowSize];
             }
+
+            _serializer.Write(_rowValues, _buffer, 0);
+            _stream.Write(_buffer, 0, rowSize);
         }
         #endregion
     }
@@ -7,15 +7,17 @@ namespace Zen.Trunk.Storage.Data.Table
     /// extra information needed for recording table extends.
     /// </summary>
     /// <remarks>
-    /// The table schema root page object maintains two additional properties;
+    /// The table schema root page object maintains three additional properties;
     /// 1. The first data page
     /// 2. The last data page
+    /// 3. The first free space map page
     /// </remarks>
     public class TableSchemaRootPage : TableSchemaPage
     {
         #region Private Fields
         private readonly BufferFieldUInt64 _dataFirstLogicalPageId;
         private readonly BufferFieldUInt64 _dataLastLogicalPageId;
+        private readonly BufferFieldUInt64 _freeSpaceFirstLogicalPageId;
         #endregion
 
         #region Public Constructors
@@ -26,6 +28,7 @@ namespace Zen.Trunk.Storage.Data.Table
         {
             _dataFirstLogicalPageId = new BufferFieldUInt64(base.LastHeaderField);
             _dataLastLogicalPageId = new BufferFieldUInt64(_dataFirstLogicalPageId);
+            _freeSpaceFirstLogicalPageId = new BufferFieldUInt64(_dataLastLogicalPageId);
         }
         #endregion
 
@@ -36,7 +39,7 @@ namespace Zen.Trunk.Storage.Data.Table
         /// <value>
         /// The minimum size of the header.
         /// </value>
-        public override uint MinHeaderSize => base.MinHeaderSize + 16;
+        public override uint MinHeaderSize => base.MinHeaderSize + 24;
 
         /// <summary>
         /// Gets or sets the logical page identifier of the first data page for the table.
@@ -75,6 +78,26 @@ namespace Zen.Trunk.Storage.Data.Table
                 }
             }
         }
+
+        /// <summary>
+        /// Gets or sets the logical page identifier of the first free space
+        /// map page for the table.
+        /// </summary>
+        /// <value>
+        /// The logical page identifier.
+        /// </value>
+        public LogicalPageId FreeSpaceFirstLogicalPageId
+        {
+            get => new LogicalPageId(_freeSpaceFirstLogicalPageId.Value);
+            set
+            {
+                if (_freeSpaceFirstLogicalPageId.Value != value.Value)
+                {
+                    _freeSpaceFirstLogicalPageId.Value = value.Value;
+                    SetHeaderDirty();
+                }
+            }
+        }
         #endregion
 
         #region Protected Properties
@@ -84,7 +107,7 @@ namespace Zen.Trunk.Storage.Data.Table
         /// <value>
         /// The last header field.
         /// </value>
-        protected override BufferField LastHeaderField => _dataLastLogicalPageId;
+        protected override BufferField LastHeaderField => _freeSpaceFirstLogicalPageId;
 
         #endregion
     }
@@ -11,6 +11,7 @@ using Zen.Trunk.Storage.BufferFields;
 using Zen.Trunk.Storage.Data;
 using Zen.Trunk.Storage.Locking;
 using Zen.Trunk.Storage.Logging;
+using Zen.Trunk.Storage.Services;
 using Zen.Trunk.Utils;
 using Zen.Trunk.VirtualMemory;
 
@@ -864,7 +865,15 @@ namespace Zen.Trunk.Storage
                 .As<IBufferDevice>()
                 .As<IMultipleBufferDevice>()
                 .SingleInstance();
-            builder.RegisterType<CachingPageBufferDevice>()
+            builder.RegisterType<PageVersionStore>()
+                .SingleInstance();
+            builder
+                .Register(
+                    context => new CachingPageBufferDevice(
+                        context.Resolve<IMultipleBufferDevice>(),
+                        context.Resolve<IStorageEngineEventService>(),
+                        context.Resolve<CachingPageBufferDeviceSettings>(),
+                        context.Resolve<PageVersionStore>()))
                 .As<ICachingPageBufferDevice>()
                 .SingleInstance();
 
@@ -1342,6 +1351,15 @@ namespace Zen.Trunk.Storage
                     await CachingBufferDevice
                         .FlushPagesAsync(new FlushCachingDeviceParameters(true))
                         .ConfigureAwait(false);
+
+                    // Persist logical page maps so the next mount need only
+                    //	export distribution pages changed after this point
+                    Logger.Debug("ExecuteCheckPoint - Saving logical page maps");
+                    await TaskExtra
+                        .WhenAllOrEmpty(_fileGroupById.Values
+                            .Select(fileGroup => fileGroup.SaveLogicalPageMapAsync())
+                            .ToArray())
+                        .ConfigureAwait(false);
                 }
                 catch (Exception error)
                 {
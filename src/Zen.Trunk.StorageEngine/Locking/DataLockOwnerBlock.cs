@@ -42,6 +42,16 @@ namespace Zen.Trunk.Storage.Locking
 		}
 		#endregion
 
+		#region Protected Properties
+		/// <summary>
+		/// Gets a description of the resource protected by the owner lock.
+		/// </summary>
+		/// <value>
+		/// The owner resource.
+		/// </value>
+		protected override string OwnerResource => $"Object {_objectId}";
+		#endregion
+
 		#region Protected Methods
 		/// <summary>
 		/// Gets the owner lock.
@@ -1,4 +1,5 @@
 using System;
+using System.Threading;
 using System.Threading.Tasks;
 using Zen.Trunk.VirtualMemory;
 
@@ -12,6 +13,7 @@ namespace Zen.Trunk.Storage.Locking
 	{
 		#region Private Fields
 		private readonly IGlobalLockManager _globalLockManager;
+		private int _lockEscalationCount;
 	    #endregion
 
         #region Public Constructors
@@ -47,8 +49,34 @@ namespace Zen.Trunk.Storage.Locking
         /// The database identifier.
         /// </value>
         public DatabaseId DatabaseId { get; }
+
+        /// <summary>
+        /// Gets or sets the number of item locks a transaction may hold on
+        /// a single object before they are escalated to an object lock.
+        /// </summary>
+        /// <value>
+        /// The lock escalation threshold.
+        /// </value>
+        public uint LockEscalationThreshold { get; set; } = 100;
+
+        /// <summary>
+        /// Gets the number of lock escalations performed against this
+        /// database.
+        /// </summary>
+        /// <value>
+        /// The lock escalation count.
+        /// </value>
+        public int LockEscalationCount => Volatile.Read(ref _lockEscalationCount);
 	    #endregion
 
+        #region Public Events
+        /// <summary>
+        /// Occurs when a transaction escalates its item locks to an owner
+        /// lock.
+        /// </summary>
+        public event EventHandler<LockEscalatedEventArgs> LockEscalated;
+        #endregion
+
         #region Public Methods
         #region Database Lock/Unlock
         /// <summary>
@@ -281,9 +309,12 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="indexId">The index identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        public void LockRootIndex(ObjectId objectId, IndexId indexId, bool writable, TimeSpan timeout)
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        public Task LockRootIndexAsync(ObjectId objectId, IndexId indexId, bool writable, TimeSpan timeout)
 		{
-			_globalLockManager.LockRootIndex(DatabaseId, objectId, indexId, writable, timeout);
+			return _globalLockManager.LockRootIndexAsync(DatabaseId, objectId, indexId, writable, timeout);
 		}
 
         /// <summary>
@@ -305,9 +336,12 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="logicalId">The logical identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        public void LockInternalIndex(ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout)
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        public Task LockInternalIndexAsync(ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout)
 		{
-			_globalLockManager.LockInternalIndex(DatabaseId, objectId, indexId, logicalId, writable, timeout);
+			return _globalLockManager.LockInternalIndexAsync(DatabaseId, objectId, indexId, logicalId, writable, timeout);
 		}
 
         /// <summary>
@@ -330,9 +364,12 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="logicalId">The logical identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        public void LockLeafIndex(ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout)
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        public Task LockLeafIndexAsync(ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout)
         {
-            _globalLockManager.LockLeafIndex(DatabaseId, objectId, indexId, logicalId, writable, timeout);
+            return _globalLockManager.LockLeafIndexAsync(DatabaseId, objectId, indexId, logicalId, writable, timeout);
         }
 
         /// <summary>
@@ -385,5 +422,18 @@ namespace Zen.Trunk.Storage.Locking
 		}
 		#endregion
 		#endregion
+
+        #region Internal Methods
+        /// <summary>
+        /// Records a lock escalation and raises the <see cref="LockEscalated"/>
+        /// event.
+        /// </summary>
+        /// <param name="e">The event data.</param>
+        internal void OnLockEscalated(LockEscalatedEventArgs e)
+        {
+            Interlocked.Increment(ref _lockEscalationCount);
+            LockEscalated?.Invoke(this, e);
+        }
+        #endregion
 	}
 }
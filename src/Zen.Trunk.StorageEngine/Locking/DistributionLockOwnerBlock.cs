@@ -41,6 +41,16 @@ namespace Zen.Trunk.Storage.Locking
 		}
 		#endregion
 
+		#region Protected Properties
+		/// <summary>
+		/// Gets a description of the resource protected by the owner lock.
+		/// </summary>
+		/// <value>
+		/// The owner resource.
+		/// </value>
+		protected override string OwnerResource => $"Distribution {_virtualPageId}";
+		#endregion
+
 		#region Protected Methods
 		/// <summary>
 		/// Gets the owner lock.
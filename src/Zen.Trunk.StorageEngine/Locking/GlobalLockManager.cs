@@ -1,6 +1,10 @@
 using System;
+using System.Collections.Generic;
 using System.Diagnostics;
+using System.Linq;
+using System.Threading;
 using System.Threading.Tasks;
+using Serilog;
 using Zen.Trunk.VirtualMemory;
 
 namespace Zen.Trunk.Storage.Locking
@@ -8,10 +12,20 @@ namespace Zen.Trunk.Storage.Locking
     /// <summary>
     /// <c>GlobalLockManager</c> tracks all lock objects across all databases
     /// </summary>
+    /// <remarks>
+    /// A background monitor periodically builds the wait-for graph of all
+    /// blocked lock requests, including resource locks, and fails one
+    /// waiter in each cycle with a
+    /// <see cref="LockAbortedException"/> so deadlocks are broken without
+    /// waiting for lock timeouts to expire.
+    /// </remarks>
     /// <seealso cref="Zen.Trunk.Storage.Locking.IGlobalLockManager" />
-    public class GlobalLockManager : IGlobalLockManager
+    public class GlobalLockManager : IGlobalLockManager, IDisposable
     {
         #region Private Fields
+        private static readonly ILogger Logger = Serilog.Log.ForContext<GlobalLockManager>();
+        private static readonly TimeSpan DefaultDeadlockDetectionInterval = TimeSpan.FromSeconds(1);
+
         private readonly LockHandler<DatabaseLock, DatabaseLockType> _databaseLocks =
             new LockHandler<DatabaseLock, DatabaseLockType>(0);
         private readonly LockHandler<FileGroupRootLock, FileGroupRootLockType> _fileGroupLocks =
@@ -23,9 +37,140 @@ namespace Zen.Trunk.Storage.Locking
         private readonly LockHandler<DataLock, DataLockType> _dataLocks =
             new LockHandler<DataLock, DataLockType>();
         private readonly RLockHandler _rLocks = new RLockHandler();
+        private readonly Timer _deadlockMonitor;
+        private int _isDetectingDeadlocks;
+        private int _deadlockCount;
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="GlobalLockManager"/> class.
+        /// </summary>
+        public GlobalLockManager()
+            : this(DefaultDeadlockDetectionInterval)
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="GlobalLockManager"/> class.
+        /// </summary>
+        /// <param name="deadlockDetectionInterval">
+        /// The interval between deadlock detection passes.
+        /// </param>
+        public GlobalLockManager(TimeSpan deadlockDetectionInterval)
+        {
+            _deadlockMonitor = new Timer(
+                OnDeadlockMonitor, null, deadlockDetectionInterval, deadlockDetectionInterval);
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the number of deadlocks broken since this instance was
+        /// created.
+        /// </summary>
+        /// <value>
+        /// The deadlock count.
+        /// </value>
+        public int DeadlockCount => Volatile.Read(ref _deadlockCount);
         #endregion
 
         #region Public Methods
+        /// <summary>
+        /// Stops the deadlock monitor.
+        /// </summary>
+        public void Dispose()
+        {
+            _deadlockMonitor.Dispose();
+        }
+
+        /// <summary>
+        /// Finds deadlocked lock requests and fails one request in each
+        /// deadlock with a <see cref="LockAbortedException"/>.
+        /// </summary>
+        /// <returns>
+        /// The number of deadlocks broken.
+        /// </returns>
+        public int DetectDeadlocks()
+        {
+            var graph = new WaitForGraph();
+            _databaseLocks.CollectWaits(graph);
+            _fileGroupLocks.CollectWaits(graph);
+            _objectLocks.CollectWaits(graph);
+            _schemaLocks.CollectWaits(graph);
+            _dataLocks.CollectWaits(graph);
+            _rLocks.CollectWaits(graph);
+            if (graph.WaiterCount < 2)
+            {
+                return 0;
+            }
+
+            var deadlocks = 0;
+            foreach (var victim in graph.FindVictims())
+            {
+                // The victim may have been granted or timed out since the
+                //  graph was built in which case the cycle no longer exists
+                if (victim.Value.AbortWaiter(
+                    victim.Key,
+                    new LockAbortedException("Lock request was chosen as deadlock victim.")))
+                {
+                    Logger.Warning(
+                        "Deadlock detected - lock request by {LockOwner} aborted",
+                        victim.Key);
+                    Interlocked.Increment(ref _deadlockCount);
+                    ++deadlocks;
+                }
+            }
+            return deadlocks;
+        }
+
+        /// <summary>
+        /// Gets the acquire, wait and timeout statistics for each class of
+        /// lock.
+        /// </summary>
+        /// <returns>
+        /// A list of <see cref="LockClassStatistics"/> objects.
+        /// </returns>
+        public IList<LockClassStatistics> GetLockStatistics()
+        {
+            return new List<LockClassStatistics>
+            {
+                _databaseLocks.Statistics.GetStatistics(),
+                _fileGroupLocks.Statistics.GetStatistics(),
+                _objectLocks.Statistics.GetStatistics(),
+                _schemaLocks.Statistics.GetStatistics(),
+                _dataLocks.Statistics.GetStatistics(),
+                _rLocks.Statistics.GetStatistics()
+            };
+        }
+
+        /// <summary>
+        /// Gets the most contended lock resources.
+        /// </summary>
+        /// <param name="count">The maximum number of resources to return.</param>
+        /// <returns>
+        /// A list of <see cref="LockResourceStatistics"/> objects ordered by
+        /// descending total wait time.
+        /// </returns>
+        /// <remarks>
+        /// Each lock class tracks a bounded set of contended resources so
+        /// rarely contended resources may not be reported.
+        /// </remarks>
+        public IList<LockResourceStatistics> GetHotResources(int count)
+        {
+            var resources = new List<LockResourceStatistics>();
+            _databaseLocks.Statistics.CollectResources(resources);
+            _fileGroupLocks.Statistics.CollectResources(resources);
+            _objectLocks.Statistics.CollectResources(resources);
+            _schemaLocks.Statistics.CollectResources(resources);
+            _dataLocks.Statistics.CollectResources(resources);
+            _rLocks.Statistics.CollectResources(resources);
+            return resources
+                .OrderByDescending(resource => resource.TotalWaitTime)
+                .Take(count)
+                .ToList();
+        }
+
         #region Database Lock/Unlock
         /// <summary>
         /// Locks the database.
@@ -475,10 +620,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="indexId">The index identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        public void LockRootIndex(DatabaseId dbId, ObjectId objectId, IndexId indexId, bool writable, TimeSpan timeout)
+        public Task LockRootIndexAsync(DatabaseId dbId, ObjectId objectId, IndexId indexId, bool writable, TimeSpan timeout)
         {
             var resourceKey = LockIdentity.GetIndexRootKey(dbId, objectId, indexId);
-            LockResource(resourceKey, writable, timeout);
+            return LockResourceAsync(resourceKey, writable, timeout);
         }
 
         /// <summary>
@@ -503,10 +648,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="logicalId">The logical identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        public void LockInternalIndex(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout)
+        public Task LockInternalIndexAsync(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout)
         {
             var resourceKey = LockIdentity.GetIndexInternalKey(dbId, objectId, indexId, logicalId);
-            LockResource(resourceKey, writable, timeout);
+            return LockResourceAsync(resourceKey, writable, timeout);
         }
 
         /// <summary>
@@ -532,10 +677,10 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="logicalId">The logical identifier.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
         /// <param name="timeout">The timeout.</param>
-        public void LockLeafIndex(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout)
+        public Task LockLeafIndexAsync(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId, bool writable, TimeSpan timeout)
         {
             var resourceKey = LockIdentity.GetIndexLeafKey(dbId, objectId, indexId, logicalId);
-            LockResource(resourceKey, writable, timeout);
+            return LockResourceAsync(resourceKey, writable, timeout);
         }
 
         /// <summary>
@@ -621,23 +766,45 @@ namespace Zen.Trunk.Storage.Locking
         #endregion
 
         #region Private Methods
+        private void OnDeadlockMonitor(object state)
+        {
+            // Skip this pass if the previous one is still running
+            if (Interlocked.CompareExchange(ref _isDetectingDeadlocks, 1, 0) != 0)
+            {
+                return;
+            }
+
+            try
+            {
+                DetectDeadlocks();
+            }
+            catch (Exception exception)
+            {
+                Logger.Error(exception, "Deadlock detection failed");
+            }
+            finally
+            {
+                Volatile.Write(ref _isDetectingDeadlocks, 0);
+            }
+        }
+
         /// <summary>
-        /// Locks the specified resource with a resource lock (spinlock).
+        /// Locks the specified resource with a resource lock.
         /// </summary>
         /// <param name="resource">The resource.</param>
         /// <param name="timeout">The timeout.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
-        private void LockResource(string resource, bool writable, TimeSpan timeout)
+        private Task LockResourceAsync(LockResourceId resource, bool writable, TimeSpan timeout)
         {
-            _rLocks.LockResource(resource, writable, timeout);
+            return _rLocks.LockResourceAsync(resource, writable, timeout);
         }
 
         /// <summary>
-        /// Unlocks the specified resource with a resource lock (spinlock).
+        /// Unlocks the specified resource with a resource lock.
         /// </summary>
         /// <param name="resource">The resource.</param>
         /// <param name="writable">if set to <c>true</c> [writable].</param>
-        private void UnlockResource(string resource, bool writable)
+        private void UnlockResource(LockResourceId resource, bool writable)
         {
             _rLocks.UnlockResource(resource, writable);
         }
@@ -1,11 +1,14 @@
 using System;
+using System.Threading.Tasks;
 
 namespace Zen.Trunk.Storage.Locking
 {
     internal interface IRLockHandler : ILockHandler
     {
-        void LockResource(string resource, bool writable, TimeSpan timeout);
+        Task LockResourceAsync(LockResourceId resource, bool writable, TimeSpan timeout);
 
-        void UnlockResource(string resource, bool writable);
+        void LockResource(LockResourceId resource, bool writable, TimeSpan timeout);
+
+        void UnlockResource(LockResourceId resource, bool writable);
     }
-}
\ No newline at end of file
+}
@@ -7,6 +7,12 @@ namespace Zen.Trunk.Storage.Locking
     {
         bool IsCompleted { get; }
 
+        long LogBytesWritten { get; }
+
+        long SnapshotSequence { get; }
+
+        long CommitSequence { get; }
+
         TransactionLockOwnerBlock GetTransactionLockOwnerBlock(IDatabaseLockManager lockManager);
 
         void BeginNestedTransaction();
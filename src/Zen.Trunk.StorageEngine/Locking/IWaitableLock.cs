@@ -0,0 +1,28 @@
+using System;
+
+namespace Zen.Trunk.Storage.Locking
+{
+    /// <summary>
+    /// <c>IWaitableLock</c> is implemented by locks whose waiters take part
+    /// in deadlock detection.
+    /// </summary>
+    internal interface IWaitableLock
+    {
+        /// <summary>
+        /// Adds the waits of every blocked request on this lock to the
+        /// specified wait-for graph.
+        /// </summary>
+        /// <param name="graph">The wait-for graph.</param>
+        void CollectWaits(WaitForGraph graph);
+
+        /// <summary>
+        /// Fails the blocked request made by the specified lock owner.
+        /// </summary>
+        /// <param name="waiter">The waiting lock owner.</param>
+        /// <param name="error">The exception used to fail the request.</param>
+        /// <returns>
+        /// <c>true</c> if a blocked request was failed; otherwise, <c>false</c>.
+        /// </returns>
+        bool AbortWaiter(LockOwnerIdentity waiter, Exception error);
+    }
+}
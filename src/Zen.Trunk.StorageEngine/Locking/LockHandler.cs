@@ -13,7 +13,11 @@ namespace Zen.Trunk.Storage.Locking
     /// <typeparam name="TLockTypeEnum"></typeparam>
     /// <remarks>
     /// <para>
-    /// The lock handler tracks active locks by their lock key string.
+    /// The lock handler tracks active locks by their lock resource id in a
+    /// lock table split into hash partitions, each guarded by its own latch,
+    /// so lookups of unrelated resources do not contend with each other.
+    /// </para>
+    /// <para>
     /// When locks are freed they are added to a free-lock pool to increase
     /// performance when new locks are requested. Currently the size of the
     /// free-lock pool is fixed.
@@ -30,9 +34,11 @@ namespace Zen.Trunk.Storage.Locking
         private static readonly ILogger Logger = Serilog.Log.ForContext<LockHandler<TLockClass, TLockTypeEnum>>();
 
         private int _maxFreeLocks;
-        private readonly SpinLockClass _syncLocks = new SpinLockClass();
-        private readonly Dictionary<string, TLockClass> _activeLocks = new Dictionary<string, TLockClass>();
+        private readonly Dictionary<LockResourceId, TLockClass>[] _partitions;
+        private readonly int _partitionMask;
         private readonly ObjectPool<TLockClass> _freeLocks;
+        private readonly LockStatisticsCollector _statistics =
+            new LockStatisticsCollector(typeof(TLockClass).Name);
         #endregion
 
         #region Public Constructors
@@ -48,12 +54,46 @@ namespace Zen.Trunk.Storage.Locking
         /// Initializes a new instance of the <see cref="LockHandler&lt;TLockClass, TLockTypeEnum&gt;"/> class.
         /// </summary>
         public LockHandler(int maxFreeLocks)
+            : this(maxFreeLocks, GetDefaultPartitionCount())
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LockHandler&lt;TLockClass, TLockTypeEnum&gt;"/> class.
+        /// </summary>
+        /// <param name="maxFreeLocks">The maximum number of free locks.</param>
+        /// <param name="partitionCount">
+        /// The number of lock table partitions; this must be a power of two.
+        /// </param>
+        public LockHandler(int maxFreeLocks, int partitionCount)
         {
+            if (partitionCount < 1 || (partitionCount & (partitionCount - 1)) != 0)
+            {
+                throw new ArgumentOutOfRangeException(
+                    nameof(partitionCount), "Partition count must be a power of two.");
+            }
+
             _maxFreeLocks = maxFreeLocks;
             _freeLocks = new ObjectPool<TLockClass>(CreateLock);
+            _partitions = new Dictionary<LockResourceId, TLockClass>[partitionCount];
+            for (var index = 0; index < partitionCount; ++index)
+            {
+                _partitions[index] = new Dictionary<LockResourceId, TLockClass>();
+            }
+            _partitionMask = partitionCount - 1;
         }
         #endregion
 
+        #region Public Properties
+        /// <summary>
+        /// Gets the statistics collected for locks of this class.
+        /// </summary>
+        /// <value>
+        /// The statistics collector.
+        /// </value>
+        public LockStatisticsCollector Statistics => _statistics;
+        #endregion
+
         #region Public Methods
         /// <summary>
         /// Gets a lock object represented by the key.
@@ -64,43 +104,87 @@ namespace Zen.Trunk.Storage.Locking
         /// The lock object is add ref'ed before it is returned to ensure
         /// stability of lock manager.
         /// </remarks>
-        public TLockClass GetOrCreateLock(string lockKey)
+        public TLockClass GetOrCreateLock(LockResourceId lockKey)
         {
             // Sanity check
-            if (string.IsNullOrEmpty(lockKey))
+            if (lockKey.IsEmpty)
             {
-                throw new ArgumentNullException(nameof(lockKey));
+                throw new ArgumentException("Lock key cannot be empty.", nameof(lockKey));
             }
 
             // Lookup/create page lock
-            TLockClass lockObject = null;
-            _syncLocks.Execute(
-                () =>
+            TLockClass lockObject;
+            var partition = GetPartition(lockKey);
+            lock (partition)
+            {
+                // Attempt to obtain the lock with the specified identifier
+                //  from our active lock cache
+                if (!partition.TryGetValue(lockKey, out lockObject))
                 {
-                    // Attempt to obtain the lock with the specified identifier
-                    //  from our active lock cache
-                    if (!_activeLocks.TryGetValue(lockKey, out lockObject))
-                    {
-                        // Get lock from free lock pool and update identifier
-                        lockObject = _freeLocks.GetObject();
-                        lockObject.Id = lockKey;
-
-                        // Add lock to the active lock cache
-                        _activeLocks.Add(lockKey, lockObject);
-                    }
-
-                    // Update lock reference count inside the sync zone
-                    lockObject.AddRefLock();
-                });
+                    // Get lock from free lock pool and update identifier
+                    lockObject = _freeLocks.GetObject();
+                    lockObject.Id = lockKey;
+
+                    // Add lock to the active lock cache
+                    partition.Add(lockKey, lockObject);
+                }
+
+                // Update lock reference count inside the sync zone
+                lockObject.AddRefLock();
+            }
             return lockObject;
         }
+
+        /// <summary>
+        /// Adds the waits of every active lock to the specified wait-for
+        /// graph.
+        /// </summary>
+        /// <param name="graph">The wait-for graph.</param>
+        /// <remarks>
+        /// Each partition latch is held only while its locks are copied so
+        /// lock lookups are not blocked while the graph is built.
+        /// </remarks>
+        public void CollectWaits(WaitForGraph graph)
+        {
+            var locks = new List<TLockClass>();
+            foreach (var partition in _partitions)
+            {
+                lock (partition)
+                {
+                    locks.AddRange(partition.Values);
+                }
+            }
+
+            foreach (var lockObject in locks)
+            {
+                lockObject.CollectWaits(graph);
+            }
+        }
         #endregion
 
         #region Private Methods
+        private static int GetDefaultPartitionCount()
+        {
+            // Aim for several partitions per processor to keep collisions
+            //  between concurrent lookups rare
+            var partitionCount = 16;
+            while (partitionCount < Environment.ProcessorCount * 4 && partitionCount < 1024)
+            {
+                partitionCount <<= 1;
+            }
+            return partitionCount;
+        }
+
+        private Dictionary<LockResourceId, TLockClass> GetPartition(LockResourceId lockKey)
+        {
+            return _partitions[lockKey.GetHashCode() & _partitionMask];
+        }
+
         private TLockClass CreateLock()
         {
             var lockObject = new TLockClass();
             lockObject.Initialise();
+            lockObject.Statistics = _statistics;
             lockObject.FinalRelease += Lock_FinalRelease;
             return lockObject;
         }
@@ -108,23 +192,34 @@ namespace Zen.Trunk.Storage.Locking
         private void Lock_FinalRelease(object sender, EventArgs e)
         {
             var lockObject = (TLockClass)sender;
-            _syncLocks.Execute(
-                () =>
+            var lockKey = lockObject.Id;
+            if (lockKey.IsEmpty)
+            {
+                return;
+            }
+
+            var partition = GetPartition(lockKey);
+            lock (partition)
+            {
+                // A concurrent lookup may have revived the lock after the
+                //  final reference was released; it will be released again
+                if (lockObject.ReferenceCount != 0 || lockObject.Id != lockKey)
                 {
-                    Logger.Debug(
-                        "Lock final release: {LockId}",
-                        lockObject.Id);
-
-                    if (!string.IsNullOrEmpty(lockObject.Id))
-                    {
-                        _activeLocks.Remove(lockObject.Id);
-                        lockObject.Id = string.Empty;
-                        if (_freeLocks.Count < _maxFreeLocks)
-                        {
-                            _freeLocks.PutObject(lockObject);
-                        }
-                    }
-                });
+                    return;
+                }
+
+                Logger.Debug(
+                    "Lock final release: {LockId}",
+                    lockKey);
+
+                partition.Remove(lockKey);
+                lockObject.Id = LockResourceId.Empty;
+            }
+
+            if (_freeLocks.Count < _maxFreeLocks)
+            {
+                _freeLocks.PutObject(lockObject);
+            }
         }
         #endregion
 
@@ -135,21 +230,28 @@ namespace Zen.Trunk.Storage.Locking
             set => Interlocked.Exchange(ref _maxFreeLocks, value);
         }
 
-        int ILockHandler.ActiveLockCount => _activeLocks.Count;
+        int ILockHandler.ActiveLockCount
+        {
+            get
+            {
+                var count = 0;
+                foreach (var partition in _partitions)
+                {
+                    count += partition.Count;
+                }
+                return count;
+            }
+        }
 
         int ILockHandler.FreeLockCount => _freeLocks.Count;
 
         void ILockHandler.PopulateFreeLockPool(int maxLocks)
         {
-            _syncLocks.Execute(
-                () =>
-                {
-                    while (_freeLocks.Count < _maxFreeLocks && maxLocks > 0)
-                    {
-                        _freeLocks.PutObject(CreateLock());
-                        --maxLocks;
-                    }
-                });
+            while (_freeLocks.Count < _maxFreeLocks && maxLocks > 0)
+            {
+                _freeLocks.PutObject(CreateLock());
+                --maxLocks;
+            }
         }
         #endregion
     }
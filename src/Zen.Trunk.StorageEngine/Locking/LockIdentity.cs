@@ -12,6 +12,10 @@ namespace Zen.Trunk.Storage.Locking
 	/// <c>LockIdentity</c> contains helper methods for obtaining keys needed to
 	/// access lock objects protecting various database resources.
 	/// </summary>
+	/// <remarks>
+	/// Keys are <see cref="LockResourceId"/> values so obtaining a key never
+	/// allocates.
+	/// </remarks>
 	internal static class LockIdentity
 	{
 		/// <summary>
@@ -19,9 +23,9 @@ namespace Zen.Trunk.Storage.Locking
 		/// </summary>
 		/// <param name="dbId">The db id.</param>
 		/// <returns></returns>
-		public static string GetDatabaseKey(DatabaseId dbId)
+		public static LockResourceId GetDatabaseKey(DatabaseId dbId)
 		{
-			return $"DBK:{dbId.Value:X4}";
+			return new LockResourceId(LockResourceType.Database, dbId, 0, 0);
 		}
 
 		/// <summary>
@@ -30,9 +34,9 @@ namespace Zen.Trunk.Storage.Locking
 		/// <param name="dbId">The db id.</param>
 		/// <param name="fileGroupId">The file group id.</param>
 		/// <returns></returns>
-		public static string GetFileGroupRootKey(DatabaseId dbId, FileGroupId fileGroupId)
+		public static LockResourceId GetFileGroupRootKey(DatabaseId dbId, FileGroupId fileGroupId)
 		{
-			return $"FRK:{dbId.Value:X4}${fileGroupId.Value:X2}";
+			return new LockResourceId(LockResourceType.FileGroupRoot, dbId, fileGroupId.Value, 0);
 		}
 
 		/// <summary>
@@ -41,9 +45,9 @@ namespace Zen.Trunk.Storage.Locking
 		/// <param name="dbId">The db id.</param>
 		/// <param name="virtualPageId">The virtual page id.</param>
 		/// <returns></returns>
-		public static string GetDistributionKey(DatabaseId dbId, VirtualPageId virtualPageId)
+		public static LockResourceId GetDistributionKey(DatabaseId dbId, VirtualPageId virtualPageId)
 		{
-			return $"DLK:{dbId.Value:X4}${virtualPageId.Value:X16}";
+			return new LockResourceId(LockResourceType.Distribution, dbId, 0, virtualPageId.Value);
 		}
 
 		/// <summary>
@@ -53,9 +57,9 @@ namespace Zen.Trunk.Storage.Locking
 		/// <param name="virtualPageId">The virtual page id.</param>
 		/// <param name="extentIndex">Index of the extent.</param>
 		/// <returns></returns>
-		public static string GetDistributionExtentLockKey(DatabaseId dbId, VirtualPageId virtualPageId, uint extentIndex)
+		public static LockResourceId GetDistributionExtentLockKey(DatabaseId dbId, VirtualPageId virtualPageId, uint extentIndex)
 		{
-			return $"ELK:{dbId.Value:X4}${virtualPageId.Value:X16}${extentIndex}";
+			return new LockResourceId(LockResourceType.DistributionExtent, dbId, extentIndex, virtualPageId.Value);
 		}
 
 	    /// <summary>
@@ -65,9 +69,9 @@ namespace Zen.Trunk.Storage.Locking
 	    /// <param name="objectId">The object id.</param>
 	    /// <param name="indexId">The index id.</param>
 	    /// <returns></returns>
-	    public static string GetIndexKey(DatabaseId dbId, ObjectId objectId, IndexId indexId)
+	    public static LockResourceId GetIndexKey(DatabaseId dbId, ObjectId objectId, IndexId indexId)
 		{
-			return $"IK:{dbId.Value:X4}${objectId.Value:X8}${indexId.Value:X8}";
+			return new LockResourceId(LockResourceType.Index, dbId, objectId.Value, indexId.Value);
 		}
 
 	    /// <summary>
@@ -77,9 +81,9 @@ namespace Zen.Trunk.Storage.Locking
 	    /// <param name="objectId">The object id.</param>
 	    /// <param name="indexId">The index id.</param>
 	    /// <returns></returns>
-	    public static string GetIndexRootKey(DatabaseId dbId, ObjectId objectId, IndexId indexId)
+	    public static LockResourceId GetIndexRootKey(DatabaseId dbId, ObjectId objectId, IndexId indexId)
 		{
-			return $"IRK:{dbId.Value:X4}${objectId.Value:X8}${indexId.Value:X8}";
+			return new LockResourceId(LockResourceType.IndexRoot, dbId, objectId.Value, indexId.Value);
 		}
 
 	    /// <summary>
@@ -90,9 +94,13 @@ namespace Zen.Trunk.Storage.Locking
 	    /// <param name="indexId">The index id.</param>
 	    /// <param name="logicalId">The logical id.</param>
 	    /// <returns></returns>
-	    public static string GetIndexInternalKey(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId)
+	    /// <remarks>
+	    /// Logical page ids are unique within a database so the index id is
+	    /// not needed to distinguish index pages and is not part of the key.
+	    /// </remarks>
+	    public static LockResourceId GetIndexInternalKey(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId)
 		{
-			return $"IIK:{dbId.Value:X4}${objectId.Value:X8}${indexId.Value:X8}${logicalId.Value:X16}";
+			return new LockResourceId(LockResourceType.IndexInternal, dbId, objectId.Value, logicalId.Value);
 		}
 
         /// <summary>
@@ -103,9 +111,13 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="indexId">The index id.</param>
         /// <param name="logicalId">The logical id.</param>
         /// <returns></returns>
-        public static string GetIndexLeafKey(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId)
+        /// <remarks>
+        /// Logical page ids are unique within a database so the index id is
+        /// not needed to distinguish index pages and is not part of the key.
+        /// </remarks>
+        public static LockResourceId GetIndexLeafKey(DatabaseId dbId, ObjectId objectId, IndexId indexId, LogicalPageId logicalId)
 		{
-			return $"ILK:{dbId.Value:X4}${objectId.Value:X8}${indexId.Value:X8}${logicalId.Value:X16}";
+			return new LockResourceId(LockResourceType.IndexLeaf, dbId, objectId.Value, logicalId.Value);
 		}
 
 		/// <summary>
@@ -114,9 +126,9 @@ namespace Zen.Trunk.Storage.Locking
 		/// <param name="dbId">The db id.</param>
 		/// <param name="objectId">The object id.</param>
 		/// <returns></returns>
-		public static string GetObjectLockKey(DatabaseId dbId, ObjectId objectId)
+		public static LockResourceId GetObjectLockKey(DatabaseId dbId, ObjectId objectId)
 		{
-			return $"OLK:{dbId.Value:X4}${objectId.Value:X8}";
+			return new LockResourceId(LockResourceType.Object, dbId, objectId.Value, 0);
 		}
 
 		/// <summary>
@@ -125,9 +137,9 @@ namespace Zen.Trunk.Storage.Locking
 		/// <param name="dbId">The db id.</param>
 		/// <param name="objectId">The object id.</param>
 		/// <returns></returns>
-		public static string GetSchemaLockKey(DatabaseId dbId, ObjectId objectId)
+		public static LockResourceId GetSchemaLockKey(DatabaseId dbId, ObjectId objectId)
 		{
-			return $"OSK:{dbId.Value:X4}${objectId.Value:X8}";
+			return new LockResourceId(LockResourceType.Schema, dbId, objectId.Value, 0);
 		}
 
 		/// <summary>
@@ -137,9 +149,9 @@ namespace Zen.Trunk.Storage.Locking
 		/// <param name="objectId">The object id.</param>
 		/// <param name="logicalId">The logical id.</param>
 		/// <returns></returns>
-		public static string GetDataLockKey(DatabaseId dbId, ObjectId objectId, LogicalPageId logicalId)
+		public static LockResourceId GetDataLockKey(DatabaseId dbId, ObjectId objectId, LogicalPageId logicalId)
 		{
-			return $"ODK:{dbId.Value:X4}${objectId.Value:X8}${logicalId.Value:X16}";
+			return new LockResourceId(LockResourceType.Data, dbId, objectId.Value, logicalId.Value);
 		}
 	}
 }
@@ -1,8 +1,8 @@
 using System;
 using System.Collections.Generic;
-using System.Linq;
 using System.Threading.Tasks;
 using Serilog;
+using Zen.Trunk.Extensions;
 
 namespace Zen.Trunk.Storage.Locking
 {
@@ -19,44 +19,242 @@ namespace Zen.Trunk.Storage.Locking
 	/// current transaction and thus escalate locking appropriately.
 	/// </para>
 	/// <para>
-	/// <b>Note:</b> Read, Update and Exclusive data locks are each counted
-	/// separately and any of these locks can cause an associated escalation
-	/// on the owner lock object.
+	/// Read, Update and Exclusive data locks are counted together; once the
+	/// count passes the threshold the block tries to take a Shared owner lock
+	/// (or an Exclusive owner lock when update or exclusive item locks are
+	/// held) without waiting and, if granted, releases the item locks in bulk.
+	/// When the owner lock is not immediately available the item locks are
+	/// kept and escalation is retried after further item locks are taken.
+	/// </para>
+	/// <para>
+	/// Item locks are tracked in a single open-addressing table keyed by item
+	/// id where each entry records the lock mode held. A request for a lock
+	/// that is already held (or covered by a stronger lock on the same item)
+	/// completes synchronously without allocating.
+	/// </para>
+	/// <para>
+	/// A block belongs to a single transaction and callers must not issue
+	/// lock or unlock requests against it concurrently; the transaction's
+	/// own operations are expected to be serialised and work that runs in
+	/// the background, such as index read-ahead, must do so outside the
+	/// transaction. The item table takes a short latch on every access so
+	/// a caller that breaks this rule cannot corrupt it, but the lock counts
+	/// kept by the block are only correct when the rule is honoured.
 	/// </para>
 	/// </remarks>
 	internal abstract class LockOwnerBlockBase<TItemLockIdType> : IDisposable
 	{
 		#region Private Types
-		private class ItemLockDictionary : Dictionary<TItemLockIdType, IDataLock>
+		private class ItemLockTable
 		{
-			public async Task<bool> TryReleaseLockAsync(TItemLockIdType key)
+			private struct Entry
 			{
-				var removed = false;
-				if (ContainsKey(key))
+				public TItemLockIdType Key;
+				public IDataLock Lock;
+				public DataLockType Mode;
+			}
+
+			private const int InitialCapacity = 16;
+			private static readonly IEqualityComparer<TItemLockIdType> KeyComparer =
+				EqualityComparer<TItemLockIdType>.Default;
+
+			private readonly object _sync = new object();
+			private readonly int[] _modeCounts = new int[(int)DataLockType.Exclusive + 1];
+			private Entry[] _entries = new Entry[InitialCapacity];
+			private int _count;
+
+			public int GetModeCount(DataLockType mode)
+			{
+				lock (_sync)
 				{
-					var lockObject = this[key];
-					if (lockObject != null)
+					return _modeCounts[(int)mode];
+				}
+			}
+
+			public DataLockType GetMode(TItemLockIdType key)
+			{
+				lock (_sync)
+				{
+					var index = FindIndex(key);
+					return index >= 0 ? _entries[index].Mode : DataLockType.None;
+				}
+			}
+
+			public bool TryGetLock(TItemLockIdType key, out DataLockType mode, out IDataLock lockObject)
+			{
+				lock (_sync)
+				{
+					var index = FindIndex(key);
+					if (index < 0)
 					{
-						await lockObject.UnlockAsync().ConfigureAwait(false);
-						lockObject.ReleaseRefLock();
+						mode = DataLockType.None;
+						lockObject = null;
+						return false;
 					}
-					removed = Remove(key);
+
+					mode = _entries[index].Mode;
+					lockObject = _entries[index].Lock;
+					return true;
 				}
-				return removed;
 			}
 
-			public async Task ReleaseLocksAsync(Action unlockAction)
+			public void Set(TItemLockIdType key, DataLockType mode, IDataLock lockObject)
 			{
-				foreach (var key in Keys.ToArray())
+				lock (_sync)
 				{
-					var lockObject = this[key];
-					if (lockObject != null)
+					var index = FindIndex(key);
+					if (index >= 0)
+					{
+						--_modeCounts[(int)_entries[index].Mode];
+					}
+					else
 					{
-						await lockObject.UnlockAsync().ConfigureAwait(false);
-						lockObject.ReleaseRefLock();
+						if ((_count + 1) * 4 > _entries.Length * 3)
+						{
+							Grow();
+						}
+
+						index = FindFreeIndex(key);
+						_entries[index].Key = key;
+						++_count;
+					}
+
+					_entries[index].Lock = lockObject;
+					_entries[index].Mode = mode;
+					++_modeCounts[(int)mode];
+				}
+			}
+
+			public bool Remove(TItemLockIdType key, out IDataLock lockObject)
+			{
+				lock (_sync)
+				{
+					var index = FindIndex(key);
+					if (index < 0)
+					{
+						lockObject = null;
+						return false;
+					}
+
+					lockObject = _entries[index].Lock;
+					--_modeCounts[(int)_entries[index].Mode];
+					--_count;
+
+					// Shift following entries of the probe run back so lookups
+					//	never need tombstones
+					var mask = _entries.Length - 1;
+					var hole = index;
+					var next = index;
+					while (true)
+					{
+						next = (next + 1) & mask;
+						if (_entries[next].Mode == DataLockType.None)
+						{
+							break;
+						}
+
+						var home = GetHomeIndex(_entries[next].Key);
+						var staysPut = hole <= next
+							? hole < home && home <= next
+							: hole < home || home <= next;
+						if (!staysPut)
+						{
+							_entries[hole] = _entries[next];
+							hole = next;
+						}
+					}
+					_entries[hole] = default(Entry);
+					return true;
+				}
+			}
+
+			public void EscalateLocks(DataLockType maxMode, IList<IDataLock> releasedLocks)
+			{
+				lock (_sync)
+				{
+					// NOTE: We must leave a hanging key so we correctly
+					//	decrement the owner lock count during unlock
+					for (var index = 0; index < _entries.Length; ++index)
+					{
+						if (_entries[index].Mode != DataLockType.None &&
+							_entries[index].Mode <= maxMode &&
+							_entries[index].Lock != null)
+						{
+							releasedLocks.Add(_entries[index].Lock);
+							_entries[index].Lock = null;
+						}
+					}
+				}
+			}
+
+			public int Clear(IList<IDataLock> heldLocks)
+			{
+				lock (_sync)
+				{
+					// Stronger locks are released first
+					for (var mode = DataLockType.Exclusive; mode > DataLockType.None; --mode)
+					{
+						for (var index = 0; index < _entries.Length; ++index)
+						{
+							if (_entries[index].Mode == mode && _entries[index].Lock != null)
+							{
+								heldLocks.Add(_entries[index].Lock);
+							}
+						}
+					}
+
+					var count = _count;
+					Array.Clear(_entries, 0, _entries.Length);
+					Array.Clear(_modeCounts, 0, _modeCounts.Length);
+					_count = 0;
+					return count;
+				}
+			}
+
+			private int GetHomeIndex(TItemLockIdType key)
+			{
+				var hash = KeyComparer.GetHashCode(key);
+				hash ^= hash >> 16;
+				return hash & (_entries.Length - 1);
+			}
+
+			private int FindIndex(TItemLockIdType key)
+			{
+				var mask = _entries.Length - 1;
+				for (var index = GetHomeIndex(key); ; index = (index + 1) & mask)
+				{
+					if (_entries[index].Mode == DataLockType.None)
+					{
+						return -1;
+					}
+					if (KeyComparer.Equals(_entries[index].Key, key))
+					{
+						return index;
+					}
+				}
+			}
+
+			private int FindFreeIndex(TItemLockIdType key)
+			{
+				var mask = _entries.Length - 1;
+				var index = GetHomeIndex(key);
+				while (_entries[index].Mode != DataLockType.None)
+				{
+					index = (index + 1) & mask;
+				}
+				return index;
+			}
+
+			private void Grow()
+			{
+				var oldEntries = _entries;
+				_entries = new Entry[oldEntries.Length * 2];
+				foreach (var entry in oldEntries)
+				{
+					if (entry.Mode != DataLockType.None)
+					{
+						_entries[FindFreeIndex(entry.Key)] = entry;
 					}
-				    Remove(key);
-    			    unlockAction?.Invoke();
 				}
 			}
 		}
@@ -64,14 +262,14 @@ namespace Zen.Trunk.Storage.Locking
 
 		#region Private Fields
         private static readonly ILogger Logger = Serilog.Log.ForContext<LockOwnerBlockBase<TItemLockIdType>>();
+		private static readonly Task<bool> ItemLockHeldTask = Task.FromResult(true);
 
 		private readonly uint _maxItemLocks;
-        private readonly TransactionalSpinLock _sync = new TransactionalSpinLock();
-		private readonly ItemLockDictionary _readLocks = new ItemLockDictionary();
-		private readonly ItemLockDictionary _updateLocks = new ItemLockDictionary();
-		private readonly ItemLockDictionary _writeLocks = new ItemLockDictionary();
+		private readonly ItemLockTable _itemLocks = new ItemLockTable();
         private Lazy<IObjectLock> _ownerLock;
 	    private uint _ownerLockCount;
+	    private int _heldItemLockCount;
+	    private int _nextEscalationCount;
 	    private bool _isDisposed;
 		#endregion
 
@@ -105,6 +303,14 @@ namespace Zen.Trunk.Storage.Locking
 		/// The lock manager.
 		/// </value>
 		protected IDatabaseLockManager LockManager { get; }
+
+		/// <summary>
+		/// Gets a description of the resource protected by the owner lock.
+		/// </summary>
+		/// <value>
+		/// The owner resource.
+		/// </value>
+		protected abstract string OwnerResource { get; }
 	    #endregion
 
 		#region Public Methods
@@ -135,34 +341,29 @@ namespace Zen.Trunk.Storage.Locking
 		/// <param name="key">The key.</param>
 		/// <param name="lockType">Type of the lock.</param>
 		/// <param name="timeout">The timeout.</param>
-		public async Task LockItemAsync(TItemLockIdType key, DataLockType lockType, TimeSpan timeout)
+		/// <remarks>
+		/// When the item is already locked in the requested mode or a
+		/// stronger one the returned task is already complete.
+		/// </remarks>
+		public Task LockItemAsync(TItemLockIdType key, DataLockType lockType, TimeSpan timeout)
 		{
 			ThrowIfDisposed();
 
-			// Skip none lock requests
-			if (lockType == DataLockType.None)
+			// Skip none lock requests and locks we already hold
+			if (lockType == DataLockType.None || _itemLocks.GetMode(key) >= lockType)
 			{
-				return;
+				return CompletedTask.Default;
 			}
 
-			//await _sync
-   //             .ExecuteAsync(
-			//	    async () =>
-			//	    {
-					    if (lockType == DataLockType.Shared && !_readLocks.ContainsKey(key))
-					    {
-						    await LockItemSharedAsync(key, timeout).ConfigureAwait(false);
-					    }
-					    else if (lockType == DataLockType.Update && !_updateLocks.ContainsKey(key))
-					    {
-						    await LockItemUpdateAsync(key, timeout).ConfigureAwait(false);
-					    }
-					    else if (lockType == DataLockType.Exclusive && !_writeLocks.ContainsKey(key))
-					    {
-						    await LockItemExclusiveAsync(key, timeout).ConfigureAwait(false);
-					    }
-				    //})
-        //        .ConfigureAwait(false);
+			switch (lockType)
+			{
+				case DataLockType.Shared:
+					return LockItemSharedAsync(key, timeout);
+				case DataLockType.Update:
+					return LockItemUpdateAsync(key, timeout);
+				default:
+					return LockItemExclusiveAsync(key, timeout);
+			}
 		}
 
 		/// <summary>
@@ -175,7 +376,7 @@ namespace Zen.Trunk.Storage.Locking
 		{
 			if (lockType == ObjectLockType.None)
 			{
-				return Task.FromResult(true);
+				return ItemLockHeldTask;
 			}
 
 			return OwnerLock.HasLockAsync(lockType);
@@ -188,55 +389,18 @@ namespace Zen.Trunk.Storage.Locking
 		/// <param name="key">The key.</param>
 		/// <param name="lockType">Type of the lock.</param>
 		/// <returns></returns>
-		public async Task<bool> HasItemLockAsync(TItemLockIdType key, DataLockType lockType)
+		/// <remarks>
+		/// Item locks are checked first so the owner lock is only consulted
+		/// when the item itself is not locked strongly enough.
+		/// </remarks>
+		public Task<bool> HasItemLockAsync(TItemLockIdType key, DataLockType lockType)
 		{
-			switch (lockType)
+			if (lockType == DataLockType.None || _itemLocks.GetMode(key) >= lockType)
 			{
-				case DataLockType.None:
-					return true;
-
-				case DataLockType.Shared:
-					if (await HasOwnerLockAsync(ObjectLockType.Shared).ConfigureAwait(false) ||
-						await HasOwnerLockAsync(ObjectLockType.Exclusive).ConfigureAwait(false))
-					{
-						return true;
-					}
-
-					if (_readLocks.ContainsKey(key) ||
-						_updateLocks.ContainsKey(key) ||
-						_writeLocks.ContainsKey(key))
-					{
-						return true;
-					}
-					break;
-
-				case DataLockType.Update:
-					if (await HasOwnerLockAsync(ObjectLockType.Exclusive).ConfigureAwait(false))
-					{
-						return true;
-					}
-
-					if (_writeLocks.ContainsKey(key) ||
-						_updateLocks.ContainsKey(key))
-					{
-						return true;
-					}
-					break;
-
-				case DataLockType.Exclusive:
-					if (await HasOwnerLockAsync(ObjectLockType.Exclusive).ConfigureAwait(false))
-					{
-						return true;
-					}
-
-					if (_writeLocks.ContainsKey(key))
-					{
-						return true;
-					}
-					break;
+				return ItemLockHeldTask;
 			}
 
-			return false;
+			return HasCoveringOwnerLockAsync(lockType);
 		}
 
 		/// <summary>
@@ -247,17 +411,19 @@ namespace Zen.Trunk.Storage.Locking
 		{
 			ThrowIfDisposed();
 
-			// Locate id in tables
-			//await _sync.ExecuteAsync(
-			//	async () =>
-			//	{
-					if (await _readLocks.TryReleaseLockAsync(key).ConfigureAwait(false) ||
-						await _updateLocks.TryReleaseLockAsync(key).ConfigureAwait(false) ||
-						await _writeLocks.TryReleaseLockAsync(key).ConfigureAwait(false))
-					{
-						--_ownerLockCount;
-					}
-				//}).ConfigureAwait(false);
+			// Locate id in table
+			if (!_itemLocks.Remove(key, out var lockObject))
+			{
+				return;
+			}
+
+			--_ownerLockCount;
+			if (lockObject != null)
+			{
+				--_heldItemLockCount;
+				await lockObject.UnlockAsync().ConfigureAwait(false);
+				lockObject.ReleaseRefLock();
+			}
 		}
 
 		/// <summary>
@@ -287,9 +453,15 @@ namespace Zen.Trunk.Storage.Locking
 		{
 			ThrowIfDisposed();
 
-			await _writeLocks.ReleaseLocksAsync(() => --_ownerLockCount).ConfigureAwait(false);
-			await _updateLocks.ReleaseLocksAsync(() => --_ownerLockCount).ConfigureAwait(false);
-            await _readLocks.ReleaseLocksAsync(() => --_ownerLockCount).ConfigureAwait(false);
+			var heldLocks = new List<IDataLock>(_heldItemLockCount);
+			_ownerLockCount -= (uint)_itemLocks.Clear(heldLocks);
+			foreach (var lockObject in heldLocks)
+			{
+				await lockObject.UnlockAsync().ConfigureAwait(false);
+				lockObject.ReleaseRefLock();
+			}
+			_heldItemLockCount = 0;
+			_nextEscalationCount = 0;
             await UnlockOwnerAsync().ConfigureAwait(false);
         }
 		#endregion
@@ -340,6 +512,17 @@ namespace Zen.Trunk.Storage.Locking
 		#endregion
 
 		#region Private Methods
+		private async Task<bool> HasCoveringOwnerLockAsync(DataLockType lockType)
+		{
+			if (await HasOwnerLockAsync(ObjectLockType.Exclusive).ConfigureAwait(false))
+			{
+				return true;
+			}
+
+			return lockType == DataLockType.Shared &&
+				await HasOwnerLockAsync(ObjectLockType.Shared).ConfigureAwait(false);
+		}
+
 		private async Task LockItemSharedAsync(TItemLockIdType key, TimeSpan timeout)
 		{
 			if (await HasOwnerLockAsync(ObjectLockType.Shared).ConfigureAwait(false) ||
@@ -351,13 +534,6 @@ namespace Zen.Trunk.Storage.Locking
 				return;
 			}
 
-			// Check if we already have a better lock on this resource
-			if (_updateLocks.ContainsKey(key) ||
-				_writeLocks.ContainsKey(key))
-			{
-				return;
-			}
-
 			// We require a minimum of an intent shared
 			//	lock on the owner at this point
 			if (!await HasOwnerLockAsync(ObjectLockType.SharedIntentExclusive).ConfigureAwait(false) &&
@@ -368,49 +544,19 @@ namespace Zen.Trunk.Storage.Locking
 			}
 
 			// Obtain an object data lock for the given key
-			if (!_updateLocks.ContainsKey(key) &&
-				!_writeLocks.ContainsKey(key))
+			if (_itemLocks.GetMode(key) == DataLockType.None)
 			{
 				// Get data lock object then lock accordingly
 				var lockObj = GetItemLock(key); // lock is already addref'ed
 				await lockObj.LockAsync(DataLockType.Shared, timeout).ConfigureAwait(false);
 				_ownerLockCount++;
+				_heldItemLockCount++;
 
-				// Add lock to the read-lock list
-				_readLocks.Add(key, lockObj);
+				// Add lock to the table in shared mode
+				_itemLocks.Set(key, DataLockType.Shared, lockObj);
 
 				// Check whether we can escalate this lock
-				if (_readLocks.Count > _maxItemLocks)
-				{
-				    Logger.Debug("Attempting lock owner block SHARED lock escalation");
-				    
-					var hasEscalatedLock = false;
-					try
-					{
-						// Acquire full shared lock on owner
-						await LockOwnerAsync(ObjectLockType.Shared, timeout).ConfigureAwait(false);
-						hasEscalatedLock = true;
-					}
-					catch
-					{
-                        // Ignore error - we will attempt escalation on next lock
-                        Logger.Debug("Lock owner block SHARED lock escalation failed");
-                    }
-
-                    if (hasEscalatedLock)
-					{
-						// We get this far then we can release the existing read locks
-						foreach (var lockPair in _readLocks.ToArray())
-						{
-							// Unlock and release reference
-							// NOTE: We must leave a hanging key so we correctly
-							//	decrement the owner lock count during unlock
-							await lockPair.Value.UnlockAsync().ConfigureAwait(false);
-							lockPair.Value.ReleaseRefLock();
-							_readLocks[lockPair.Key] = null;
-						}
-					}
-				}
+				await TryEscalateLocksAsync().ConfigureAwait(false);
 			}
 		}
 
@@ -422,42 +568,25 @@ namespace Zen.Trunk.Storage.Locking
 				return;
 			}
 
-			// Check if we already have a better lock on this resource
-			if (_writeLocks.ContainsKey(key))
-			{
-				return;
-			}
-
 			// We require a minimum of a shared intent exclusive lock on the
 			//	owner at this point
-			if (!await HasOwnerLockAsync(ObjectLockType.SharedIntentExclusive).ConfigureAwait(false) &&
-				!await HasOwnerLockAsync(ObjectLockType.IntentExclusive).ConfigureAwait(false))
-			{
-				if (await HasOwnerLockAsync(ObjectLockType.Shared).ConfigureAwait(false))
-				{
-					await LockOwnerAsync(ObjectLockType.SharedIntentExclusive, timeout).ConfigureAwait(false);
-				}
-				else
-				{
-					await LockOwnerAsync(ObjectLockType.IntentExclusive, timeout).ConfigureAwait(false);
-				}
-			}
-
-			IDataLock lockObj;
+			await LockOwnerIntentExclusiveAsync(timeout).ConfigureAwait(false);
 
 			// Check whether we have an existing read lock
-			if (_readLocks.ContainsKey(key))
+			if (_itemLocks.TryGetLock(key, out _, out var lockObj))
 			{
                 // Reuse the lock object if we still have it otherwise renew it
-                // NOTE: If the readLock value is null then we must have escalated
+                // NOTE: If the lock is null then we must have escalated
                 //  read locks earlier so get distinct lock object from manager
-				lockObj = _readLocks[key] ?? GetItemLock(key);
+				if (lockObj == null)
+				{
+					lockObj = GetItemLock(key);
+					_heldItemLockCount++;
+				}
 
-				// Attempt to upgrade the lock for this resource and remove
-				//	read lock reference
+				// Attempt to upgrade the lock for this resource
 				// NOTE: Do not update the reference count
 				await lockObj.LockAsync(DataLockType.Update, timeout).ConfigureAwait(false);
-				_readLocks.Remove(key);
 			}
 			else
 			{
@@ -465,14 +594,15 @@ namespace Zen.Trunk.Storage.Locking
 				//	acquire the update lock requested
 				lockObj = GetItemLock(key);
 
-				// TODO: Do we need to get a shared lock first?
-				//lockObj.Lock(DataLockType.Shared, timeout);
-
                 // Acquire update lock
 				await lockObj.LockAsync(DataLockType.Update, timeout).ConfigureAwait(false);
 				_ownerLockCount++;
+				_heldItemLockCount++;
 			}
-			_updateLocks.Add(key, lockObj);
+			_itemLocks.Set(key, DataLockType.Update, lockObj);
+
+			// Check whether we can escalate this lock
+			await TryEscalateLocksAsync().ConfigureAwait(false);
 		}
 
 		private async Task LockItemExclusiveAsync(TItemLockIdType key, TimeSpan timeout)
@@ -482,13 +612,39 @@ namespace Zen.Trunk.Storage.Locking
 				_ownerLockCount++;
 				return;
 			}
-			if (_writeLocks.ContainsKey(key))
-			{
-				return;
-			}
 
 			// We require a minimum of a shared intent exclusive lock on the
 			//	owner at this point
+			await LockOwnerIntentExclusiveAsync(timeout).ConfigureAwait(false);
+
+			// Technically we can only obtain an exclusive lock via an update lock...
+			// However we support attempts to gain an exclusive lock directly
+			if (_itemLocks.TryGetLock(key, out _, out var lockObj))
+			{
+				// We must have escalated read or update locks earlier
+				//	so get distinct lock object from manager
+				if (lockObj == null)
+				{
+					lockObj = GetItemLock(key);
+					_heldItemLockCount++;
+				}
+				await lockObj.LockAsync(DataLockType.Exclusive, timeout).ConfigureAwait(false);
+			}
+			else
+			{
+				lockObj = GetItemLock(key);
+				await lockObj.LockAsync(DataLockType.Exclusive, timeout).ConfigureAwait(false);
+				_ownerLockCount++;
+				_heldItemLockCount++;
+			}
+			_itemLocks.Set(key, DataLockType.Exclusive, lockObj);
+
+			// Check whether we can escalate this lock
+			await TryEscalateLocksAsync().ConfigureAwait(false);
+		}
+
+		private async Task LockOwnerIntentExclusiveAsync(TimeSpan timeout)
+		{
 			if (!await HasOwnerLockAsync(ObjectLockType.SharedIntentExclusive).ConfigureAwait(false) &&
 				!await HasOwnerLockAsync(ObjectLockType.IntentExclusive).ConfigureAwait(false))
 			{
@@ -501,75 +657,67 @@ namespace Zen.Trunk.Storage.Locking
 					await LockOwnerAsync(ObjectLockType.IntentExclusive, timeout).ConfigureAwait(false);
 				}
 			}
+		}
 
-			// Technically we can only obtain an exclusive lock via an update lock...
-			// However we support attempts to gain an exclusive lock directly
-			IDataLock lockObj;
-			if (_updateLocks.ContainsKey(key))
+		private async Task TryEscalateLocksAsync()
+		{
+			if (_heldItemLockCount <= _maxItemLocks ||
+				_heldItemLockCount < _nextEscalationCount)
 			{
-				// TODO: If ObjectLock ever supports escalation of update locks
-				//	then this code will need to be revised...
-				lockObj = _updateLocks[key];
-				await lockObj.LockAsync(DataLockType.Exclusive, timeout).ConfigureAwait(false);
-				_updateLocks.Remove(key);
+				return;
 			}
-			else if (_readLocks.ContainsKey(key))
+
+			// Update and exclusive item locks can only be covered by an
+			//	exclusive owner lock
+			var lockType = ObjectLockType.Shared;
+			if (_itemLocks.GetModeCount(DataLockType.Update) > 0 ||
+				_itemLocks.GetModeCount(DataLockType.Exclusive) > 0 ||
+				await HasOwnerLockAsync(ObjectLockType.IntentExclusive).ConfigureAwait(false) ||
+				await HasOwnerLockAsync(ObjectLockType.SharedIntentExclusive).ConfigureAwait(false))
 			{
-				// We must have escalated read locks earlier
-				//	so get distinct lock object from manager
-				lockObj = _readLocks[key] ?? GetItemLock(key);
-				await lockObj.LockAsync(DataLockType.Exclusive, timeout).ConfigureAwait(false);
-				_readLocks.Remove(key);
+				lockType = ObjectLockType.Exclusive;
 			}
-			else
+
+			Logger.Debug(
+				"Attempting lock owner block {LockType} lock escalation",
+				lockType);
+			try
 			{
-				lockObj = GetItemLock(key);
-				await lockObj.LockAsync(DataLockType.Exclusive, timeout).ConfigureAwait(false);
-				_ownerLockCount++;
+				// Never wait for the owner lock; if another transaction holds
+				//	an incompatible lock we simply keep our item locks
+				await LockOwnerAsync(lockType, TimeSpan.Zero).ConfigureAwait(false);
 			}
-			_writeLocks.Add(key, lockObj);
-
-			// Check whether we can escalate this lock
-			if (_writeLocks.Count > _maxItemLocks)
+			catch (Exception)
 			{
-                Logger.Debug("Attempting lock owner block EXCLUSIVE lock escalation");
-                
-				var hasEscalated = false;
-				try
-				{
-					// Acquire full exclusive lock on owner
-					await LockOwnerAsync(ObjectLockType.Exclusive, timeout).ConfigureAwait(false);
-					hasEscalated = true;
-				}
-				catch
-				{
-                    // Ignore error - we will attempt escalation on next lock
-                    Logger.Debug("Lock owner block EXCLUSIVE lock escalation failed");
-                }
+				// Retry once a further batch of item locks has been taken
+				_nextEscalationCount = _heldItemLockCount + (int)Math.Max(1u, _maxItemLocks / 4);
+				Logger.Debug(
+					"Lock owner block {LockType} lock escalation failed",
+					lockType);
+				return;
+			}
 
-                if (hasEscalated)
-				{
-					// We get this far then we can release ALL existing locks
-					foreach (var lockPair in _readLocks.ToArray())
-					{
-						await lockPair.Value.UnlockAsync().ConfigureAwait(false);
-						lockPair.Value.ReleaseRefLock();
-						_readLocks[lockPair.Key] = null;
-					}
-					foreach (var lockPair in _updateLocks.ToArray())
-					{
-						await lockPair.Value.UnlockAsync().ConfigureAwait(false);
-						lockPair.Value.ReleaseRefLock();
-						_updateLocks[lockPair.Key] = null;
-					}
-					foreach (var lockPair in _writeLocks.ToArray())
-					{
-						await lockPair.Value.UnlockAsync().ConfigureAwait(false);
-						lockPair.Value.ReleaseRefLock();
-						_writeLocks[lockPair.Key] = null;
-					}
-				}
+			// We get this far then we can release the covered item locks
+			var releasedLocks = new List<IDataLock>(_heldItemLockCount);
+			_itemLocks.EscalateLocks(
+				lockType == ObjectLockType.Exclusive ? DataLockType.Exclusive : DataLockType.Shared,
+				releasedLocks);
+			foreach (var lockObject in releasedLocks)
+			{
+				await lockObject.UnlockAsync().ConfigureAwait(false);
+				lockObject.ReleaseRefLock();
 			}
+			var releasedLockCount = releasedLocks.Count;
+			_heldItemLockCount -= releasedLockCount;
+			_nextEscalationCount = 0;
+
+			Logger.Information(
+				"Lock escalation on {Resource} to {LockType} released {ReleasedLockCount} item locks",
+				OwnerResource,
+				lockType,
+				releasedLockCount);
+			(LockManager as DatabaseLockManager)?.OnLockEscalated(
+				new LockEscalatedEventArgs(OwnerResource, lockType, releasedLockCount));
 		}
 		#endregion
 	}
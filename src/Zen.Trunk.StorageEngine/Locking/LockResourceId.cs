@@ -0,0 +1,175 @@
+using System;
+
+namespace Zen.Trunk.Storage.Locking
+{
+    /// <summary>
+    /// <c>LockResourceId</c> is a compact 128-bit identifier for a database
+    /// resource protected by a lock.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The upper 64 bits hold the resource type (8 bits), the database id
+    /// (16 bits) and a 32-bit qualifier such as the object id; the lower
+    /// 64 bits hold the page id or other resource-specific value.
+    /// </para>
+    /// <para>
+    /// Lock identifiers are created on every lock acquisition so this
+    /// type is a value type with an allocation-free hash and equality.
+    /// </para>
+    /// </remarks>
+    [Serializable]
+    public struct LockResourceId : IEquatable<LockResourceId>
+    {
+        #region Public Fields
+        /// <summary>
+        /// The empty lock resource identifier.
+        /// </summary>
+        public static readonly LockResourceId Empty = new LockResourceId();
+        #endregion
+
+        #region Private Fields
+        private readonly ulong _high;
+        private readonly ulong _low;
+        #endregion
+
+        #region Internal Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LockResourceId"/> struct.
+        /// </summary>
+        /// <param name="resourceType">Type of the resource.</param>
+        /// <param name="dbId">The database identifier.</param>
+        /// <param name="qualifier">The 32-bit resource qualifier.</param>
+        /// <param name="value">The 64-bit resource value.</param>
+        internal LockResourceId(LockResourceType resourceType, DatabaseId dbId, uint qualifier, ulong value)
+        {
+            _high = ((ulong)resourceType << 56) | ((ulong)dbId.Value << 40) | qualifier;
+            _low = value;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets a value indicating whether this instance is empty.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if this instance is empty; otherwise, <c>false</c>.
+        /// </value>
+        public bool IsEmpty => _high == 0 && _low == 0;
+        #endregion
+
+        #region Internal Properties
+        internal LockResourceType ResourceType => (LockResourceType)(_high >> 56);
+
+        internal ushort DbId => (ushort)(_high >> 40);
+
+        internal uint Qualifier => (uint)_high;
+
+        internal ulong Value => _low;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Overridden. Gets a string representation of the type.
+        /// </summary>
+        /// <returns></returns>
+        public override string ToString()
+        {
+            switch (ResourceType)
+            {
+                case LockResourceType.Database:
+                    return $"DBK:{DbId:X4}";
+                case LockResourceType.FileGroupRoot:
+                    return $"FRK:{DbId:X4}${Qualifier:X2}";
+                case LockResourceType.Distribution:
+                    return $"DLK:{DbId:X4}${Value:X16}";
+                case LockResourceType.DistributionExtent:
+                    return $"ELK:{DbId:X4}${Value:X16}${Qualifier}";
+                case LockResourceType.Index:
+                    return $"IK:{DbId:X4}${Qualifier:X8}${Value:X8}";
+                case LockResourceType.IndexRoot:
+                    return $"IRK:{DbId:X4}${Qualifier:X8}${Value:X8}";
+                case LockResourceType.IndexInternal:
+                    return $"IIK:{DbId:X4}${Qualifier:X8}${Value:X16}";
+                case LockResourceType.IndexLeaf:
+                    return $"ILK:{DbId:X4}${Qualifier:X8}${Value:X16}";
+                case LockResourceType.Object:
+                    return $"OLK:{DbId:X4}${Qualifier:X8}";
+                case LockResourceType.Schema:
+                    return $"OSK:{DbId:X4}${Qualifier:X8}";
+                case LockResourceType.Data:
+                    return $"ODK:{DbId:X4}${Qualifier:X8}${Value:X16}";
+                default:
+                    return string.Empty;
+            }
+        }
+
+        /// <summary>
+        /// Determines whether the specified lock resource id is equal to
+        /// this instance.
+        /// </summary>
+        /// <param name="other">The other lock resource id.</param>
+        /// <returns>
+        /// <c>true</c> if the identifiers are equal; otherwise, <c>false</c>.
+        /// </returns>
+        public bool Equals(LockResourceId other)
+        {
+            return _high == other._high && _low == other._low;
+        }
+
+        /// <summary>
+        /// Overridden. Tests obj for equality with this instance.
+        /// </summary>
+        /// <param name="obj"></param>
+        /// <returns></returns>
+        public override bool Equals(object obj)
+        {
+            return obj is LockResourceId other && Equals(other);
+        }
+
+        /// <summary>
+        /// Overridden. Returns the hash code for this instance.
+        /// </summary>
+        /// <returns></returns>
+        /// <remarks>
+        /// The hash is well mixed in every bit since the lock table uses
+        /// the low bits to select a partition.
+        /// </remarks>
+        public override int GetHashCode()
+        {
+            var hash = _high ^ (_low * 0x9E3779B97F4A7C15UL);
+            hash ^= hash >> 30;
+            hash *= 0xBF58476D1CE4E5B9UL;
+            hash ^= hash >> 27;
+            hash *= 0x94D049BB133111EBUL;
+            hash ^= hash >> 31;
+            return (int)hash;
+        }
+
+        /// <summary>
+        /// Implements the operator ==.
+        /// </summary>
+        /// <param name="left">The left.</param>
+        /// <param name="right">The right.</param>
+        /// <returns>
+        /// The result of the operator.
+        /// </returns>
+        public static bool operator ==(LockResourceId left, LockResourceId right)
+        {
+            return left.Equals(right);
+        }
+
+        /// <summary>
+        /// Implements the operator !=.
+        /// </summary>
+        /// <param name="left">The left.</param>
+        /// <param name="right">The right.</param>
+        /// <returns>
+        /// The result of the operator.
+        /// </returns>
+        public static bool operator !=(LockResourceId left, LockResourceId right)
+        {
+            return !left.Equals(right);
+        }
+        #endregion
+    }
+}
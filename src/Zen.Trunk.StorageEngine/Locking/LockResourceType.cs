@@ -0,0 +1,73 @@
+namespace Zen.Trunk.Storage.Locking
+{
+    /// <summary>
+    /// <c>LockResourceType</c> identifies the kind of database resource
+    /// protected by a lock.
+    /// </summary>
+    /// <remarks>
+    /// The value is stored in the top byte of a <see cref="LockResourceId"/>
+    /// so resources of different kinds never share a lock.
+    /// </remarks>
+    internal enum LockResourceType : byte
+    {
+        /// <summary>
+        /// No resource.
+        /// </summary>
+        None = 0,
+
+        /// <summary>
+        /// A database.
+        /// </summary>
+        Database = 1,
+
+        /// <summary>
+        /// The root page of a file-group.
+        /// </summary>
+        FileGroupRoot = 2,
+
+        /// <summary>
+        /// A distribution page.
+        /// </summary>
+        Distribution = 3,
+
+        /// <summary>
+        /// An extent tracked by a distribution page.
+        /// </summary>
+        DistributionExtent = 4,
+
+        /// <summary>
+        /// An index.
+        /// </summary>
+        Index = 5,
+
+        /// <summary>
+        /// The root definition of an index.
+        /// </summary>
+        IndexRoot = 6,
+
+        /// <summary>
+        /// A non-root and non-leaf index page.
+        /// </summary>
+        IndexInternal = 7,
+
+        /// <summary>
+        /// A leaf index page.
+        /// </summary>
+        IndexLeaf = 8,
+
+        /// <summary>
+        /// An object.
+        /// </summary>
+        Object = 9,
+
+        /// <summary>
+        /// The schema of a table or sample.
+        /// </summary>
+        Schema = 10,
+
+        /// <summary>
+        /// A table or sample data page.
+        /// </summary>
+        Data = 11
+    }
+}
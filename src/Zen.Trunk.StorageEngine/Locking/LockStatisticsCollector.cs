@@ -0,0 +1,234 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+
+namespace Zen.Trunk.Storage.Locking
+{
+    /// <summary>
+    /// <c>LockStatisticsCollector</c> accumulates acquire, wait and timeout
+    /// counts for a single class of lock.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Uncontended acquires only increment a counter; the wait time and the
+    /// identity of the contended resource are recorded when a request has
+    /// to wait.
+    /// </para>
+    /// <para>
+    /// Counters are striped by thread across separate cache lines and summed
+    /// when read so that threads acquiring locks concurrently do not contend
+    /// on a single shared counter.
+    /// </para>
+    /// <para>
+    /// Contended resources are tracked in a small table; when the table is
+    /// full the least contended entry is replaced so the hottest resources
+    /// are retained without tracking every lock.
+    /// </para>
+    /// </remarks>
+    internal class LockStatisticsCollector
+    {
+        #region Private Types
+        private class ResourceCounter
+        {
+            public long WaitCount;
+            public long WaitTicks;
+        }
+
+        private class StripedCounter
+        {
+            // Each stripe occupies its own 64 byte cache line
+            private const int StripeSpacing = 8;
+
+            private static readonly int StripeMask = GetStripeCount() - 1;
+
+            private readonly long[] _stripes = new long[(StripeMask + 1) * StripeSpacing];
+
+            public void Add(long value)
+            {
+                var stripe = (Thread.CurrentThread.ManagedThreadId & StripeMask) * StripeSpacing;
+                Interlocked.Add(ref _stripes[stripe], value);
+            }
+
+            public long Read()
+            {
+                var total = 0L;
+                for (var stripe = 0; stripe < _stripes.Length; stripe += StripeSpacing)
+                {
+                    total += Interlocked.Read(ref _stripes[stripe]);
+                }
+                return total;
+            }
+
+            private static int GetStripeCount()
+            {
+                var count = 1;
+                while (count < Environment.ProcessorCount)
+                {
+                    count <<= 1;
+                }
+                return count;
+            }
+        }
+        #endregion
+
+        #region Private Fields
+        private const int HistogramBucketCount = 17;
+        private const int MaxTrackedResources = 64;
+
+        private readonly string _lockClass;
+        private readonly long[] _waitTimeHistogram = new long[HistogramBucketCount];
+        private readonly Dictionary<LockResourceId, ResourceCounter> _resources =
+            new Dictionary<LockResourceId, ResourceCounter>();
+        private readonly StripedCounter _acquireCount = new StripedCounter();
+        private readonly StripedCounter _waitCount = new StripedCounter();
+        private readonly StripedCounter _timeoutCount = new StripedCounter();
+        private readonly StripedCounter _totalWaitTicks = new StripedCounter();
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LockStatisticsCollector"/> class.
+        /// </summary>
+        /// <param name="lockClass">The lock class name.</param>
+        public LockStatisticsCollector(string lockClass)
+        {
+            _lockClass = lockClass;
+        }
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Records a lock request.
+        /// </summary>
+        public void OnAcquire()
+        {
+            _acquireCount.Add(1);
+        }
+
+        /// <summary>
+        /// Records the start of a wait for a lock request that could not be
+        /// granted immediately.
+        /// </summary>
+        /// <returns>
+        /// The timestamp to pass to <see cref="OnWaitCompleted"/>.
+        /// </returns>
+        public long OnWaitStarted()
+        {
+            _waitCount.Add(1);
+            return Stopwatch.GetTimestamp();
+        }
+
+        /// <summary>
+        /// Records the end of a wait.
+        /// </summary>
+        /// <param name="resource">The resource waited on.</param>
+        /// <param name="startTimestamp">The timestamp returned when the wait started.</param>
+        /// <param name="isTimeout"><c>true</c> if the wait timed out.</param>
+        public void OnWaitCompleted(LockResourceId resource, long startTimestamp, bool isTimeout)
+        {
+            var waitTicks = Stopwatch.GetTimestamp() - startTimestamp;
+            _totalWaitTicks.Add(waitTicks);
+            Interlocked.Increment(ref _waitTimeHistogram[GetHistogramBucket(waitTicks)]);
+            if (isTimeout)
+            {
+                _timeoutCount.Add(1);
+            }
+
+            lock (_resources)
+            {
+                if (!_resources.TryGetValue(resource, out var counter))
+                {
+                    if (_resources.Count >= MaxTrackedResources)
+                    {
+                        EvictColdestResource();
+                    }
+
+                    counter = new ResourceCounter();
+                    _resources.Add(resource, counter);
+                }
+
+                ++counter.WaitCount;
+                counter.WaitTicks += waitTicks;
+            }
+        }
+
+        /// <summary>
+        /// Gets a snapshot of the statistics for this lock class.
+        /// </summary>
+        /// <returns>A <see cref="LockClassStatistics"/> instance.</returns>
+        public LockClassStatistics GetStatistics()
+        {
+            var histogram = new long[HistogramBucketCount];
+            for (var index = 0; index < HistogramBucketCount; ++index)
+            {
+                histogram[index] = Interlocked.Read(ref _waitTimeHistogram[index]);
+            }
+
+            return new LockClassStatistics(
+                _lockClass,
+                _acquireCount.Read(),
+                _waitCount.Read(),
+                _timeoutCount.Read(),
+                ToTimeSpan(_totalWaitTicks.Read()),
+                histogram);
+        }
+
+        /// <summary>
+        /// Adds the tracked contended resources to the specified list.
+        /// </summary>
+        /// <param name="resources">The list to add to.</param>
+        public void CollectResources(IList<LockResourceStatistics> resources)
+        {
+            lock (_resources)
+            {
+                foreach (var entry in _resources)
+                {
+                    resources.Add(new LockResourceStatistics(
+                        _lockClass,
+                        entry.Key.ToString(),
+                        entry.Value.WaitCount,
+                        ToTimeSpan(entry.Value.WaitTicks)));
+                }
+            }
+        }
+        #endregion
+
+        #region Private Methods
+        private static int GetHistogramBucket(long waitTicks)
+        {
+            var waitMilliseconds = waitTicks * 1000 / Stopwatch.Frequency;
+            var bucket = 0;
+            while (bucket < HistogramBucketCount - 1 && waitMilliseconds >= (1L << bucket))
+            {
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        private static TimeSpan ToTimeSpan(long stopwatchTicks)
+        {
+            return TimeSpan.FromTicks((long)(stopwatchTicks * ((double)TimeSpan.TicksPerSecond / Stopwatch.Frequency)));
+        }
+
+        private void EvictColdestResource()
+        {
+            var coldest = default(KeyValuePair<LockResourceId, ResourceCounter>);
+            var found = false;
+            foreach (var entry in _resources)
+            {
+                if (!found || entry.Value.WaitTicks < coldest.Value.WaitTicks)
+                {
+                    coldest = entry;
+                    found = true;
+                }
+            }
+
+            if (found)
+            {
+                _resources.Remove(coldest.Key);
+            }
+        }
+        #endregion
+    }
+}
@@ -1,17 +1,59 @@
 using System;
+using System.Collections.Generic;
 using System.Threading;
+using System.Threading.Tasks;
+using Zen.Trunk.Extensions;
 
 namespace Zen.Trunk.Storage.Locking
 {
     /// <summary>
-    /// 
+    /// <c>RLock</c> is a light-weight asynchronous reader/writer lock used to
+    /// protect short-lived resources such as index root and internal pages.
     /// </summary>
-    public class RLock
+    /// <remarks>
+    /// <para>
+    /// Requests are evaluated under a small latch and callers that cannot be
+    /// granted immediately wait on a task rather than blocking a thread.
+    /// </para>
+    /// <para>
+    /// Waiters are granted in arrival order. A new reader is only admitted
+    /// ahead of the queue when nothing is waiting so a waiting writer cannot
+    /// be starved by a stream of readers; when a writer releases the lock
+    /// every reader at the head of the queue is granted together.
+    /// </para>
+    /// <para>
+    /// Index page locks are held while waiting for transaction locks so
+    /// the owners holding and waiting on each lock are tracked and added
+    /// to the wait-for graph used for deadlock detection.
+    /// </para>
+    /// </remarks>
+    public class RLock : IWaitableLock
 	{
+		#region Private Types
+		private class Waiter : TaskCompletionSource<bool>
+		{
+			public Waiter(bool writable, LockOwnerIdentity owner)
+				: base(TaskCreationOptions.RunContinuationsAsynchronously)
+			{
+				Writable = writable;
+				Owner = owner;
+				Transaction = TrunkTransactionContext.Current as ITrunkTransactionPrivate;
+			}
+
+			public bool Writable { get; }
+
+			public LockOwnerIdentity Owner { get; }
+
+			public ITrunkTransactionPrivate Transaction { get; }
+		}
+		#endregion
+
 		#region Private Fields
-		private readonly object _readLock = new object();
-		private readonly object _writeLock = new object();
+		private readonly object _sync = new object();
+		private readonly LinkedList<Waiter> _waiters = new LinkedList<Waiter>();
+		private readonly List<LockOwnerIdentity> _holders = new List<LockOwnerIdentity>();
 		private int _readCount;
+		private bool _isWriteLocked;
 		private int _lockCount;
 		#endregion
 
@@ -19,7 +61,12 @@ namespace Zen.Trunk.Storage.Locking
         /// <summary>
         /// Gets the current lock count.
         /// </summary>
-		public int LockCount => _lockCount;
+        /// <remarks>
+        /// The lock count is the number of callers that hold or are waiting
+        /// for this lock; it is maintained by the lock handler that owns
+        /// this lock.
+        /// </remarks>
+		public int LockCount => Volatile.Read(ref _lockCount);
 	    #endregion
 
 		#region Public Methods
@@ -29,84 +76,227 @@ namespace Zen.Trunk.Storage.Locking
         /// <param name="writable">
         /// <c>true</c> for a writable lock; otherwise <c>false</c> for a readable lock.
         /// </param>
-        /// <param name="timeout"></param>
-        /// <remarks>
-        /// This operation will block for as long as necessary until the resource becomes available.
-        /// </remarks>
-		public void Lock(bool writable, TimeSpan timeout)
+        /// <param name="timeout">The timeout.</param>
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
+        /// <exception cref="LockTimeoutException">
+        /// Thrown if the lock cannot be acquired within the timeout.
+        /// </exception>
+		public async Task LockAsync(bool writable, TimeSpan timeout)
 		{
-			Interlocked.Increment(ref _lockCount);
+			var owner = GetLockOwner();
+			Waiter waiter;
+			lock (_sync)
+			{
+				// Fast path when nothing is queued ahead of us
+				if (_waiters.Count == 0 && CanGrant(writable))
+				{
+					Grant(writable, owner);
+					return;
+				}
+
+				waiter = new Waiter(writable, owner);
+				_waiters.AddLast(waiter);
+			}
+
 			try
 			{
-				var start = DateTime.UtcNow;
-				if (!writable)
+				await waiter.Task.WithTimeout(timeout).ConfigureAwait(false);
+			}
+			catch (OperationCanceledException)
+			{
+				lock (_sync)
 				{
-					// If we can lock read then we are in
-					if (!Monitor.TryEnter(_readLock, timeout))
+					// Withdraw the request unless it was granted as the
+					//	timeout expired
+					if (waiter.TrySetCanceled())
 					{
-						throw new LockException("Failed to acquire read lock on RLock.");
+						_waiters.Remove(waiter);
+						GrantWaiters();
+						throw new LockTimeoutException(
+							writable
+								? "Timeout acquiring write lock on RLock."
+								: "Timeout acquiring read lock on RLock.",
+							timeout);
 					}
+				}
+
+				// Request was chosen as a deadlock victim as it timed out
+				if (waiter.Task.IsFaulted)
+				{
+					await waiter.Task.ConfigureAwait(false);
+				}
+			}
+		}
+
+        /// <summary>
+        /// Unlocks the resource protected by this lock.
+        /// </summary>
+        /// <param name="writable">
+        /// <c>true</c> for a writable lock; otherwise <c>false</c> for a readable lock.
+        /// </param>
+		public void Unlock(bool writable)
+		{
+			var owner = GetLockOwner();
+			lock (_sync)
+			{
+				// Locks may be released outside the context that took them
+				//	in which case any single remaining holder is the owner
+				var holderIndex = _holders.IndexOf(owner);
+				if (holderIndex < 0 && _holders.Count == 1)
+				{
+					holderIndex = 0;
+				}
+				if (holderIndex >= 0)
+				{
+					_holders.RemoveAt(holderIndex);
+				}
 
-					// Increment number of readers and exit
-					Interlocked.Increment(ref _readCount);
-					Monitor.Exit(_readLock);
+				if (writable)
+				{
+					_isWriteLocked = false;
 				}
 				else
 				{
-					// Get read lock first - to block new readers
-					if (!Monitor.TryEnter(_readLock, timeout))
-					{
-						throw new LockException("Failed to acquire read lock on RLock.");
-					}
+					--_readCount;
+				}
 
-					// Wait for read count to fall to zero
-					while (_readCount > 0)
+				GrantWaiters();
+			}
+		}
+		#endregion
+
+		#region Internal Methods
+		internal void AddRefLock()
+		{
+			Interlocked.Increment(ref _lockCount);
+		}
+
+		internal bool ReleaseRefLock()
+		{
+			return Interlocked.Decrement(ref _lockCount) == 0;
+		}
+
+		internal void CollectWaits(WaitForGraph graph)
+		{
+			lock (_sync)
+			{
+				// Waiters are granted in order so each also waits on the
+				//	waiters queued ahead of it
+				var node = _waiters.First;
+				while (node != null)
+				{
+					var waiter = node.Value;
+					if (!waiter.Task.IsCompleted && !IsAnonymous(waiter.Owner))
 					{
-						if ((DateTime.UtcNow - start) < timeout)
+						var cost = waiter.Transaction?.LogBytesWritten ?? 0;
+						foreach (var holder in _holders)
 						{
-							Thread.Sleep(50);
+							AddWait(graph, waiter, holder, cost);
 						}
-						else
+						for (var ahead = node.Previous; ahead != null; ahead = ahead.Previous)
 						{
-							Monitor.Exit(_readLock);
-							throw new LockException("Timeout acquiring write lock while waiting for concurrent readers to release RLock.");
+							AddWait(graph, waiter, ahead.Value.Owner, cost);
 						}
 					}
+					node = node.Next;
+				}
+			}
+		}
 
-					// Get write lock second
-					if (!Monitor.TryEnter(_writeLock, timeout))
+		internal bool AbortWaiter(LockOwnerIdentity waiter, Exception error)
+		{
+			lock (_sync)
+			{
+				foreach (var queuedWaiter in _waiters)
+				{
+					if (queuedWaiter.Owner == waiter && queuedWaiter.TrySetException(error))
 					{
-						Monitor.Exit(_readLock);
-						throw new LockException("Failed to acquire write lock on RLock.");
+						_waiters.Remove(queuedWaiter);
+						GrantWaiters();
+						return true;
 					}
 				}
+				return false;
 			}
-			catch
+		}
+		#endregion
+
+		#region Private Methods
+		private static LockOwnerIdentity GetLockOwner()
+		{
+			return new LockOwnerIdentity(
+				TrunkSessionContext.Current?.SessionId ?? SessionId.Zero,
+				TrunkTransactionContext.Current?.TransactionId ?? TransactionId.Zero);
+		}
+
+		private static bool IsAnonymous(LockOwnerIdentity owner)
+		{
+			return owner.SessionId == SessionId.Zero &&
+				owner.TransactionId == TransactionId.Zero;
+		}
+
+		private void AddWait(WaitForGraph graph, Waiter waiter, LockOwnerIdentity holder, long cost)
+		{
+			if (holder != waiter.Owner &&
+				holder != waiter.Owner.SessionOnlyLockOwner &&
+				!IsAnonymous(holder))
 			{
-				Interlocked.Decrement(ref _lockCount);
-				throw;
+				graph.AddWait(waiter.Owner, holder, this, cost);
 			}
 		}
 
-        /// <summary>
-        /// Unlocks the resource protected by this lock.
-        /// </summary>
-        /// <param name="writable">
-        /// <c>true</c> for a writable lock; otherwise <c>false</c> for a readable lock.
-        /// </param>
-        /// <returns></returns>
-		public bool Unlock(bool writable)
+		private bool CanGrant(bool writable)
+		{
+			return writable
+				? !_isWriteLocked && _readCount == 0
+				: !_isWriteLocked;
+		}
+
+		private void Grant(bool writable, LockOwnerIdentity owner)
 		{
-			if (!writable)
+			_holders.Add(owner);
+			if (writable)
 			{
-				Interlocked.Decrement(ref _readCount);
+				_isWriteLocked = true;
 			}
 			else
 			{
-				Monitor.Exit(_writeLock);
-				Monitor.Exit(_readLock);
+				++_readCount;
 			}
-			return Interlocked.Decrement(ref _lockCount) == 0;
+		}
+
+		private void GrantWaiters()
+		{
+			// Grant waiters in order until we reach one that must wait;
+			//	this releases either a single writer or a run of readers
+			while (_waiters.Count > 0)
+			{
+				var waiter = _waiters.First.Value;
+				if (!CanGrant(waiter.Writable))
+				{
+					break;
+				}
+
+				_waiters.RemoveFirst();
+				if (waiter.TrySetResult(true))
+				{
+					Grant(waiter.Writable, waiter.Owner);
+				}
+			}
+		}
+		#endregion
+
+		#region IWaitableLock Members
+		void IWaitableLock.CollectWaits(WaitForGraph graph)
+		{
+			CollectWaits(graph);
+		}
+
+		bool IWaitableLock.AbortWaiter(LockOwnerIdentity waiter, Exception error)
+		{
+			return AbortWaiter(waiter, error);
 		}
 		#endregion
 	}
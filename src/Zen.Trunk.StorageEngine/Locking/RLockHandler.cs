@@ -1,6 +1,7 @@
 using System;
-using System.Collections.Concurrent;
+using System.Collections.Generic;
 using System.Threading;
+using System.Threading.Tasks;
 using Zen.Trunk.CoordinationDataStructures;
 
 namespace Zen.Trunk.Storage.Locking
@@ -9,50 +10,154 @@ namespace Zen.Trunk.Storage.Locking
     {
         #region Private Fields
         private int _maxFreeLocks = 100;
-        private readonly ConcurrentDictionary<string, RLock> _activeLocks =
-            new ConcurrentDictionary<string, RLock>();
+        private readonly Dictionary<LockResourceId, RLock> _activeLocks =
+            new Dictionary<LockResourceId, RLock>();
         private readonly ObjectPool<RLock> _freeLocks =
             new ObjectPool<RLock>(() => new RLock());
+        private readonly LockStatisticsCollector _statistics =
+            new LockStatisticsCollector(nameof(RLock));
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the statistics collected for resource locks.
+        /// </summary>
+        /// <value>
+        /// The statistics collector.
+        /// </value>
+        public LockStatisticsCollector Statistics => _statistics;
         #endregion
 
         #region Public Methods
         /// <summary>
         /// Acquires a resource lock on the resource associated with the
-        /// resource string.
+        /// resource id.
         /// </summary>
         /// <param name="resource"></param>
-        /// <param name="timeout"></param>
         /// <param name="writable"></param>
+        /// <param name="timeout"></param>
+        /// <returns>
+        /// A <see cref="Task"/> that completes once the lock has been acquired.
+        /// </returns>
         /// <remarks>
         /// A resource lock or RLock only support read and write locks.
         /// </remarks>
-        public void LockResource(string resource, bool writable, TimeSpan timeout)
+        public async Task LockResourceAsync(LockResourceId resource, bool writable, TimeSpan timeout)
         {
             // Fetch r lock for resource or get one from free pool
-            var lockObject = _activeLocks.GetOrAdd(resource, key => _freeLocks.GetObject());
+            //  the reference is taken under the latch so the lock cannot be
+            //  recycled while we wait for it
+            RLock lockObject;
+            lock (_activeLocks)
+            {
+                if (!_activeLocks.TryGetValue(resource, out lockObject))
+                {
+                    lockObject = _freeLocks.GetObject();
+                    _activeLocks.Add(resource, lockObject);
+                }
+                lockObject.AddRefLock();
+            }
 
             // Attempt to lock object
-            lockObject.Lock(writable, timeout);
+            _statistics.OnAcquire();
+            var lockTask = lockObject.LockAsync(writable, timeout);
+            var waitStarted = lockTask.IsCompleted ? 0 : _statistics.OnWaitStarted();
+            try
+            {
+                await lockTask.ConfigureAwait(false);
+            }
+            catch (LockTimeoutException)
+            {
+                ReleaseLock(resource, lockObject);
+                _statistics.OnWaitCompleted(resource, waitStarted, true);
+                throw;
+            }
+            catch
+            {
+                ReleaseLock(resource, lockObject);
+                throw;
+            }
+
+            if (waitStarted != 0)
+            {
+                _statistics.OnWaitCompleted(resource, waitStarted, false);
+            }
+        }
+
+        /// <summary>
+        /// Acquires a resource lock on the resource associated with the
+        /// resource id, blocking the calling thread while waiting.
+        /// </summary>
+        /// <param name="resource"></param>
+        /// <param name="writable"></param>
+        /// <param name="timeout"></param>
+        /// <remarks>
+        /// Only intended for callers that cannot be made asynchronous and
+        /// use very short timeouts.
+        /// </remarks>
+        public void LockResource(LockResourceId resource, bool writable, TimeSpan timeout)
+        {
+            LockResourceAsync(resource, writable, timeout).GetAwaiter().GetResult();
         }
 
         /// <summary>
         /// Releases a resource lock on the resource associated with the
-        /// resource string.
+        /// resource id.
         /// </summary>
         /// <param name="resource"></param>
         /// <param name="writable"></param>
-        public void UnlockResource(string resource, bool writable)
+        public void UnlockResource(LockResourceId resource, bool writable)
         {
-            if (_activeLocks.TryGetValue(resource, out var lockObject) &&
-                lockObject.Unlock(writable) &&
-                lockObject.LockCount == 0)
+            RLock lockObject;
+            lock (_activeLocks)
             {
-                _activeLocks.TryRemove(resource, out var _);
-                if (_freeLocks.Count < _maxFreeLocks)
+                if (!_activeLocks.TryGetValue(resource, out lockObject))
                 {
-                    _freeLocks.PutObject(lockObject);
+                    return;
                 }
             }
+
+            lockObject.Unlock(writable);
+            ReleaseLock(resource, lockObject);
+        }
+
+        /// <summary>
+        /// Adds the waits of every active resource lock to the specified
+        /// wait-for graph.
+        /// </summary>
+        /// <param name="graph">The wait-for graph.</param>
+        public void CollectWaits(WaitForGraph graph)
+        {
+            List<RLock> locks;
+            lock (_activeLocks)
+            {
+                locks = new List<RLock>(_activeLocks.Values);
+            }
+
+            foreach (var lockObject in locks)
+            {
+                lockObject.CollectWaits(graph);
+            }
+        }
+        #endregion
+
+        #region Private Methods
+        private void ReleaseLock(LockResourceId resource, RLock lockObject)
+        {
+            lock (_activeLocks)
+            {
+                if (!lockObject.ReleaseRefLock())
+                {
+                    return;
+                }
+
+                _activeLocks.Remove(resource);
+            }
+
+            if (_freeLocks.Count < _maxFreeLocks)
+            {
+                _freeLocks.PutObject(lockObject);
+            }
         }
         #endregion
 
@@ -63,7 +168,16 @@ namespace Zen.Trunk.Storage.Locking
             set => Interlocked.Exchange(ref _maxFreeLocks, value);
         }
 
-        int ILockHandler.ActiveLockCount => _activeLocks.Count;
+        int ILockHandler.ActiveLockCount
+        {
+            get
+            {
+                lock (_activeLocks)
+                {
+                    return _activeLocks.Count;
+                }
+            }
+        }
 
         int ILockHandler.FreeLockCount => _freeLocks.Count;
 
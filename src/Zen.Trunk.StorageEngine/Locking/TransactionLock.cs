@@ -1,9 +1,7 @@
 ﻿using System;
 using System.Collections.Generic;
-using System.Linq;
 using System.Threading;
 using System.Threading.Tasks;
-using System.Threading.Tasks.Dataflow;
 using Serilog;
 using Serilog.Core;
 using Serilog.Events;
@@ -15,6 +13,19 @@ namespace Zen.Trunk.Storage.Locking
     /// Generic transaction-based lock implementation
     /// </summary>
     /// <typeparam name="TLockTypeEnum"></typeparam>
+    /// <remarks>
+    /// <para>
+    /// The granted lock state and the queue of waiting requests are guarded
+    /// by a small latch held only while the request is evaluated, so an
+    /// uncontended acquire or release completes synchronously on the
+    /// calling thread.
+    /// </para>
+    /// <para>
+    /// Callers only wait asynchronously when a request is blocked by an
+    /// incompatible lock; such waiters are resumed on the thread pool rather
+    /// than on the thread that released the lock.
+    /// </para>
+    /// </remarks>
     public abstract class TransactionLock<TLockTypeEnum> :
         TransactionLockBase, ITransactionLock<TLockTypeEnum>
         where TLockTypeEnum : struct, IComparable, IConvertible, IFormattable // enum
@@ -29,6 +40,7 @@ namespace Zen.Trunk.Storage.Locking
         {
             #region Internal Constructors
             internal LockRequestBase(TLockTypeEnum lockType, LockOwnerIdentity lockOwner)
+                : base(TaskCreationOptions.RunContinuationsAsynchronously)
             {
                 Lock = lockType;
                 LockOwner = lockOwner;
@@ -53,37 +65,12 @@ namespace Zen.Trunk.Storage.Locking
             internal AcquireLock(TLockTypeEnum lockType, LockOwnerIdentity lockOwner)
                 : base(lockType, lockOwner)
             {
+                Transaction = TrunkTransactionContext.Current as ITrunkTransactionPrivate;
             }
             #endregion
-        }
 
-        /// <summary>
-        /// <c>ReleaseLock</c> is a message sent when releasing a lock.
-        /// </summary>
-        /// <seealso cref="Zen.Trunk.Storage.Locking.TransactionLockBase" />
-        /// <seealso cref="Zen.Trunk.Storage.Locking.IReferenceLock" />
-        protected class ReleaseLock : LockRequestBase
-        {
-            #region Internal Constructors
-            internal ReleaseLock(TLockTypeEnum lockType, LockOwnerIdentity lockOwner)
-                : base(lockType, lockOwner)
-            {
-            }
-            #endregion
-        }
-
-        /// <summary>
-        /// <c>QueryLock</c> is a message sent when querying lock state.
-        /// </summary>
-        /// <seealso cref="Zen.Trunk.Storage.Locking.TransactionLockBase" />
-        /// <seealso cref="Zen.Trunk.Storage.Locking.IReferenceLock" />
-        protected class QueryLock : LockRequestBase
-        {
-            #region Internal Constructors
-            internal QueryLock(TLockTypeEnum lockType, LockOwnerIdentity lockOwner)
-                : base(lockType, lockOwner)
-            {
-            }
+            #region Internal Properties
+            internal ITrunkTransactionPrivate Transaction { get; }
             #endregion
         }
         #endregion
@@ -198,21 +185,25 @@ namespace Zen.Trunk.Storage.Locking
             /// </returns>
             private bool CanAcquireLock(AcquireLock request)
             {
-                if (AllowedLockTypes.Length == 0)
+                var requestLock = Convert.ToInt32(request.Lock);
+                foreach (var lockType in AllowedLockTypes)
                 {
-                    return false;
+                    if (Convert.ToInt32(lockType) == requestLock)
+                    {
+                        return true;
+                    }
                 }
-
-                return AllowedLockTypes.Any(lockType => Convert.ToInt32(lockType) == Convert.ToInt32(request.Lock));
+                return false;
             }
         }
         #endregion
 
         #region Private Fields
+        private static readonly Task<bool> LockHeldTask = Task.FromResult(true);
+        private static readonly Task<bool> LockNotHeldTask = Task.FromResult(false);
+
         private readonly ILogger _logger = Serilog.Log.ForContext<TransactionLock<TLockTypeEnum>>();
-        private readonly ActionBlock<AcquireLock> _acquireLockAction;
-        private readonly ActionBlock<ReleaseLock> _releaseLockAction;
-        private readonly ActionBlock<QueryLock> _queryLockAction;
+        private readonly object _syncLock = new object();
         private readonly Dictionary<LockOwnerIdentity, AcquireLock> _activeRequests = new Dictionary<LockOwnerIdentity, AcquireLock>();
         private readonly Queue<AcquireLock> _pendingRequests = new Queue<AcquireLock>();
         private int _referenceCount;
@@ -228,40 +219,27 @@ namespace Zen.Trunk.Storage.Locking
         public event EventHandler FinalRelease;
         #endregion
 
-        #region Protected Constructors
+        #region Public Properties
         /// <summary>
-        /// Initializes a new instance of the <see cref="TransactionLock{TLockTypeEnum}"/> class.
+        /// Gets/sets the lock Id.
         /// </summary>
-        protected TransactionLock()
-        {
-            // Initialise receiver arbiters
-            var taskInterleave = new ConcurrentExclusiveSchedulerPair(TaskScheduler.Default);
-            _acquireLockAction = new ActionBlock<AcquireLock>(
-                AcquireLockRequestHandler,
-                new ExecutionDataflowBlockOptions
-                {
-                    TaskScheduler = taskInterleave.ExclusiveScheduler
-                });
-            _releaseLockAction = new ActionBlock<ReleaseLock>(
-                ReleaseLockRequestHandler,
-                new ExecutionDataflowBlockOptions
-                {
-                    TaskScheduler = taskInterleave.ExclusiveScheduler
-                });
-            _queryLockAction = new ActionBlock<QueryLock>(
-                QueryLockRequestHandler,
-                new ExecutionDataflowBlockOptions
-                {
-                    TaskScheduler = taskInterleave.ConcurrentScheduler
-                });
-        }
-        #endregion
+        public LockResourceId Id { get; set; }
 
-        #region Public Properties
         /// <summary>
-        /// Gets/sets the lock Id.
+        /// Gets the number of outstanding references to this lock object.
+        /// </summary>
+        /// <value>
+        /// The reference count.
+        /// </value>
+        internal int ReferenceCount => Volatile.Read(ref _referenceCount);
+
+        /// <summary>
+        /// Gets or sets the statistics collector for this class of lock.
         /// </summary>
-        public string Id { get; set; }
+        /// <value>
+        /// The statistics collector or <c>null</c> when not collected.
+        /// </value>
+        internal LockStatisticsCollector Statistics { get; set; }
         #endregion
 
         #region Protected Properties
@@ -400,22 +378,45 @@ namespace Zen.Trunk.Storage.Locking
         {
             using (FromLockContext())
             {
-                // Post lock acquisition message
+                // Evaluate the request inline
                 var request = new AcquireLock(lockType, lockOwner);
-                if (!_acquireLockAction.Post(request))
+                lock (_syncLock)
                 {
-                    throw new LockRejectedException();
+                    AcquireLockRequestHandler(request);
                 }
 
-                // Wait for task to complete
+                var statistics = Statistics;
+                statistics?.OnAcquire();
+
+                // Only wait when the request could not be satisfied at once
                 bool addRefLock;
-                try
+                if (request.Task.IsCompleted)
                 {
-                    addRefLock = await request.Task.WithTimeout(timeout).ConfigureAwait(false);
+                    addRefLock = request.Task.GetAwaiter().GetResult();
                 }
-                catch (OperationCanceledException)
+                else
                 {
-                    throw new LockTimeoutException("Lock timeout occurred.", timeout);
+                    var waitStarted = statistics?.OnWaitStarted() ?? 0;
+                    var isTimeout = false;
+                    try
+                    {
+                        addRefLock = await request.Task.WithTimeout(timeout).ConfigureAwait(false);
+                    }
+                    catch (OperationCanceledException)
+                    {
+                        // Withdraw the request unless it was granted as the
+                        //  timeout expired
+                        if (CancelWaitingRequest(request))
+                        {
+                            isTimeout = true;
+                            throw new LockTimeoutException("Lock timeout occurred.", timeout);
+                        }
+                        addRefLock = request.Task.GetAwaiter().GetResult();
+                    }
+                    finally
+                    {
+                        statistics?.OnWaitCompleted(Id, waitStarted, isTimeout);
+                    }
                 }
 
                 // Increment reference count on lock
@@ -426,22 +427,90 @@ namespace Zen.Trunk.Storage.Locking
             }
         }
 
-        internal async Task UnlockAsync(LockOwnerIdentity lockOwner, TLockTypeEnum newLockType)
+        internal Task UnlockAsync(LockOwnerIdentity lockOwner, TLockTypeEnum newLockType)
         {
             using (FromLockContext())
             {
-                // Post lock acquisition message
-                var request = new ReleaseLock(newLockType, lockOwner);
-                if (!_releaseLockAction.Post(request))
+                // Release is never blocked so it is always completed inline
+                bool releaseLock;
+                try
+                {
+                    lock (_syncLock)
+                    {
+                        releaseLock = ReleaseLockRequestHandler(newLockType, lockOwner);
+                    }
+                }
+                catch (Exception e)
                 {
-                    throw new LockRejectedException();
+                    return Task.FromException(e);
                 }
 
-                // Wait for task to complete
-                if (await request.Task.ConfigureAwait(false))
+                if (releaseLock)
                 {
                     ReleaseRefLock();
                 }
+                return CompletedTask.Default;
+            }
+        }
+
+        internal override void CollectWaits(WaitForGraph graph)
+        {
+            lock (_syncLock)
+            {
+                if (_pendingExclusiveRequest != null)
+                {
+                    AddWaits(graph, _pendingExclusiveRequest, null);
+                }
+
+                // Queued requests are granted in order so each also waits
+                //  on the requests queued ahead of it
+                var queuedAhead = new List<AcquireLock>();
+                foreach (var request in _pendingRequests)
+                {
+                    AddWaits(graph, request, queuedAhead);
+                    if (!request.Task.IsCompleted)
+                    {
+                        queuedAhead.Add(request);
+                    }
+                }
+            }
+        }
+
+        internal override bool AbortWaiter(LockOwnerIdentity waiter, Exception error)
+        {
+            lock (_syncLock)
+            {
+                AcquireLock request = null;
+                if (_pendingExclusiveRequest != null &&
+                    _pendingExclusiveRequest.LockOwner == waiter)
+                {
+                    request = _pendingExclusiveRequest;
+                }
+                else
+                {
+                    foreach (var queuedRequest in _pendingRequests)
+                    {
+                        if (queuedRequest.LockOwner == waiter &&
+                            !queuedRequest.Task.IsCompleted)
+                        {
+                            request = queuedRequest;
+                            break;
+                        }
+                    }
+                }
+
+                if (request == null || !request.TrySetException(error))
+                {
+                    return false;
+                }
+
+                // Failed requests are skipped when the queue is drained
+                if (_pendingExclusiveRequest == request)
+                {
+                    _pendingExclusiveRequest = null;
+                }
+                ReleaseWaitingRequests();
+                return true;
             }
         }
         #endregion
@@ -467,13 +536,12 @@ namespace Zen.Trunk.Storage.Locking
         /// </returns>
         protected internal Task<bool> HasLockAsync(LockOwnerIdentity lockOwner, TLockTypeEnum lockType)
         {
-            // Post lock acquisition message
-            var request = new QueryLock(lockType, lockOwner);
-            if (!_queryLockAction.Post(request))
+            bool hasLock;
+            lock (_syncLock)
             {
-                throw new LockRejectedException();
+                hasLock = QueryLockRequestHandler(lockType, lockOwner);
             }
-            return request.Task;
+            return hasLock ? LockHeldTask : LockNotHeldTask;
         }
 
         /// <summary>
@@ -586,14 +654,14 @@ namespace Zen.Trunk.Storage.Locking
             }
         }
 
-        private void ReleaseLockRequestHandler(ReleaseLock request)
+        private bool ReleaseLockRequestHandler(TLockTypeEnum newLockType, LockOwnerIdentity lockOwner)
         {
             _logger.Verbose("ReleaseLock - Enter");
             try
             {
                 var releaseLock = false;
 
-                var activeLockOwner = GetActiveLockOwner(request.LockOwner);
+                var activeLockOwner = GetActiveLockOwner(lockOwner);
                 if (activeLockOwner == null)
                 {
                     //throw new InvalidOperationException("Lock not held by transaction.");
@@ -601,7 +669,7 @@ namespace Zen.Trunk.Storage.Locking
                 }
                 else
                 {
-                    if (IsEquivalentLock(request.Lock, NoneLockType))
+                    if (IsEquivalentLock(newLockType, NoneLockType))
                     {
                         _activeRequests.Remove(activeLockOwner.Value);
                         if (_activeRequests.Count == 0)
@@ -611,22 +679,18 @@ namespace Zen.Trunk.Storage.Locking
 
                         releaseLock = true;
                     }
-                    else if (!IsDowngradedLock(_activeRequests[activeLockOwner.Value].Lock, request.Lock))
+                    else if (!IsDowngradedLock(_activeRequests[activeLockOwner.Value].Lock, newLockType))
                     {
                         throw new InvalidOperationException(
                             "New lock type is not downgrade of current lock.");
                     }
                     else
                     {
-                        _activeRequests[activeLockOwner.Value].Lock = request.Lock;
+                        _activeRequests[activeLockOwner.Value].Lock = newLockType;
                     }
                 }
 
-                request.TrySetResult(releaseLock);
-            }
-            catch (Exception e)
-            {
-                request.TrySetException(e);
+                return releaseLock;
             }
             finally
             {
@@ -635,33 +699,76 @@ namespace Zen.Trunk.Storage.Locking
             }
         }
 
-        private void QueryLockRequestHandler(QueryLock request)
+        private bool QueryLockRequestHandler(TLockTypeEnum lockType, LockOwnerIdentity lockOwner)
         {
-            if (GetActiveLockOwner(request.LockOwner) == null)
+            if (GetActiveLockOwner(lockOwner) == null)
             {
                 // Current transaction is not in active list therefore
                 //	lock is not held
-                request.TrySetResult(false);
+                return false;
             }
-            else if (IsEquivalentLock(request.Lock, NoneLockType))
+
+            if (IsEquivalentLock(lockType, NoneLockType))
             {
                 // Using the NoneLockType means check if we have any kind
                 //	of lock; since transaction id is in the active list
                 //	this must be the case...
-                request.TrySetResult(true);
+                return true;
+            }
+
+            // Current lock state must be the same as or superior to the
+            //	request lock for the lock to be held
+            return IsEquivalentLock(_currentState.Lock, lockType) ||
+                IsDowngradedLock(_currentState.Lock, lockType);
+        }
+
+        private bool CancelWaitingRequest(AcquireLock request)
+        {
+            lock (_syncLock)
+            {
+                if (!request.TrySetCanceled())
+                {
+                    return false;
+                }
+
+                // Cancelled requests are skipped when the queue is drained
+                //  so requests queued behind this one may now be granted
+                if (_pendingExclusiveRequest == request)
+                {
+                    _pendingExclusiveRequest = null;
+                }
+                ReleaseWaitingRequests();
+                return true;
             }
-            else if (
-                IsEquivalentLock(_currentState.Lock, request.Lock) ||
-                IsDowngradedLock(_currentState.Lock, request.Lock))
+        }
+
+        private void AddWaits(WaitForGraph graph, AcquireLock request, List<AcquireLock> queuedAhead)
+        {
+            if (request.Task.IsCompleted)
             {
-                // Current lock state is the same as or superior to the 
-                //	request lock so lock must be held
-                request.TrySetResult(true);
+                return;
             }
-            else
+
+            // Cost of aborting the waiter is the log it would roll back
+            var cost = request.Transaction?.LogBytesWritten ?? 0;
+            var sessionOnlyOwner = request.LockOwner.SessionOnlyLockOwner;
+            foreach (var holder in _activeRequests.Keys)
+            {
+                if (holder != request.LockOwner && holder != sessionOnlyOwner)
+                {
+                    graph.AddWait(request.LockOwner, holder, this, cost);
+                }
+            }
+
+            if (queuedAhead != null)
             {
-                // If we get to this point then we don't have the lock
-                request.TrySetResult(false);
+                foreach (var queuedRequest in queuedAhead)
+                {
+                    if (queuedRequest.LockOwner != request.LockOwner)
+                    {
+                        graph.AddWait(request.LockOwner, queuedRequest.LockOwner, this, cost);
+                    }
+                }
             }
         }
 
@@ -9,7 +9,7 @@ namespace Zen.Trunk.Storage.Locking
     /// <c>TransactionLockBase</c> serves as the base class for all transaction
     /// lock objects.
     /// </summary>
-    public abstract class TransactionLockBase
+    public abstract class TransactionLockBase : IWaitableLock
     {
         private class TransactionLockLogEventEnricher : ILogEventEnricher
         {
@@ -37,6 +37,33 @@ namespace Zen.Trunk.Storage.Locking
             _transactionLockId = Interlocked.Increment(ref _nextTransactionLockId);
         }
 
+        /// <summary>
+        /// Adds the waits of every blocked request on this lock to the
+        /// specified wait-for graph.
+        /// </summary>
+        /// <param name="graph">The wait-for graph.</param>
+        internal abstract void CollectWaits(WaitForGraph graph);
+
+        /// <summary>
+        /// Fails the blocked request made by the specified lock owner.
+        /// </summary>
+        /// <param name="waiter">The waiting lock owner.</param>
+        /// <param name="error">The exception used to fail the request.</param>
+        /// <returns>
+        /// <c>true</c> if a blocked request was failed; otherwise, <c>false</c>.
+        /// </returns>
+        internal abstract bool AbortWaiter(LockOwnerIdentity waiter, Exception error);
+
+        void IWaitableLock.CollectWaits(WaitForGraph graph)
+        {
+            CollectWaits(graph);
+        }
+
+        bool IWaitableLock.AbortWaiter(LockOwnerIdentity waiter, Exception error)
+        {
+            return AbortWaiter(waiter, error);
+        }
+
         protected IDisposable FromLockContext()
         {
             return Serilog.Context.LogContext.Push(new TransactionLockLogEventEnricher(this));
@@ -94,16 +94,20 @@ namespace Zen.Trunk.Storage.Locking
 		/// Gets (or creates) a data lock owner block.
 		/// </summary>
 		/// <param name="objectId">Object ID</param>
-		/// <param name="maxPageLocks">The maximum page locks.</param>
+		/// <param name="maxPageLocks">
+		/// The maximum page locks; when not specified the lock escalation
+		/// threshold of the database lock manager is used.
+		/// </param>
 		/// <returns>
 		/// A <see cref="DataLockOwnerBlock"/> for the object.
 		/// </returns>
 		public DataLockOwnerBlock GetOrCreateDataLockOwnerBlock(
-		    ObjectId objectId, uint maxPageLocks = 100)
+		    ObjectId objectId, uint? maxPageLocks = null)
 		{
 			return _dataOwnerBlocks.GetOrAdd(
 				objectId,
-				id => new DataLockOwnerBlock(_lockManager, id, maxPageLocks));
+				id => new DataLockOwnerBlock(
+					_lockManager, id, maxPageLocks ?? _lockManager.LockEscalationThreshold));
 		}
 
 		/// <summary>
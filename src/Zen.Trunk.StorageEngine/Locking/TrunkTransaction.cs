@@ -109,6 +109,7 @@ namespace Zen.Trunk.Storage.Locking
         private static readonly ILogger Logger = Serilog.Log.ForContext<TrunkTransaction>();
 
         private readonly ILifetimeScope _lifetimeScope;
+        private readonly PageVersionStore _versionStore;
         private readonly List<IPageEnlistmentNotification> _subEnlistments = new List<IPageEnlistmentNotification>();
         private readonly List<TransactionLogEntry> _transactionLogs = new List<TransactionLogEntry>();
         private readonly Dictionary<DatabaseId, TransactionLockOwnerBlock> _transactionLockOwnerBlocks = new Dictionary<DatabaseId, TransactionLockOwnerBlock>();
@@ -120,6 +121,9 @@ namespace Zen.Trunk.Storage.Locking
         private bool _nestedRollbackTriggered;
         private bool _isCompleting;
         private bool _isCompleted;
+        private long _logBytesWritten;
+        private long _snapshotSequence = -1;
+        private long _commitSequence;
         #endregion
 
         #region Public Constructors
@@ -179,6 +183,13 @@ namespace Zen.Trunk.Storage.Locking
                 Timeout = timeout
             };
 
+            // Snapshot readers see only those commits completed before now
+            _versionStore = lifetimeScope.ResolveOptional<PageVersionStore>();
+            if (isoLevel == IsolationLevel.Snapshot && _versionStore != null)
+            {
+                _snapshotSequence = _versionStore.RegisterSnapshot();
+            }
+
             EnlistInTransaction();
         }
         #endregion
@@ -204,6 +215,21 @@ namespace Zen.Trunk.Storage.Locking
         /// <value>The timeout.</value>
         public TimeSpan Timeout => _options.Timeout;
 
+        /// <summary>
+        /// Gets or sets a value indicating whether commit returns before the
+        /// commit log record has been written to the log.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if durability is delayed; otherwise, <c>false</c>.
+        /// </value>
+        /// <remarks>
+        /// When set the commit record is placed in the log buffer and the
+        /// master log device writes it in the background; locks are still
+        /// released only after the record has been queued so log order
+        /// matches commit order.
+        /// </remarks>
+        public bool IsDurabilityDelayed { get; set; }
+
         /// <summary>
         /// Gets a value indicating whether this instance is completed.
         /// </summary>
@@ -211,6 +237,36 @@ namespace Zen.Trunk.Storage.Locking
         /// <c>true</c> if this instance is completed; otherwise, <c>false</c>.
         /// </value>
         public bool IsCompleted => _isCompleted;
+
+        /// <summary>
+        /// Gets the number of log bytes written by this transaction.
+        /// </summary>
+        /// <value>
+        /// The log bytes written.
+        /// </value>
+        /// <remarks>
+        /// Used by deadlock detection as the cost of rolling back this
+        /// transaction.
+        /// </remarks>
+        public long LogBytesWritten => Interlocked.Read(ref _logBytesWritten);
+
+        /// <summary>
+        /// Gets the snapshot sequence number used to select page versions
+        /// when running under snapshot isolation.
+        /// </summary>
+        /// <value>
+        /// The snapshot sequence or -1 if this is not a snapshot transaction.
+        /// </value>
+        public long SnapshotSequence => _snapshotSequence;
+
+        /// <summary>
+        /// Gets the commit sequence number assigned while this transaction
+        /// commits its pages.
+        /// </summary>
+        /// <value>
+        /// The commit sequence or zero when not committing.
+        /// </value>
+        public long CommitSequence => _commitSequence;
         #endregion
 
         #region Private Properties
@@ -313,6 +369,7 @@ namespace Zen.Trunk.Storage.Locking
             if (LoggingDevice != null)
             {
                 _transactionLogs.Add(entry);
+                Interlocked.Add(ref _logBytesWritten, entry.RawSize);
                 await LoggingDevice.WriteEntryAsync(entry).ConfigureAwait(false);
             }
         }
@@ -435,6 +492,7 @@ namespace Zen.Trunk.Storage.Locking
                         "{TransactionId} => Committing {SubEnlistmentCount} sub-enlistments",
                         _transactionId, commitList.Count);
                     var commitTasks = new List<Task>();
+                    _commitSequence = _versionStore?.BeginCommit() ?? 0;
                     try
                     {
                         // Commit each item in the commit list
@@ -478,6 +536,11 @@ namespace Zen.Trunk.Storage.Locking
                             "Commit failed - rolling back");
                         performCommit = false;
                     }
+                    finally
+                    {
+                        _versionStore?.EndCommit(_commitSequence);
+                        _commitSequence = 0;
+                    }
                 }
 
                 if (!performCommit)
@@ -569,6 +632,7 @@ namespace Zen.Trunk.Storage.Locking
             //	since we haven't done any transaction-able work
             if (!_isBeginLogWritten && _subEnlistments.Count == 0)
             {
+                ReleaseSnapshot();
                 return true;
             }
 
@@ -665,7 +729,11 @@ namespace Zen.Trunk.Storage.Locking
             // Should already be set but just make sure...
             _isCompleting = true;
 
-            // Clear transaction logs
+            // Return pooled page images and clear transaction logs
+            foreach (var entry in _transactionLogs)
+            {
+                entry.Release();
+            }
             _transactionLogs.Clear();
 
             // Release all locks
@@ -674,6 +742,7 @@ namespace Zen.Trunk.Storage.Locking
                 await transactionLock.ReleaseAllAsync().ConfigureAwait(false);
             }
             _transactionLockOwnerBlocks.Clear();
+            ReleaseSnapshot();
 
             // Cleanup enlistments that implement IDisposable
             // NOTE: Never dispose sub-enlistments as PageBuffer objects have
@@ -693,6 +762,15 @@ namespace Zen.Trunk.Storage.Locking
             _isCompleting = false;
         }
 
+        private void ReleaseSnapshot()
+        {
+            if (_snapshotSequence >= 0)
+            {
+                _versionStore.ReleaseSnapshot(_snapshotSequence);
+                _snapshotSequence = -1;
+            }
+        }
+
         private void EnlistInTransaction()
         {
             try
@@ -752,7 +830,11 @@ namespace Zen.Trunk.Storage.Locking
                 {
                     entry = new RollbackTransactionLogEntry(_transactionId);
                 }
-                await LoggingDevice.WriteEntryAsync(entry).ConfigureAwait(false);
+
+                // Only commit records are eligible for delayed durability
+                await LoggingDevice
+                    .WriteEntryAsync(entry, commit && IsDurabilityDelayed)
+                    .ConfigureAwait(false);
             }
         }
         #endregion
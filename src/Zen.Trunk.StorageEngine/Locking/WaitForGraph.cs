@@ -0,0 +1,172 @@
+using System.Collections.Generic;
+
+namespace Zen.Trunk.Storage.Locking
+{
+    /// <summary>
+    /// <c>WaitForGraph</c> records which lock owners are waiting on which
+    /// other lock owners so that deadlocks can be found and broken.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each waiting lock owner is blocked on a single lock request; the
+    /// graph remembers that lock so the request of a chosen victim can be
+    /// failed.
+    /// </para>
+    /// <para>
+    /// Victims are chosen by the lowest cost (the number of log bytes the
+    /// transaction has written) so the least work is rolled back; ties are
+    /// broken in favour of the youngest transaction.
+    /// </para>
+    /// </remarks>
+    internal class WaitForGraph
+    {
+        #region Private Types
+        private class Waiter
+        {
+            public Waiter(IWaitableLock lockObject, long cost)
+            {
+                Lock = lockObject;
+                Cost = cost;
+            }
+
+            public IWaitableLock Lock { get; }
+
+            public long Cost { get; }
+
+            public List<LockOwnerIdentity> Holders { get; } = new List<LockOwnerIdentity>();
+        }
+        #endregion
+
+        #region Private Fields
+        private readonly Dictionary<LockOwnerIdentity, Waiter> _waiters =
+            new Dictionary<LockOwnerIdentity, Waiter>();
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the number of waiting lock owners.
+        /// </summary>
+        /// <value>
+        /// The waiter count.
+        /// </value>
+        public int WaiterCount => _waiters.Count;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Records that the waiter is blocked by the holder.
+        /// </summary>
+        /// <param name="waiter">The waiting lock owner.</param>
+        /// <param name="holder">The lock owner blocking the waiter.</param>
+        /// <param name="lockObject">The lock the waiter is blocked on.</param>
+        /// <param name="cost">The cost of aborting the waiter.</param>
+        public void AddWait(LockOwnerIdentity waiter, LockOwnerIdentity holder, IWaitableLock lockObject, long cost)
+        {
+            if (!_waiters.TryGetValue(waiter, out var node))
+            {
+                node = new Waiter(lockObject, cost);
+                _waiters.Add(waiter, node);
+            }
+
+            if (!node.Holders.Contains(holder))
+            {
+                node.Holders.Add(holder);
+            }
+        }
+
+        /// <summary>
+        /// Finds the set of waiters that must be aborted to break every
+        /// cycle in the graph.
+        /// </summary>
+        /// <returns>
+        /// The victims together with the lock each victim is waiting on.
+        /// </returns>
+        public IList<KeyValuePair<LockOwnerIdentity, IWaitableLock>> FindVictims()
+        {
+            var victims = new List<KeyValuePair<LockOwnerIdentity, IWaitableLock>>();
+            List<LockOwnerIdentity> cycle;
+            while ((cycle = FindCycle()) != null)
+            {
+                // Removing the victim removes every wait it is part of
+                var victim = ChooseVictim(cycle);
+                victims.Add(new KeyValuePair<LockOwnerIdentity, IWaitableLock>(
+                    victim, _waiters[victim].Lock));
+                _waiters.Remove(victim);
+            }
+            return victims;
+        }
+        #endregion
+
+        #region Private Methods
+        private List<LockOwnerIdentity> FindCycle()
+        {
+            // Visiting owners are on the current path; visited owners are
+            //  known not to lead to a cycle
+            var visited = new Dictionary<LockOwnerIdentity, bool>();
+            var path = new List<LockOwnerIdentity>();
+            foreach (var owner in _waiters.Keys)
+            {
+                if (!visited.ContainsKey(owner))
+                {
+                    var cycle = Visit(owner, visited, path);
+                    if (cycle != null)
+                    {
+                        return cycle;
+                    }
+                }
+            }
+            return null;
+        }
+
+        private List<LockOwnerIdentity> Visit(
+            LockOwnerIdentity owner,
+            Dictionary<LockOwnerIdentity, bool> visited,
+            List<LockOwnerIdentity> path)
+        {
+            visited[owner] = false;
+            path.Add(owner);
+
+            if (_waiters.TryGetValue(owner, out var node))
+            {
+                foreach (var holder in node.Holders)
+                {
+                    if (!visited.TryGetValue(holder, out var isComplete))
+                    {
+                        var cycle = Visit(holder, visited, path);
+                        if (cycle != null)
+                        {
+                            return cycle;
+                        }
+                    }
+                    else if (!isComplete)
+                    {
+                        // Holder is on the current path so we have a cycle
+                        var start = path.IndexOf(holder);
+                        return path.GetRange(start, path.Count - start);
+                    }
+                }
+            }
+
+            visited[owner] = true;
+            path.RemoveAt(path.Count - 1);
+            return null;
+        }
+
+        private LockOwnerIdentity ChooseVictim(List<LockOwnerIdentity> cycle)
+        {
+            var victim = cycle[0];
+            foreach (var owner in cycle)
+            {
+                var cost = _waiters[owner].Cost;
+                var victimCost = _waiters[victim].Cost;
+                if (cost < victimCost ||
+                    (cost == victimCost && owner.TransactionId > victim.TransactionId))
+                {
+                    victim = owner;
+                }
+            }
+            return victim;
+        }
+        #endregion
+    }
+}
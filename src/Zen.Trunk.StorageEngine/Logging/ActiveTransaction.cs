@@ -7,6 +7,11 @@ namespace Zen.Trunk.Storage.Logging
     /// </summary>
 	public class ActiveTransaction : BufferFieldWrapper
     {
+        /// <summary>
+        /// The encoded size of an active transaction record in bytes.
+        /// </summary>
+        public const int EncodedSize = 16;
+
         private readonly BufferFieldUInt32 _transactionId;
         private readonly BufferFieldLogFileId _fileId;
         private readonly BufferFieldUInt32 _fileOffset;
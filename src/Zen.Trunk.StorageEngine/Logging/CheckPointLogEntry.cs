@@ -52,7 +52,7 @@ namespace Zen.Trunk.Storage.Logging
                 var rawSize = base.RawSize + 2;
                 if (_activeTransactions != null)
                 {
-                    rawSize += (uint)(_activeTransactions.Count * 14);
+                    rawSize += (uint)(_activeTransactions.Count * ActiveTransaction.EncodedSize);
                 }
                 return rawSize;
             }
@@ -167,6 +167,48 @@ namespace Zen.Trunk.Storage.Logging
                 }
             }
         }
+
+        /// <summary>
+        /// Encodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="writer">The log record writer.</param>
+        protected override void OnEncode(ref LogRecordWriter writer)
+        {
+            base.OnEncode(ref writer);
+
+            writer.WriteUInt16((ushort)TransactionCount);
+            for (var index = 0; index < TransactionCount; ++index)
+            {
+                var tran = _activeTransactions[index];
+                writer.WriteUInt32(tran.TransactionId);
+                writer.WriteUInt32(tran.FileId.FileId);
+                writer.WriteUInt32(tran.FileOffset);
+                writer.WriteUInt32(tran.FirstLogId);
+            }
+        }
+
+        /// <summary>
+        /// Decodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        protected override void OnDecode(ref LogRecordReader reader)
+        {
+            base.OnDecode(ref reader);
+
+            var count = reader.ReadUInt16();
+            if (count > 0)
+            {
+                _activeTransactions = new List<ActiveTransaction>(count);
+                for (var index = 0; index < count; ++index)
+                {
+                    _activeTransactions.Add(new ActiveTransaction(
+                        reader.ReadUInt32(),
+                        new LogFileId(reader.ReadUInt32()),
+                        reader.ReadUInt32(),
+                        reader.ReadUInt32()));
+                }
+            }
+        }
         #endregion
 
         #region Internal Methods
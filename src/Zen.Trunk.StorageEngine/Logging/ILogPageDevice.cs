@@ -47,6 +47,18 @@ namespace Zen.Trunk.Storage.Logging
         /// <value><c>true</c> if this instance is create; otherwise, <c>false</c>.</value>
         bool IsCreate { get; }
 
+        /// <summary>
+        /// Gets the object used to serialise access to the device backing store.
+        /// </summary>
+        /// <value>
+        /// The synchronisation object.
+        /// </value>
+        /// <remarks>
+        /// All virtual log files on a device share the same backing store
+        /// so any I/O that repositions it must hold this lock.
+        /// </remarks>
+        object SyncRoot { get; }
+
         /// <summary>
         /// Initialises the virtual file table for a newly added log device.
         /// </summary>
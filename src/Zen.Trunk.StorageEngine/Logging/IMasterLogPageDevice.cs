@@ -36,6 +36,27 @@ namespace Zen.Trunk.Storage.Logging
         /// </value>
         bool IsTruncatingLog { get; }
 
+        /// <summary>
+        /// Gets or sets a value indicating whether log blocks are striped
+        /// across all log devices.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if the log is striped; otherwise, <c>false</c>.
+        /// </value>
+        /// <remarks>
+        /// This setting can only be changed before the log is created.
+        /// </remarks>
+        bool IsStriped { get; set; }
+
+        /// <summary>
+        /// Gets the number of bytes of log entries that have been accepted
+        /// with delayed durability but not yet written to the log.
+        /// </summary>
+        /// <value>
+        /// The unhardened byte count.
+        /// </value>
+        long UnhardenedBytes { get; }
+
         /// <summary>
         /// Adds a log device based on supplied parameters.
         /// </summary>
@@ -64,6 +85,30 @@ namespace Zen.Trunk.Storage.Logging
         /// <exception cref="BufferDeviceShuttingDownException"></exception>
         Task WriteEntryAsync(LogEntry entry);
 
+        /// <summary>
+        /// Writes the entry optionally delaying durability.
+        /// </summary>
+        /// <param name="entry">The entry.</param>
+        /// <param name="delayDurability">
+        /// <c>true</c> to return as soon as the entry has been accepted into
+        /// the in-memory log buffer; <c>false</c> to wait until the entry has
+        /// been written to the log.
+        /// </param>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <exception cref="BufferDeviceShuttingDownException"></exception>
+        Task WriteEntryAsync(LogEntry entry, bool delayDurability);
+
+        /// <summary>
+        /// Writes all log entries held with delayed durability to the log.
+        /// </summary>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <exception cref="BufferDeviceShuttingDownException"></exception>
+        Task FlushDelayedEntriesAsync();
+
         /// <summary>
         /// Performs database recovery.
         /// </summary>
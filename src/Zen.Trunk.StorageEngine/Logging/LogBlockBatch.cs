@@ -0,0 +1,54 @@
+namespace Zen.Trunk.Storage.Logging
+{
+    /// <summary>
+    /// <c>LogBlockBatch</c> holds one or more contiguous log blocks that
+    /// have been encoded by a <see cref="VirtualLogFileStream"/> but not yet
+    /// written to it.
+    /// </summary>
+    /// <remarks>
+    /// Preparing a batch reserves space in the stream so the log position
+    /// of every entry is known before the blocks reach the disk. This lets
+    /// the owner encode and compress blocks in log order on one thread and
+    /// hand the write to another.
+    /// </remarks>
+    public sealed class LogBlockBatch
+    {
+        #region Internal Constructors
+        internal LogBlockBatch(VirtualLogFileStream stream)
+        {
+            Stream = stream;
+            Buffer = new byte[VirtualLogFileStream.MaximumBlockSize];
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the stream the batch will be written to.
+        /// </summary>
+        /// <value>
+        /// The virtual log file stream.
+        /// </value>
+        public VirtualLogFileStream Stream { get; }
+
+        /// <summary>
+        /// Gets the log position of the first entry in the batch.
+        /// </summary>
+        /// <value>
+        /// The first log position.
+        /// </value>
+        public uint FirstLogPosition => (uint)BlockStart;
+        #endregion
+
+        #region Internal Properties
+        internal byte[] Buffer { get; set; }
+
+        internal int Length { get; set; }
+
+        internal long BlockStart { get; set; }
+
+        internal uint Cursor { get; set; }
+
+        internal uint LastCursor { get; set; }
+        #endregion
+    }
+}
@@ -0,0 +1,225 @@
+using Zen.Trunk.Storage.BufferFields;
+
+namespace Zen.Trunk.Storage.Logging
+{
+    /// <summary>
+    /// <c>LogBlockHeader</c> frames a block of log entries written to a
+    /// virtual log file.
+    /// </summary>
+    /// <seealso cref="BufferFieldWrapper" />
+    /// <remarks>
+    /// The checksum is a CRC-32C computed over the header fields that
+    /// precede it followed by the stored payload bytes. It is written last
+    /// so a torn block write can always be detected.
+    /// </remarks>
+    public class LogBlockHeader : BufferFieldWrapper
+    {
+        #region Public Constants
+        /// <summary>
+        /// The status bit indicating the payload is compressed.
+        /// </summary>
+        public const byte StatusIsCompressed = 1;
+
+        /// <summary>
+        /// The size of the block header in bytes.
+        /// </summary>
+        public const int HeaderSize = 23;
+
+        /// <summary>
+        /// The number of header bytes covered by the checksum.
+        /// </summary>
+        public const int ChecksumOffset = HeaderSize - 4;
+        #endregion
+
+        #region Private Fields
+        private readonly BufferFieldBitVector8 _status;
+        private readonly BufferFieldUInt16 _entryCount;
+        private readonly BufferFieldUInt16 _storedLength;
+        private readonly BufferFieldUInt16 _rawLength;
+        private readonly BufferFieldUInt32 _firstLogId;
+        private readonly BufferFieldUInt32 _lastLogId;
+        private readonly BufferFieldUInt32 _sequence;
+        private readonly BufferFieldUInt32 _checksum;
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LogBlockHeader"/> class.
+        /// </summary>
+        public LogBlockHeader()
+        {
+            _status = new BufferFieldBitVector8();
+            _entryCount = new BufferFieldUInt16(_status);
+            _storedLength = new BufferFieldUInt16(_entryCount);
+            _rawLength = new BufferFieldUInt16(_storedLength);
+            _firstLogId = new BufferFieldUInt32(_rawLength);
+            _lastLogId = new BufferFieldUInt32(_firstLogId);
+            _sequence = new BufferFieldUInt32(_lastLogId);
+            _checksum = new BufferFieldUInt32(_sequence);
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets or sets a value indicating whether the payload is compressed.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if the payload is compressed; otherwise, <c>false</c>.
+        /// </value>
+        public bool IsCompressed
+        {
+            get => _status.GetBit(StatusIsCompressed);
+            set => _status.SetBit(StatusIsCompressed, value);
+        }
+
+        /// <summary>
+        /// Gets or sets the number of log entries in the block.
+        /// </summary>
+        /// <value>
+        /// The entry count.
+        /// </value>
+        public ushort EntryCount
+        {
+            get => _entryCount.Value;
+            set => _entryCount.Value = value;
+        }
+
+        /// <summary>
+        /// Gets or sets the length of the payload as stored on disk.
+        /// </summary>
+        /// <value>
+        /// The stored length.
+        /// </value>
+        public ushort StoredLength
+        {
+            get => _storedLength.Value;
+            set => _storedLength.Value = value;
+        }
+
+        /// <summary>
+        /// Gets or sets the length of the payload once decompressed.
+        /// </summary>
+        /// <value>
+        /// The raw length.
+        /// </value>
+        public ushort RawLength
+        {
+            get => _rawLength.Value;
+            set => _rawLength.Value = value;
+        }
+
+        /// <summary>
+        /// Gets or sets the log id of the first entry in the block.
+        /// </summary>
+        /// <value>
+        /// The first log identifier.
+        /// </value>
+        public uint FirstLogId
+        {
+            get => _firstLogId.Value;
+            set => _firstLogId.Value = value;
+        }
+
+        /// <summary>
+        /// Gets or sets the log id of the last entry in the block.
+        /// </summary>
+        /// <value>
+        /// The last log identifier.
+        /// </value>
+        public uint LastLogId
+        {
+            get => _lastLogId.Value;
+            set => _lastLogId.Value = value;
+        }
+
+        /// <summary>
+        /// Gets or sets the sequence number of the virtual file the block
+        /// was written to.
+        /// </summary>
+        /// <value>
+        /// The virtual file sequence number.
+        /// </value>
+        public uint Sequence
+        {
+            get => _sequence.Value;
+            set => _sequence.Value = value;
+        }
+
+        /// <summary>
+        /// Gets or sets the block checksum.
+        /// </summary>
+        /// <value>
+        /// The CRC-32C checksum of the header and stored payload.
+        /// </value>
+        public uint Checksum
+        {
+            get => _checksum.Value;
+            set => _checksum.Value = value;
+        }
+        #endregion
+
+        #region Protected Properties
+        /// <summary>
+        /// Gets the first buffer field object.
+        /// </summary>
+        /// <value>
+        /// A <see cref="T:BufferField" /> object.
+        /// </value>
+        protected override BufferField FirstField => _status;
+
+        /// <summary>
+        /// Gets the last buffer field object.
+        /// </summary>
+        /// <value>
+        /// A <see cref="T:BufferField" /> object.
+        /// </value>
+        protected override BufferField LastField => _checksum;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Encodes this header into the start of a log block buffer.
+        /// </summary>
+        /// <param name="buffer">The block buffer.</param>
+        public void Encode(byte[] buffer)
+        {
+            Encode(buffer, 0);
+        }
+
+        /// <summary>
+        /// Encodes this header into a log block buffer at the specified offset.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        /// <param name="offset">The offset of the log block within the buffer.</param>
+        public void Encode(byte[] buffer, int offset)
+        {
+            var writer = new LogRecordWriter(buffer, offset, HeaderSize);
+            writer.WriteByte(_status.Value);
+            writer.WriteUInt16(_entryCount.Value);
+            writer.WriteUInt16(_storedLength.Value);
+            writer.WriteUInt16(_rawLength.Value);
+            writer.WriteUInt32(_firstLogId.Value);
+            writer.WriteUInt32(_lastLogId.Value);
+            writer.WriteUInt32(_sequence.Value);
+            writer.WriteUInt32(_checksum.Value);
+        }
+
+        /// <summary>
+        /// Decodes this header from the start of a log block buffer.
+        /// </summary>
+        /// <param name="buffer">The block buffer.</param>
+        public void Decode(byte[] buffer)
+        {
+            var reader = new LogRecordReader(buffer, 0, HeaderSize);
+            _status.Value = reader.ReadByte();
+            _entryCount.Value = reader.ReadUInt16();
+            _storedLength.Value = reader.ReadUInt16();
+            _rawLength.Value = reader.ReadUInt16();
+            _firstLogId.Value = reader.ReadUInt32();
+            _lastLogId.Value = reader.ReadUInt32();
+            _sequence.Value = reader.ReadUInt32();
+            _checksum.Value = reader.ReadUInt32();
+        }
+        #endregion
+    }
+}
@@ -83,43 +83,89 @@ namespace Zen.Trunk.Storage.Logging
         /// <exception cref="InvalidOperationException">Illegal log entry type detected.</exception>
         public static LogEntry ReadEntry(SwitchingBinaryReader streamManager)
         {
-            LogEntry entry;
             var logType = ReadLogType(streamManager);
+            var entry = CreateEntry(logType);
+            entry.Read(streamManager);
+            return entry;
+        }
+
+        /// <summary>
+        /// Decodes the next entry from a log block buffer.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        /// <returns></returns>
+        /// <exception cref="InvalidOperationException">Illegal log entry type detected.</exception>
+        public static LogEntry ReadEntry(ref LogRecordReader reader)
+        {
+            var logType = (LogEntryType)reader.ReadByte();
+            var entry = CreateEntry(logType);
+            entry.OnDecode(ref reader);
+            return entry;
+        }
+
+        /// <summary>
+        /// Reads the identity of the next entry from a log block buffer and
+        /// skips over the remainder of the record.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        /// <returns>
+        /// A <see cref="LogRecordInfo"/> describing the record.
+        /// </returns>
+        /// <exception cref="InvalidOperationException">Illegal log entry type detected.</exception>
+        public static LogRecordInfo ReadEntryInfo(ref LogRecordReader reader)
+        {
+            var logType = (LogEntryType)reader.ReadByte();
+            var logId = reader.ReadUInt32();
+            var lastLog = reader.ReadUInt32();
             switch (logType)
             {
                 case LogEntryType.NoOp:
-                    entry = new NoOpLogEntry();
                     break;
                 case LogEntryType.BeginCheckpoint:
-                    entry = new BeginCheckPointLogEntry();
-                    break;
                 case LogEntryType.EndCheckpoint:
-                    entry = new EndCheckPointLogEntry();
+                    reader.Skip(reader.ReadUInt16() * ActiveTransaction.EncodedSize);
                     break;
                 case LogEntryType.BeginXact:
-                    entry = new BeginTransactionLogEntry();
-                    break;
                 case LogEntryType.CommitXact:
-                    entry = new CommitTransactionLogEntry();
-                    break;
                 case LogEntryType.RollbackXact:
-                    entry = new RollbackTransactionLogEntry();
+                    reader.Skip(4);
                     break;
                 case LogEntryType.CreatePage:
-                    entry = new PageImageCreateLogEntry();
+                case LogEntryType.DeletePage:
+                    reader.Skip(20 + StorageConstants.PageBufferSize);
                     break;
                 case LogEntryType.ModifyPage:
-                    entry = new PageImageUpdateLogEntry();
-                    break;
-                case LogEntryType.DeletePage:
-                    entry = new PageImageDeleteLogEntry();
+                    reader.Skip(20 + (2 * StorageConstants.PageBufferSize));
                     break;
                 default:
                     throw new InvalidOperationException("Illegal log entry type detected.");
             }
-            entry._logType = logType;
-            entry.Read(streamManager);
-            return entry;
+            return new LogRecordInfo(logType, logId, lastLog);
+        }
+
+        /// <summary>
+        /// Encodes this entry directly into a log block buffer.
+        /// </summary>
+        /// <param name="writer">The log record writer.</param>
+        /// <remarks>
+        /// The encoding is identical to that produced by <see cref="BufferFieldWrapper.Write"/>
+        /// and occupies exactly <see cref="RawSize"/> bytes.
+        /// </remarks>
+        public void Encode(ref LogRecordWriter writer)
+        {
+            writer.WriteByte((byte)(int)_logType);
+            OnEncode(ref writer);
+        }
+
+        /// <summary>
+        /// Releases any pooled resources held by this entry.
+        /// </summary>
+        /// <remarks>
+        /// Called once the owning transaction has completed; the entry must
+        /// not be used afterwards.
+        /// </remarks>
+        public virtual void Release()
+        {
         }
 
         /// <summary>
@@ -173,9 +219,68 @@ namespace Zen.Trunk.Storage.Logging
             writer.Write((byte)(int)_logType);
             base.OnWrite(writer);
         }
+
+        /// <summary>
+        /// Encodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="writer">The log record writer.</param>
+        protected virtual void OnEncode(ref LogRecordWriter writer)
+        {
+            writer.WriteUInt32(_logId.Value);
+            writer.WriteUInt32(_lastLog.Value);
+        }
+
+        /// <summary>
+        /// Decodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        protected virtual void OnDecode(ref LogRecordReader reader)
+        {
+            _logId.Value = reader.ReadUInt32();
+            _lastLog.Value = reader.ReadUInt32();
+        }
         #endregion
 
         #region Private Methods
+        private static LogEntry CreateEntry(LogEntryType logType)
+        {
+            LogEntry entry;
+            switch (logType)
+            {
+                case LogEntryType.NoOp:
+                    entry = new NoOpLogEntry();
+                    break;
+                case LogEntryType.BeginCheckpoint:
+                    entry = new BeginCheckPointLogEntry();
+                    break;
+                case LogEntryType.EndCheckpoint:
+                    entry = new EndCheckPointLogEntry();
+                    break;
+                case LogEntryType.BeginXact:
+                    entry = new BeginTransactionLogEntry();
+                    break;
+                case LogEntryType.CommitXact:
+                    entry = new CommitTransactionLogEntry();
+                    break;
+                case LogEntryType.RollbackXact:
+                    entry = new RollbackTransactionLogEntry();
+                    break;
+                case LogEntryType.CreatePage:
+                    entry = new PageImageCreateLogEntry();
+                    break;
+                case LogEntryType.ModifyPage:
+                    entry = new PageImageUpdateLogEntry();
+                    break;
+                case LogEntryType.DeletePage:
+                    entry = new PageImageDeleteLogEntry();
+                    break;
+                default:
+                    throw new InvalidOperationException("Illegal log entry type detected.");
+            }
+            entry._logType = logType;
+            return entry;
+        }
+
         private static LogEntryType ReadLogType(SwitchingBinaryReader streamManager)
         {
             return (LogEntryType)streamManager.ReadByte();
@@ -34,6 +34,7 @@ namespace Zen.Trunk.Storage.Logging
         private const uint MinimumPagesPerVirtualFile = 128;
         private const uint MaximumPagesPerVirtualFile = 16384;
 
+        private readonly object _syncIo = new object();
         private FileStream _deviceStream;
         private readonly Dictionary<LogFileId, VirtualLogFileStream> _fileStreams =
             new Dictionary<LogFileId, VirtualLogFileStream>();
@@ -78,6 +79,14 @@ namespace Zen.Trunk.Storage.Logging
         /// </value>
         public bool IsReadOnly => false;
 
+        /// <summary>
+        /// Gets the object used to serialise access to the device backing store.
+        /// </summary>
+        /// <value>
+        /// The synchronisation object.
+        /// </value>
+        public object SyncRoot => _syncIo;
+
         /// <summary>
         /// Gets a value indicating whether this instance is in recovery.
         /// </summary>
@@ -224,6 +233,13 @@ namespace Zen.Trunk.Storage.Logging
                 stream = new VirtualLogFileStream(
                     this, new NonClosingStream(_deviceStream), info);
 
+                // Files in use carry cursors and a sequence number in their
+                //  headers that must be loaded before reading or writing
+                if (info.IsAllocated)
+                {
+                    stream.InitLoad();
+                }
+
                 // Add file stream to the cache
                 _fileStreams.Add(info.FileId, stream);
             }
@@ -242,6 +258,12 @@ namespace Zen.Trunk.Storage.Logging
                 growthPageCount = Math.Min(maximumGrowthPages, growthPageCount);
             }
 
+            // If we have reached the maximum size then return immediately
+            if (growthPageCount == 0)
+            {
+                return new VirtualLogFileInfo[0];
+            }
+
             // We need at least the minimum pages per virtual file
             growthPageCount = Math.Max(growthPageCount, MinimumPagesPerVirtualFile);
 
@@ -271,6 +293,20 @@ namespace Zen.Trunk.Storage.Logging
                 masterRootPage.LastLogFileId = info.FileId;
             }
 
+            // Preallocate the backing store so that log writes into the new
+            //  virtual files never have to extend the underlying file
+            var lastInfo = result[result.Count - 1];
+            var requiredLength = lastInfo.StartOffset + lastInfo.Length;
+            lock (_syncIo)
+            {
+                if (_deviceStream != null && _deviceStream.Length < requiredLength)
+                {
+                    _deviceStream.SetLength(requiredLength);
+                }
+            }
+            rootPage.AllocatedPages = newAllocatedPageCount;
+            rootPage.SetDirty();
+
             // Save the root page
             SaveRootPage();
 
@@ -378,7 +414,10 @@ namespace Zen.Trunk.Storage.Logging
         /// </summary>
         protected void SaveRootPage()
         {
-            _rootPage.Save();
+            lock (_syncIo)
+            {
+                _rootPage.Save();
+            }
         }
 
         protected uint CalculateGrowthPageCount()
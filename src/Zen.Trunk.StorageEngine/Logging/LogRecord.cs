@@ -0,0 +1,255 @@
+using System;
+using System.Threading.Tasks;
+using Zen.Trunk.Extensions;
+using Zen.Trunk.VirtualMemory;
+
+namespace Zen.Trunk.Storage.Logging
+{
+    /// <summary>
+    /// <c>LogRecord</c> is a decoded log record that carries the record
+    /// fields by value rather than as a <see cref="LogEntry"/> object graph.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Recovery reads every record from the checkpoint onwards and keeps the
+    /// transaction records until it knows whether each transaction committed;
+    /// holding them as values means decoding a block allocates nothing but
+    /// the pooled page images.
+    /// </para>
+    /// <para>
+    /// Page images are rented from the page image pool and must be handed
+    /// back through <see cref="Release"/> by whoever owns the record once it
+    /// has been applied or discarded.
+    /// </para>
+    /// </remarks>
+    public struct LogRecord
+    {
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LogRecord"/> struct.
+        /// </summary>
+        /// <param name="logType">Type of the log record.</param>
+        /// <param name="logId">The log identifier.</param>
+        /// <param name="lastLog">The position of the previous log record.</param>
+        public LogRecord(LogEntryType logType, uint logId, uint lastLog)
+            : this(logType, logId, lastLog, TransactionId.Zero, VirtualPageId.Zero, 0, null, null)
+        {
+        }
+        #endregion
+
+        #region Private Constructors
+        private LogRecord(
+            LogEntryType logType,
+            uint logId,
+            uint lastLog,
+            TransactionId transactionId,
+            VirtualPageId virtualPageId,
+            long timestamp,
+            byte[] beforeImage,
+            byte[] afterImage)
+        {
+            LogType = logType;
+            LogId = logId;
+            LastLog = lastLog;
+            TransactionId = transactionId;
+            VirtualPageId = virtualPageId;
+            Timestamp = timestamp;
+            BeforeImage = beforeImage;
+            AfterImage = afterImage;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the type of the log record.
+        /// </summary>
+        /// <value>
+        /// The type of the log record.
+        /// </value>
+        public LogEntryType LogType { get; }
+
+        /// <summary>
+        /// Gets the log identifier.
+        /// </summary>
+        /// <value>
+        /// The log identifier.
+        /// </value>
+        public uint LogId { get; }
+
+        /// <summary>
+        /// Gets the position of the previous log record.
+        /// </summary>
+        /// <value>
+        /// The last log position.
+        /// </value>
+        public uint LastLog { get; }
+
+        /// <summary>
+        /// Gets the transaction identifier of a transaction record.
+        /// </summary>
+        /// <value>
+        /// The transaction identifier or zero for checkpoint and no-op
+        /// records.
+        /// </value>
+        public TransactionId TransactionId { get; }
+
+        /// <summary>
+        /// Gets the virtual page identifier of a page record.
+        /// </summary>
+        /// <value>
+        /// The virtual page identifier.
+        /// </value>
+        public VirtualPageId VirtualPageId { get; }
+
+        /// <summary>
+        /// Gets the page timestamp of a page record.
+        /// </summary>
+        /// <value>
+        /// The timestamp.
+        /// </value>
+        public long Timestamp { get; }
+
+        /// <summary>
+        /// Gets the page image before the change.
+        /// </summary>
+        /// <value>
+        /// The before image or <c>null</c> when the page did not exist.
+        /// </value>
+        public byte[] BeforeImage { get; }
+
+        /// <summary>
+        /// Gets the page image after the change.
+        /// </summary>
+        /// <value>
+        /// The after image or <c>null</c> when the page was deleted.
+        /// </value>
+        public byte[] AfterImage { get; }
+
+        /// <summary>
+        /// Gets a value indicating whether this record belongs to a transaction.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if this is a transaction record; otherwise, <c>false</c>.
+        /// </value>
+        public bool IsTransactionRecord => LogType >= LogEntryType.BeginXact;
+
+        /// <summary>
+        /// Gets a value indicating whether this record changes a page.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if this is a page record; otherwise, <c>false</c>.
+        /// </value>
+        public bool IsPageRecord => LogType >= LogEntryType.CreatePage;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Decodes the next record from a log block buffer.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        /// <returns>
+        /// The decoded <see cref="LogRecord"/>.
+        /// </returns>
+        /// <remarks>
+        /// The layout read is identical to that written by
+        /// <see cref="LogEntry.Encode"/>. Checkpoint records are returned
+        /// without their active transaction list.
+        /// </remarks>
+        /// <exception cref="InvalidOperationException">Illegal log entry type detected.</exception>
+        public static LogRecord Decode(ref LogRecordReader reader)
+        {
+            var logType = (LogEntryType)reader.ReadByte();
+            var logId = reader.ReadUInt32();
+            var lastLog = reader.ReadUInt32();
+            switch (logType)
+            {
+                case LogEntryType.NoOp:
+                    return new LogRecord(logType, logId, lastLog);
+
+                case LogEntryType.BeginCheckpoint:
+                case LogEntryType.EndCheckpoint:
+                    reader.Skip(reader.ReadUInt16() * ActiveTransaction.EncodedSize);
+                    return new LogRecord(logType, logId, lastLog);
+
+                case LogEntryType.BeginXact:
+                case LogEntryType.CommitXact:
+                case LogEntryType.RollbackXact:
+                    return new LogRecord(
+                        logType, logId, lastLog, new TransactionId(reader.ReadUInt32()), VirtualPageId.Zero, 0, null, null);
+
+                case LogEntryType.CreatePage:
+                case LogEntryType.ModifyPage:
+                case LogEntryType.DeletePage:
+                    var transactionId = new TransactionId(reader.ReadUInt32());
+                    var virtualPageId = new VirtualPageId(reader.ReadUInt64());
+                    var timestamp = reader.ReadInt64();
+                    var beforeImage = logType != LogEntryType.CreatePage ? ReadImage(ref reader) : null;
+                    var afterImage = logType != LogEntryType.DeletePage ? ReadImage(ref reader) : null;
+                    return new LogRecord(
+                        logType, logId, lastLog, transactionId, virtualPageId, timestamp, beforeImage, afterImage);
+
+                default:
+                    throw new InvalidOperationException("Illegal log entry type detected.");
+            }
+        }
+
+        /// <summary>
+        /// Performs the rollforward action on the associated page buffer from
+        /// this log record state.
+        /// </summary>
+        /// <param name="device">The device.</param>
+        /// <returns></returns>
+        public Task RollForward(DatabaseDevice device)
+        {
+            return IsPageRecord
+                ? ApplyPageImageAsync(device, VirtualPageId, Timestamp, AfterImage)
+                : CompletedTask.Default;
+        }
+
+        /// <summary>
+        /// Performs the rollback action on the associated page buffer from
+        /// this log record state.
+        /// </summary>
+        /// <param name="device">The device.</param>
+        /// <returns></returns>
+        public Task RollBack(DatabaseDevice device)
+        {
+            return IsPageRecord
+                ? ApplyPageImageAsync(device, VirtualPageId, Timestamp, BeforeImage)
+                : CompletedTask.Default;
+        }
+
+        /// <summary>
+        /// Returns the pooled page images held by this record.
+        /// </summary>
+        /// <remarks>
+        /// The record and any copies of it must not be used afterwards.
+        /// </remarks>
+        public void Release()
+        {
+            PageImagePool.Return(BeforeImage);
+            PageImagePool.Return(AfterImage);
+        }
+        #endregion
+
+        #region Private Methods
+        private static byte[] ReadImage(ref LogRecordReader reader)
+        {
+            var image = PageImagePool.Rent();
+            reader.ReadBytes(image, StorageConstants.PageBufferSize);
+            return image;
+        }
+
+        private static async Task ApplyPageImageAsync(
+            DatabaseDevice device, VirtualPageId virtualPageId, long timestamp, byte[] image)
+        {
+            var page = await PageLogEntry.LoadPageAsync(device, virtualPageId).ConfigureAwait(false);
+
+            if (page.Timestamp != timestamp)
+            {
+                PageLogEntry.WritePageImage(page.DataBuffer, image);
+            }
+        }
+        #endregion
+    }
+}
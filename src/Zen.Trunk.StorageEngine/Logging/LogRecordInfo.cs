@@ -0,0 +1,54 @@
+namespace Zen.Trunk.Storage.Logging
+{
+    /// <summary>
+    /// <c>LogRecordInfo</c> describes a log record without materialising
+    /// the full <see cref="LogEntry"/> object.
+    /// </summary>
+    /// <remarks>
+    /// Used when scanning the log where only the record identity is needed
+    /// (such as locating the highest log id on startup).
+    /// </remarks>
+    public struct LogRecordInfo
+    {
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LogRecordInfo"/> struct.
+        /// </summary>
+        /// <param name="logType">Type of the log record.</param>
+        /// <param name="logId">The log identifier.</param>
+        /// <param name="lastLog">The position of the previous log record.</param>
+        public LogRecordInfo(LogEntryType logType, uint logId, uint lastLog)
+        {
+            LogType = logType;
+            LogId = logId;
+            LastLog = lastLog;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the type of the log record.
+        /// </summary>
+        /// <value>
+        /// The type of the log record.
+        /// </value>
+        public LogEntryType LogType { get; }
+
+        /// <summary>
+        /// Gets the log identifier.
+        /// </summary>
+        /// <value>
+        /// The log identifier.
+        /// </value>
+        public uint LogId { get; }
+
+        /// <summary>
+        /// Gets the position of the previous log record.
+        /// </summary>
+        /// <value>
+        /// The last log position.
+        /// </value>
+        public uint LastLog { get; }
+        #endregion
+    }
+}
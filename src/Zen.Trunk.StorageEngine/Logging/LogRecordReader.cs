@@ -0,0 +1,162 @@
+using System;
+using System.IO;
+
+namespace Zen.Trunk.Storage.Logging
+{
+    /// <summary>
+    /// <c>LogRecordReader</c> decodes log records directly from a log block
+    /// buffer.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Reading past the end of the region throws an
+    /// <see cref="EndOfStreamException"/> in the same way a binary reader
+    /// would.
+    /// </para>
+    /// <para>
+    /// This is a mutable value type and must be passed by reference.
+    /// </para>
+    /// </remarks>
+    public struct LogRecordReader
+    {
+        #region Private Fields
+        private readonly byte[] _buffer;
+        private readonly int _end;
+        private int _position;
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LogRecordReader"/> struct.
+        /// </summary>
+        /// <param name="buffer">The source buffer.</param>
+        /// <param name="offset">The offset at which reading starts.</param>
+        /// <param name="count">The number of bytes available for reading.</param>
+        public LogRecordReader(byte[] buffer, int offset, int count)
+        {
+            if (buffer == null)
+            {
+                throw new ArgumentNullException(nameof(buffer));
+            }
+            if (offset < 0 || count < 0 || offset > buffer.Length - count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+
+            _buffer = buffer;
+            _position = offset;
+            _end = offset + count;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the current position within the source buffer.
+        /// </summary>
+        /// <value>
+        /// The position.
+        /// </value>
+        public int Position => _position;
+
+        /// <summary>
+        /// Gets the number of bytes remaining in the source region.
+        /// </summary>
+        /// <value>
+        /// The remaining byte count.
+        /// </value>
+        public int Remaining => _end - _position;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Reads a byte.
+        /// </summary>
+        /// <returns>The value.</returns>
+        public byte ReadByte()
+        {
+            EnsureAvailable(1);
+            return _buffer[_position++];
+        }
+
+        /// <summary>
+        /// Reads a 16-bit unsigned integer.
+        /// </summary>
+        /// <returns>The value.</returns>
+        public ushort ReadUInt16()
+        {
+            EnsureAvailable(2);
+            var value = (ushort)(_buffer[_position] | (_buffer[_position + 1] << 8));
+            _position += 2;
+            return value;
+        }
+
+        /// <summary>
+        /// Reads a 32-bit unsigned integer.
+        /// </summary>
+        /// <returns>The value.</returns>
+        public uint ReadUInt32()
+        {
+            EnsureAvailable(4);
+            var value = (uint)(
+                _buffer[_position] |
+                (_buffer[_position + 1] << 8) |
+                (_buffer[_position + 2] << 16) |
+                (_buffer[_position + 3] << 24));
+            _position += 4;
+            return value;
+        }
+
+        /// <summary>
+        /// Reads a 64-bit unsigned integer.
+        /// </summary>
+        /// <returns>The value.</returns>
+        public ulong ReadUInt64()
+        {
+            var low = ReadUInt32();
+            var high = ReadUInt32();
+            return ((ulong)high << 32) | low;
+        }
+
+        /// <summary>
+        /// Reads a 64-bit signed integer.
+        /// </summary>
+        /// <returns>The value.</returns>
+        public long ReadInt64()
+        {
+            return (long)ReadUInt64();
+        }
+
+        /// <summary>
+        /// Reads bytes into the start of the specified array.
+        /// </summary>
+        /// <param name="destination">The destination array.</param>
+        /// <param name="count">The number of bytes to read.</param>
+        public void ReadBytes(byte[] destination, int count)
+        {
+            EnsureAvailable(count);
+            Buffer.BlockCopy(_buffer, _position, destination, 0, count);
+            _position += count;
+        }
+
+        /// <summary>
+        /// Skips the specified number of bytes.
+        /// </summary>
+        /// <param name="count">The number of bytes to skip.</param>
+        public void Skip(int count)
+        {
+            EnsureAvailable(count);
+            _position += count;
+        }
+        #endregion
+
+        #region Private Methods
+        private void EnsureAvailable(int count)
+        {
+            if (count < 0 || count > _end - _position)
+            {
+                throw new EndOfStreamException();
+            }
+        }
+        #endregion
+    }
+}
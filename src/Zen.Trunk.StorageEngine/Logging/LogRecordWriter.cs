@@ -0,0 +1,148 @@
+using System;
+
+namespace Zen.Trunk.Storage.Logging
+{
+    /// <summary>
+    /// <c>LogRecordWriter</c> encodes log records directly into a log block
+    /// buffer.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The encoding is byte-for-byte identical to that produced by writing
+    /// a <see cref="LogEntry"/> through a <see cref="Zen.Trunk.IO.SwitchingBinaryWriter"/>
+    /// (little-endian, no padding) however no streams or intermediate
+    /// buffers are created.
+    /// </para>
+    /// <para>
+    /// This is a mutable value type and must be passed by reference.
+    /// </para>
+    /// </remarks>
+    public struct LogRecordWriter
+    {
+        #region Private Fields
+        private readonly byte[] _buffer;
+        private readonly int _end;
+        private int _position;
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LogRecordWriter"/> struct.
+        /// </summary>
+        /// <param name="buffer">The target buffer.</param>
+        /// <param name="offset">The offset at which writing starts.</param>
+        /// <param name="count">The number of bytes available for writing.</param>
+        public LogRecordWriter(byte[] buffer, int offset, int count)
+        {
+            if (buffer == null)
+            {
+                throw new ArgumentNullException(nameof(buffer));
+            }
+            if (offset < 0 || count < 0 || offset > buffer.Length - count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+
+            _buffer = buffer;
+            _position = offset;
+            _end = offset + count;
+        }
+        #endregion
+
+        #region Public Properties
+        /// <summary>
+        /// Gets the current position within the target buffer.
+        /// </summary>
+        /// <value>
+        /// The position.
+        /// </value>
+        public int Position => _position;
+
+        /// <summary>
+        /// Gets the number of bytes remaining in the target buffer.
+        /// </summary>
+        /// <value>
+        /// The remaining byte count.
+        /// </value>
+        public int Remaining => _end - _position;
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Writes the specified byte.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        public void WriteByte(byte value)
+        {
+            EnsureSpace(1);
+            _buffer[_position++] = value;
+        }
+
+        /// <summary>
+        /// Writes the specified 16-bit unsigned integer.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        public void WriteUInt16(ushort value)
+        {
+            EnsureSpace(2);
+            _buffer[_position++] = (byte)value;
+            _buffer[_position++] = (byte)(value >> 8);
+        }
+
+        /// <summary>
+        /// Writes the specified 32-bit unsigned integer.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        public void WriteUInt32(uint value)
+        {
+            EnsureSpace(4);
+            _buffer[_position++] = (byte)value;
+            _buffer[_position++] = (byte)(value >> 8);
+            _buffer[_position++] = (byte)(value >> 16);
+            _buffer[_position++] = (byte)(value >> 24);
+        }
+
+        /// <summary>
+        /// Writes the specified 64-bit unsigned integer.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        public void WriteUInt64(ulong value)
+        {
+            WriteUInt32((uint)value);
+            WriteUInt32((uint)(value >> 32));
+        }
+
+        /// <summary>
+        /// Writes the specified 64-bit signed integer.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        public void WriteInt64(long value)
+        {
+            WriteUInt64((ulong)value);
+        }
+
+        /// <summary>
+        /// Writes the specified region of a byte array.
+        /// </summary>
+        /// <param name="source">The source array.</param>
+        /// <param name="offset">The offset into the source array.</param>
+        /// <param name="count">The number of bytes to write.</param>
+        public void WriteBytes(byte[] source, int offset, int count)
+        {
+            EnsureSpace(count);
+            Buffer.BlockCopy(source, offset, _buffer, _position, count);
+            _position += count;
+        }
+        #endregion
+
+        #region Private Methods
+        private void EnsureSpace(int count)
+        {
+            if (count > _end - _position)
+            {
+                throw new InvalidOperationException("Log record does not fit in the log block.");
+            }
+        }
+        #endregion
+    }
+}
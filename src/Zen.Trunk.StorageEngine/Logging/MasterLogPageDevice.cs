@@ -57,7 +57,7 @@ namespace Zen.Trunk.Storage.Logging
             }
         }
 
-        private class WriteLogEntryRequest : TaskRequest<LogEntry, bool>
+        private class WriteLogEntryRequest : TaskRequest<LogEntry, Task>
         {
             public WriteLogEntryRequest(LogEntry entry)
                 : base(entry)
@@ -65,18 +65,64 @@ namespace Zen.Trunk.Storage.Logging
             }
         }
 
+        private class WriteStripeBlockRequest : TaskRequest<LogBlockBatch, bool>
+        {
+            public WriteStripeBlockRequest(LogBlockBatch batch)
+                : base(batch)
+            {
+            }
+        }
+
+        private class LogStripe
+        {
+            public LogStripe(DeviceId deviceId)
+            {
+                DeviceId = deviceId;
+            }
+
+            public DeviceId DeviceId { get; }
+
+            public ConcurrentExclusiveSchedulerPair Scheduler { get; } =
+                new ConcurrentExclusiveSchedulerPair(TaskScheduler.Default);
+
+            public ITargetBlock<WriteStripeBlockRequest> WriteBlockPort { get; set; }
+
+            public VirtualLogFileStream Stream { get; set; }
+
+            public Task LastWriteTask { get; set; } = CompletedTask.Default;
+
+            public bool IsFaulted { get; set; }
+        }
+
         private class PerformRecoveryRequest : TaskRequest<bool>
         {
         }
+
+        private delegate bool ReadLogRecord(out LogRecord record);
         #endregion
 
         #region Private Fields
         private readonly Dictionary<DeviceId, ILogPageDevice> _secondaryDevices =
             new Dictionary<DeviceId, ILogPageDevice>();
+        private readonly ConcurrentExclusiveSchedulerPair _taskInterleave =
+            new ConcurrentExclusiveSchedulerPair(TaskScheduler.Default);
 
         private VirtualLogFileStream _currentStream;
+        private List<LogStripe> _stripes;
+        private int _nextStripeIndex;
+        private readonly Dictionary<LogFileId, uint> _lastLogIdByFile =
+            new Dictionary<LogFileId, uint>();
+        private uint _beginCheckpointLogId;
+        private uint _checkpointLogId;
+        private readonly object _syncDelayedEntries = new object();
+        private List<LogEntry> _delayedEntries = new List<LogEntry>();
+        private long _delayedEntryBytes;
+        private long _unhardenedBytes;
+        private Timer _delayedFlushTimer;
         private Dictionary<ActiveTransaction, List<TransactionLogEntry>> _activeTransactions;
         private int _nextTransactionId;
+        private int _nextLogId;
+        private int _writeLogEntriesQueued;
         private DeviceId _nextLogDeviceId;
 
         private bool _trucateLog = false;
@@ -95,42 +141,42 @@ namespace Zen.Trunk.Storage.Logging
         public MasterLogPageDevice(string pathName)
             : base(DeviceId.Zero, pathName)
         {
-            var taskInterleave = new ConcurrentExclusiveSchedulerPair(TaskScheduler.Default);
             AddLogDevicePort = new TaskRequestActionBlock<AddLogDeviceRequest, Tuple<DeviceId, string>>(
                 request => AddLogDeviceHandlerAsync(request),
                 new ExecutionDataflowBlockOptions
                 {
-                    TaskScheduler = taskInterleave.ExclusiveScheduler
+                    TaskScheduler = _taskInterleave.ExclusiveScheduler
                 });
             RemoveLogDevicePort = new TaskRequestActionBlock<RemoveLogDeviceRequest, bool>(
                 request => RemoveLogDeviceHandlerAsync(request),
                 new ExecutionDataflowBlockOptions
                 {
-                    TaskScheduler = taskInterleave.ExclusiveScheduler
+                    TaskScheduler = _taskInterleave.ExclusiveScheduler
                 });
             ExpandLogDevicePort = new TaskRequestActionBlock<ExpandLogDeviceRequest, bool>(
                 request => ExpandLogDeviceHandlerAsync(request),
                 new ExecutionDataflowBlockOptions
                 {
-                    TaskScheduler = taskInterleave.ExclusiveScheduler
+                    TaskScheduler = _taskInterleave.ExclusiveScheduler
                 });
             TruncateLogDevicePort = new TaskRequestActionBlock<TruncateLogDeviceRequest, bool>(
                 request => TruncateLogDeviceHandlerAsync(request),
                 new ExecutionDataflowBlockOptions
                 {
-                    TaskScheduler = taskInterleave.ExclusiveScheduler
+                    TaskScheduler = _taskInterleave.ExclusiveScheduler
                 });
-            WriteLogEntryPort = new TaskRequestActionBlock<WriteLogEntryRequest, bool>(
-                request => WriteLogEntryHandler(request),
+            WriteLogEntryPort = new BufferBlock<WriteLogEntryRequest>();
+            WriteLogBatchPort = new ActionBlock<bool>(
+                _ => WriteLogEntriesHandler(),
                 new ExecutionDataflowBlockOptions
                 {
-                    TaskScheduler = taskInterleave.ExclusiveScheduler
+                    TaskScheduler = _taskInterleave.ExclusiveScheduler
                 });
             PerformRecoveryPort = new ActionBlock<PerformRecoveryRequest>(
                 request => PerformRecoveryHandlerAsync(request),
                 new ExecutionDataflowBlockOptions
                 {
-                    TaskScheduler = taskInterleave.ExclusiveScheduler
+                    TaskScheduler = _taskInterleave.ExclusiveScheduler
                 });
         }
         #endregion
@@ -150,18 +196,59 @@ namespace Zen.Trunk.Storage.Logging
         /// <value>
         /// The current log file offset.
         /// </value>
-        public uint CurrentLogFileOffset => (uint)_currentStream.Position;
+        public uint CurrentLogFileOffset => _currentStream.LogPosition;
+
+        /// <summary>
+        /// Gets or sets a value indicating whether log blocks are striped
+        /// across all log devices.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if the log is striped; otherwise, <c>false</c>.
+        /// </value>
+        /// <remarks>
+        /// <para>
+        /// When striped each log device keeps its own chain of virtual files
+        /// and successive log blocks are handed to each device in turn so
+        /// the devices are written in parallel. The log id stamped on each
+        /// block gives the global order and recovery merges the stripes
+        /// back together using a <see cref="StripedLogReader"/>.
+        /// </para>
+        /// <para>
+        /// This setting is persisted in the master root page and can only
+        /// be changed before the log is created.
+        /// </para>
+        /// </remarks>
+        /// <exception cref="InvalidOperationException">
+        /// The log device has already been opened.
+        /// </exception>
+        public bool IsStriped
+        {
+            get => GetRootPage<MasterLogRootPage>().IsStriped;
+            set
+            {
+                if (DeviceState != MountableDeviceState.Closed)
+                {
+                    throw new InvalidOperationException(
+                        "Log striping can only be changed before the log is created.");
+                }
+                GetRootPage<MasterLogRootPage>().IsStriped = value;
+            }
+        }
 
         /// <summary>
         /// Gets or sets the position.
         /// </summary>
         /// <value>
-        /// The position.
+        /// The log position within the current virtual file.
         /// </value>
+        /// <remarks>
+        /// Setting the position only affects where entries are next read
+        /// from; writes always append a new log block.
+        /// </remarks>
         public long Position
         {
-            get => _currentStream.Position;
-            set => _currentStream.Position = value;
+            get => _currentStream.LogPosition;
+            set => _currentStream.SeekLogPosition((uint)value);
         }
 
         /// <summary>
@@ -179,6 +266,39 @@ namespace Zen.Trunk.Storage.Logging
         /// <c>true</c> if this instance is truncating log; otherwise, <c>false</c>.
         /// </value>
         public bool IsTruncatingLog => _trucateLog;
+
+        /// <summary>
+        /// Gets the number of bytes of log entries that have been accepted
+        /// with delayed durability but not yet written to the log.
+        /// </summary>
+        /// <value>
+        /// The unhardened byte count.
+        /// </value>
+        public long UnhardenedBytes => Interlocked.Read(ref _unhardenedBytes);
+
+        /// <summary>
+        /// Gets or sets the maximum time a log entry written with delayed
+        /// durability is held in memory before being written to the log.
+        /// </summary>
+        /// <value>
+        /// The delayed durability flush interval.
+        /// </value>
+        /// <remarks>
+        /// This bounds the window of committed transactions that can be
+        /// lost if the process fails; changes take effect when the device
+        /// is next opened.
+        /// </remarks>
+        public TimeSpan DelayedFlushInterval { get; set; } = TimeSpan.FromMilliseconds(20);
+
+        /// <summary>
+        /// Gets or sets the number of bytes of delayed durability log
+        /// entries that can be held in memory before they are written to
+        /// the log without waiting for the flush interval.
+        /// </summary>
+        /// <value>
+        /// The delayed durability flush threshold.
+        /// </value>
+        public int DelayedFlushThreshold { get; set; } = 60 * 1024;
         #endregion
 
         #region Private Properties
@@ -190,7 +310,9 @@ namespace Zen.Trunk.Storage.Logging
 
         private ITargetBlock<TruncateLogDeviceRequest> TruncateLogDevicePort { get; }
 
-        private ITargetBlock<WriteLogEntryRequest> WriteLogEntryPort { get; }
+        private BufferBlock<WriteLogEntryRequest> WriteLogEntryPort { get; }
+
+        private ITargetBlock<bool> WriteLogBatchPort { get; }
 
         private ITargetBlock<PerformRecoveryRequest> PerformRecoveryPort { get; }
         #endregion
@@ -260,12 +382,62 @@ namespace Zen.Trunk.Storage.Logging
         /// <exception cref="BufferDeviceShuttingDownException"></exception>
         public Task WriteEntryAsync(LogEntry entry)
         {
-            var request = new WriteLogEntryRequest(entry);
-            if (!WriteLogEntryPort.Post(request))
+            return WriteEntryAsync(entry, false);
+        }
+
+        /// <summary>
+        /// Writes the entry optionally delaying durability.
+        /// </summary>
+        /// <param name="entry">The entry.</param>
+        /// <param name="delayDurability">
+        /// <c>true</c> to return as soon as the entry has been accepted into
+        /// the in-memory log buffer; <c>false</c> to wait until the entry has
+        /// been written to the log.
+        /// </param>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <remarks>
+        /// Delayed entries are written by a background flush at most
+        /// <see cref="DelayedFlushInterval"/> later. Writing an entry without
+        /// delayed durability writes all delayed entries ahead of it so log
+        /// order is always preserved.
+        /// </remarks>
+        /// <exception cref="BufferDeviceShuttingDownException"></exception>
+        public Task WriteEntryAsync(LogEntry entry, bool delayDurability)
+        {
+            lock (_syncDelayedEntries)
             {
-                throw new BufferDeviceShuttingDownException();
+                if (delayDurability)
+                {
+                    _delayedEntries.Add(entry);
+                    _delayedEntryBytes += entry.RawSize;
+                    Interlocked.Add(ref _unhardenedBytes, entry.RawSize);
+                    if (_delayedEntryBytes >= DelayedFlushThreshold)
+                    {
+                        PostDelayedEntries();
+                    }
+                    return CompletedTask.Default;
+                }
+
+                PostDelayedEntries();
+                return PostWriteEntry(entry);
+            }
+        }
+
+        /// <summary>
+        /// Writes all log entries held with delayed durability to the log.
+        /// </summary>
+        /// <returns>
+        /// A <see cref="Task"/> representing the asynchronous operation.
+        /// </returns>
+        /// <exception cref="BufferDeviceShuttingDownException"></exception>
+        public Task FlushDelayedEntriesAsync()
+        {
+            lock (_syncDelayedEntries)
+            {
+                return PostDelayedEntries();
             }
-            return request.Task;
         }
 
         /// <summary>
@@ -427,6 +599,10 @@ namespace Zen.Trunk.Storage.Logging
                 // Setup current log stream
                 _currentStream = GetVirtualFileStream(rootPage.StartLogFileId);
                 _currentStream.InitNew();
+                if (rootPage.IsStriped)
+                {
+                    InitStripes();
+                }
 
                 // Save root page
                 SaveRootPage();
@@ -450,9 +626,21 @@ namespace Zen.Trunk.Storage.Logging
                     .WhenAllOrEmpty(secondaryTasks.ToArray())
                     .ConfigureAwait(false);
 
-                // Open the current log file stream
-                _currentStream = GetVirtualFileStream(rootPage.StartLogFileId);
+                // Open the current log file stream (the start file may
+                //  precede the end file once the log has been truncated)
+                _currentStream = GetVirtualFileStream(rootPage.EndLogFileId);
+                if (rootPage.IsStriped)
+                {
+                    InitStripes();
+                }
             }
+
+            // Start background flush of delayed durability log entries
+            _delayedFlushTimer = new Timer(
+                state => ((MasterLogPageDevice)state).OnDelayedFlushTimer(),
+                this,
+                DelayedFlushInterval,
+                DelayedFlushInterval);
         }
 
         /// <summary>
@@ -463,6 +651,28 @@ namespace Zen.Trunk.Storage.Logging
         /// </returns>
         protected override async Task OnCloseAsync()
         {
+            // Harden entries written with delayed durability
+            _delayedFlushTimer?.Dispose();
+            _delayedFlushTimer = null;
+            await FlushDelayedEntriesAsync().ConfigureAwait(false);
+
+            // Wait for queued stripe writes to reach their devices
+            if (_stripes != null)
+            {
+                foreach (var stripe in _stripes)
+                {
+                    stripe.WriteBlockPort.Complete();
+                }
+                await Task
+                    .WhenAll(_stripes.Select(stripe => stripe.WriteBlockPort.Completion))
+                    .ConfigureAwait(false);
+                foreach (var stripe in _stripes)
+                {
+                    stripe.Scheduler.Complete();
+                }
+                _stripes = null;
+            }
+
             // Close secondary devices first
             foreach (var secondaryDevice in _secondaryDevices.Values)
             {
@@ -610,7 +820,33 @@ namespace Zen.Trunk.Storage.Logging
             // TODO: Add properties to request message that allow the 
             //  device and/or the number of growth pages to be set
             //  explicitly.
+            return ExpandLogDeviceCore();
+        }
+
+        // ReSharper disable once UnusedParameter.Local
+        private bool TruncateLogDeviceHandlerAsync(TruncateLogDeviceRequest request)
+        {
+            return TruncateLogCore();
+        }
 
+        /// <summary>
+        /// Expands the log by adding virtual log files to the first device
+        /// capable of growth.
+        /// </summary>
+        /// <param name="deviceId">
+        /// The device to expand or <c>null</c> to choose the device.
+        /// </param>
+        /// <returns>
+        /// <c>true</c> if the log was expanded; otherwise <c>false</c>.
+        /// </returns>
+        /// <remarks>
+        /// When the log is open the new virtual files are spliced into the
+        /// chain directly after the file currently being written so they are
+        /// the next to be used even if the log has already wrapped. When the
+        /// log is striped the new files join the stripe for their device.
+        /// </remarks>
+        private bool ExpandLogDeviceCore(DeviceId? deviceId = null)
+        {
             // Get sorted list of candidate expandable devices
             var candidateDevices = (new[] { (LogPageDevice)this }).Concat(
                     _secondaryDevices.Values)
@@ -621,275 +857,1098 @@ namespace Zen.Trunk.Storage.Logging
                             Device = device,
                             RootPage = device.GetRootPage<LogRootPage>()
                         })
-                .Where(candidate =>
-                    candidate.RootPage.IsExpandable &&
-                    candidate.RootPage.IsExpandableByPercent)
+                .Where(candidate => candidate.RootPage.IsExpandable &&
+                    (deviceId == null || candidate.Device.DeviceId == deviceId) &&
+                    (_stripes == null || GetStripe(candidate.Device.DeviceId) != null))
                 .Select(
                     candidate =>
                         new
                         {
                             candidate.Device,
                             candidate.RootPage,
-                            GrowthPages = candidate.RootPage.CalculateExpansionPageCount(),
+                            ExpandedPages = candidate.RootPage.CalculateExpansionPageCount(),
                         })
+                .Where(candidate => candidate.ExpandedPages > candidate.RootPage.AllocatedPages)
                 .OrderBy(candidate => candidate.RootPage.AllocatedPages);
 
             var masterRootPage = GetRootPage<MasterLogRootPage>();
             foreach (var candidate in candidateDevices)
             {
-                var result = candidate.Device.ExpandDeviceCore(
-                    masterRootPage, candidate.GrowthPages);
-                if (result.Any())
+                // Capture the chain position the new files will follow
+                var previousLastFileId = masterRootPage.LastLogFileId;
+                var afterFileId = GetStripe(candidate.Device.DeviceId)?.Stream.FileId ??
+                    _currentStream?.FileId ?? previousLastFileId;
+                var afterNextFileId = GetVirtualFileById(afterFileId).CurrentHeader.NextLogFileId;
+
+                // Once the log has wrapped the last file links back to the
+                //  head of the chain; open the ring so the device can chain
+                //  the new files onto the last file
+                var previousLastNextFileId = GetVirtualFileById(previousLastFileId).CurrentHeader.NextLogFileId;
+                if (previousLastNextFileId != LogFileId.Zero)
+                {
+                    SetNextLogFileId(previousLastFileId, LogFileId.Zero);
+                }
+
+                var result = candidate.Device
+                    .ExpandDeviceCore(
+                        masterRootPage,
+                        candidate.ExpandedPages - candidate.RootPage.AllocatedPages)
+                    .ToList();
+                if (result.Count > 0)
                 {
+                    LinkExpandedVirtualFiles(
+                        previousLastFileId, previousLastNextFileId, afterFileId, afterNextFileId, result);
+
                     // Save the master root page
                     SaveRootPage();
                     return true;
                 }
+
+                if (previousLastNextFileId != LogFileId.Zero)
+                {
+                    SetNextLogFileId(previousLastFileId, previousLastNextFileId);
+                }
             }
 
             return false;
         }
 
-#pragma warning disable CS1998 // Async method lacks 'await' operators and will run synchronously
-        // ReSharper disable once UnusedParameter.Local
-        private async Task<bool> TruncateLogDeviceHandlerAsync(TruncateLogDeviceRequest request)
-#pragma warning restore CS1998 // Async method lacks 'await' operators and will run synchronously
+        private void LinkExpandedVirtualFiles(
+            LogFileId previousLastFileId,
+            LogFileId previousLastNextFileId,
+            LogFileId afterFileId,
+            LogFileId afterNextFileId,
+            IList<VirtualLogFileInfo> addedFiles)
         {
-            // TODO Determine protected virtual files.
-            // TODO Mark all other files as unallocated.
-            // TODO For each device 
-            // TODO Skip devices without allocations.
-
-            // TODO find first free virtual file.
-
-            // TODO If this is the next file after protected block then skip.
+            var masterRootPage = GetRootPage<MasterLogRootPage>();
+            var firstAdded = addedFiles[0];
+            var lastAdded = addedFiles[addedFiles.Count - 1];
 
-            // TODO: Consider moving protected log to start of first file
-            //	unless we are in the first file (then don't bother)
+            // Undo the link made by the device when we are splicing into the
+            //  middle of the chain (the chain end does not change)
+            if (afterFileId != previousLastFileId)
+            {
+                SetNextLogFileId(previousLastFileId, previousLastNextFileId);
+                if (previousLastNextFileId != LogFileId.Zero)
+                {
+                    GetVirtualFileById(previousLastNextFileId).CurrentHeader.PreviousLogFileId =
+                        previousLastFileId;
+                }
+                masterRootPage.LastLogFileId = previousLastFileId;
+            }
 
-            // TODO Update 
+            // The new files take over the link that followed the target file
+            //  (this closes the ring again when the log has wrapped)
+            lastAdded.CurrentHeader.NextLogFileId = afterNextFileId;
+            if (afterNextFileId != LogFileId.Zero)
+            {
+                GetVirtualFileById(afterNextFileId).CurrentHeader.PreviousLogFileId =
+                    lastAdded.FileId;
+            }
 
-            return false;
+            // Link the new files after the target file (this also fixes up
+            //  the forward link when the new files live on another device)
+            SetNextLogFileId(afterFileId, firstAdded.FileId);
+            firstAdded.CurrentHeader.PreviousLogFileId = afterFileId;
         }
 
-        private Dictionary<TransactionId, List<TransactionLogEntry>> GetCheckPointTransactions()
+        private void SetNextLogFileId(LogFileId fileId, LogFileId nextFileId)
         {
-            // Read last reliable checkpoint record
-            var cpi = GetBestCheckpoint();
+            // Changes to the current file go via the stream so the header
+            //  is rewritten on the next flush
+            var stream = GetStripe(fileId.DeviceId)?.Stream ?? _currentStream;
+            if (stream != null && stream.FileId == fileId)
+            {
+                stream.NextLogFileId = nextFileId;
+            }
+            else
+            {
+                GetVirtualFileById(fileId).CurrentHeader.NextLogFileId = nextFileId;
+            }
+        }
 
-            // Determine first virtual file for check-point start.
-            _currentStream = GetVirtualFileStream(cpi.BeginLogFileId);
-            _currentStream.Position = cpi.BeginOffset;
+        /// <summary>
+        /// Marks as inactive all virtual log files that precede both the
+        /// last valid checkpoint and the first log record of the oldest
+        /// active transaction.
+        /// </summary>
+        /// <returns>
+        /// <c>true</c> if one or more virtual files were released for reuse;
+        /// otherwise <c>false</c>.
+        /// </returns>
+        private bool TruncateLogCore()
+        {
+            if (_currentStream == null || _isInRecovery)
+            {
+                return false;
+            }
 
-            // Create log reader
-            Dictionary<TransactionId, List<TransactionLogEntry>> transactionTable = null;
-            BeginCheckPointLogEntry startCheck = null;
-            EndCheckPointLogEntry endCheck = null;
-            while (endCheck == null)
+            _trucateLog = true;
+            try
             {
-                // Read begin checkpoint record and build list of transactions
-                var entry = _currentStream.ReadEntry();
-                if (entry.LogType == LogEntryType.BeginCheckpoint)
+                if (_stripes != null)
                 {
-                    if (startCheck != null)
-                    {
-                        throw new InvalidOperationException("Start checkpoint already found.");
-                    }
-                    startCheck = (BeginCheckPointLogEntry)entry;
+                    return TruncateStripedLogCore();
                 }
 
-                // Track end checkpoint to ensure we have full record
-                else if (entry.LogType == LogEntryType.EndCheckpoint)
+                // Determine the log positions that must be retained; the
+                //  current write position, the start of the best checkpoint
+                //  and the start of each active transaction.
+                var protectedFiles = new Dictionary<LogFileId, uint>();
+                ProtectLogPosition(protectedFiles, _currentStream.FileId, _currentStream.LogPosition);
+
+                var checkPoint = GetBestCheckpoint();
+                if (checkPoint != null)
                 {
-                    endCheck = (EndCheckPointLogEntry)entry;
+                    ProtectLogPosition(protectedFiles, checkPoint.BeginLogFileId, checkPoint.BeginOffset);
                 }
 
-                // Process all other entries
-                else if (entry.LogType != LogEntryType.NoOp)
+                if (_activeTransactions != null)
                 {
-                    var transEntry = (TransactionLogEntry)entry;
-
-                    // We should have a begin checkpoint.
-                    // We should not have an end checkpoint.
-
-                    if (transactionTable == null)
+                    foreach (var tran in _activeTransactions.Keys)
                     {
-                        transactionTable = new Dictionary<TransactionId, List<TransactionLogEntry>>();
+                        ProtectLogPosition(protectedFiles, tran.FileId, tran.FileOffset);
                     }
+                }
 
-                    // Create transaction array as required
-                    var transactionId = transEntry.TransactionId;
-                    if (!transactionTable.ContainsKey(transactionId))
+                // Walk the chain from the start of the active log releasing
+                //  each virtual file until we reach a protected file
+                var rootPage = GetRootPage<MasterLogRootPage>();
+                var totalFileCount = GetTotalVirtualFileCount();
+                var releasedFiles = new List<VirtualLogFileInfo>();
+                var fileId = rootPage.StartLogFileId;
+                uint offset;
+                while (!protectedFiles.TryGetValue(fileId, out offset))
+                {
+                    if (releasedFiles.Count >= totalFileCount)
                     {
-                        transactionTable.Add(transactionId, new List<TransactionLogEntry>());
+                        throw new StorageEngineException("Log virtual file chain is corrupt.");
                     }
 
-                    // Add entry to list in transaction table
-                    transactionTable[transactionId].Add(transEntry);
+                    var info = GetVirtualFileById(fileId);
+                    info.IsAllocated = false;
+                    info.IsFull = false;
+                    releasedFiles.Add(info);
+
+                    fileId = GetNextVirtualFileId(fileId);
                 }
-            }
 
-            // Final sanity check - we should have both checkpoint records
-            if (startCheck == null || endCheck == null)
+                if (releasedFiles.Count == 0)
+                {
+                    return false;
+                }
+
+                // Persist status changes on each affected log device
+                foreach (var deviceId in releasedFiles.Select(info => info.DeviceId).Distinct())
+                {
+                    if (deviceId != DeviceId)
+                    {
+                        SaveVirtualFileStatus(deviceId);
+                    }
+                }
+
+                // Move the start of the active log
+                rootPage.StartLogFileId = fileId;
+                rootPage.StartLogOffset = offset;
+                rootPage.SetDataDirty();
+                SaveRootPage();
+                return true;
+            }
+            finally
             {
-                throw new InvalidOperationException("No valid checkpoint information found.");
+                _trucateLog = false;
             }
-            return transactionTable;
         }
 
-        private bool WriteLogEntryHandler(WriteLogEntryRequest request)
+        private static void ProtectLogPosition(
+            Dictionary<LogFileId, uint> protectedFiles, LogFileId fileId, uint offset)
         {
-            // Sanity check
-            if (DeviceState != MountableDeviceState.Open)
+            if (!protectedFiles.TryGetValue(fileId, out var existingOffset) ||
+                offset < existingOffset)
             {
-                throw new DeviceException(DeviceId.Zero, "Not mounted!");
+                protectedFiles[fileId] = offset;
             }
+        }
 
-            var entry = request.Message;
-
-            // Update checkpoint records with active transaction list
-            if ((entry.LogType == LogEntryType.BeginCheckpoint ||
-                entry.LogType == LogEntryType.EndCheckpoint) &&
-                _activeTransactions != null && _activeTransactions.Count > 0)
+        /// <summary>
+        /// Marks as inactive the virtual log files in each stripe that only
+        /// hold entries preceding both the last valid checkpoint and the
+        /// first log record of the oldest active transaction.
+        /// </summary>
+        /// <returns>
+        /// <c>true</c> if one or more virtual files were released for reuse;
+        /// otherwise <c>false</c>.
+        /// </returns>
+        /// <remarks>
+        /// Positions in different stripes cannot be compared so the log id
+        /// of the last entry in each virtual file decides whether it can be
+        /// released.
+        /// </remarks>
+        private bool TruncateStripedLogCore()
+        {
+            if (!TryGetProtectedLogId(out var protectedLogId))
             {
-                // Update log entry with active transactions
-                var cple = entry as CheckPointLogEntry;
-                var tranlist = new List<ActiveTransaction>(
-                    _activeTransactions.Keys);
-                // ReSharper disable once PossibleNullReferenceException
-                cple.UpdateTransactions(tranlist);
+                return false;
             }
 
-            // Write log entry
-            WriteEntryCore(entry);
-
-            var rootPage = GetRootPage<MasterLogRootPage>();
-            var isWrapperEntry = false;
-            switch (entry.LogType)
+            var totalFileCount = GetTotalVirtualFileCount();
+            var releasedFiles = new List<VirtualLogFileInfo>();
+            foreach (var stripe in _stripes)
             {
-                case LogEntryType.BeginXact:
-                    // Update active transactions for begin/end transaction
-                    var beginXactEntry = entry as TransactionLogEntry;
-                    if (_activeTransactions == null)
+                // Walk the stripe from its oldest file releasing files until
+                //  we reach one holding entries that must be retained
+                var endFileId = stripe.Stream.FileId;
+                var fileId = GetNextVirtualFileId(endFileId);
+                for (var count = 0; fileId != endFileId; ++count)
+                {
+                    if (count >= totalFileCount)
                     {
-                        _activeTransactions = new Dictionary<ActiveTransaction, List<TransactionLogEntry>>();
+                        throw new StorageEngineException("Log virtual file chain is corrupt.");
                     }
-                    _activeTransactions.Add(
-                        new ActiveTransaction(
-                            // ReSharper disable once PossibleNullReferenceException
-                            beginXactEntry.TransactionId.Value,
-                            rootPage.EndLogFileId,
-                            rootPage.EndLogOffset,
-                            beginXactEntry.LogId),
-                        new List<TransactionLogEntry>());
-                    isWrapperEntry = true;
-                    break;
-                case LogEntryType.BeginCheckpoint:
-                case LogEntryType.EndCheckpoint:
-                    // Update root-page checkpoint info as needed
-                    rootPage.AddCheckPoint(
-                        rootPage.EndLogFileId,
-                        rootPage.EndLogOffset,
-                        entry.LogType == LogEntryType.BeginCheckpoint);
-                    _isInCheckpoint = entry.LogType == LogEntryType.BeginCheckpoint;
-                    _logEntriesSinceCheckpoint = 0;
-                    _bytesWrittenSinceCheckpoint = 0;
-                    isWrapperEntry = true;
-                    break;
-                case LogEntryType.RollbackXact:
-                case LogEntryType.CommitXact:
-                    // Remove active transaction on commit or rollback
-                    var finalXactEntry = entry as TransactionLogEntry;
-                    // ReSharper disable once PossibleNullReferenceException
-                    foreach (var tran in _activeTransactions.Keys.ToArray())
+
+                    var info = GetVirtualFileById(fileId);
+                    if (info.IsAllocated)
                     {
-                        // Is this the matching transaction?
-                        // ReSharper disable once PossibleNullReferenceException
-                        if (tran.TransactionId == finalXactEntry.TransactionId.Value)
+                        if (GetVirtualFileLastLogId(fileId) >= protectedLogId)
                         {
-                            // Remove the active transaction from the list
-                            _activeTransactions.Remove(tran);
                             break;
                         }
+
+                        info.IsAllocated = false;
+                        info.IsFull = false;
+                        _lastLogIdByFile.Remove(fileId);
+                        releasedFiles.Add(info);
                     }
-                    isWrapperEntry = true;
-                    break;
-                default:
-                    // Add transaction records to correct list
-                    if (entry is TransactionLogEntry)
-                    {
-                        var transactionEntry = entry as TransactionLogEntry;
-                        // ReSharper disable once PossibleNullReferenceException
-                        var tran = _activeTransactions.Keys
-                            .FirstOrDefault(item => item.TransactionId == transactionEntry.TransactionId.Value);
-                        if (tran != null)
-                        {
-                            // Add transaction entry to list
-                            _activeTransactions[tran].Add(transactionEntry);
-                        }
-                    }
-                    break;
+
+                    fileId = GetNextVirtualFileId(fileId);
+                }
             }
 
-            // Update root page with new information
-            rootPage.EndLogFileId = _currentStream.FileId;
-            rootPage.EndLogOffset = (uint)_currentStream.Position;
-            SaveRootPage();
+            if (releasedFiles.Count == 0)
+            {
+                return false;
+            }
 
-            // Update log entry count and total number of bytes written since
-            //  last checkpoint as required
-            if (!_isInCheckpoint && !isWrapperEntry)
+            // Persist status changes on each affected log device
+            foreach (var deviceId in releasedFiles.Select(info => info.DeviceId).Distinct())
             {
-                ++_logEntriesSinceCheckpoint;
-                _bytesWrittenSinceCheckpoint += entry.RawSize;
+                SaveVirtualFileStatus(deviceId);
             }
             return true;
         }
 
-        private void WriteEntryCore(LogEntry entry)
+        private bool TryGetProtectedLogId(out uint protectedLogId)
         {
-            var rootPage = GetRootPage<MasterLogRootPage>();
+            // Entries yet to be written are always retained
+            protectedLogId = (uint)_nextLogId + 1;
 
-            // Determine whether entry fits on current stream
-            var freeSpace = (uint)(_currentStream.Length - _currentStream.Position);
-            if (entry.RawSize > freeSpace)
+            if (_activeTransactions != null)
             {
-                // Determine next file id
-                var current = GetVirtualFileById(_currentStream.FileId);
-
-                // If the next file is zero then attempt to expand the log device
-                if (current.CurrentHeader.NextLogFileId == LogFileId.Zero)
+                foreach (var tran in _activeTransactions.Keys)
                 {
-                    //ExpandDevice();
+                    protectedLogId = Math.Min(protectedLogId, tran.FirstLogId);
+                }
+            }
+
+            var checkPoint = GetBestCheckpoint();
+            if (checkPoint != null)
+            {
+                // Checkpoints written before the log was opened must be
+                //  located on disk to discover their log id
+                if (_checkpointLogId == 0)
+                {
+                    var stream = GetVirtualFileStream(checkPoint.BeginLogFileId);
+                    stream.SeekLogPosition(checkPoint.BeginOffset);
+                    if (!stream.TryReadEntryInfo(out var info))
+                    {
+                        return false;
+                    }
+                    _checkpointLogId = info.LogId;
+                }
+                protectedLogId = Math.Min(protectedLogId, _checkpointLogId);
+            }
+            return true;
+        }
+
+        private uint GetVirtualFileLastLogId(LogFileId fileId)
+        {
+            // Log ids assigned since the log was opened are tracked in memory
+            //  as the stripe writes for them may still be queued
+            if (!_lastLogIdByFile.TryGetValue(fileId, out var lastLogId))
+            {
+                lastLogId = GetVirtualFileStream(fileId).GetLastLogId();
+                _lastLogIdByFile.Add(fileId, lastLogId);
+            }
+            return lastLogId;
+        }
+
+        private void SaveVirtualFileStatus(DeviceId deviceId)
+        {
+            if (deviceId == DeviceId)
+            {
+                GetRootPage<LogRootPage>().SetDataDirty();
+                SaveRootPage();
+            }
+            else
+            {
+                // Stripe writes may be using the device backing store
+                var secondaryDevice = _secondaryDevices[deviceId];
+                var secondaryRootPage = secondaryDevice.GetRootPage<LogRootPage>();
+                secondaryRootPage.SetDataDirty();
+                lock (secondaryDevice.SyncRoot)
+                {
+                    secondaryRootPage.Save();
+                }
+            }
+        }
+
+        private int GetTotalVirtualFileCount()
+        {
+            return GetRootPage<LogRootPage>().LogFileCount +
+                _secondaryDevices.Values.Sum(device => (int)device.GetRootPage<LogRootPage>().LogFileCount);
+        }
+
+        /// <summary>
+        /// Gets the virtual file that follows the specified file treating
+        /// the chain of virtual files as a circular list.
+        /// </summary>
+        /// <param name="fileId">The file identifier.</param>
+        /// <returns></returns>
+        private LogFileId GetNextVirtualFileId(LogFileId fileId)
+        {
+            var nextFileId = GetVirtualFileById(fileId).CurrentHeader.NextLogFileId;
+            if (nextFileId == LogFileId.Zero)
+            {
+                // Loop back to the first file on the primary log device (each
+                //  stripe loops back to the first file on its own device)
+                nextFileId = new LogFileId(_stripes != null ? fileId.DeviceId : DeviceId, 0);
+            }
+            return nextFileId;
+        }
+
+        private bool IsVirtualFileReusable(LogFileId currentFileId, LogFileId fileId)
+        {
+            return fileId != currentFileId &&
+                !GetVirtualFileById(fileId).IsAllocated;
+        }
+
+        /// <summary>
+        /// Determines the virtual file that will follow the current file,
+        /// truncating and then expanding the log as necessary.
+        /// </summary>
+        /// <param name="currentFileId">The file currently being written.</param>
+        /// <param name="nextFileId">The next file identifier.</param>
+        /// <returns>
+        /// <c>true</c> if a writable virtual file is available;
+        /// otherwise <c>false</c>.
+        /// </returns>
+        private bool TryGetNextWritableFileId(LogFileId currentFileId, out LogFileId nextFileId)
+        {
+            nextFileId = GetNextVirtualFileId(currentFileId);
+            if (IsVirtualFileReusable(currentFileId, nextFileId))
+            {
+                return true;
+            }
+
+            // Attempt to release virtual files that are no longer needed
+            if (TruncateLogCore())
+            {
+                nextFileId = GetNextVirtualFileId(currentFileId);
+                if (IsVirtualFileReusable(currentFileId, nextFileId))
+                {
+                    return true;
+                }
+            }
+
+            // Finally attempt to grow the log (a stripe can only grow onto
+            //  its own device)
+            if (ExpandLogDeviceCore(_stripes != null ? currentFileId.DeviceId : (DeviceId?)null))
+            {
+                nextFileId = GetNextVirtualFileId(currentFileId);
+                return IsVirtualFileReusable(currentFileId, nextFileId);
+            }
+
+            return false;
+        }
+
+        private void SeedNextLogId()
+        {
+            // Log ids must keep increasing across restarts so readers can
+            //  tell current log blocks from those left in recycled files.
+            //  The end of the log is scanned in full as its header may not
+            //  record the last block written.
+            var lastLogId = 0u;
+            var streams = _stripes?.Select(stripe => stripe.Stream) ?? new[] { _currentStream };
+            foreach (var stream in streams)
+            {
+                stream.SeekLogPosition(0);
+                while (stream.TryReadEntryInfo(out var info))
+                {
+                    lastLogId = Math.Max(lastLogId, info.LogId);
+                }
+            }
+
+            // Once the log has wrapped the end file need not hold the
+            //  highest log id so consider every active virtual file
+            foreach (var info in GetVirtualFiles().Where(info => info.IsAllocated))
+            {
+                lastLogId = Math.Max(lastLogId, GetVirtualFileStream(info.FileId).GetLastLogId());
+            }
+            _nextLogId = (int)Math.Max((uint)_nextLogId, lastLogId);
+        }
+
+        private IEnumerable<VirtualLogFileInfo> GetVirtualFiles()
+        {
+            var devices = new[] { (ILogPageDevice)this }.Concat(_secondaryDevices.Values);
+            foreach (var device in devices)
+            {
+                var rootPage = device.GetRootPage<LogRootPage>();
+                for (ushort index = 0; index < rootPage.LogFileCount; ++index)
+                {
+                    yield return rootPage.GetLogFile(index);
+                }
+            }
+        }
+
+        private Dictionary<TransactionId, List<LogRecord>> GetCheckPointTransactions()
+        {
+            // Read last reliable checkpoint record
+            var cpi = GetBestCheckpoint();
+
+            // Determine first virtual file for check-point start (a striped
+            //  log is read by merging the stripes from the checkpoint on)
+            ReadLogRecord readRecord;
+            if (_stripes != null)
+            {
+                readRecord = CreateStripedLogReader(cpi).TryReadRecord;
+            }
+            else
+            {
+                _currentStream = GetVirtualFileStream(cpi.BeginLogFileId);
+                _currentStream.SeekLogPosition(cpi.BeginOffset);
+                readRecord = _currentStream.TryReadRecord;
+            }
+
+            // Records are decoded as values so only the page images they
+            //  carry are allocated (from the page image pool)
+            Dictionary<TransactionId, List<LogRecord>> transactionTable = null;
+            var foundStartCheck = false;
+            var foundEndCheck = false;
+            while (!foundEndCheck)
+            {
+                // Read begin checkpoint record and build list of transactions
+                if (!readRecord(out var record))
+                {
+                    // Reached the last valid log block
+                    break;
+                }
+                if (record.LogType == LogEntryType.BeginCheckpoint)
+                {
+                    if (foundStartCheck)
+                    {
+                        throw new InvalidOperationException("Start checkpoint already found.");
+                    }
+                    foundStartCheck = true;
                 }
 
-                // If next file Id is still zero then die
-                // TODO If we are on minimal log setting then attempt to loop back to start
-                if (current.CurrentHeader.NextLogFileId == LogFileId.Zero)
+                // Track end checkpoint to ensure we have full record
+                else if (record.LogType == LogEntryType.EndCheckpoint)
+                {
+                    foundEndCheck = true;
+                }
+
+                // Process all other records
+                else if (record.IsTransactionRecord)
+                {
+                    // We should have a begin checkpoint.
+                    // We should not have an end checkpoint.
+
+                    if (transactionTable == null)
+                    {
+                        transactionTable = new Dictionary<TransactionId, List<LogRecord>>();
+                    }
+
+                    // Create transaction array as required
+                    if (!transactionTable.TryGetValue(record.TransactionId, out var transactionRecords))
+                    {
+                        transactionRecords = new List<LogRecord>();
+                        transactionTable.Add(record.TransactionId, transactionRecords);
+                    }
+
+                    // Add record to list in transaction table
+                    transactionRecords.Add(record);
+                }
+            }
+
+            // Final sanity check - we should have both checkpoint records
+            if (!foundStartCheck || !foundEndCheck)
+            {
+                ReleaseRecords(transactionTable);
+                throw new InvalidOperationException("No valid checkpoint information found.");
+            }
+            return transactionTable;
+        }
+
+        private StripedLogReader CreateStripedLogReader(CheckPointInfo cpi)
+        {
+            // Determine the log id of the begin checkpoint record
+            var stream = GetVirtualFileStream(cpi.BeginLogFileId);
+            stream.SeekLogPosition(cpi.BeginOffset);
+            if (!stream.TryReadEntryInfo(out var info))
+            {
+                throw new InvalidOperationException("No valid checkpoint information found.");
+            }
+            _checkpointLogId = info.LogId;
+
+            return new StripedLogReader(
+                _stripes.Select(stripe => ReadStripe(stripe, info.LogId)).ToList(),
+                info.LogId);
+        }
+
+        private IEnumerable<LogRecord> ReadStripe(LogStripe stripe, uint firstLogId)
+        {
+            // The oldest file in a stripe is the first allocated file that
+            //  follows the file currently being written
+            var endFileId = stripe.Stream.FileId;
+            var fileId = GetNextVirtualFileId(endFileId);
+            while (fileId != endFileId && !GetVirtualFileById(fileId).IsAllocated)
+            {
+                fileId = GetNextVirtualFileId(fileId);
+            }
+
+            // Read each file in turn through to the end of the stripe; only
+            //  records from the first log id on are decoded, files that end
+            //  before it are skipped entirely
+            while (true)
+            {
+                if (fileId == endFileId || GetVirtualFileLastLogId(fileId) >= firstLogId)
+                {
+                    var stream = GetVirtualFileStream(fileId);
+                    stream.SeekLogPosition(0);
+                    while (stream.TryPeekEntryInfo(out var info) && info.LogId < firstLogId)
+                    {
+                        stream.TryReadEntryInfo(out _);
+                    }
+
+                    while (stream.TryReadRecord(out var record))
+                    {
+                        yield return record;
+                    }
+                }
+
+                if (fileId == endFileId)
+                {
+                    yield break;
+                }
+                fileId = GetNextVirtualFileId(fileId);
+            }
+        }
+
+        private async Task RollForwardRecordsAsync(List<LogRecord> records)
+        {
+            var pageDevice = GetService<DatabaseDevice>();
+            foreach (var record in records)
+            {
+                await record
+                    .RollForward(pageDevice)
+                    .ConfigureAwait(false);
+            }
+        }
+
+        private async Task RollBackRecordsAsync(List<LogRecord> records)
+        {
+            // Records are undone in reverse order
+            var pageDevice = GetService<DatabaseDevice>();
+            for (var index = records.Count - 1; index >= 0; --index)
+            {
+                await records[index]
+                    .RollBack(pageDevice)
+                    .ConfigureAwait(false);
+            }
+        }
+
+        private static void ReleaseRecords(Dictionary<TransactionId, List<LogRecord>> transactionTable)
+        {
+            if (transactionTable == null)
+            {
+                return;
+            }
+
+            foreach (var record in transactionTable.Values.SelectMany(records => records))
+            {
+                record.Release();
+            }
+        }
+
+        private Task PostWriteEntry(LogEntry entry)
+        {
+            var request = new WriteLogEntryRequest(entry);
+            if (!WriteLogEntryPort.Post(request))
+            {
+                throw new BufferDeviceShuttingDownException();
+            }
+
+            // Entries are drained from the queue in batches so only one
+            //  batch write needs to be pending at any time
+            if (Interlocked.Exchange(ref _writeLogEntriesQueued, 1) == 0 &&
+                !WriteLogBatchPort.Post(true))
+            {
+                throw new BufferDeviceShuttingDownException();
+            }
+            return request.Task.Unwrap();
+        }
+
+        private Task PostDelayedEntries()
+        {
+            // Caller must hold the delayed entry lock so that the queued
+            //  entries reach the write port ahead of any later entry
+            if (_delayedEntries.Count == 0)
+            {
+                return CompletedTask.Default;
+            }
+
+            var entries = _delayedEntries;
+            _delayedEntries = new List<LogEntry>();
+            _delayedEntryBytes = 0;
+
+            var writeTasks = new Task[entries.Count];
+            for (var index = 0; index < entries.Count; ++index)
+            {
+                var rawSize = (long)entries[index].RawSize;
+                writeTasks[index] = PostWriteEntry(entries[index])
+                    .ContinueWith(
+                        task =>
+                        {
+                            Interlocked.Add(ref _unhardenedBytes, -rawSize);
+                            return task;
+                        },
+                        TaskContinuationOptions.ExecuteSynchronously)
+                    .Unwrap();
+            }
+            return Task.WhenAll(writeTasks);
+        }
+
+        private void OnDelayedFlushTimer()
+        {
+            try
+            {
+                FlushDelayedEntriesAsync().ContinueWith(
+                    task => task.Exception,
+                    TaskContinuationOptions.OnlyOnFaulted |
+                    TaskContinuationOptions.ExecuteSynchronously);
+            }
+            catch (BufferDeviceShuttingDownException)
+            {
+                // Entries are flushed by the close handler
+            }
+        }
+
+        private void WriteLogEntriesHandler()
+        {
+            // Further entries posted from here on need another pass
+            Interlocked.Exchange(ref _writeLogEntriesQueued, 0);
+            if (!WriteLogEntryPort.TryReceiveAll(out var requests))
+            {
+                return;
+            }
+
+            // Sanity check
+            if (DeviceState != MountableDeviceState.Open)
+            {
+                var error = new DeviceException(DeviceId.Zero, "Not mounted!");
+                foreach (var request in requests)
+                {
+                    request.TrySetException(error);
+                }
+                return;
+            }
+
+            // Entries queued while the previous batch was written are packed
+            //  into shared log blocks
+            var index = 0;
+            try
+            {
+                while (index < requests.Count)
+                {
+                    index = WriteLogEntryBatch(requests, index);
+                }
+            }
+            catch (Exception error)
+            {
+                for (; index < requests.Count; ++index)
+                {
+                    requests[index].TrySetException(error);
+                }
+            }
+        }
+
+        private int WriteLogEntryBatch(IList<WriteLogEntryRequest> requests, int startIndex)
+        {
+            // Gather entries until we reach a checkpoint record; checkpoint
+            //  records are written on their own so they capture every
+            //  transaction started by the entries ahead of them
+            var batch = new List<WriteLogEntryRequest>();
+            var entries = new List<LogEntry>();
+            var index = startIndex;
+            for (; index < requests.Count; ++index)
+            {
+                var request = requests[index];
+                var entry = request.Message;
+                if (entry.RawSize > VirtualLogFileStream.MaximumBlockPayload)
+                {
+                    request.TrySetException(new InvalidOperationException(
+                        "Log entry is too large for a log block."));
+                    continue;
+                }
+
+                var isCheckpoint =
+                    entry.LogType == LogEntryType.BeginCheckpoint ||
+                    entry.LogType == LogEntryType.EndCheckpoint;
+                if (isCheckpoint && entries.Count > 0)
+                {
+                    break;
+                }
+
+                // Update checkpoint records with active transaction list
+                if (isCheckpoint && _activeTransactions != null && _activeTransactions.Count > 0)
+                {
+                    var cple = entry as CheckPointLogEntry;
+                    var tranlist = new List<ActiveTransaction>(
+                        _activeTransactions.Keys);
+                    // ReSharper disable once PossibleNullReferenceException
+                    cple.UpdateTransactions(tranlist);
+                }
+
+                batch.Add(request);
+                entries.Add(entry);
+                if (isCheckpoint)
+                {
+                    ++index;
+                    break;
+                }
+            }
+
+            if (entries.Count == 0)
+            {
+                return index;
+            }
+
+            // Write log entries
+            IList<Task> writeTasks;
+            if (_stripes != null)
+            {
+                writeTasks = WriteStripedEntriesCore(entries);
+            }
+            else
+            {
+                var writtenCount = WriteEntriesCore(entries);
+                if (writtenCount < entries.Count)
+                {
+                    // Remaining entries are written to the next virtual file
+                    index = requests.IndexOf(batch[writtenCount]);
+                    batch.RemoveRange(writtenCount, batch.Count - writtenCount);
+                }
+                writeTasks = Enumerable.Repeat(CompletedTask.Default, batch.Count).ToList();
+            }
+
+            // Release log space behind a completed checkpoint
+            if (entries[entries.Count - 1].LogType == LogEntryType.EndCheckpoint)
+            {
+                TruncateLogCore();
+            }
+
+            // Update root page with new information
+            var rootPage = GetRootPage<MasterLogRootPage>();
+            rootPage.EndLogFileId = _currentStream.FileId;
+            rootPage.EndLogOffset = CurrentLogFileOffset;
+            SaveRootPage();
+
+            for (var requestIndex = 0; requestIndex < batch.Count; ++requestIndex)
+            {
+                batch[requestIndex].TrySetResult(writeTasks[requestIndex]);
+            }
+            return index;
+        }
+
+        private void OnLogEntryWritten(LogEntry entry, LogFileId fileId, uint logPosition)
+        {
+            var rootPage = GetRootPage<MasterLogRootPage>();
+            var isWrapperEntry = false;
+            switch (entry.LogType)
+            {
+                case LogEntryType.BeginXact:
+                    // Update active transactions for begin/end transaction
+                    var beginXactEntry = entry as TransactionLogEntry;
+                    if (_activeTransactions == null)
+                    {
+                        _activeTransactions = new Dictionary<ActiveTransaction, List<TransactionLogEntry>>();
+                    }
+                    _activeTransactions.Add(
+                        new ActiveTransaction(
+                            // ReSharper disable once PossibleNullReferenceException
+                            beginXactEntry.TransactionId.Value,
+                            fileId,
+                            logPosition,
+                            beginXactEntry.LogId),
+                        new List<TransactionLogEntry>());
+                    isWrapperEntry = true;
+                    break;
+                case LogEntryType.BeginCheckpoint:
+                case LogEntryType.EndCheckpoint:
+                    // Update root-page checkpoint info as needed
+                    rootPage.AddCheckPoint(
+                        fileId,
+                        logPosition,
+                        entry.LogType == LogEntryType.BeginCheckpoint);
+                    _isInCheckpoint = entry.LogType == LogEntryType.BeginCheckpoint;
+                    if (_isInCheckpoint)
+                    {
+                        _beginCheckpointLogId = entry.LogId;
+                    }
+                    else
+                    {
+                        _checkpointLogId = _beginCheckpointLogId;
+                    }
+                    _logEntriesSinceCheckpoint = 0;
+                    _bytesWrittenSinceCheckpoint = 0;
+                    isWrapperEntry = true;
+                    break;
+                case LogEntryType.RollbackXact:
+                case LogEntryType.CommitXact:
+                    // Remove active transaction on commit or rollback
+                    var finalXactEntry = entry as TransactionLogEntry;
+                    // ReSharper disable once PossibleNullReferenceException
+                    foreach (var tran in _activeTransactions.Keys.ToArray())
+                    {
+                        // Is this the matching transaction?
+                        // ReSharper disable once PossibleNullReferenceException
+                        if (tran.TransactionId == finalXactEntry.TransactionId.Value)
+                        {
+                            // Remove the active transaction from the list
+                            _activeTransactions.Remove(tran);
+                            break;
+                        }
+                    }
+                    isWrapperEntry = true;
+                    break;
+                default:
+                    // Add transaction records to correct list
+                    if (entry is TransactionLogEntry)
+                    {
+                        var transactionEntry = entry as TransactionLogEntry;
+                        // ReSharper disable once PossibleNullReferenceException
+                        var tran = _activeTransactions.Keys
+                            .FirstOrDefault(item => item.TransactionId == transactionEntry.TransactionId.Value);
+                        if (tran != null)
+                        {
+                            // Add transaction entry to list
+                            _activeTransactions[tran].Add(transactionEntry);
+                        }
+                    }
+                    break;
+            }
+
+            // Update log entry count and total number of bytes written since
+            //  last checkpoint as required
+            if (!_isInCheckpoint && !isWrapperEntry)
+            {
+                ++_logEntriesSinceCheckpoint;
+                _bytesWrittenSinceCheckpoint += entry.RawSize;
+            }
+        }
+
+        /// <summary>
+        /// Writes as many of the specified entries as will fit into the
+        /// current virtual file, moving to the next file first when none fit.
+        /// </summary>
+        /// <param name="entries">The entries.</param>
+        /// <returns>
+        /// The number of entries written.
+        /// </returns>
+        private int WriteEntriesCore(IList<LogEntry> entries)
+        {
+            // Determine whether entries fit on current stream
+            var count = _currentStream.GetEntriesThatFit(entries);
+            if (count == 0)
+            {
+                // Determine next file id; this will loop back to the start
+                //  of the chain to reuse truncated files and will expand the
+                //  log device when no inactive file is available
+                if (!TryGetNextWritableFileId(_currentStream.FileId, out var nextFileId))
                 {
                     // TODO: Throw correct exception type
                     throw new StorageEngineException("Log device is full");
                 }
 
-                var newStream = GetVirtualFileStream(current.CurrentHeader.NextLogFileId);
+                var newStream = GetVirtualFileStream(nextFileId);
 
-                // Chain new file to old
+                // Chain new file to old (when we loop back this closes the
+                //  chain into a ring so it can be walked in both directions)
                 _currentStream.IsFull = true;
                 _currentStream.NextLogFileId = newStream.FileId;
-                _currentStream.Flush();
                 newStream.PreviousLogFileId = _currentStream.FileId;
+                _currentStream.Flush();
 
                 // Update current stream
                 _currentStream = newStream;
                 _currentStream.InitNew();
-                _currentStream.Position = 0;
+
+                // Make sure the following file is ready ahead of time so the
+                //  next switch does not stall on truncation or growth
+                TryGetNextWritableFileId(_currentStream.FileId, out _);
+
+                count = _currentStream.GetEntriesThatFit(entries);
+                if (count == 0)
+                {
+                    throw new StorageEngineException("Log entry is too large for a virtual log file.");
+                }
             }
 
-            // Update last log position
-            rootPage.EndLogFileId = _currentStream.FileId;
-            rootPage.EndLogOffset = (uint)_currentStream.Position;
+            // Allocate log ids now the space is secured so a failed write
+            //  never leaves a gap in the sequence
+            var writeEntries = count == entries.Count ? entries : entries.Take(count).ToList();
+            foreach (var entry in writeEntries)
+            {
+                entry.LogId = (uint)Interlocked.Increment(ref _nextLogId);
+            }
+
+            // Write entries and update last log position
+            var logPositions = new List<uint>(count);
+            _currentStream.WriteEntries(writeEntries, logPositions);
+            for (var index = 0; index < count; ++index)
+            {
+                OnLogEntryWritten(writeEntries[index], _currentStream.FileId, logPositions[index]);
+            }
+            return count;
+        }
+
+        /// <summary>
+        /// Deals the specified entries out to the stripes one log block at
+        /// a time.
+        /// </summary>
+        /// <param name="entries">The entries.</param>
+        /// <returns>
+        /// A task for each entry that completes once the entry and every
+        /// entry ahead of it have been written.
+        /// </returns>
+        private IList<Task> WriteStripedEntriesCore(IList<LogEntry> entries)
+        {
+            var writeTasks = new List<Task>(entries.Count);
+            var index = 0;
+            while (index < entries.Count)
+            {
+                // Hand the next block of entries to the next stripe in turn
+                var stripe = _stripes[_nextStripeIndex];
+                _nextStripeIndex = (_nextStripeIndex + 1) % _stripes.Count;
 
-            _currentStream.WriteEntry(entry);
+                var count = WriteStripedEntriesCore(stripe, entries, index);
+                var writeTask = GetStripedWriteTask();
+                for (var entryIndex = 0; entryIndex < count; ++entryIndex)
+                {
+                    writeTasks.Add(writeTask);
+                }
+                index += count;
+            }
+            return writeTasks;
+        }
+
+        private int WriteStripedEntriesCore(LogStripe stripe, IList<LogEntry> entries, int startIndex)
+        {
+            // Determine how many entries fit in one block on this stripe
+            var count = stripe.Stream.GetEntriesThatFit(entries, startIndex, 1);
+            if (count == 0)
+            {
+                SwitchStripeFile(stripe);
+                count = stripe.Stream.GetEntriesThatFit(entries, startIndex, 1);
+                if (count == 0)
+                {
+                    throw new StorageEngineException("Log entry is too large for a virtual log file.");
+                }
+            }
+
+            // Allocate log ids now the space is secured so a failed write
+            //  never leaves a gap in the sequence
+            for (var index = startIndex; index < startIndex + count; ++index)
+            {
+                entries[index].LogId = (uint)Interlocked.Increment(ref _nextLogId);
+            }
+
+            // Encode and compress the block here so log positions are known
+            //  before the stripe writes it
+            var logPositions = new List<uint>(count);
+            var batch = stripe.Stream.PrepareEntries(entries, startIndex, count, logPositions);
+            var request = new WriteStripeBlockRequest(batch);
+            if (!stripe.WriteBlockPort.Post(request))
+            {
+                throw new BufferDeviceShuttingDownException();
+            }
+            stripe.LastWriteTask = request.Task;
+
+            var fileId = stripe.Stream.FileId;
+            for (var index = 0; index < count; ++index)
+            {
+                OnLogEntryWritten(entries[startIndex + index], fileId, logPositions[index]);
+            }
+            _lastLogIdByFile[fileId] = entries[startIndex + count - 1].LogId;
+            _currentStream = stripe.Stream;
+            return count;
+        }
+
+        private Task GetStripedWriteTask()
+        {
+            // Stripes write their blocks in order so an entry has been written
+            //  along with every entry ahead of it once the last block queued
+            //  on each stripe has been written; recovery stops at the first
+            //  gap so reporting it any sooner could lose a committed entry
+            return Task.WhenAll(_stripes.Select(stripe => stripe.LastWriteTask));
+        }
+
+        private void SwitchStripeFile(LogStripe stripe)
+        {
+            // Determine next file id within the chain for this stripe
+            if (!TryGetNextWritableFileId(stripe.Stream.FileId, out var nextFileId))
+            {
+                // TODO: Throw correct exception type
+                throw new StorageEngineException("Log device is full");
+            }
+
+            var newStream = GetVirtualFileStream(nextFileId);
+
+            // Chain new file to old; any writes still queued for the old
+            //  file carry their own stream so they are unaffected
+            stripe.Stream.IsFull = true;
+            stripe.Stream.NextLogFileId = newStream.FileId;
+            newStream.PreviousLogFileId = stripe.Stream.FileId;
+            stripe.Stream.Flush();
+
+            // Update stripe stream
+            newStream.InitNew();
+            stripe.Stream = newStream;
+            SaveVirtualFileStatus(stripe.DeviceId);
+
+            // Make sure the following file is ready ahead of time
+            TryGetNextWritableFileId(newStream.FileId, out _);
+        }
+
+        private bool WriteStripeBlockHandler(LogStripe stripe, WriteStripeBlockRequest request)
+        {
+            // Blocks queued behind a failed write would leave a hole in the
+            //  stripe so they are failed too
+            if (stripe.IsFaulted)
+            {
+                throw new StorageEngineException("Log stripe write failed.");
+            }
+
+            try
+            {
+                request.Message.Stream.WriteBatch(request.Message);
+            }
+            catch
+            {
+                stripe.IsFaulted = true;
+                throw;
+            }
+            return true;
         }
 
         private async Task PerformRecoveryHandlerAsync(PerformRecoveryRequest request)
@@ -902,13 +1961,20 @@ namespace Zen.Trunk.Storage.Logging
             }
 
             _isInRecovery = true;
+            Dictionary<TransactionId, List<LogRecord>> transactionTable = null;
             try
             {
                 var workDone = false;
                 List<TransactionId> rollbackList = null;
 
                 // Process each transaction
-                var transactionTable = GetCheckPointTransactions();
+                transactionTable = GetCheckPointTransactions();
+
+                // Reading the checkpoint moves the current stream so restore
+                //  the write position to the end of the log
+                _currentStream = GetVirtualFileStream(
+                    GetRootPage<MasterLogRootPage>().EndLogFileId);
+                SeedNextLogId();
                 if (transactionTable != null)
                 {
                     foreach (var tranList in transactionTable.Values.Where(tl => tl.Count > 0))
@@ -917,14 +1983,14 @@ namespace Zen.Trunk.Storage.Logging
                         //	can be committed.
                         if (tranList[tranList.Count - 1].LogType == LogEntryType.CommitXact)
                         {
-                            await CommitTransactionsAsync(tranList).ConfigureAwait(false);
+                            await RollForwardRecordsAsync(tranList).ConfigureAwait(false);
                             workDone = true;
                         }
 
                         // Everything else must be rolled back
                         else
                         {
-                            await RollbackTransactionsAsync(tranList).ConfigureAwait(false);
+                            await RollBackRecordsAsync(tranList).ConfigureAwait(false);
 
                             // For implicit rollbacks we need to ensure we write an explicit
                             //	rollback record to the log at the end of recovery
@@ -967,6 +2033,7 @@ namespace Zen.Trunk.Storage.Logging
             }
             finally
             {
+                ReleaseRecords(transactionTable);
                 _isInRecovery = false;
             }
         }
@@ -1012,13 +2079,74 @@ namespace Zen.Trunk.Storage.Logging
             // Init file info for primary device
             var lastFileInfo = InitVirtualFileForDevice(rootPage, null);
 
-            // Init file info for secondary devices chaining previous file info objects
+            // Init file info for secondary devices chaining previous file info
+            //  objects (when striped each device has a chain of its own)
             foreach (var device in _secondaryDevices.Values)
             {
-                lastFileInfo = device.InitVirtualFileForDevice(rootPage, lastFileInfo);
+                lastFileInfo = device.InitVirtualFileForDevice(
+                    rootPage, rootPage.IsStriped ? null : lastFileInfo);
             }
         }
 
+        /// <summary>
+        /// Initialises a stripe for each log device that has virtual files.
+        /// </summary>
+        /// <remarks>
+        /// Log blocks are prepared by the write handler and handed to the
+        /// stripe for writing. Each stripe writes its blocks in order on a
+        /// scheduler of its own so stripes write in parallel with each other
+        /// and with the preparation of later blocks.
+        /// </remarks>
+        private void InitStripes()
+        {
+            var devices = new[] { (ILogPageDevice)this }
+                .Concat(_secondaryDevices.Values.OrderBy(device => device.DeviceId))
+                .Where(device => device.GetRootPage<LogRootPage>().LogFileCount > 0);
+
+            _stripes = new List<LogStripe>();
+            foreach (var device in devices)
+            {
+                var stripe = new LogStripe(device.DeviceId);
+                stripe.WriteBlockPort = new TaskRequestActionBlock<WriteStripeBlockRequest, bool>(
+                    request => WriteStripeBlockHandler(stripe, request),
+                    new ExecutionDataflowBlockOptions
+                    {
+                        TaskScheduler = stripe.Scheduler.ExclusiveScheduler
+                    });
+
+                // Resume writing to the file left open on the device
+                var fileId = GetStripeEndFileId(device);
+                var stream = GetVirtualFileStream(fileId);
+                if (!GetVirtualFileById(fileId).IsAllocated)
+                {
+                    stream.InitNew();
+                    SaveVirtualFileStatus(device.DeviceId);
+                }
+                stripe.Stream = stream;
+                _stripes.Add(stripe);
+            }
+        }
+
+        private static LogFileId GetStripeEndFileId(ILogPageDevice device)
+        {
+            // The end of a stripe is the allocated file yet to be filled
+            var rootPage = device.GetRootPage<LogRootPage>();
+            for (ushort index = 0; index < rootPage.LogFileCount; ++index)
+            {
+                var info = rootPage.GetLogFile(index);
+                if (info.IsAllocated && !info.IsFull)
+                {
+                    return info.FileId;
+                }
+            }
+            return new LogFileId(device.DeviceId, 0);
+        }
+
+        private LogStripe GetStripe(DeviceId deviceId)
+        {
+            return _stripes?.FirstOrDefault(stripe => stripe.DeviceId == deviceId);
+        }
+
         private VirtualLogFileStream GetVirtualFileStream(LogFileId fileId)
         {
             // Get file info
@@ -18,6 +18,14 @@ namespace Zen.Trunk.Storage.Logging
     /// </summary>
     public class MasterLogRootPage : LogRootPage
     {
+        #region Public Constants
+        /// <summary>
+        /// The status bit indicating log blocks are striped across the log
+        /// devices.
+        /// </summary>
+        public const byte StatusIsStriped = 3;
+        #endregion
+
         #region Private Fields
         private readonly Dictionary<DeviceId, DeviceReferenceBufferFieldWrapper> _deviceById;
         private readonly List<DeviceReferenceBufferFieldWrapper> _devicesByIndex;
@@ -170,6 +178,32 @@ namespace Zen.Trunk.Storage.Logging
             }
         }
 
+        /// <summary>
+        /// Gets or sets a value indicating whether log blocks are striped
+        /// across all log devices.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> if the log is striped; otherwise, <c>false</c>.
+        /// </value>
+        /// <remarks>
+        /// When striped each log device maintains its own chain of virtual
+        /// files and log blocks are written to the devices in turn.
+        /// </remarks>
+        public bool IsStriped
+        {
+            get => (Status & (1 << StatusIsStriped)) != 0;
+            set
+            {
+                if (IsStriped != value)
+                {
+                    Status = value
+                        ? (byte)(Status | (1 << StatusIsStriped))
+                        : (byte)(Status & ~(1 << StatusIsStriped));
+                    SetHeaderDirty();
+                }
+            }
+        }
+
         /// <summary>
         /// Gets the check point history count.
         /// </summary>
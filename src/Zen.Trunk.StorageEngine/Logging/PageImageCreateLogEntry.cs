@@ -28,7 +28,7 @@ namespace Zen.Trunk.Storage.Logging
             long timestamp)
             : base(virtualPageId, timestamp, LogEntryType.CreatePage)
         {
-            _image = new byte[StorageConstants.PageBufferSize];
+            _image = PageImagePool.Rent();
 
             buffer.CopyTo(_image);
         }
@@ -57,6 +57,17 @@ namespace Zen.Trunk.Storage.Logging
 
         #endregion
 
+        #region Public Methods
+        /// <summary>
+        /// Returns the pooled page image held by this entry.
+        /// </summary>
+        public override void Release()
+        {
+            PageImagePool.Return(_image);
+            _image = null;
+        }
+        #endregion
+
         #region Protected Methods
         /// <summary>
         /// Writes the field chain to the specified stream manager.
@@ -78,6 +89,27 @@ namespace Zen.Trunk.Storage.Logging
             _image = reader.ReadBytes(StorageConstants.PageBufferSize);
         }
 
+        /// <summary>
+        /// Encodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="writer">The log record writer.</param>
+        protected override void OnEncode(ref LogRecordWriter writer)
+        {
+            base.OnEncode(ref writer);
+            writer.WriteBytes(_image, 0, StorageConstants.PageBufferSize);
+        }
+
+        /// <summary>
+        /// Decodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        protected override void OnDecode(ref LogRecordReader reader)
+        {
+            base.OnDecode(ref reader);
+            _image = PageImagePool.Rent();
+            reader.ReadBytes(_image, StorageConstants.PageBufferSize);
+        }
+
         /// <summary>
         /// <b>OnUndoChanges</b> is called during recovery to undo DataBuffer
         /// changes to the given page object.
@@ -89,17 +121,7 @@ namespace Zen.Trunk.Storage.Logging
         /// </remarks>
         protected override void OnUndoChanges(IPageBuffer dataBuffer)
         {
-            // Copy before image into page DataBuffer
-            using (var stream = dataBuffer.GetBufferStream(0, StorageConstants.PageBufferSize, false))
-            {
-                // NOTE: The before image in this case is empty
-                var initStream = new byte[StorageConstants.PageBufferSize];
-                stream.Write(initStream, 0, StorageConstants.PageBufferSize);
-                stream.Flush();
-            }
-
-            // Mark DataBuffer as dirty
-            dataBuffer.SetDirtyAsync();
+            WritePageImage(dataBuffer, null);
         }
 
         /// <summary>
@@ -113,15 +135,7 @@ namespace Zen.Trunk.Storage.Logging
         /// </remarks>
         protected override void OnRedoChanges(IPageBuffer dataBuffer)
         {
-            // Copy after image into page DataBuffer
-            using (var stream = dataBuffer.GetBufferStream(0, StorageConstants.PageBufferSize, false))
-            {
-                stream.Write(_image, 0, StorageConstants.PageBufferSize);
-                stream.Flush();
-            }
-
-            // Mark DataBuffer as dirty
-            dataBuffer.SetDirtyAsync();
+            WritePageImage(dataBuffer, _image);
         }
         #endregion
     }
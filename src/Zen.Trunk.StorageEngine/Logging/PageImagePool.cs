@@ -0,0 +1,48 @@
+using Zen.Trunk.CoordinationDataStructures;
+
+namespace Zen.Trunk.Storage.Logging
+{
+    /// <summary>
+    /// <c>PageImagePool</c> recycles the page-sized arrays used to hold
+    /// before and after images in page log entries.
+    /// </summary>
+    /// <remarks>
+    /// Images are returned once the owning transaction has completed so a
+    /// steady commit workload stops allocating fresh 8KB arrays for every
+    /// page it touches.
+    /// </remarks>
+    internal static class PageImagePool
+    {
+        #region Private Fields
+        private const int MaximumPooledImages = 256;
+
+        private static readonly ObjectPool<byte[]> FreeImages =
+            new ObjectPool<byte[]>(() => new byte[StorageConstants.PageBufferSize]);
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Gets a page image array from the pool.
+        /// </summary>
+        /// <returns>A page sized byte array.</returns>
+        public static byte[] Rent()
+        {
+            return FreeImages.GetObject();
+        }
+
+        /// <summary>
+        /// Returns a page image array to the pool.
+        /// </summary>
+        /// <param name="image">The image.</param>
+        public static void Return(byte[] image)
+        {
+            if (image != null &&
+                image.Length == StorageConstants.PageBufferSize &&
+                FreeImages.Count < MaximumPooledImages)
+            {
+                FreeImages.PutObject(image);
+            }
+        }
+        #endregion
+    }
+}
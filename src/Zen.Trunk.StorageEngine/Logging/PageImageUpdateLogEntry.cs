@@ -31,8 +31,8 @@ namespace Zen.Trunk.Storage.Logging
             long timestamp)
             : base(virtualPageId, timestamp, LogEntryType.ModifyPage)
         {
-            _beforeImage = new byte[StorageConstants.PageBufferSize];
-            _afterImage = new byte[StorageConstants.PageBufferSize];
+            _beforeImage = PageImagePool.Rent();
+            _afterImage = PageImagePool.Rent();
 
             before.CopyTo(_beforeImage);
             after.CopyTo(_afterImage);
@@ -69,6 +69,19 @@ namespace Zen.Trunk.Storage.Logging
         public byte[] AfterImage => _afterImage;
         #endregion
 
+        #region Public Methods
+        /// <summary>
+        /// Returns the pooled page images held by this entry.
+        /// </summary>
+        public override void Release()
+        {
+            PageImagePool.Return(_beforeImage);
+            PageImagePool.Return(_afterImage);
+            _beforeImage = null;
+            _afterImage = null;
+        }
+        #endregion
+
         #region Protected Methods
         /// <summary>
         /// Writes the field chain to the specified stream manager.
@@ -92,6 +105,30 @@ namespace Zen.Trunk.Storage.Logging
             _afterImage = reader.ReadBytes(StorageConstants.PageBufferSize);
         }
 
+        /// <summary>
+        /// Encodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="writer">The log record writer.</param>
+        protected override void OnEncode(ref LogRecordWriter writer)
+        {
+            base.OnEncode(ref writer);
+            writer.WriteBytes(_beforeImage, 0, StorageConstants.PageBufferSize);
+            writer.WriteBytes(_afterImage, 0, StorageConstants.PageBufferSize);
+        }
+
+        /// <summary>
+        /// Decodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        protected override void OnDecode(ref LogRecordReader reader)
+        {
+            base.OnDecode(ref reader);
+            _beforeImage = PageImagePool.Rent();
+            _afterImage = PageImagePool.Rent();
+            reader.ReadBytes(_beforeImage, StorageConstants.PageBufferSize);
+            reader.ReadBytes(_afterImage, StorageConstants.PageBufferSize);
+        }
+
         /// <summary>
         /// <b>OnUndoChanges</b> is called during recovery to undo DataBuffer
         /// changes to the given page object.
@@ -103,15 +140,7 @@ namespace Zen.Trunk.Storage.Logging
         /// </remarks>
         protected override void OnUndoChanges(IPageBuffer dataBuffer)
         {
-            // Copy before image into page DataBuffer
-            using (var stream = dataBuffer.GetBufferStream(0, StorageConstants.PageBufferSize, false))
-            {
-                stream.Write(_beforeImage, 0, StorageConstants.PageBufferSize);
-                stream.Flush();
-            }
-
-            // Mark DataBuffer as dirty
-            dataBuffer.SetDirtyAsync();
+            WritePageImage(dataBuffer, _beforeImage);
         }
 
         /// <summary>
@@ -125,15 +154,7 @@ namespace Zen.Trunk.Storage.Logging
         /// </remarks>
         protected override void OnRedoChanges(IPageBuffer dataBuffer)
         {
-            // Copy after image into page DataBuffer
-            using (var stream = dataBuffer.GetBufferStream(0, StorageConstants.PageBufferSize, false))
-            {
-                stream.Write(_afterImage, 0, StorageConstants.PageBufferSize);
-                stream.Flush();
-            }
-
-            // Mark DataBuffer as dirty
-            dataBuffer.SetDirtyAsync();
+            WritePageImage(dataBuffer, _afterImage);
         }
         #endregion
     }
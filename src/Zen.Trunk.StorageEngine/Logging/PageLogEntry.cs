@@ -20,6 +20,8 @@ namespace Zen.Trunk.Storage.Logging
     public abstract class PageLogEntry : TransactionLogEntry
     {
         #region Private Fields
+        private static readonly byte[] EmptyPageImage = new byte[StorageConstants.PageBufferSize];
+
         private readonly BufferFieldUInt64 _virtualPageId;
         private readonly BufferFieldInt64 _timestamp;
         #endregion
@@ -82,7 +84,7 @@ namespace Zen.Trunk.Storage.Logging
         /// <returns></returns>
         public override async Task RollBack(DatabaseDevice device)
         {
-            var page = await LoadPageFromDevice(device);
+            var page = await LoadPageAsync(device, VirtualPageId).ConfigureAwait(false);
 
             if (page.Timestamp != _timestamp.Value)
             {
@@ -98,7 +100,7 @@ namespace Zen.Trunk.Storage.Logging
         /// <returns></returns>
         public override async Task RollForward(DatabaseDevice device)
         {
-            var page = await LoadPageFromDevice(device);
+            var page = await LoadPageAsync(device, VirtualPageId).ConfigureAwait(false);
 
             if (page.Timestamp != _timestamp.Value)
             {
@@ -108,6 +110,28 @@ namespace Zen.Trunk.Storage.Logging
         #endregion
 
         #region Protected Methods
+        /// <summary>
+        /// Encodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="writer">The log record writer.</param>
+        protected override void OnEncode(ref LogRecordWriter writer)
+        {
+            base.OnEncode(ref writer);
+            writer.WriteUInt64(_virtualPageId.Value);
+            writer.WriteInt64(_timestamp.Value);
+        }
+
+        /// <summary>
+        /// Decodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        protected override void OnDecode(ref LogRecordReader reader)
+        {
+            base.OnDecode(ref reader);
+            _virtualPageId.Value = reader.ReadUInt64();
+            _timestamp.Value = reader.ReadInt64();
+        }
+
         /// <summary>
         /// <b>OnUndoChanges</b> is called during recovery to undo DataBuffer
         /// changes to the given page object.
@@ -131,13 +155,19 @@ namespace Zen.Trunk.Storage.Logging
         protected abstract void OnRedoChanges(IPageBuffer dataBuffer);
         #endregion
 
-        #region Private Methods
-        private async Task<IDataPage> LoadPageFromDevice(DatabaseDevice device)
+        #region Internal Methods
+        /// <summary>
+        /// Loads the page a page log record refers to for recovery.
+        /// </summary>
+        /// <param name="device">The device.</param>
+        /// <param name="virtualPageId">The virtual page identifier.</param>
+        /// <returns>The loaded page.</returns>
+        internal static async Task<IDataPage> LoadPageAsync(DatabaseDevice device, VirtualPageId virtualPageId)
         {
             var page = 
                 new DataPage
                 {
-                    VirtualPageId = VirtualPageId,
+                    VirtualPageId = virtualPageId,
                     FileGroupId = FileGroupId.Invalid
                 };
 
@@ -147,6 +177,23 @@ namespace Zen.Trunk.Storage.Logging
 
             return page;
         }
+
+        /// <summary>
+        /// Copies a page image into the page buffer and marks it dirty.
+        /// </summary>
+        /// <param name="dataBuffer">The page buffer.</param>
+        /// <param name="image">The page image or <c>null</c> for an empty page.</param>
+        internal static void WritePageImage(IPageBuffer dataBuffer, byte[] image)
+        {
+            using (var stream = dataBuffer.GetBufferStream(0, StorageConstants.PageBufferSize, false))
+            {
+                stream.Write(image ?? EmptyPageImage, 0, StorageConstants.PageBufferSize);
+                stream.Flush();
+            }
+
+            // Mark DataBuffer as dirty
+            dataBuffer.SetDirtyAsync();
+        }
         #endregion
     }
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace Zen.Trunk.Storage.Logging
+{
+    /// <summary>
+    /// <c>StripedLogReader</c> merges the log records read from each stripe
+    /// of a striped log back into a single sequence ordered by log id.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Records within a stripe are always written in ascending log id order
+    /// so the next record overall is simply the lowest of the records at the
+    /// head of each stripe.
+    /// </para>
+    /// <para>
+    /// Log ids are allocated without gaps so reading stops at the first
+    /// missing log id; any records beyond a gap were written to a stripe
+    /// that got ahead of the others and were never reported as written.
+    /// </para>
+    /// </remarks>
+    public class StripedLogReader
+    {
+        #region Private Fields
+        private readonly IEnumerator<LogRecord>[] _stripes;
+        private readonly LogRecord[] _heads;
+        private readonly bool[] _hasHead;
+        private uint _nextLogId;
+        #endregion
+
+        #region Public Constructors
+        /// <summary>
+        /// Initializes a new instance of the <see cref="StripedLogReader"/> class.
+        /// </summary>
+        /// <param name="stripes">The log records held by each stripe.</param>
+        /// <param name="firstLogId">
+        /// The log id of the first record to return; records with lower log
+        /// ids are skipped.
+        /// </param>
+        public StripedLogReader(IEnumerable<IEnumerable<LogRecord>> stripes, uint firstLogId)
+        {
+            if (stripes == null)
+            {
+                throw new ArgumentNullException(nameof(stripes));
+            }
+
+            _stripes = stripes.Select(stripe => stripe.GetEnumerator()).ToArray();
+            _heads = new LogRecord[_stripes.Length];
+            _hasHead = new bool[_stripes.Length];
+            _nextLogId = firstLogId;
+
+            // Prime the head of each stripe skipping records we don't need
+            for (var index = 0; index < _stripes.Length; ++index)
+            {
+                MoveNext(index);
+                while (_hasHead[index] && _heads[index].LogId < firstLogId)
+                {
+                    // Release skipped records so pooled page images are reclaimed
+                    _heads[index].Release();
+                    MoveNext(index);
+                }
+            }
+        }
+        #endregion
+
+        #region Public Methods
+        /// <summary>
+        /// Reads the next log record in log id order.
+        /// </summary>
+        /// <param name="record">The log record.</param>
+        /// <returns>
+        /// <c>true</c> if a record was read; <c>false</c> when there are no
+        /// further contiguous log records.
+        /// </returns>
+        public bool TryReadRecord(out LogRecord record)
+        {
+            var next = -1;
+            for (var index = 0; index < _heads.Length; ++index)
+            {
+                if (_hasHead[index] &&
+                    (next == -1 || _heads[index].LogId < _heads[next].LogId))
+                {
+                    next = index;
+                }
+            }
+
+            if (next == -1 || _heads[next].LogId != _nextLogId)
+            {
+                record = default(LogRecord);
+                return false;
+            }
+
+            record = _heads[next];
+            MoveNext(next);
+            ++_nextLogId;
+            return true;
+        }
+        #endregion
+
+        #region Private Methods
+        private void MoveNext(int index)
+        {
+            _hasHead[index] = _stripes[index].MoveNext();
+            _heads[index] = _hasHead[index] ? _stripes[index].Current : default(LogRecord);
+        }
+        #endregion
+    }
+}
@@ -69,6 +69,28 @@ namespace Zen.Trunk.Storage.Logging
         protected override BufferField LastField => _transactionId;
         #endregion
 
+        #region Protected Methods
+        /// <summary>
+        /// Encodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="writer">The log record writer.</param>
+        protected override void OnEncode(ref LogRecordWriter writer)
+        {
+            base.OnEncode(ref writer);
+            writer.WriteUInt32(_transactionId.Value);
+        }
+
+        /// <summary>
+        /// Decodes the fields of this entry that follow the log type.
+        /// </summary>
+        /// <param name="reader">The log record reader.</param>
+        protected override void OnDecode(ref LogRecordReader reader)
+        {
+            base.OnDecode(ref reader);
+            _transactionId.Value = reader.ReadUInt32();
+        }
+        #endregion
+
         #region Internal Methods
         internal void RewriteTransactionId(TransactionId transactionId)
         {
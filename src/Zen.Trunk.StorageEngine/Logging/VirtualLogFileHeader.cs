@@ -15,6 +15,7 @@ namespace Zen.Trunk.Storage.Logging
         private readonly BufferFieldUInt32 _cursor;
         private readonly BufferFieldLogFileId _previousLogFileId;
         private readonly BufferFieldLogFileId _nextLogFileId;
+        private readonly BufferFieldUInt32 _sequence;
         private readonly BufferFieldInt32 _hash;
         #endregion
 
@@ -29,7 +30,8 @@ namespace Zen.Trunk.Storage.Logging
             _cursor = new BufferFieldUInt32(_lastCursor);
             _previousLogFileId = new BufferFieldLogFileId(_cursor);
             _nextLogFileId = new BufferFieldLogFileId(_previousLogFileId);
-            _hash = new BufferFieldInt32(_nextLogFileId);
+            _sequence = new BufferFieldUInt32(_nextLogFileId);
+            _hash = new BufferFieldInt32(_sequence);
         }
         #endregion
 
@@ -94,6 +96,19 @@ namespace Zen.Trunk.Storage.Logging
             set => _cursor.Value = value;
         }
 
+        /// <summary>
+        /// Gets/sets the sequence number of the virtual file.
+        /// </summary>
+        /// <value>
+        /// The sequence number is incremented each time the virtual file is
+        /// reused and is stamped on every log block written to it.
+        /// </value>
+        public uint Sequence
+        {
+            get => _sequence.Value;
+            set => _sequence.Value = value;
+        }
+
         /// <summary>
         /// Gets/sets the header hash.
         /// </summary>
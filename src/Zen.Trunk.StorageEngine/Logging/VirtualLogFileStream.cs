@@ -1,5 +1,8 @@
 using System;
+using System.Collections.Generic;
 using System.IO;
+using System.IO.Compression;
+using Zen.Trunk.CoordinationDataStructures;
 using Zen.Trunk.IO;
 
 namespace Zen.Trunk.Storage.Logging
@@ -10,9 +13,37 @@ namespace Zen.Trunk.Storage.Logging
     /// </summary>
     /// <seealso cref="Stream" />
     /// <remarks>
-    /// Log streams maintain two header blocks and a set of log entries.
+    /// <para>
+    /// Log streams maintain two header blocks and a set of log blocks.
     /// The use of two headers allows the system to recover if a power failure occurs
     /// during writing of header data.
+    /// </para>
+    /// <para>
+    /// Each call to write entries produces a new log block aligned on a
+    /// <see cref="BlockAlignment"/> boundary and framed by a
+    /// <see cref="LogBlockHeader"/> carrying a CRC-32C checksum and the
+    /// range of log ids contained within. Blocks are never rewritten so a
+    /// torn write can only ever affect the last block and readers stop at
+    /// the last block that validates.
+    /// </para>
+    /// <para>
+    /// Every block is also stamped with the sequence number held in the
+    /// file header. The sequence number is incremented each time the file
+    /// is reused so blocks left over from an earlier use never validate.
+    /// </para>
+    /// <para>
+    /// Log positions handed out by this stream encode the block offset in
+    /// the upper bits and the index of the entry within the block in the
+    /// lower bits.
+    /// </para>
+    /// <para>
+    /// Writing is split into preparing a <see cref="LogBlockBatch"/>, which
+    /// encodes the blocks and reserves their space, and writing the batch.
+    /// Batches must be written in the order they were prepared but the
+    /// write may run on a different thread. All access to the backing
+    /// store is serialised through the sync root of the owning device as
+    /// every virtual file on a device shares the same backing store.
+    /// </para>
     /// </remarks>
     public class VirtualLogFileStream : Stream
     {
@@ -20,16 +51,39 @@ namespace Zen.Trunk.Storage.Logging
         /// <summary>
         /// The header size
         /// </summary>
-        public const int HeaderSize = 28;
+        public const int HeaderSize = 32;
 
         /// <summary>
         /// The total header size
         /// </summary>
         public const int TotalHeaderSize = HeaderSize * 2;
+
+        /// <summary>
+        /// The alignment of log blocks within the stream.
+        /// </summary>
+        public const int BlockAlignment = 512;
+
+        /// <summary>
+        /// The maximum size of a log block including header.
+        /// </summary>
+        public const int MaximumBlockSize = 60 * 1024;
+
+        /// <summary>
+        /// The maximum payload that will fit in a single log block.
+        /// </summary>
+        public const int MaximumBlockPayload = MaximumBlockSize - LogBlockHeader.HeaderSize;
+
+        /// <summary>
+        /// The maximum number of entries in a single log block.
+        /// </summary>
+        public const int MaximumEntriesPerBlock = BlockAlignment - 1;
         #endregion
 
         #region Private Fields
+        private const int MaximumPooledBatches = 8;
+
         private readonly object _syncWrite = new object();
+        private readonly object _syncIo;
         private readonly ILogPageDevice _device;
         private readonly VirtualLogFileInfo _logFileInfo;
         private readonly Stream _innerStream;
@@ -38,6 +92,26 @@ namespace Zen.Trunk.Storage.Logging
         private bool _writeFirstHeader = true;
         private bool _headerDirty;
         private long _position;
+
+        private bool _writeBlockValid;
+        private long _writeBlockStart;
+        private uint _writeLastCursor;
+        private byte[] _writeBlock;
+        private readonly ObjectPool<LogBlockBatch> _freeBatches;
+        private MemoryStream _compressStream;
+        private readonly LogBlockHeader _writeHeader = new LogBlockHeader();
+
+        private long _readBlockStart = -1;
+        private long _readBlockLength;
+        private uint _readLastLogId;
+        private byte[] _readBlock;
+        private byte[] _readPayload;
+        private byte[] _readData;
+        private int _readDataEnd;
+        private int _readCursor;
+        private int _readEntryCount;
+        private int _readIndex;
+        private readonly LogBlockHeader _readHeader = new LogBlockHeader();
         #endregion
 
         #region Public Constructors
@@ -54,7 +128,9 @@ namespace Zen.Trunk.Storage.Logging
             ILogPageDevice device, Stream backingStore, VirtualLogFileInfo logFileInfo)
         {
             _device = device;
+            _syncIo = device?.SyncRoot ?? new object();
             _logFileInfo = logFileInfo;
+            _freeBatches = new ObjectPool<LogBlockBatch>(() => new LogBlockBatch(this));
             _innerStream = backingStore;
             _streamReader = new SwitchingBinaryReader(backingStore, true);
             _streamWriter = new SwitchingBinaryWriter(backingStore, true);
@@ -108,6 +184,37 @@ namespace Zen.Trunk.Storage.Logging
             set => _logFileInfo.IsFull = value;
         }
 
+        /// <summary>
+        /// Gets or sets a value indicating whether blocks containing page
+        /// image log entries are compressed.
+        /// </summary>
+        /// <value>
+        /// <c>true</c> to compress page image blocks; otherwise, <c>false</c>.
+        /// </value>
+        /// <remarks>
+        /// Compression is only retained when it makes the block smaller.
+        /// </remarks>
+        public bool CompressPageImages { get; set; } = true;
+
+        /// <summary>
+        /// Gets the log position that will be assigned to the next entry
+        /// written to this stream.
+        /// </summary>
+        /// <value>
+        /// The log position.
+        /// </value>
+        public uint LogPosition
+        {
+            get
+            {
+                lock (_syncWrite)
+                {
+                    EnsureWriteBlockValid();
+                    return (uint)_writeBlockStart;
+                }
+            }
+        }
+
         /// <summary>
         /// Gets a boolean value indicating whether the owner 
         /// <see cref="T:LogPageDevice"/> is in recovery mode.
@@ -163,6 +270,19 @@ namespace Zen.Trunk.Storage.Logging
         #endregion
 
         #region Public Methods
+        /// <summary>
+        /// Gets the length of the uncompressed log block needed to hold a
+        /// single entry of the specified size.
+        /// </summary>
+        /// <param name="rawSize">The raw size of the log entry.</param>
+        /// <returns>
+        /// The aligned block length in bytes.
+        /// </returns>
+        public static uint GetBlockLength(uint rawSize)
+        {
+            return (uint)AlignBlockLength(LogBlockHeader.HeaderSize + rawSize);
+        }
+
         /// <summary>
         /// Initialises a new file stream.
         /// </summary>
@@ -170,15 +290,44 @@ namespace Zen.Trunk.Storage.Logging
         /// Marks this file stream as allocated and writes both headers to
         /// the underlying device before positioning the stream ready for
         /// writing.
+        /// When a virtual log file is reused after truncation the cursors
+        /// left over from the previous generation are discarded and the
+        /// sequence number is advanced past the one on disk.
         /// </remarks>
         public void InitNew()
         {
-            // Write header twice and flush
-            _logFileInfo.IsAllocated = true;
-            WriteHeader();
-            WriteHeader();
-            Flush();
-            Position = 0;
+            lock (_syncWrite)
+            {
+                lock (_syncIo)
+                {
+                    // Reset cursors (file may be recycled from an earlier generation)
+                    _logFileInfo.CurrentHeader.Cursor = 0;
+                    _logFileInfo.CurrentHeader.LastCursor = 0;
+                    _logFileInfo.CurrentHeader.Sequence = Math.Max(
+                        _logFileInfo.CurrentHeader.Sequence, ReadPersistedSequence()) + 1;
+                    _writeBlockStart = 0;
+                    _writeLastCursor = 0;
+                    _writeBlockValid = true;
+                    _readBlockStart = -1;
+                    _readEntryCount = 0;
+
+                    // Invalidate any block left at the start of a recycled file
+                    var firstBlockOffset = _logFileInfo.StartOffset + TotalHeaderSize;
+                    if (firstBlockOffset + LogBlockHeader.HeaderSize <= _innerStream.Length)
+                    {
+                        _innerStream.Position = firstBlockOffset;
+                        _innerStream.Write(new byte[LogBlockHeader.HeaderSize], 0, LogBlockHeader.HeaderSize);
+                    }
+
+                    // Write header twice and flush
+                    _logFileInfo.IsAllocated = true;
+                    _logFileInfo.IsFull = false;
+                    WriteHeader();
+                    WriteHeader();
+                    Flush();
+                    Position = 0;
+                }
+            }
         }
 
         /// <summary>
@@ -191,9 +340,105 @@ namespace Zen.Trunk.Storage.Logging
         /// </remarks>
         public void InitLoad()
         {
-            // Read headers and determine correct version
-            ReadHeaders();
-            Position = 0;
+            lock (_syncWrite)
+            {
+                // Read headers and determine correct version
+                ReadHeaders();
+                _writeBlockValid = false;
+                _readBlockStart = -1;
+                Position = 0;
+            }
+        }
+
+        /// <summary>
+        /// Determines how many of the specified entries can be written to
+        /// the remaining space in this stream.
+        /// </summary>
+        /// <param name="entries">The log entries.</param>
+        /// <param name="startIndex">The index of the first entry to consider.</param>
+        /// <param name="maximumBlocks">The maximum number of log blocks to fill.</param>
+        /// <returns>
+        /// The number of entries from <paramref name="startIndex"/> that
+        /// will fit.
+        /// </returns>
+        /// <remarks>
+        /// Entries are packed exactly as <see cref="PrepareEntries"/> packs
+        /// them; compression can only make blocks smaller so the
+        /// uncompressed block lengths are used.
+        /// </remarks>
+        public int GetEntriesThatFit(
+            IList<LogEntry> entries, int startIndex = 0, int maximumBlocks = int.MaxValue)
+        {
+            lock (_syncWrite)
+            {
+                EnsureWriteBlockValid();
+                var available = Length - _writeBlockStart;
+                var blockCount = 1;
+                var blockEntries = 0;
+                var blockPayload = 0L;
+                var count = 0;
+                for (var index = startIndex; index < entries.Count; ++index)
+                {
+                    var rawSize = entries[index].RawSize;
+                    if (blockEntries == MaximumEntriesPerBlock ||
+                        blockPayload + rawSize > MaximumBlockPayload)
+                    {
+                        if (blockCount == maximumBlocks)
+                        {
+                            break;
+                        }
+
+                        available -= AlignBlockLength(LogBlockHeader.HeaderSize + blockPayload);
+                        blockEntries = 0;
+                        blockPayload = 0;
+                        ++blockCount;
+                    }
+                    if (AlignBlockLength(LogBlockHeader.HeaderSize + blockPayload + rawSize) > available)
+                    {
+                        break;
+                    }
+
+                    blockPayload += rawSize;
+                    ++blockEntries;
+                    ++count;
+                }
+                return count;
+            }
+        }
+
+        /// <summary>
+        /// Determines whether an entry of the specified size can be written
+        /// to the remaining space in this stream.
+        /// </summary>
+        /// <param name="rawSize">The raw size of the log entry.</param>
+        /// <returns>
+        /// <c>true</c> if the entry will fit; otherwise, <c>false</c>.
+        /// </returns>
+        public bool HasSpaceFor(uint rawSize)
+        {
+            lock (_syncWrite)
+            {
+                EnsureWriteBlockValid();
+                return _writeBlockStart + GetBlockLength(rawSize) <= Length;
+            }
+        }
+
+        /// <summary>
+        /// Gets the log id of the last entry written to this stream.
+        /// </summary>
+        /// <returns>
+        /// The last log identifier or zero if the stream holds no valid
+        /// log blocks.
+        /// </returns>
+        public uint GetLastLogId()
+        {
+            lock (_syncWrite)
+            {
+                // Log blocks in flight are not reflected until written
+                var block = _writeBlock ?? (_writeBlock = new byte[MaximumBlockSize]);
+                var blockStart = _logFileInfo.CurrentHeader.LastCursor & ~(uint)(BlockAlignment - 1);
+                return TryReadBlock(blockStart, block, _writeHeader) ? _writeHeader.LastLogId : 0;
+            }
         }
 
         /// <summary>
@@ -202,51 +447,291 @@ namespace Zen.Trunk.Storage.Logging
         /// </summary>
         /// <param name="entry"><see cref="T:LogEntry"/> log entry to be 
         /// written.</param>
-        public void WriteEntry(LogEntry entry)
+        /// <returns>
+        /// The log position of the entry.
+        /// </returns>
+        public uint WriteEntry(LogEntry entry)
+        {
+            return WriteEntries(new[] { entry });
+        }
+
+        /// <summary>
+        /// Writes the specified <see cref="T:LogEntry"/> objects to the
+        /// log file stream packing them into as few log blocks as possible.
+        /// </summary>
+        /// <param name="entries">The log entries to be written.</param>
+        /// <returns>
+        /// The log position of the first entry.
+        /// </returns>
+        /// <exception cref="InvalidOperationException">
+        /// An entry is too large to fit in a log block or the stream is full.
+        /// </exception>
+        public uint WriteEntries(IList<LogEntry> entries)
+        {
+            return WriteEntries(entries, null);
+        }
+
+        /// <summary>
+        /// Writes the specified <see cref="T:LogEntry"/> objects to the
+        /// log file stream packing them into as few log blocks as possible.
+        /// </summary>
+        /// <param name="entries">The log entries to be written.</param>
+        /// <param name="logPositions">
+        /// When specified receives the log position of each entry.
+        /// </param>
+        /// <returns>
+        /// The log position of the first entry.
+        /// </returns>
+        /// <exception cref="InvalidOperationException">
+        /// An entry is too large to fit in a log block or the stream is full.
+        /// </exception>
+        public uint WriteEntries(IList<LogEntry> entries, IList<uint> logPositions)
+        {
+            var batch = PrepareEntries(entries, 0, entries.Count, logPositions);
+            var firstPosition = batch.FirstLogPosition;
+            WriteBatch(batch);
+            return firstPosition;
+        }
+
+        /// <summary>
+        /// Encodes the specified <see cref="T:LogEntry"/> objects into as few
+        /// log blocks as possible and reserves space for them in this stream.
+        /// </summary>
+        /// <param name="entries">The log entries.</param>
+        /// <param name="startIndex">The index of the first entry to encode.</param>
+        /// <param name="count">The number of entries to encode.</param>
+        /// <param name="logPositions">
+        /// When specified receives the log position of each entry.
+        /// </param>
+        /// <returns>
+        /// A <see cref="LogBlockBatch"/> that must be passed to
+        /// <see cref="WriteBatch"/>.
+        /// </returns>
+        /// <exception cref="InvalidOperationException">
+        /// An entry is too large to fit in a log block or the stream is full.
+        /// </exception>
+        public LogBlockBatch PrepareEntries(
+            IList<LogEntry> entries, int startIndex, int count, IList<uint> logPositions)
         {
             lock (_syncWrite)
             {
-                // Record cursor position of last log record written to the
-                //	stream and move stream position to write point.
-                entry.LastLog = _logFileInfo.CurrentHeader.LastCursor;
-                Seek(_logFileInfo.CurrentHeader.Cursor, SeekOrigin.Begin);
+                EnsureWriteBlockValid();
+                var batch = _freeBatches.GetObject();
+                batch.BlockStart = _writeBlockStart;
 
-                // Serialise the log entry
-                EnsurePositionValid();
-                try
+                // Entries are encoded straight into the batch buffer
+                var blockOffset = 0;
+                var writer = new LogRecordWriter(batch.Buffer, LogBlockHeader.HeaderSize, MaximumBlockPayload);
+                var lastCursor = _writeLastCursor;
+                var blockEntries = 0;
+                var blockHasPageImages = false;
+                uint firstLogId = 0;
+                uint lastLogId = 0;
+                for (var index = startIndex; index < startIndex + count; ++index)
                 {
-                    entry.Write(_streamWriter);
+                    var entry = entries[index];
+                    var rawSize = (int)entry.RawSize;
+                    if (rawSize > MaximumBlockPayload)
+                    {
+                        _freeBatches.PutObject(batch);
+                        throw new InvalidOperationException("Log entry is too large for a log block.");
+                    }
+
+                    // Complete the pending block when this entry will not fit
+                    if (blockEntries == MaximumEntriesPerBlock ||
+                        rawSize > writer.Remaining)
+                    {
+                        blockOffset += CompleteBlock(batch, blockOffset,
+                            writer.Position - blockOffset - LogBlockHeader.HeaderSize,
+                            blockEntries, firstLogId, lastLogId, blockHasPageImages);
+                        EnsureBatchCapacity(batch, blockOffset + MaximumBlockSize);
+                        writer = new LogRecordWriter(
+                            batch.Buffer, blockOffset + LogBlockHeader.HeaderSize, MaximumBlockPayload);
+                        blockEntries = 0;
+                        blockHasPageImages = false;
+                    }
+
+                    // Record position of last log record written and encode
+                    entry.LastLog = lastCursor;
+                    entry.Encode(ref writer);
+
+                    if (blockEntries == 0)
+                    {
+                        firstLogId = entry.LogId;
+                    }
+                    lastLogId = entry.LogId;
+                    blockHasPageImages |= entry is PageLogEntry;
+                    lastCursor = (uint)(_writeBlockStart + blockOffset) | (uint)blockEntries;
+                    logPositions?.Add(lastCursor);
+                    ++blockEntries;
                 }
-                finally
+
+                if (blockEntries > 0)
                 {
+                    blockOffset += CompleteBlock(batch, blockOffset,
+                        writer.Position - blockOffset - LogBlockHeader.HeaderSize,
+                        blockEntries, firstLogId, lastLogId, blockHasPageImages);
+                }
+
+                // Commit the reservation
+                batch.Length = blockOffset;
+                _writeBlockStart += blockOffset;
+                _writeLastCursor = lastCursor;
+                batch.Cursor = (uint)_writeBlockStart;
+                batch.LastCursor = lastCursor;
+                return batch;
+            }
+        }
+
+        /// <summary>
+        /// Writes a batch of log blocks prepared by this stream.
+        /// </summary>
+        /// <param name="batch">The batch.</param>
+        /// <remarks>
+        /// The file header is rewritten once the blocks have been written
+        /// so it never refers to blocks that have not reached the disk.
+        /// </remarks>
+        public void WriteBatch(LogBlockBatch batch)
+        {
+            if (batch.Stream != this)
+            {
+                throw new ArgumentException("Batch was prepared by a different stream.", nameof(batch));
+            }
+
+            lock (_syncIo)
+            {
+                // Write the entire batch in a single operation
+                if (batch.Length > 0)
+                {
+                    _streamWriter.Flush();
+                    _innerStream.Position = TotalHeaderSize + _logFileInfo.StartOffset + batch.BlockStart;
+                    _innerStream.Write(batch.Buffer, 0, batch.Length);
                     UpdatePosition();
                 }
 
                 // If write was successfull then we can update the header.
-                _logFileInfo.CurrentHeader.LastCursor =
-                    _logFileInfo.CurrentHeader.Cursor;
-                _logFileInfo.CurrentHeader.Cursor = (uint)Position;
+                _logFileInfo.CurrentHeader.Cursor = batch.Cursor;
+                _logFileInfo.CurrentHeader.LastCursor = batch.LastCursor;
                 WriteHeader();
             }
+
+            if (_freeBatches.Count < MaximumPooledBatches)
+            {
+                _freeBatches.PutObject(batch);
+            }
+        }
+
+        /// <summary>
+        /// Positions the stream for reading at the specified log position.
+        /// </summary>
+        /// <param name="logPosition">The log position.</param>
+        public void SeekLogPosition(uint logPosition)
+        {
+            _readBlockStart = logPosition & ~(uint)(BlockAlignment - 1);
+            _readLastLogId = 0;
+            _readIndex = 0;
+            if (!ReadBlock(_readBlockStart))
+            {
+                _readEntryCount = 0;
+                return;
+            }
+
+            // Skip over entries preceding the requested entry
+            var entryIndex = (int)(logPosition & (BlockAlignment - 1));
+            while (_readIndex < entryIndex && TryReadEntryInfo(out _))
+            {
+            }
         }
 
         /// <summary>
         /// Reads the next log entry from the log file stream.
         /// </summary>
-        /// <returns><see cref="T:LogEntry"/> object.</returns>
+        /// <returns>
+        /// <see cref="T:LogEntry"/> object or <c>null</c> when there are no
+        /// further valid log blocks in this stream.
+        /// </returns>
         public LogEntry ReadEntry()
         {
-            LogEntry entry;
-            EnsurePositionValid();
-            try
+            if (!EnsureReadEntryAvailable())
             {
-                entry = LogEntry.ReadEntry(_streamReader);
+                return null;
             }
-            finally
+
+            var reader = new LogRecordReader(_readData, _readCursor, _readDataEnd - _readCursor);
+            var entry = LogEntry.ReadEntry(ref reader);
+            _readCursor = reader.Position;
+            ++_readIndex;
+            return entry;
+        }
+
+        /// <summary>
+        /// Decodes the next log record from the log file stream without
+        /// creating a log entry object.
+        /// </summary>
+        /// <param name="record">The log record.</param>
+        /// <returns>
+        /// <c>true</c> if a record was read; <c>false</c> when there are no
+        /// further valid log blocks in this stream.
+        /// </returns>
+        public bool TryReadRecord(out LogRecord record)
+        {
+            if (!EnsureReadEntryAvailable())
             {
-                UpdatePosition();
+                record = default(LogRecord);
+                return false;
             }
-            return entry;
+
+            var reader = new LogRecordReader(_readData, _readCursor, _readDataEnd - _readCursor);
+            record = LogRecord.Decode(ref reader);
+            _readCursor = reader.Position;
+            ++_readIndex;
+            return true;
+        }
+
+        /// <summary>
+        /// Reads the identity of the next log entry without decoding the
+        /// full record.
+        /// </summary>
+        /// <param name="info">The log record information.</param>
+        /// <returns>
+        /// <c>true</c> if an entry was read; <c>false</c> when there are no
+        /// further valid log blocks in this stream.
+        /// </returns>
+        public bool TryReadEntryInfo(out LogRecordInfo info)
+        {
+            if (!EnsureReadEntryAvailable())
+            {
+                info = default(LogRecordInfo);
+                return false;
+            }
+
+            var reader = new LogRecordReader(_readData, _readCursor, _readDataEnd - _readCursor);
+            info = LogEntry.ReadEntryInfo(ref reader);
+            _readCursor = reader.Position;
+            ++_readIndex;
+            return true;
+        }
+
+        /// <summary>
+        /// Reads the identity of the next log entry without decoding the
+        /// full record or moving past it.
+        /// </summary>
+        /// <param name="info">The log record information.</param>
+        /// <returns>
+        /// <c>true</c> if an entry is available; <c>false</c> when there are
+        /// no further valid log blocks in this stream.
+        /// </returns>
+        public bool TryPeekEntryInfo(out LogRecordInfo info)
+        {
+            if (!EnsureReadEntryAvailable())
+            {
+                info = default(LogRecordInfo);
+                return false;
+            }
+
+            var reader = new LogRecordReader(_readData, _readCursor, _readDataEnd - _readCursor);
+            info = LogEntry.ReadEntryInfo(ref reader);
+            return true;
         }
 
         /// <summary>
@@ -293,8 +778,11 @@ namespace Zen.Trunk.Storage.Logging
             }
 
             // Seek inner stream and update known position
-            _innerStream.Seek(newOffset, SeekOrigin.Begin);
-            UpdatePosition();
+            lock (_syncIo)
+            {
+                _innerStream.Seek(newOffset, SeekOrigin.Begin);
+                UpdatePosition();
+            }
 
             return Position;
         }
@@ -319,14 +807,17 @@ namespace Zen.Trunk.Storage.Logging
         {
             if (_streamWriter != null && CanWrite)
             {
-                // Write header block if necessary
-                if (_headerDirty)
+                lock (_syncIo)
                 {
-                    WriteHeader();
-                }
+                    // Write header block if necessary
+                    if (_headerDirty)
+                    {
+                        WriteHeader();
+                    }
 
-                // Flush to underlying stream
-                _streamWriter.Flush();
+                    // Flush to underlying stream
+                    _streamWriter.Flush();
+                }
             }
         }
 
@@ -348,14 +839,17 @@ namespace Zen.Trunk.Storage.Logging
             }
 
             int retVal;
-            EnsurePositionValid();
-            try
-            {
-                retVal = _innerStream.Read(buffer, offset, count);
-            }
-            finally
+            lock (_syncIo)
             {
-                UpdatePosition();
+                EnsurePositionValid();
+                try
+                {
+                    retVal = _innerStream.Read(buffer, offset, count);
+                }
+                finally
+                {
+                    UpdatePosition();
+                }
             }
             return retVal;
         }
@@ -375,14 +869,17 @@ namespace Zen.Trunk.Storage.Logging
             }
 
             int retVal;
-            EnsurePositionValid();
-            try
+            lock (_syncIo)
             {
-                retVal = _innerStream.ReadByte();
-            }
-            finally
-            {
-                UpdatePosition();
+                EnsurePositionValid();
+                try
+                {
+                    retVal = _innerStream.ReadByte();
+                }
+                finally
+                {
+                    UpdatePosition();
+                }
             }
             return retVal;
         }
@@ -409,14 +906,17 @@ namespace Zen.Trunk.Storage.Logging
                 return;
             }
 
-            EnsurePositionValid();
-            try
-            {
-                _innerStream.Write(buffer, offset, count);
-            }
-            finally
+            lock (_syncIo)
             {
-                UpdatePosition();
+                EnsurePositionValid();
+                try
+                {
+                    _innerStream.Write(buffer, offset, count);
+                }
+                finally
+                {
+                    UpdatePosition();
+                }
             }
         }
 
@@ -434,35 +934,342 @@ namespace Zen.Trunk.Storage.Logging
                 throw new InvalidOperationException("Stream mode does not support writing.");
             }
 
-            EnsurePositionValid();
+            lock (_syncIo)
+            {
+                EnsurePositionValid();
+                try
+                {
+                    _innerStream.WriteByte(value);
+                }
+                finally
+                {
+                    UpdatePosition();
+                }
+            }
+        }
+        #endregion
+
+        #region Private Methods
+        private static long AlignBlockLength(long length)
+        {
+            return (length + BlockAlignment - 1) & ~(long)(BlockAlignment - 1);
+        }
+
+        private void EnsureWriteBlockValid()
+        {
+            if (_writeBlockValid)
+            {
+                return;
+            }
+
+            // Writing resumes after the last block recorded in the header
+            _writeBlockStart = _logFileInfo.CurrentHeader.Cursor;
+            _writeLastCursor = _logFileInfo.CurrentHeader.LastCursor;
+            var block = _writeBlock ?? (_writeBlock = new byte[MaximumBlockSize]);
+            if (TryReadBlock(_writeBlockStart, block, _writeHeader))
+            {
+                _writeBlockStart += AlignBlockLength(LogBlockHeader.HeaderSize + _writeHeader.StoredLength);
+            }
+            _writeBlockValid = true;
+        }
+
+        private static void EnsureBatchCapacity(LogBlockBatch batch, int length)
+        {
+            if (batch.Buffer.Length < length)
+            {
+                var buffer = batch.Buffer;
+                Array.Resize(ref buffer, Math.Max(length, buffer.Length * 2));
+                batch.Buffer = buffer;
+            }
+        }
+
+        private int CompleteBlock(
+            LogBlockBatch batch,
+            int blockOffset,
+            int rawLength,
+            int entryCount,
+            uint firstLogId,
+            uint lastLogId,
+            bool hasPageImages)
+        {
+            var block = batch.Buffer;
+            var payloadOffset = blockOffset + LogBlockHeader.HeaderSize;
+            var storedLength = rawLength;
+            var isCompressed = false;
+
+            // Page images typically compress well
+            if (CompressPageImages && hasPageImages)
+            {
+                var compressed = _compressStream ?? (_compressStream = new MemoryStream(MaximumBlockSize));
+                compressed.SetLength(0);
+                using (var deflate = new DeflateStream(compressed, CompressionLevel.Fastest, true))
+                {
+                    deflate.Write(block, payloadOffset, rawLength);
+                }
+                if (compressed.Length < rawLength)
+                {
+                    storedLength = (int)compressed.Length;
+                    Buffer.BlockCopy(compressed.GetBuffer(), 0, block, payloadOffset, storedLength);
+                    isCompressed = true;
+                }
+            }
+
+            // Check block will fit
+            var blockLength = (int)AlignBlockLength(LogBlockHeader.HeaderSize + storedLength);
+            if (_writeBlockStart + blockOffset + blockLength > Length)
+            {
+                throw new InvalidOperationException("Virtual log file is full.");
+            }
+
+            // Clear padding so stale data never reaches the disk
+            var payloadEnd = payloadOffset + storedLength;
+            Array.Clear(block, payloadEnd, blockOffset + blockLength - payloadEnd);
+
+            // Compute checksum over header and payload then encode header
+            var header = _writeHeader;
+            header.IsCompressed = isCompressed;
+            header.EntryCount = (ushort)entryCount;
+            header.StoredLength = (ushort)storedLength;
+            header.RawLength = (ushort)rawLength;
+            header.FirstLogId = firstLogId;
+            header.LastLogId = lastLogId;
+            header.Sequence = _logFileInfo.CurrentHeader.Sequence;
+            header.Checksum = 0;
+            header.Encode(block, blockOffset);
+            header.Checksum = Crc32C.Append(
+                Crc32C.Compute(block, blockOffset, LogBlockHeader.ChecksumOffset),
+                block, payloadOffset, storedLength);
+            header.Encode(block, blockOffset);
+            return blockLength;
+        }
+
+        private bool TryReadBlock(long blockStart, byte[] block, LogBlockHeader header)
+        {
+            lock (_syncIo)
+            {
+                return TryReadBlockCore(blockStart, block, header);
+            }
+        }
+
+        private bool TryReadBlockCore(long blockStart, byte[] block, LogBlockHeader header)
+        {
+            var headerOffset = TotalHeaderSize + _logFileInfo.StartOffset + blockStart;
+            if (blockStart + LogBlockHeader.HeaderSize > Length ||
+                headerOffset + LogBlockHeader.HeaderSize > _innerStream.Length)
+            {
+                return false;
+            }
+
+            // Read and decode the block header
+            _innerStream.Position = headerOffset;
+            if (!ReadFully(block, 0, LogBlockHeader.HeaderSize))
+            {
+                return false;
+            }
+            header.Decode(block);
+
+            // Sanity check header fields
+            if (header.EntryCount == 0 ||
+                header.EntryCount > MaximumEntriesPerBlock ||
+                header.StoredLength > MaximumBlockPayload ||
+                header.RawLength > MaximumBlockPayload ||
+                header.FirstLogId > header.LastLogId ||
+                header.Sequence != _logFileInfo.CurrentHeader.Sequence ||
+                blockStart + AlignBlockLength(LogBlockHeader.HeaderSize + header.StoredLength) > Length)
+            {
+                return false;
+            }
+
+            // Read payload and validate checksum
+            if (!ReadFully(block, LogBlockHeader.HeaderSize, header.StoredLength))
+            {
+                return false;
+            }
+
+            var checksum = Crc32C.Append(
+                Crc32C.Compute(block, 0, LogBlockHeader.ChecksumOffset),
+                block, LogBlockHeader.HeaderSize, header.StoredLength);
+            return checksum == header.Checksum;
+        }
+
+        private bool ReadFully(byte[] buffer, int offset, int count)
+        {
+            while (count > 0)
+            {
+                var bytesRead = _innerStream.Read(buffer, offset, count);
+                if (bytesRead == 0)
+                {
+                    return false;
+                }
+                offset += bytesRead;
+                count -= bytesRead;
+            }
+            return true;
+        }
+
+        private bool EnsureReadEntryAvailable()
+        {
+            if (_readBlockStart < 0)
+            {
+                SeekLogPosition(0);
+            }
+
+            while (_readIndex >= _readEntryCount)
+            {
+                // Stop when the current block is invalid or was the last
+                if (_readEntryCount == 0)
+                {
+                    return false;
+                }
+
+                var nextBlockStart = _readBlockStart + _readBlockLength;
+                _readIndex = 0;
+                if (!ReadBlock(nextBlockStart))
+                {
+                    _readEntryCount = 0;
+                    return false;
+                }
+                _readBlockStart = nextBlockStart;
+            }
+            return true;
+        }
+
+        private bool ReadBlock(long blockStart)
+        {
+            var block = _readBlock ?? (_readBlock = new byte[MaximumBlockSize]);
+            var header = _readHeader;
             try
             {
-                _innerStream.WriteByte(value);
+                // Log ids never go backwards; anything older is left over
+                //  from an earlier use of this virtual file.
+                if (!TryReadBlock(blockStart, block, header) ||
+                    header.FirstLogId < _readLastLogId)
+                {
+                    return false;
+                }
+
+                // Decompress payload as required
+                var data = block;
+                var dataOffset = LogBlockHeader.HeaderSize;
+                if (header.IsCompressed)
+                {
+                    data = _readPayload ?? (_readPayload = new byte[MaximumBlockPayload]);
+                    dataOffset = 0;
+                    using (var deflate = new DeflateStream(
+                        new MemoryStream(block, LogBlockHeader.HeaderSize, header.StoredLength, false),
+                        CompressionMode.Decompress))
+                    {
+                        var rawRead = 0;
+                        while (rawRead < header.RawLength)
+                        {
+                            var bytesRead = deflate.Read(data, rawRead, header.RawLength - rawRead);
+                            if (bytesRead == 0)
+                            {
+                                return false;
+                            }
+                            rawRead += bytesRead;
+                        }
+                    }
+                }
+                var dataLength = header.IsCompressed ? header.RawLength : header.StoredLength;
+
+                // Walk the entries to make sure the block parses cleanly
+                var reader = new LogRecordReader(data, dataOffset, dataLength);
+                for (var index = 0; index < header.EntryCount; ++index)
+                {
+                    LogEntry.ReadEntryInfo(ref reader);
+                }
+                if (reader.Remaining != 0)
+                {
+                    return false;
+                }
+
+                _readData = data;
+                _readCursor = dataOffset;
+                _readDataEnd = dataOffset + dataLength;
+                _readEntryCount = header.EntryCount;
+                _readBlockLength = AlignBlockLength(LogBlockHeader.HeaderSize + header.StoredLength);
+                _readLastLogId = header.LastLogId;
+                return true;
+            }
+            catch (InvalidDataException)
+            {
+                // Corrupt compressed payload
+                return false;
             }
-            finally
+            catch (EndOfStreamException)
             {
-                UpdatePosition();
+                // Payload shorter than entries claim
+                return false;
+            }
+            catch (InvalidOperationException)
+            {
+                // Illegal log entry type
+                return false;
             }
         }
-        #endregion
 
-        #region Private Methods
-        private void ReadHeaders()
+        private uint ReadPersistedSequence()
+        {
+            // A file that has never been written has no headers to read
+            if (_logFileInfo.StartOffset + TotalHeaderSize > _innerStream.Length)
+            {
+                return 0;
+            }
+
+            ReadHeaderBlocks(out var firstHeader, out var secondHeader);
+            var sequence = 0u;
+            if (IsHeaderValid(firstHeader))
+            {
+                sequence = firstHeader.Sequence;
+            }
+            if (IsHeaderValid(secondHeader))
+            {
+                sequence = Math.Max(sequence, secondHeader.Sequence);
+            }
+            return sequence;
+        }
+
+        private void ReadHeaderBlocks(
+            out VirtualLogFileHeader firstHeader, out VirtualLogFileHeader secondHeader)
+        {
+            // Headers precede the data section so bypass stream positioning
+            lock (_syncIo)
+            {
+                var currentPosition = _innerStream.Position;
+                try
+                {
+                    _innerStream.Position = _logFileInfo.StartOffset;
+                    firstHeader = new VirtualLogFileHeader();
+                    firstHeader.Read(_streamReader);
+
+                    _innerStream.Position = _logFileInfo.StartOffset + HeaderSize;
+                    secondHeader = new VirtualLogFileHeader();
+                    secondHeader.Read(_streamReader);
+                }
+                finally
+                {
+                    _innerStream.Position = currentPosition;
+                }
+            }
+        }
+
+        private static bool IsHeaderValid(VirtualLogFileHeader header)
         {
-            // Read first header from log stream
-            Position = 0;
-            var firstHeader = new VirtualLogFileHeader();
-            firstHeader.Read(_streamReader);
+            // Timestamp is written first and hash last
+            return header.Timestamp != 0 &&
+                header.Timestamp.GetHashCode() == header.Hash;
+        }
 
-            // Read second header from log stream
-            Position = HeaderSize;
-            var secondHeader = new VirtualLogFileHeader();
-            secondHeader.Read(_streamReader);
+        private void ReadHeaders()
+        {
+            // Read both headers from log stream
+            ReadHeaderBlocks(out var firstHeader, out var secondHeader);
 
             // Determine whether each header is valid by comparison of timestamp hash
             //  with the value in the hash field (timestamp is written first and hash last)
-            var isFirstHeaderValid = firstHeader.Timestamp.GetHashCode() == firstHeader.Hash;
-            var isSecondHeaderValid = secondHeader.Timestamp.GetHashCode() == secondHeader.Hash;
+            var isFirstHeaderValid = IsHeaderValid(firstHeader);
+            var isSecondHeaderValid = IsHeaderValid(secondHeader);
 
             // Check for cases where only one header is valid
             if (isFirstHeaderValid && !isSecondHeaderValid)
@@ -520,27 +1327,30 @@ namespace Zen.Trunk.Storage.Logging
 
         private void WriteHeader()
         {
-            // Save the current position
-            var currentPosition = _innerStream.Position;
-            try
+            lock (_syncIo)
             {
-                // Header size is 28 bytes
-                _streamWriter.Flush();
-                _innerStream.Seek(_logFileInfo.StartOffset +
-                    (_writeFirstHeader ? 0 : HeaderSize), SeekOrigin.Begin);
+                // Save the current position
+                var currentPosition = _innerStream.Position;
+                try
+                {
+                    // Header size is 32 bytes
+                    _streamWriter.Flush();
+                    _innerStream.Seek(_logFileInfo.StartOffset +
+                        (_writeFirstHeader ? 0 : HeaderSize), SeekOrigin.Begin);
 
-                // Update state machine
-                _writeFirstHeader = !_writeFirstHeader;
-                ++_logFileInfo.CurrentHeader.Timestamp;
-                _logFileInfo.CurrentHeader.Hash = _logFileInfo.CurrentHeader.Timestamp.GetHashCode();
+                    // Update state machine
+                    _writeFirstHeader = !_writeFirstHeader;
+                    ++_logFileInfo.CurrentHeader.Timestamp;
+                    _logFileInfo.CurrentHeader.Hash = _logFileInfo.CurrentHeader.Timestamp.GetHashCode();
 
-                // Write the header block (28 bytes)
-                _logFileInfo.CurrentHeader.Write(_streamWriter);
-                _headerDirty = false;
-            }
-            finally
-            {
-                _innerStream.Position = currentPosition;
+                    // Write the header block (32 bytes)
+                    _logFileInfo.CurrentHeader.Write(_streamWriter);
+                    _headerDirty = false;
+                }
+                finally
+                {
+                    _innerStream.Position = currentPosition;
+                }
             }
         }
         #endregion
@@ -162,4 +162,41 @@ namespace Zen.Trunk.Storage
 			
 		}
 	}
+
+
+	/// <summary>
+	/// <b>PageUpdateConflictException</b> is thrown when a snapshot
+	/// transaction attempts to write a page that another transaction has
+	/// committed since the snapshot started.
+	/// </summary>
+	[Serializable]
+	public class PageUpdateConflictException : PageException
+	{
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PageUpdateConflictException"/> class.
+        /// </summary>
+        public PageUpdateConflictException ()
+			: this ("Page update conflict exception occurred.")
+		{
+		}
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PageUpdateConflictException"/> class.
+        /// </summary>
+        /// <param name="message">The message.</param>
+        public PageUpdateConflictException (string message)
+			: base (message, (Page)null)
+		{
+		}
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PageUpdateConflictException"/> class.
+        /// </summary>
+        /// <param name="info">The serialization information.</param>
+        /// <param name="context">The streaming context.</param>
+        protected PageUpdateConflictException (SerializationInfo info, StreamingContext context)
+			: base (info, context)
+		{
+		}
+	}
 }
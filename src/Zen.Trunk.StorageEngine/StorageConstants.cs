@@ -23,6 +23,14 @@
         /// </summary>
         public const string SecondaryDeviceFileExtension = ".sdf";
 
+        /// <summary>
+        /// The logical page map file extension
+        /// </summary>
+        /// <remarks>
+        /// Written alongside the primary device of each file-group.
+        /// </remarks>
+        public const string LogicalPageMapFileExtension = ".lpm";
+
         /// <summary>
         /// The primary file group => primary device filename
         /// </summary>